@@ -178,7 +178,8 @@ macro(CXXTEST_ADD_TEST _cxxtest_testname)
 				          COMMAND ${CMAKE_COMMAND} -E chdir "${CMAKE_BINARY_DIR}/bin/Testing" 
 						  $<TARGET_FILE:${_cxxtest_testname}> ${_performance_suite_name} )
         set_tests_properties ( ${_cxxtest_separate_name} PROPERTIES
-                               TIMEOUT ${TESTING_TIMEOUT} )
+                               TIMEOUT ${TESTING_TIMEOUT}
+                               LABELS Performance )
 			endif ()
 		endif ()
       endforeach ( part ${ARGN} )
@@ -0,0 +1,152 @@
+#!/usr/bin/env python
+"""
+Runs the CxxTest Performance suites and records their timings, or compares
+two sets of recorded timings.
+
+The Performance suites are registered with ctest, under the "Performance"
+label, when the build is configured with CXXTEST_ADD_PERFORMANCE=ON.
+
+  benchmark.py run --build-dir <build> [--threads 1,8] [--filter Rebin] \\
+               [--output results.json]
+  benchmark.py compare base.json new.json [--tolerance 0.1]
+
+Each suite is run once for each thread count with OMP_NUM_THREADS set.
+The timings are taken from the xUnit files that the test runners write to
+<build>/bin/Testing and saved as JSON. Compare exits with a non-zero status
+if any test is slower than the base by more than the tolerance.
+"""
+import glob
+import json
+import multiprocessing
+import optparse
+import os
+import platform
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ElementTree
+
+VERSION = "1.0"
+
+#======================================================================
+def git_revision(directory):
+    """Returns the commit checked out in the given directory, or an empty string"""
+    try:
+        process = subprocess.Popen(["git", "rev-parse", "HEAD"], cwd=directory,
+                                   stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        out = process.communicate()[0]
+        return out.decode().strip()
+    except OSError:
+        return ""
+
+#======================================================================
+def read_xunit(filename, threads):
+    """Returns the test cases of an xUnit file as a list of dictionaries"""
+    results = []
+    root = ElementTree.parse(filename).getroot()
+    for case in root.iter("testcase"):
+        # classname is <runner>.<suite>
+        suite = case.get("classname").split(".")[-1]
+        failed = case.find("failure") is not None or case.find("error") is not None
+        results.append({"suite": suite,
+                        "test": case.get("name"),
+                        "threads": threads,
+                        "seconds": float(case.get("time", 0.0)),
+                        "total_seconds": float(case.get("totalTime", 0.0)),
+                        "passed": not failed})
+    return results
+
+#======================================================================
+def run(options):
+    """Runs the Performance suites for each thread count and writes the timings"""
+    build_dir = os.path.abspath(options.build_dir)
+    testing_dir = os.path.join(build_dir, "bin", "Testing")
+    source_dir = os.path.dirname(os.path.abspath(__file__))
+
+    results = []
+    for threads in sorted(set([int(n) for n in options.threads.split(",")])):
+        print("Running Performance suites with %d thread(s)" % threads)
+        env = dict(os.environ)
+        env["OMP_NUM_THREADS"] = str(threads)
+        started = time.time()
+        command = [options.ctest, "-L", "Performance"]
+        if options.filter:
+            command += ["-R", options.filter]
+        subprocess.call(command, cwd=build_dir, env=env)
+        # Only pick up the files written by this run
+        for filename in glob.glob(os.path.join(testing_dir, "TEST-*Performance.xml")):
+            if os.path.getmtime(filename) >= started:
+                results += read_xunit(filename, threads)
+
+    report = {"version": VERSION,
+              "revision": git_revision(source_dir),
+              "host": platform.node(),
+              "platform": platform.platform(),
+              "cores": multiprocessing.cpu_count(),
+              "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+              "results": results}
+    output = open(options.output, "w")
+    json.dump(report, output, indent=1, sort_keys=True)
+    output.close()
+    print("Wrote %d timings to %s" % (len(results), options.output))
+    return 0
+
+#======================================================================
+def compare(base_file, new_file, tolerance):
+    """Prints the change in each timing and returns 1 if any test regressed"""
+    def load(filename):
+        report = json.load(open(filename))
+        timings = {}
+        for result in report["results"]:
+            if result["passed"]:
+                key = (result["suite"], result["test"], result["threads"])
+                timings[key] = result["seconds"]
+        return report, timings
+
+    base_report, base = load(base_file)
+    new_report, new = load(new_file)
+    print("Base: %s (%s)" % (base_report.get("revision", ""), base_report.get("date", "")))
+    print("New:  %s (%s)" % (new_report.get("revision", ""), new_report.get("date", "")))
+
+    regressions = 0
+    for key in sorted(set(base.keys()) & set(new.keys())):
+        before, after = base[key], new[key]
+        change = (after - before) / before if before > 0 else 0.0
+        flag = ""
+        if change > tolerance:
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%-40s %-40s %3d %10.3f %10.3f %+7.1f%%%s" %
+              (key[0], key[1], key[2], before, after, 100.0 * change, flag))
+    for key in sorted(set(base.keys()) ^ set(new.keys())):
+        print("%-40s %-40s %3d only in %s" %
+              (key[0], key[1], key[2], base_file if key in base else new_file))
+
+    print("%d regression(s) above %.0f%%" % (regressions, 100.0 * tolerance))
+    return 1 if regressions > 0 else 0
+
+#======================================================================
+def main():
+    parser = optparse.OptionParser(usage=__doc__, version=VERSION)
+    parser.add_option("--build-dir", default=".",
+                      help="The build directory containing CTestTestfile.cmake")
+    parser.add_option("--ctest", default="ctest", help="The ctest executable")
+    parser.add_option("--threads", default="1,%d" % multiprocessing.cpu_count(),
+                      help="Comma-separated list of thread counts to run with")
+    parser.add_option("--filter", default="",
+                      help="Only run tests matching this regular expression")
+    parser.add_option("--output", default="benchmark.json",
+                      help="The file to write the timings to")
+    parser.add_option("--tolerance", type="float", default=0.1,
+                      help="Fractional slow-down reported as a regression by compare")
+    (options, args) = parser.parse_args()
+
+    if len(args) == 1 and args[0] == "run":
+        return run(options)
+    elif len(args) == 3 and args[0] == "compare":
+        return compare(args[1], args[2], options.tolerance)
+    parser.print_help()
+    return 2
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -28,6 +28,7 @@ namespace Poco {
 template <class R, class A, class O, class S> class ActiveMethod;
 template <class O> class ActiveStarter;
 class NotificationCenter;
+class Notification;
 template <class C, class N> class NObserver;
 class Void;
 }
@@ -314,6 +315,8 @@ protected:
 
   friend class AlgorithmProxy;
   void initializeFromProxy(const AlgorithmProxy &);
+  /// The AlgorithmManager marks the algorithms that it creates
+  friend class AlgorithmManagerImpl;
 
   void setInitialized();
   void setExecuted(bool state);
@@ -393,6 +396,9 @@ private:
 
   void logAlgorithmInfo() const;
 
+  /// Post a notification if anything can be observing this algorithm
+  void notifyObservers(Poco::Notification *notification) const;
+
   bool executeAsyncImpl(const Poco::Void &i);
 
   // Report that the algorithm has completed.
@@ -414,6 +420,7 @@ private:
   bool m_isInitialized;         ///< Algorithm has been initialized flag
   bool m_isExecuted;            ///< Algorithm is executed flag
   bool m_isChildAlgorithm;      ///< Algorithm is a child algorithm
+  bool m_isManaged; ///< Algorithm was created by the AlgorithmManager
   bool m_recordHistoryForChild; ///< Flag to indicate whether history should be
   /// recorded. Applicable to child algs only
   bool m_alwaysStoreInADS; ///< Always store in the ADS, even for child algos
@@ -71,6 +71,8 @@ public:
   virtual std::vector<double> getTofs() const = 0;
   /// Return the list of TOF values
   virtual void getTofs(std::vector<double> &tofs) const = 0;
+  /// Return the TOF values in place, stride bytes apart
+  virtual const double *readTofs(std::size_t &stride) const = 0;
   /// Return the list of event weight  values
   virtual std::vector<double> getWeights() const = 0;
   /// Return the list of event weight values
@@ -0,0 +1,179 @@
+#ifndef MANTID_API_KEYEDLRUCACHE_H_
+#define MANTID_API_KEYEDLRUCACHE_H_
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidKernel/MultiThreaded.h"
+#include <boost/shared_ptr.hpp>
+#include <Poco/NObserver.h>
+#include <limits>
+#include <list>
+
+namespace Mantid {
+namespace API {
+
+/** KeyedLRUCache : Keeps the most recently used of a small number of large,
+  expensive-to-compute values so that algorithms run repeatedly on the same
+  inputs can reuse them. Values are looked up by equality of their key. The
+  least recently used value is discarded once either the number of values or
+  the memory they take up would exceed the limits, and everything is released
+  when the AnalysisDataService is cleared.
+
+  VALUETYPE must provide
+    - const KEYTYPE &cacheKey() const : the key the value was computed for
+    - size_t memorySize() const : the memory used by the value, in bytes
+  and KEYTYPE must provide operator==.
+
+  A cache shared between algorithms is reached through a
+  Kernel::SingletonHolder of its instantiation.
+
+  Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge
+  National Laboratory
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename KEYTYPE, typename VALUETYPE> class KeyedLRUCache {
+public:
+  /// Typedef for a shared pointer to a cached value
+  typedef boost::shared_ptr<const VALUETYPE> Value_const_sptr;
+
+  /**
+   * @param capacity :: The maximum number of values to keep
+   */
+  explicit KeyedLRUCache(const size_t capacity = 2)
+      : m_values(), m_capacity(capacity), m_memorySize(0), m_hits(0),
+        m_clearObserver(*this, &KeyedLRUCache::handleClear), m_mutex() {
+    AnalysisDataService::Instance().notificationCenter.addObserver(
+        m_clearObserver);
+  }
+
+  /// Stops observing the AnalysisDataService
+  ~KeyedLRUCache() {
+    AnalysisDataService::Instance().notificationCenter.removeObserver(
+        m_clearObserver);
+  }
+
+  /**
+   * A value that is found is moved to the front of the list so that it is the
+   * last to be discarded.
+   * @param key :: The key to look for
+   * @returns The value for the key or an empty pointer if there is none
+   */
+  Value_const_sptr find(const KEYTYPE &key) const {
+    Kernel::Mutex::ScopedLock lock(m_mutex);
+    typename std::list<Value_const_sptr>::iterator it = m_values.begin();
+    for (; it != m_values.end(); ++it) {
+      if ((*it)->cacheKey() == key) {
+        Value_const_sptr value = *it;
+        m_values.erase(it);
+        m_values.push_front(value);
+        ++m_hits;
+        return value;
+      }
+    }
+    return Value_const_sptr();
+  }
+
+  /**
+   * Any existing value for the same key is replaced. The least recently used
+   * values are discarded until both the number of values and their memory are
+   * within the limits. A value that is larger than maxMemory on its own is not
+   * stored.
+   * @param value :: The value to store
+   * @param maxMemory :: The most memory, in bytes, that the cache may hold
+   */
+  void store(const Value_const_sptr &value,
+             const size_t maxMemory = std::numeric_limits<size_t>::max()) {
+    if (!value || m_capacity == 0)
+      return;
+    const size_t valueSize = value->memorySize();
+    Kernel::Mutex::ScopedLock lock(m_mutex);
+    typename std::list<Value_const_sptr>::iterator it = m_values.begin();
+    while (it != m_values.end()) {
+      if ((*it)->cacheKey() == value->cacheKey()) {
+        m_memorySize -= (*it)->memorySize();
+        it = m_values.erase(it);
+      } else
+        ++it;
+    }
+    if (valueSize > maxMemory)
+      return;
+    m_values.push_front(value);
+    m_memorySize += valueSize;
+    while (m_values.size() > m_capacity || m_memorySize > maxMemory) {
+      m_memorySize -= m_values.back()->memorySize();
+      m_values.pop_back();
+    }
+  }
+
+  /// Remove all of the values
+  void clear() {
+    Kernel::Mutex::ScopedLock lock(m_mutex);
+    m_values.clear();
+    m_memorySize = 0;
+  }
+
+  /// @returns The number of values currently held
+  size_t size() const {
+    Kernel::Mutex::ScopedLock lock(m_mutex);
+    return m_values.size();
+  }
+
+  /// @returns The memory taken by the values currently held, in bytes
+  size_t memorySize() const {
+    Kernel::Mutex::ScopedLock lock(m_mutex);
+    return m_memorySize;
+  }
+
+  /// @returns The maximum number of values held
+  size_t capacity() const { return m_capacity; }
+
+  /// @returns The number of times find has returned a value
+  size_t hits() const {
+    Kernel::Mutex::ScopedLock lock(m_mutex);
+    return m_hits;
+  }
+
+private:
+  /// Private copy constructor. NO COPY ALLOWED
+  KeyedLRUCache(const KeyedLRUCache &);
+  /// Private assignment operator. NO ASSIGNMENT ALLOWED
+  KeyedLRUCache &operator=(const KeyedLRUCache &);
+
+  /// The values can be large, so they are released along with the
+  /// workspaces when the framework clears its memory
+  void handleClear(ClearADSNotification_ptr) { clear(); }
+
+  /// The values, most recently used first
+  mutable std::list<Value_const_sptr> m_values;
+  /// Maximum number of values to keep
+  const size_t m_capacity;
+  /// The memory taken by the values held, in bytes
+  size_t m_memorySize;
+  /// Number of successful lookups
+  mutable size_t m_hits;
+  /// Observer of the clearing of the AnalysisDataService
+  Poco::NObserver<KeyedLRUCache, ClearADSNotification> m_clearObserver;
+  /// Guards access to the list
+  mutable Kernel::Mutex m_mutex;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_KEYEDLRUCACHE_H_ */
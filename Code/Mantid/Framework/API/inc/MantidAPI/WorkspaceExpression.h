@@ -0,0 +1,121 @@
+#ifndef MANTID_API_WORKSPACEEXPRESSION_H_
+#define MANTID_API_WORKSPACEEXPRESSION_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/MatrixWorkspace.h"
+
+#include <boost/shared_ptr.hpp>
+
+namespace Mantid {
+namespace API {
+//----------------------------------------------------------------------
+// Forward declarations
+//----------------------------------------------------------------------
+class Algorithm;
+
+/**
+A deferred chain of element-wise arithmetic on matrix workspaces.
+
+Combining WorkspaceExpressions only records the operations. Nothing is
+computed until evaluate() is called, which creates a single output workspace
+and fills it in one parallel pass over the spectra, propagating the errors in
+the same way as the Plus, Minus, Multiply, Divide, Power and Exponential
+algorithms. Compared with running those algorithms in turn, no intermediate
+workspaces are created, e.g.
+
+@code
+WorkspaceExpression s(sample), c(can), v(vanadium);
+MatrixWorkspace_sptr result = ((s - c * 0.9) / v).evaluate();
+@endcode
+
+Note that the operators on MatrixWorkspace_sptr run the algorithms straight
+away, so at least one operand of each operator must be a WorkspaceExpression.
+
+All workspaces in an expression must have the same number of histograms, the
+same number of bins, matching X values and the same X unit. The output takes
+its X values, instrument and meta-data from the first workspace in the
+expression, with the Y unit, distribution flag and run that the algorithms
+would give it.
+
+The single pass does not handle event workspaces or masking. If any input is
+an event workspace or has masked bins or detectors, or the algorithms would
+reject the Y units, evaluate() runs the algorithms in turn instead so the
+result is always the same as theirs. isFused() tells which will happen.
+
+Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>.
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL WorkspaceExpression {
+public:
+  /// Forward declaration of the nodes of the expression tree
+  class Node;
+
+  /// An expression that is just a workspace
+  WorkspaceExpression(const MatrixWorkspace_const_sptr &workspace);
+  /// An expression that is just a workspace
+  WorkspaceExpression(const MatrixWorkspace_sptr &workspace);
+  /// An expression that is a constant value with an error
+  WorkspaceExpression(const double value, const double error = 0.0);
+
+  /// Compute the expression into a new workspace
+  MatrixWorkspace_sptr evaluate() const;
+  /// Compute the expression, stopping if the calling algorithm is cancelled
+  MatrixWorkspace_sptr evaluate(const Algorithm *caller) const;
+  /// True if evaluate() will compute the expression in a single pass
+  bool isFused() const;
+  /// The number of operations the expression will fuse
+  size_t numberOfOperations() const;
+  /// A readable form of the expression
+  std::string toString() const;
+
+  /// Internal: build an expression from a node
+  explicit WorkspaceExpression(const boost::shared_ptr<const Node> &node);
+  /// Internal: the root node of the expression
+  const boost::shared_ptr<const Node> &node() const { return m_node; }
+
+private:
+  /// Collect the workspaces of the expression and check they are compatible
+  void checkInputs(std::vector<MatrixWorkspace_const_sptr> &inputs) const;
+
+  boost::shared_ptr<const Node> m_node;
+};
+
+MANTID_API_DLL WorkspaceExpression operator+(const WorkspaceExpression &lhs,
+                                             const WorkspaceExpression &rhs);
+MANTID_API_DLL WorkspaceExpression operator-(const WorkspaceExpression &lhs,
+                                             const WorkspaceExpression &rhs);
+MANTID_API_DLL WorkspaceExpression operator*(const WorkspaceExpression &lhs,
+                                             const WorkspaceExpression &rhs);
+MANTID_API_DLL WorkspaceExpression operator/(const WorkspaceExpression &lhs,
+                                             const WorkspaceExpression &rhs);
+/// Raise each value to a power, as the Power algorithm
+MANTID_API_DLL WorkspaceExpression power(const WorkspaceExpression &base,
+                                         const double exponent);
+/// Take the exponential of each value, as the Exponential algorithm
+MANTID_API_DLL WorkspaceExpression exponential(const WorkspaceExpression &arg);
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_WORKSPACEEXPRESSION_H_ */
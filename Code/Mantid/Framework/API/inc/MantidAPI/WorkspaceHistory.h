@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidKernel/EnvironmentHistory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include <ctime>
 #include <set>
 
@@ -24,6 +25,13 @@ class HistoryView;
 /** This class stores information about the Workspace History used by algorithms
   on a workspace and the environment history.
 
+  The history is kept as a graph of immutable nodes, one for each algorithm
+  execution, that point to the nodes of the histories it was built from.
+  Copying a history or adding one history to another only copies the pointers
+  to the latest nodes, so the histories of workspaces produced from one another
+  share all their common entries. The sorted list of algorithm histories is
+  built from the graph when it is first asked for.
+
   @author Dickon Champion, ISIS, RAL
   @date 21/01/2008
 
@@ -56,8 +64,8 @@ public:
   virtual ~WorkspaceHistory();
   /// Copy constructor
   WorkspaceHistory(const WorkspaceHistory &);
-  /// Retrieve the algorithm history list
-  const AlgorithmHistories &getAlgorithmHistories() const;
+  /// Retrieve a copy of the algorithm history list
+  AlgorithmHistories getAlgorithmHistories() const;
   /// Retrieve the environment history
   const Kernel::EnvironmentHistory &getEnvironmentHistory() const;
   /// Append an workspace history to this one
@@ -100,10 +108,22 @@ private:
   AlgorithmHistory_sptr parseAlgorithmHistory(const std::string &rawData);
   /// Find the history entries at this level in the file.
   std::set<int> findHistoryEntries(::NeXus::File *file);
+
+  /// The algorithm history list, built from the graph if necessary
+  boost::shared_ptr<const AlgorithmHistories> algorithmHistories() const;
+
+  /// A node of the history graph
+  struct HistoryNode;
+  typedef boost::shared_ptr<const HistoryNode> HistoryNode_const_sptr;
+
   /// The environment of the workspace
   const Kernel::EnvironmentHistory m_environment;
-  /// The algorithms which have been called on the workspace
-  Mantid::API::AlgorithmHistories m_algorithms;
+  /// The latest nodes of the history graph of the workspace
+  std::vector<HistoryNode_const_sptr> m_heads;
+  /// The algorithms reachable from m_heads, built when first asked for
+  mutable boost::shared_ptr<const AlgorithmHistories> m_algorithms;
+  /// Guards the building of m_algorithms
+  mutable Kernel::Mutex m_mutex;
 };
 
 MANTID_API_DLL std::ostream &operator<<(std::ostream &,
@@ -15,6 +15,7 @@
 #include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Profiler.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Timer.h"
 
@@ -73,9 +74,9 @@ Algorithm::Algorithm()
       m_log("Algorithm"), g_log(m_log), m_groupSize(0), m_executeAsync(NULL),
       m_notificationCenter(NULL), m_progressObserver(NULL),
       m_isInitialized(false), m_isExecuted(false), m_isChildAlgorithm(false),
-      m_recordHistoryForChild(false), m_alwaysStoreInADS(false),
-      m_runningAsync(false), m_running(false), m_rethrow(false),
-      m_isAlgStartupLoggingEnabled(true), m_algorithmID(this),
+      m_isManaged(false), m_recordHistoryForChild(false),
+      m_alwaysStoreInADS(false), m_runningAsync(false), m_running(false),
+      m_rethrow(false), m_isAlgStartupLoggingEnabled(true), m_algorithmID(this),
       m_singleGroup(-1), m_groupsHaveSimilarNames(false) {}
 
 /// Virtual destructor
@@ -180,7 +181,7 @@ void Algorithm::removeObserver(const Poco::AbstractObserver &observer) const {
 */
 void Algorithm::progress(double p, const std::string &msg, double estimatedTime,
                          int progressPrecision) {
-  notificationCenter().postNotification(
+  notifyObservers(
       new ProgressNotification(this, p, msg, estimatedTime, progressPrecision));
 }
 
@@ -425,7 +426,11 @@ void Algorithm::unlockWorkspaces() {
 *  @return true if executed successfully.
 */
 bool Algorithm::execute() {
-  AlgorithmManager::Instance().notifyAlgorithmStarting(this->getAlgorithmID());
+  // Only algorithms created by the AlgorithmManager can be found by it. This
+  // avoids locking the manager for every execution of an unmanaged child.
+  if (m_isManaged)
+    AlgorithmManager::Instance().notifyAlgorithmStarting(
+        this->getAlgorithmID());
   {
     DeprecatedAlgorithm *depo = dynamic_cast<DeprecatedAlgorithm *>(this);
     if (depo != NULL)
@@ -434,7 +439,7 @@ bool Algorithm::execute() {
   // Start by freeing up any memory available.
   Mantid::API::MemoryManager::Instance().releaseFreeMemory();
 
-  notificationCenter().postNotification(new StartedNotification(this));
+  notifyObservers(new StartedNotification(this));
   Mantid::Kernel::DateAndTime start_time;
 
   // Return a failure if the algorithm hasn't been initialized
@@ -567,12 +572,23 @@ bool Algorithm::execute() {
       start_time = Mantid::Kernel::DateAndTime::getCurrentTime();
       // Start a timer
       Timer timer;
-      // Call the concrete algorithm's exec method
-      this->exec();
-      // Check for a cancellation request in case the concrete algorithm doesn't
-      interruption_point();
-      // Get how long this algorithm took to run
-      const float duration = timer.elapsed();
+      float duration(0.0f);
+      {
+        // Record the execution with the profiler, if it is switched on
+        ProfilerScope profile(std::string(),
+                              isChild() ? "child algorithm" : "algorithm");
+        if (profile.isActive()) {
+          profile.setName(name());
+          if (!isChild())
+            profile.sampleMemory();
+        }
+        // Call the concrete algorithm's exec method
+        this->exec();
+        // Check for a cancellation request in case exec() doesn't
+        interruption_point();
+        // Get how long this algorithm took to run
+        duration = timer.elapsed();
+      }
 
       // need it to throw before trying to run fillhistory() on an algorithm
       // which has failed
@@ -658,8 +674,7 @@ bool Algorithm::execute() {
   // Unlock the locked workspaces
   this->unlockWorkspaces();
 
-  notificationCenter().postNotification(
-      new FinishedNotification(this, isExecuted()));
+  notifyObservers(new FinishedNotification(this, isExecuted()));
   // Only gets to here if algorithm ended normally
   // Free up any memory available.
   Mantid::API::MemoryManager::Instance().releaseFreeMemory();
@@ -736,6 +751,10 @@ void Algorithm::store() {
 *  algorithms directly via the new operator is prefered since then
 *  the framework can take care of all of the necessary book-keeping.
 *
+*  Creating and initializing an algorithm costs much more than executing a
+*  small one. A parent that runs the same child in a loop should create it once
+*  and execute it again with new values set through the typed setProperty().
+*
 *  @param name ::           The concrete algorithm class of the Child Algorithm
 *  @param startProgress ::  The percentage progress value of the overall
 *algorithm where this child algorithm starts
@@ -943,6 +962,8 @@ void Algorithm::initializeFromProxy(const AlgorithmProxy &proxy) {
   initialize();
   copyPropertiesFrom(proxy);
   m_algorithmID = proxy.getAlgorithmID();
+  // Proxies are only made by the AlgorithmManager
+  m_isManaged = true;
   setLogging(proxy.isLogging());
   setLoggingOffset(proxy.getLoggingOffset());
   setAlgStartupLogging(proxy.getAlgStartupLogging());
@@ -1164,7 +1185,9 @@ bool Algorithm::checkGroups() {
     // Workspace groups are NOT returned by IWP->getWorkspace() most of the time
     // because WorkspaceProperty is templated by <MatrixWorkspace>
     // and WorkspaceGroup does not subclass <MatrixWorkspace>
-    if (!wsGroup && !prop->value().empty()) {
+    // A property that already holds a workspace that is not a group cannot be
+    // naming a group, so the AnalysisDataService is not searched for it
+    if (!ws && !prop->value().empty()) {
       // So try to use the name in the AnalysisDataService
       try {
         wsGroup = AnalysisDataService::Instance().retrieveWS<WorkspaceGroup>(
@@ -1355,8 +1378,7 @@ bool Algorithm::processGroups() {
 
   // We finished successfully.
   setExecuted(true);
-  notificationCenter().postNotification(
-      new FinishedNotification(this, isExecuted()));
+  notifyObservers(new FinishedNotification(this, isExecuted()));
 
   return true;
 }
@@ -1469,6 +1491,17 @@ Poco::NotificationCenter &Algorithm::notificationCenter() const {
   return *m_notificationCenter;
 }
 
+/** Sends a notification to the observers of this algorithm. Nothing can be
+ * observing an algorithm whose notification center has not been created yet,
+ * so then the notification is discarded rather than creating the center.
+ * @param notification :: The notification, which is owned by this method
+ */
+void Algorithm::notifyObservers(Poco::Notification *notification) const {
+  Poco::Notification::Ptr owner(notification);
+  if (m_notificationCenter)
+    m_notificationCenter->postNotification(owner);
+}
+
 /** Handles and rescales child algorithm progress notifications.
 *  @param pNf :: The progress notification from the child algorithm.
 */
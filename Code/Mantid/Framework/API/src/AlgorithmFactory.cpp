@@ -9,6 +9,7 @@
 #include "MantidKernel/ConfigService.h"
 
 #include "Poco/StringTokenizer.h"
+#include <boost/lexical_cast.hpp>
 
 namespace Mantid {
 namespace API {
@@ -121,9 +122,8 @@ bool AlgorithmFactoryImpl::exists(const std::string &algorithmName,
 */
 std::string AlgorithmFactoryImpl::createName(const std::string &name,
                                              const int &version) const {
-  std::ostringstream oss;
-  oss << name << "|" << version;
-  return (oss.str());
+  // This is called for every algorithm that is created so avoid a stream
+  return name + "|" + boost::lexical_cast<std::string>(version);
 }
 
 /** Decodes a mangled name for interal storage
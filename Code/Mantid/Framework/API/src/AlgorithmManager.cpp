@@ -71,6 +71,7 @@ IAlgorithm_sptr AlgorithmManagerImpl::create(const std::string &algName,
   try {
     Algorithm_sptr unmanagedAlg = AlgorithmFactory::Instance().create(
         algName, version); // Throws on fail:
+    unmanagedAlg->m_isManaged = true;
     if (makeProxy)
       alg = IAlgorithm_sptr(new AlgorithmProxy(unmanagedAlg));
     else
@@ -177,7 +177,7 @@ void AnalysisDataServiceImpl::addToGroup(const std::string &groupName,
   }
   auto ws = retrieve(wsName);
   group->addWorkspace(ws);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -222,7 +222,7 @@ void AnalysisDataServiceImpl::removeFromGroup(const std::string &groupName,
                              " does not containt workspace " + wsName);
   }
   group->removeByADS(wsName);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -0,0 +1,814 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/WorkspaceExpression.h"
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/SIMD.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace API {
+
+/// Scratch arrays for the intermediate results of one spectrum
+typedef std::vector<MantidVec> ScratchSpace;
+
+/// The Y unit and distribution flag that the algorithms would give a result
+struct YUnits {
+  std::string unit;  ///< The Y unit
+  bool distribution; ///< True if the result is a distribution
+  bool workspace;    ///< False if the result is a single value
+};
+
+/**
+ * A node of the expression tree. Each node can compute its value for a whole
+ * spectrum. Intermediate results of depth d are kept in the scratch arrays
+ * 2d and 2d+1, so a spectrum only ever occupies a few cache-sized buffers.
+ */
+class WorkspaceExpression::Node {
+public:
+  virtual ~Node() {}
+  /**
+   * Compute the data and errors of a spectrum
+   * @param index :: The workspace index
+   * @param depth :: The depth of this node in the tree
+   * @param scratch :: Scratch arrays, 2 for each level of the tree
+   * @param Y :: Output data, already sized to the number of bins
+   * @param E :: Output errors, already sized to the number of bins
+   */
+  virtual void evaluate(const size_t index, const size_t depth,
+                        ScratchSpace &scratch, MantidVec &Y,
+                        MantidVec &E) const = 0;
+  /// Append the workspaces used by the expression
+  virtual void workspaces(std::vector<MatrixWorkspace_const_sptr> &) const {}
+  /// The number of levels of operations below this node
+  virtual size_t depth() const { return 0; }
+  /// The number of operations in this node and below
+  virtual size_t operations() const { return 0; }
+  /// A readable form of the expression
+  virtual std::string toString() const = 0;
+  /// True, and the value, if the node is a constant
+  virtual bool isValue(double &, double &) const { return false; }
+  /// The workspace if the node is a plain workspace, otherwise NULL
+  virtual const MatrixWorkspace *workspace() const { return NULL; }
+  /**
+   * Work out the Y unit and distribution flag that running the algorithms
+   * would give the result
+   * @param units :: Set to the units of the result
+   * @param nbins :: The number of bins of the workspaces
+   * @returns False if only the algorithms can decide, e.g. when they would
+   * reject the units
+   */
+  virtual bool outputUnits(YUnits &units, const size_t nbins) const = 0;
+  /// True if the run of the result is not simply that of the first workspace
+  virtual bool mergesRuns() const { return false; }
+  /// The run that running the algorithms would give the result
+  virtual Run run() const = 0;
+  /// Compute the expression by running the algorithms in turn
+  virtual MatrixWorkspace_sptr runAlgorithms() const = 0;
+};
+
+namespace {
+/// static logger
+Kernel::Logger g_log("WorkspaceExpression");
+
+//----------------------------------------------------------------------
+// Per-bin kernels. These propagate the errors as the equivalent algorithms.
+//----------------------------------------------------------------------
+/// As Plus
+struct PlusKernel {
+  static const char *symbol() { return " + "; }
+  static const char *algorithm() { return "Plus"; }
+  /// Plus and Minus reject workspaces with different units
+  static bool setOutputUnits(const YUnits &lhs, const YUnits &rhs,
+                             const size_t, YUnits &) {
+    return !lhs.workspace || !rhs.workspace ||
+           (lhs.unit == rhs.unit && lhs.distribution == rhs.distribution);
+  }
+  /// Plus adds the runs, e.g. the proton charges
+  static const bool mergesRuns = true;
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    YOut = lhsY + rhsY;
+    EOut = std::sqrt(lhsE * lhsE + rhsE * rhsE);
+  }
+};
+
+/// As Minus
+struct MinusKernel {
+  static const char *symbol() { return " - "; }
+  static const char *algorithm() { return "Minus"; }
+  static bool setOutputUnits(const YUnits &lhs, const YUnits &rhs,
+                             const size_t nbins, YUnits &out) {
+    // x - workspace is run as x + workspace * -1
+    if (!lhs.workspace)
+      out.distribution = false;
+    return PlusKernel::setOutputUnits(lhs, rhs, nbins, out);
+  }
+  static const bool mergesRuns = false;
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    YOut = lhsY - rhsY;
+    EOut = std::sqrt(lhsE * lhsE + rhsE * rhsE);
+  }
+};
+
+/// As Multiply
+struct MultiplyKernel {
+  static const char *symbol() { return " * "; }
+  static const char *algorithm() { return "Multiply"; }
+  /// As Multiply::setOutputUnits, a single value is not a distribution
+  static bool setOutputUnits(const YUnits &lhs, const YUnits &rhs,
+                             const size_t, YUnits &out) {
+    if (!lhs.distribution || !rhs.distribution)
+      out.distribution = false;
+    return true;
+  }
+  static const bool mergesRuns = false;
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    const double a = lhsE * rhsY;
+    const double b = rhsE * lhsY;
+    EOut = std::sqrt(a * a + b * b);
+    YOut = lhsY * rhsY;
+  }
+};
+
+/// As Divide
+struct DivideKernel {
+  static const char *symbol() { return " / "; }
+  static const char *algorithm() { return "Divide"; }
+  /// As Divide::setOutputUnits
+  static bool setOutputUnits(const YUnits &lhs, const YUnits &rhs,
+                             const size_t nbins, YUnits &out) {
+    if (!lhs.workspace) {
+      // x / workspace is run as Power(workspace, -1) * x
+      out.distribution = false;
+    } else if (!rhs.workspace || rhs.unit.empty()) {
+      // The units are left alone
+    } else if (lhs.unit == rhs.unit && nbins > 1) {
+      out.unit = "";
+      out.distribution = true;
+    } else if (!lhs.unit.empty()) {
+      out.unit = lhs.unit + "/" + rhs.unit;
+    } else {
+      out.unit = "1/" + rhs.unit;
+    }
+    return true;
+  }
+  static const bool mergesRuns = false;
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    const double b = lhsY * rhsE / rhsY;
+    EOut = std::sqrt(lhsE * lhsE + b * b) / std::fabs(rhsY);
+    YOut = lhsY / rhsY;
+  }
+};
+
+/// As Power
+struct PowerKernel {
+  explicit PowerKernel(const double exponent) : m_exponent(exponent) {}
+  std::string name() const {
+    return "power(" + boost::lexical_cast<std::string>(m_exponent) + ")";
+  }
+  static const char *algorithm() { return "Power"; }
+  void setProperties(IAlgorithm &alg) const {
+    alg.setProperty("Exponent", m_exponent);
+  }
+  inline void operator()(const double YIn, const double EIn, double &YOut,
+                         double &EOut) const {
+    YOut = std::pow(YIn, m_exponent);
+    EOut = std::fabs(m_exponent * YOut * (EIn / YIn));
+  }
+  const double m_exponent;
+};
+
+/// As Exponential
+struct ExponentialKernel {
+  std::string name() const { return "exp"; }
+  static const char *algorithm() { return "Exponential"; }
+  void setProperties(IAlgorithm &) const {}
+  inline void operator()(const double YIn, const double EIn, double &YOut,
+                         double &EOut) const {
+    YOut = std::exp(YIn);
+    EOut = EIn * YOut;
+  }
+};
+
+//----------------------------------------------------------------------
+// Running the algorithms
+//----------------------------------------------------------------------
+/// @returns A WorkspaceSingleValue holding the value and error
+MatrixWorkspace_sptr singleValue(const double value, const double error) {
+  MatrixWorkspace_sptr single =
+      WorkspaceFactory::Instance().create("WorkspaceSingleValue", 1, 1, 1);
+  single->dataY(0)[0] = value;
+  single->dataE(0)[0] = error;
+  return single;
+}
+
+/// Run a binary operation algorithm as the workspace operators do
+MatrixWorkspace_sptr runBinaryAlgorithm(const std::string &name,
+                                        const MatrixWorkspace_sptr &lhs,
+                                        const MatrixWorkspace_sptr &rhs) {
+  return OperatorOverloads::executeBinaryOperation<
+      MatrixWorkspace_sptr, MatrixWorkspace_sptr, MatrixWorkspace_sptr>(
+      name, lhs, rhs, false, true, "", true);
+}
+
+/// Run the algorithm of a function of one argument
+template <typename Op>
+MatrixWorkspace_sptr runUnaryAlgorithm(const Op &kernel,
+                                       const MatrixWorkspace_sptr &input) {
+  IAlgorithm_sptr alg =
+      AlgorithmManager::Instance().createUnmanaged(Op::algorithm());
+  alg->setChild(true);
+  alg->setRethrows(true);
+  alg->initialize();
+  alg->setProperty("InputWorkspace", input);
+  alg->setPropertyValue("OutputWorkspace", "__NotApplicable");
+  kernel.setProperties(*alg);
+  alg->execute();
+  return alg->getProperty("OutputWorkspace");
+}
+
+/**
+ * Run the algorithms for value op workspace. Plus and Multiply accept a
+ * single value on either side.
+ * @param value :: The value as a WorkspaceSingleValue
+ * @param rhs :: The workspace
+ * @returns The result
+ */
+template <typename Op>
+MatrixWorkspace_sptr runWithValueOnLeft(const MatrixWorkspace_sptr &value,
+                                        const MatrixWorkspace_sptr &rhs) {
+  return runBinaryAlgorithm(Op::algorithm(), value, rhs);
+}
+
+/// Minus rejects a single value on the left, so x - workspace is run as
+/// workspace * -1 + x
+template <>
+MatrixWorkspace_sptr
+runWithValueOnLeft<MinusKernel>(const MatrixWorkspace_sptr &value,
+                                const MatrixWorkspace_sptr &rhs) {
+  return runBinaryAlgorithm(
+      "Plus", runBinaryAlgorithm("Multiply", rhs, singleValue(-1.0, 0.0)),
+      value);
+}
+
+/// Divide rejects a single value on the left, so x / workspace is run as
+/// Power(workspace, -1) * x
+template <>
+MatrixWorkspace_sptr
+runWithValueOnLeft<DivideKernel>(const MatrixWorkspace_sptr &value,
+                                 const MatrixWorkspace_sptr &rhs) {
+  return runBinaryAlgorithm(
+      "Multiply", runUnaryAlgorithm(PowerKernel(-1.0), rhs), value);
+}
+
+//----------------------------------------------------------------------
+// Nodes
+//----------------------------------------------------------------------
+/// A workspace
+class WorkspaceNode : public WorkspaceExpression::Node {
+public:
+  explicit WorkspaceNode(const MatrixWorkspace_const_sptr &workspace)
+      : m_workspace(workspace) {
+    if (!m_workspace)
+      throw std::invalid_argument("WorkspaceExpression: null workspace");
+  }
+  void evaluate(const size_t index, const size_t, ScratchSpace &, MantidVec &Y,
+                MantidVec &E) const {
+    Y = m_workspace->readY(index);
+    E = m_workspace->readE(index);
+  }
+  void workspaces(std::vector<MatrixWorkspace_const_sptr> &list) const {
+    list.push_back(m_workspace);
+  }
+  std::string toString() const {
+    const std::string name = m_workspace->getName();
+    return name.empty() ? "<workspace>" : name;
+  }
+  const MatrixWorkspace *workspace() const { return m_workspace.get(); }
+  bool outputUnits(YUnits &units, const size_t) const {
+    units.unit = m_workspace->YUnit();
+    units.distribution = m_workspace->isDistribution();
+    units.workspace = true;
+    return true;
+  }
+  Run run() const { return m_workspace->run(); }
+  MatrixWorkspace_sptr runAlgorithms() const {
+    // The algorithms do not modify their inputs
+    return boost::const_pointer_cast<MatrixWorkspace>(m_workspace);
+  }
+
+private:
+  const MatrixWorkspace_const_sptr m_workspace;
+};
+
+/// A constant value with an error
+class ValueNode : public WorkspaceExpression::Node {
+public:
+  ValueNode(const double value, const double error)
+      : m_value(value), m_error(error) {}
+  void evaluate(const size_t, const size_t, ScratchSpace &, MantidVec &Y,
+                MantidVec &E) const {
+    std::fill(Y.begin(), Y.end(), m_value);
+    std::fill(E.begin(), E.end(), m_error);
+  }
+  std::string toString() const {
+    std::string str = boost::lexical_cast<std::string>(m_value);
+    if (m_error != 0.0)
+      str += "(+-" + boost::lexical_cast<std::string>(m_error) + ")";
+    return str;
+  }
+  bool isValue(double &value, double &error) const {
+    value = m_value;
+    error = m_error;
+    return true;
+  }
+  bool outputUnits(YUnits &units, const size_t) const {
+    units.unit = "";
+    units.distribution = false;
+    units.workspace = false;
+    return true;
+  }
+  Run run() const { return Run(); }
+  MatrixWorkspace_sptr runAlgorithms() const {
+    return singleValue(m_value, m_error);
+  }
+
+private:
+  const double m_value;
+  const double m_error;
+};
+
+/// A binary operation
+template <typename Op>
+class BinaryNode : public WorkspaceExpression::Node {
+public:
+  BinaryNode(const boost::shared_ptr<const Node> &lhs,
+             const boost::shared_ptr<const Node> &rhs)
+      : m_lhs(lhs), m_rhs(rhs), m_kernel() {}
+
+  void evaluate(const size_t index, const size_t depth, ScratchSpace &scratch,
+                MantidVec &Y, MantidVec &E) const {
+    m_lhs->evaluate(index, depth + 1, scratch, Y, E);
+    // Constants and workspaces are used directly rather than copied
+    double value(0.0), error(0.0);
+    if (m_rhs->isValue(value, error)) {
+      Kernel::SIMD::binary(m_kernel, Y, E, value, error, Y, E);
+    } else if (const MatrixWorkspace *ws = m_rhs->workspace()) {
+      Kernel::SIMD::binary(m_kernel, Y, E, ws->readY(index), ws->readE(index),
+                           Y, E);
+    } else {
+      MantidVec &rhsY = scratch[2 * depth];
+      MantidVec &rhsE = scratch[2 * depth + 1];
+      m_rhs->evaluate(index, depth + 1, scratch, rhsY, rhsE);
+      Kernel::SIMD::binary(m_kernel, Y, E, rhsY, rhsE, Y, E);
+    }
+  }
+  void workspaces(std::vector<MatrixWorkspace_const_sptr> &list) const {
+    m_lhs->workspaces(list);
+    m_rhs->workspaces(list);
+  }
+  size_t depth() const { return 1 + std::max(m_lhs->depth(), m_rhs->depth()); }
+  size_t operations() const {
+    return 1 + m_lhs->operations() + m_rhs->operations();
+  }
+  std::string toString() const {
+    return "(" + m_lhs->toString() + Op::symbol() + m_rhs->toString() +
+           ")";
+  }
+  bool outputUnits(YUnits &units, const size_t nbins) const {
+    YUnits lhs, rhs;
+    if (!m_lhs->outputUnits(lhs, nbins) || !m_rhs->outputUnits(rhs, nbins))
+      return false;
+    // The algorithms create the output from the larger operand
+    units = lhs.workspace ? lhs : rhs;
+    return Op::setOutputUnits(lhs, rhs, nbins, units);
+  }
+  bool mergesRuns() const {
+    double value(0.0), error(0.0);
+    if (Op::mergesRuns && !m_lhs->isValue(value, error) &&
+        !m_rhs->isValue(value, error))
+      return true;
+    return m_lhs->mergesRuns() || m_rhs->mergesRuns();
+  }
+  Run run() const {
+    double value(0.0), error(0.0);
+    if (m_lhs->isValue(value, error))
+      return m_rhs->run();
+    Run result = m_lhs->run();
+    if (Op::mergesRuns && !m_rhs->isValue(value, error))
+      result += m_rhs->run();
+    return result;
+  }
+  MatrixWorkspace_sptr runAlgorithms() const {
+    double value(0.0), error(0.0);
+    if (m_lhs->isValue(value, error))
+      return runWithValueOnLeft<Op>(m_lhs->runAlgorithms(),
+                                    m_rhs->runAlgorithms());
+    return runBinaryAlgorithm(Op::algorithm(), m_lhs->runAlgorithms(),
+                              m_rhs->runAlgorithms());
+  }
+
+private:
+  const boost::shared_ptr<const Node> m_lhs;
+  const boost::shared_ptr<const Node> m_rhs;
+  const Op m_kernel;
+};
+
+/// A function of one argument
+template <typename Op>
+class UnaryNode : public WorkspaceExpression::Node {
+public:
+  UnaryNode(const boost::shared_ptr<const Node> &arg, const Op &kernel)
+      : m_arg(arg), m_kernel(kernel) {}
+
+  void evaluate(const size_t index, const size_t depth, ScratchSpace &scratch,
+                MantidVec &Y, MantidVec &E) const {
+    m_arg->evaluate(index, depth + 1, scratch, Y, E);
+    const ptrdiff_t n = static_cast<ptrdiff_t>(Y.size());
+    double *y = n > 0 ? &Y[0] : NULL;
+    double *e = n > 0 ? &E[0] : NULL;
+    PRAGMA_SIMD
+    for (ptrdiff_t i = 0; i < n; ++i) {
+      double yOut, eOut;
+      m_kernel(y[i], e[i], yOut, eOut);
+      y[i] = yOut;
+      e[i] = eOut;
+    }
+  }
+  void workspaces(std::vector<MatrixWorkspace_const_sptr> &list) const {
+    m_arg->workspaces(list);
+  }
+  size_t depth() const { return 1 + m_arg->depth(); }
+  size_t operations() const { return 1 + m_arg->operations(); }
+  std::string toString() const {
+    return m_kernel.name() + "(" + m_arg->toString() + ")";
+  }
+  /// Power and Exponential leave the units alone
+  bool outputUnits(YUnits &units, const size_t nbins) const {
+    return m_arg->outputUnits(units, nbins);
+  }
+  bool mergesRuns() const { return m_arg->mergesRuns(); }
+  Run run() const { return m_arg->run(); }
+  MatrixWorkspace_sptr runAlgorithms() const {
+    return runUnaryAlgorithm(m_kernel, m_arg->runAlgorithms());
+  }
+
+private:
+  const boost::shared_ptr<const Node> m_arg;
+  const Op m_kernel;
+};
+
+/// Combine two expressions, folding constants straight away
+template <typename Op>
+WorkspaceExpression combine(const WorkspaceExpression &lhs,
+                            const WorkspaceExpression &rhs) {
+  double lhsY(0.0), lhsE(0.0), rhsY(0.0), rhsE(0.0);
+  if (lhs.node()->isValue(lhsY, lhsE) && rhs.node()->isValue(rhsY, rhsE)) {
+    double YOut(0.0), EOut(0.0);
+    Op()(lhsY, lhsE, rhsY, rhsE, YOut, EOut);
+    return WorkspaceExpression(YOut, EOut);
+  }
+  return WorkspaceExpression(
+      boost::make_shared<BinaryNode<Op>>(lhs.node(), rhs.node()));
+}
+
+/// Apply a function, folding constants straight away
+template <typename Op>
+WorkspaceExpression apply(const WorkspaceExpression &arg, const Op &kernel) {
+  double YIn(0.0), EIn(0.0);
+  if (arg.node()->isValue(YIn, EIn)) {
+    double YOut(0.0), EOut(0.0);
+    kernel(YIn, EIn, YOut, EOut);
+    return WorkspaceExpression(YOut, EOut);
+  }
+  return WorkspaceExpression(
+      boost::make_shared<UnaryNode<Op>>(arg.node(), kernel));
+}
+
+/// @returns The ID of the X unit of a workspace, or an empty string
+std::string xUnitID(const MatrixWorkspace &workspace) {
+  if (workspace.axes() == 0)
+    return "";
+  Kernel::Unit_const_sptr unit = workspace.getAxis(0)->unit();
+  return unit ? unit->unitID() : "";
+}
+
+/// @returns True if any bin or detector of the workspace is masked
+bool hasMasking(const MatrixWorkspace &workspace) {
+  const size_t nhist = workspace.getNumberHistograms();
+  for (size_t i = 0; i < nhist; ++i) {
+    if (workspace.hasMaskedBins(i))
+      return true;
+  }
+  if (workspace.getInstrument()->getNumberDetectors() == 0)
+    return false;
+  for (size_t i = 0; i < nhist; ++i) {
+    try {
+      if (workspace.getDetector(i)->isMasked())
+        return true;
+    } catch (Kernel::Exception::NotFoundError &) {
+      // No detector, so nothing to mask
+    }
+  }
+  return false;
+}
+
+/**
+ * The single pass only reproduces the algorithms for histogram workspaces
+ * without masking whose units the algorithms accept.
+ * @param node :: The root of the expression
+ * @param inputs :: The workspaces in the expression
+ * @param units :: Set to the units of the result
+ * @returns True if the expression can be computed in a single pass
+ */
+bool canFuse(const WorkspaceExpression::Node &node,
+             const std::vector<MatrixWorkspace_const_sptr> &inputs,
+             YUnits &units) {
+  if (!node.outputUnits(units, inputs.front()->blocksize()))
+    return false;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const MatrixWorkspace_const_sptr &input = inputs[i];
+    // Event lists have no Y to write to and RebinnedOutput carries fractions
+    if (boost::dynamic_pointer_cast<const IEventWorkspace>(input) ||
+        input->id() == "RebinnedOutput")
+      return false;
+    if (std::find(inputs.begin(), inputs.begin() + i, input) ==
+            inputs.begin() + i &&
+        hasMasking(*input))
+      return false;
+  }
+  return true;
+}
+
+/**
+ * The single pass over the spectra. The loop is interrupted in the same way
+ * as those of the algorithms, so it stops at the first error or when the
+ * calling algorithm, if any, is cancelled.
+ */
+class FusedPass {
+public:
+  /**
+   * @param node :: The root of the expression
+   * @param caller :: The algorithm evaluating the expression, or NULL
+   */
+  FusedPass(const WorkspaceExpression::Node &node, const Algorithm *caller)
+      : m_node(node), m_caller(caller), m_cancel(false),
+        m_parallelException(false) {}
+
+  /**
+   * @param first :: The workspace that gives the X values
+   * @param output :: The workspace to fill
+   * @param threadSafe :: True if the spectra can be filled in parallel
+   */
+  void run(const MatrixWorkspace &first, MatrixWorkspace &output,
+           const bool threadSafe) {
+    const int64_t numberOfSpectra =
+        static_cast<int64_t>(first.getNumberHistograms());
+    // Scratch arrays for each thread
+    std::vector<ScratchSpace> scratch(
+        PARALLEL_GET_MAX_THREADS,
+        ScratchSpace(2 * m_node.depth(), MantidVec(first.blocksize())));
+
+    PARALLEL_FOR_IF(threadSafe)
+    for (int64_t i = 0; i < numberOfSpectra; ++i) {
+      PARALLEL_START_INTERUPT_REGION
+      const size_t index = static_cast<size_t>(i);
+      output.setX(index, first.refX(index));
+      m_node.evaluate(index, 0, scratch[PARALLEL_THREAD_NUMBER],
+                      output.dataY(index), output.dataE(index));
+      if (m_caller && m_caller->getCancel())
+        m_cancel = true;
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+  }
+
+private:
+  /// The name used in the messages of the interrupt macros
+  std::string name() const { return "WorkspaceExpression"; }
+  /// Throw if the calling algorithm has been cancelled
+  void interruption_point() const {
+    if (m_cancel)
+      throw Algorithm::CancelException();
+  }
+
+  const WorkspaceExpression::Node &m_node;
+  const Algorithm *m_caller;
+  /// Set once the calling algorithm has been cancelled
+  bool m_cancel;
+  /// Set if an exception is thrown within the loop
+  bool m_parallelException;
+};
+}
+
+/// @param workspace :: The workspace
+WorkspaceExpression::WorkspaceExpression(
+    const MatrixWorkspace_const_sptr &workspace)
+    : m_node(boost::make_shared<WorkspaceNode>(workspace)) {}
+
+/// @param workspace :: The workspace
+WorkspaceExpression::WorkspaceExpression(const MatrixWorkspace_sptr &workspace)
+    : m_node(boost::make_shared<WorkspaceNode>(workspace)) {}
+
+/**
+ * @param value :: The value
+ * @param error :: The error on the value
+ */
+WorkspaceExpression::WorkspaceExpression(const double value,
+                                         const double error)
+    : m_node(boost::make_shared<ValueNode>(value, error)) {}
+
+/// @param node :: The root of the expression tree
+WorkspaceExpression::WorkspaceExpression(
+    const boost::shared_ptr<const Node> &node)
+    : m_node(node) {}
+
+/**
+ * The output is created from the first workspace in the expression and each
+ * spectrum is computed in a single pass with no intermediate workspaces.
+ * Expressions that the single pass cannot compute in the same way as the
+ * algorithms are computed by running the algorithms in turn, see isFused().
+ * @returns A new workspace holding the result
+ * @throws std::invalid_argument if the expression contains no workspace or
+ * its workspaces are not compatible
+ */
+MatrixWorkspace_sptr WorkspaceExpression::evaluate() const {
+  return evaluate(NULL);
+}
+
+/**
+ * As evaluate(), stopping the single pass if the calling algorithm is
+ * cancelled.
+ * @param caller :: The algorithm evaluating the expression, or NULL
+ * @returns A new workspace holding the result
+ * @throws std::invalid_argument if the expression contains no workspace or
+ * its workspaces are not compatible
+ * @throws Algorithm::CancelException if the caller is cancelled
+ */
+MatrixWorkspace_sptr
+WorkspaceExpression::evaluate(const Algorithm *caller) const {
+  std::vector<MatrixWorkspace_const_sptr> inputs;
+  checkInputs(inputs);
+  YUnits units;
+  if (!canFuse(*m_node, inputs, units))
+    return m_node->runAlgorithms();
+
+  const MatrixWorkspace_const_sptr first = inputs.front();
+  bool threadSafe = first->threadSafe();
+  for (size_t i = 1; i < inputs.size(); ++i)
+    threadSafe = threadSafe && inputs[i]->threadSafe();
+
+  MatrixWorkspace_sptr output = WorkspaceFactory::Instance().create(first);
+  threadSafe = threadSafe && output->threadSafe();
+  output->setYUnit(units.unit);
+  output->isDistribution(units.distribution);
+  if (m_node->mergesRuns())
+    output->mutableRun() = m_node->run();
+
+  FusedPass(*m_node, caller).run(*first, *output, threadSafe);
+  return output;
+}
+
+/**
+ * The single pass is used when all the workspaces are histogram workspaces
+ * without masked bins or detectors and the algorithms would accept their Y
+ * units. Otherwise evaluate() runs the algorithms so that masking, units and
+ * event workspaces are handled as they would be by the operators.
+ * @returns True if evaluate() computes the expression in a single pass
+ * @throws std::invalid_argument if the expression contains no workspace or
+ * its workspaces are not compatible
+ */
+bool WorkspaceExpression::isFused() const {
+  std::vector<MatrixWorkspace_const_sptr> inputs;
+  checkInputs(inputs);
+  YUnits units;
+  return canFuse(*m_node, inputs, units);
+}
+
+/**
+ * @param inputs :: Set to the workspaces in the expression
+ * @throws std::invalid_argument if the expression contains no workspace or
+ * its workspaces are not compatible
+ */
+void WorkspaceExpression::checkInputs(
+    std::vector<MatrixWorkspace_const_sptr> &inputs) const {
+  m_node->workspaces(inputs);
+  if (inputs.empty()) {
+    throw std::invalid_argument("WorkspaceExpression: " + toString() +
+                                " does not contain a workspace");
+  }
+
+  const MatrixWorkspace_const_sptr first = inputs.front();
+  const size_t nhist = first->getNumberHistograms();
+  const size_t nbins = first->blocksize();
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    const MatrixWorkspace_const_sptr &other = inputs[i];
+    if (other == first)
+      continue;
+    if (other->getNumberHistograms() != nhist || other->blocksize() != nbins) {
+      throw std::invalid_argument("WorkspaceExpression: the workspaces in " +
+                                  toString() + " are not the same size");
+    }
+    if (xUnitID(*other) != xUnitID(*first) ||
+        !WorkspaceHelpers::matchingBins(first, other, true)) {
+      throw std::invalid_argument("WorkspaceExpression: the workspaces in " +
+                                  toString() +
+                                  " do not have matching X values");
+    }
+  }
+}
+
+/// @returns The number of operations fused into the single evaluation pass
+size_t WorkspaceExpression::numberOfOperations() const {
+  return m_node->operations();
+}
+
+/// @returns A readable form of the expression
+std::string WorkspaceExpression::toString() const {
+  return m_node->toString();
+}
+
+//----------------------------------------------------------------------
+// Operators
+//----------------------------------------------------------------------
+/**
+ * @param lhs :: The left-hand expression
+ * @param rhs :: The right-hand expression
+ * @returns The deferred sum
+ */
+WorkspaceExpression operator+(const WorkspaceExpression &lhs,
+                              const WorkspaceExpression &rhs) {
+  return combine<PlusKernel>(lhs, rhs);
+}
+
+/**
+ * @param lhs :: The left-hand expression
+ * @param rhs :: The right-hand expression
+ * @returns The deferred difference
+ */
+WorkspaceExpression operator-(const WorkspaceExpression &lhs,
+                              const WorkspaceExpression &rhs) {
+  return combine<MinusKernel>(lhs, rhs);
+}
+
+/**
+ * @param lhs :: The left-hand expression
+ * @param rhs :: The right-hand expression
+ * @returns The deferred product
+ */
+WorkspaceExpression operator*(const WorkspaceExpression &lhs,
+                              const WorkspaceExpression &rhs) {
+  return combine<MultiplyKernel>(lhs, rhs);
+}
+
+/**
+ * @param lhs :: The left-hand expression
+ * @param rhs :: The right-hand expression
+ * @returns The deferred quotient
+ */
+WorkspaceExpression operator/(const WorkspaceExpression &lhs,
+                              const WorkspaceExpression &rhs) {
+  return combine<DivideKernel>(lhs, rhs);
+}
+
+/**
+ * @param base :: The expression to raise to the power
+ * @param exponent :: The exponent
+ * @returns The deferred power
+ */
+WorkspaceExpression power(const WorkspaceExpression &base,
+                          const double exponent) {
+  return apply(base, PowerKernel(exponent));
+}
+
+/**
+ * @param arg :: The expression to take the exponential of
+ * @returns The deferred exponential
+ */
+WorkspaceExpression exponential(const WorkspaceExpression &arg) {
+  return apply(arg, ExponentialKernel());
+}
+
+} // namespace API
+} // namespace Mantid
@@ -7,6 +7,7 @@
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidKernel/EnvironmentHistory.h"
 #include <boost/algorithm/string/split.hpp>
+#include <boost/make_shared.hpp>
 #include "Poco/DateTime.h"
 #include <Poco/DateTimeParser.h>
 
@@ -20,36 +21,110 @@ namespace {
 Kernel::Logger g_log("WorkspaceHistory");
 }
 
+/** A node of the history graph: the history of one algorithm execution and the
+ * nodes of the histories that it was added to. A node is never changed after
+ * it has been created, so it can be shared by any number of workspaces.
+ */
+struct WorkspaceHistory::HistoryNode {
+  HistoryNode(const AlgorithmHistory_sptr &history,
+              const std::vector<HistoryNode_const_sptr> &previous)
+      : algorithm(history), parents(previous) {}
+  ~HistoryNode();
+  /// The history of the algorithm execution
+  AlgorithmHistory_sptr algorithm;
+  /// The nodes this one was added after. Only cleared by the destructor.
+  mutable std::vector<HistoryNode_const_sptr> parents;
+};
+
+/** A long history is a long chain of nodes. The nodes that are owned by this
+ * chain alone are unlinked one at a time so that destroying them does not
+ * recurse once per node.
+ */
+WorkspaceHistory::HistoryNode::~HistoryNode() {
+  std::vector<HistoryNode_const_sptr> pending;
+  pending.swap(parents);
+  while (!pending.empty()) {
+    HistoryNode_const_sptr node = pending.back();
+    pending.pop_back();
+    if (node.unique()) {
+      pending.insert(pending.end(), node->parents.begin(), node->parents.end());
+      node->parents.clear();
+    }
+  }
+}
+
 /// Default Constructor
 WorkspaceHistory::WorkspaceHistory()
-    : m_environment(),
-      m_algorithms(boost::bind(CompareHistory::compare, _1, _2)) {}
+    : m_environment(), m_heads(), m_algorithms(), m_mutex() {}
 
 /// Destructor
 WorkspaceHistory::~WorkspaceHistory() {}
 
 /**
-  Standard Copy Constructor
+  Standard Copy Constructor. The copy shares the history graph with the
+  original.
   @param A :: WorkspaceHistory Item to copy
  */
 WorkspaceHistory::WorkspaceHistory(const WorkspaceHistory &A)
-    : m_environment(A.m_environment),
-      m_algorithms(boost::bind(CompareHistory::compare, _1, _2)) {
+    : m_environment(A.m_environment), m_heads(A.m_heads), m_algorithms(),
+      m_mutex() {
+  Kernel::Mutex::ScopedLock lock(A.m_mutex);
   m_algorithms = A.m_algorithms;
 }
 
-/// Returns a const reference to the algorithmHistory
-const Mantid::API::AlgorithmHistories &
+/** Returns a copy of the algorithmHistory. A copy is returned as the list held
+ * by this object is replaced whenever the history changes.
+ */
+Mantid::API::AlgorithmHistories
 WorkspaceHistory::getAlgorithmHistories() const {
+  return *algorithmHistories();
+}
+
+/** Returns the algorithm history list. The list is built from the history
+ * graph on the first call after the history has changed. The list that is
+ * returned is never modified, so it stays valid if the history changes.
+ * @returns A shared pointer to the list of algorithm histories
+ */
+boost::shared_ptr<const AlgorithmHistories>
+WorkspaceHistory::algorithmHistories() const {
+  Kernel::Mutex::ScopedLock lock(m_mutex);
+  if (!m_algorithms) {
+    boost::shared_ptr<AlgorithmHistories> algorithms =
+        boost::make_shared<AlgorithmHistories>(
+            boost::bind(CompareHistory::compare, _1, _2));
+    // Walk the graph without recursion as it may be very deep. Nodes reached
+    // by more than one path are only visited once.
+    std::set<const HistoryNode *> visited;
+    std::vector<const HistoryNode *> pending;
+    for (size_t i = 0; i < m_heads.size(); ++i) {
+      pending.push_back(m_heads[i].get());
+    }
+    while (!pending.empty()) {
+      const HistoryNode *node = pending.back();
+      pending.pop_back();
+      if (!visited.insert(node).second)
+        continue;
+      algorithms->insert(node->algorithm);
+      for (size_t i = 0; i < node->parents.size(); ++i) {
+        pending.push_back(node->parents[i].get());
+      }
+    }
+    m_algorithms = algorithms;
+  }
   return m_algorithms;
 }
+
 /// Returns a const reference to the EnvironmentHistory
 const Kernel::EnvironmentHistory &
 WorkspaceHistory::getEnvironmentHistory() const {
   return m_environment;
 }
 
-/// Append the algorithm history from another WorkspaceHistory into this one
+/** Append the algorithm history from another WorkspaceHistory into this one.
+ * Only the latest nodes of the other history are copied, the rest of its graph
+ * is shared.
+ * @param otherHistory :: The history to add
+ */
 void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
   // Don't copy one's own history onto oneself
   if (this == &otherHistory) {
@@ -57,31 +132,50 @@ void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
   }
 
   // Merge the histories
-  const AlgorithmHistories &otherAlgorithms =
-      otherHistory.getAlgorithmHistories();
-  m_algorithms.insert(otherAlgorithms.begin(), otherAlgorithms.end());
+  const std::vector<HistoryNode_const_sptr> &otherHeads = otherHistory.m_heads;
+  if (m_heads.empty()) {
+    m_heads = otherHeads;
+    Kernel::Mutex::ScopedLock lock(otherHistory.m_mutex);
+    m_algorithms = otherHistory.m_algorithms;
+    return;
+  }
+  for (size_t i = 0; i < otherHeads.size(); ++i) {
+    if (std::find(m_heads.begin(), m_heads.end(), otherHeads[i]) ==
+        m_heads.end()) {
+      m_heads.push_back(otherHeads[i]);
+      m_algorithms.reset();
+    }
+  }
 }
 
-/// Append an AlgorithmHistory to this WorkspaceHistory
+/** Append an AlgorithmHistory to this WorkspaceHistory
+ * @param algHistory :: The history of the algorithm
+ */
 void WorkspaceHistory::addHistory(AlgorithmHistory_sptr algHistory) {
-  m_algorithms.insert(algHistory);
+  HistoryNode_const_sptr node =
+      boost::make_shared<HistoryNode>(algHistory, m_heads);
+  m_heads.assign(1, node);
+  m_algorithms.reset();
 }
 
 /*
  Return the history length
  */
-size_t WorkspaceHistory::size() const { return m_algorithms.size(); }
+size_t WorkspaceHistory::size() const { return algorithmHistories()->size(); }
 
 /**
  * Query if the history is empty or not
  * @returns True if the list is empty, false otherwise
  */
-bool WorkspaceHistory::empty() const { return m_algorithms.empty(); }
+bool WorkspaceHistory::empty() const { return m_heads.empty(); }
 
 /**
  * Empty the list of algorithm history objects.
  */
-void WorkspaceHistory::clearHistory() { m_algorithms.clear(); }
+void WorkspaceHistory::clearHistory() {
+  m_heads.clear();
+  m_algorithms.reset();
+}
 
 /**
  * Retrieve an algorithm history by index
@@ -91,11 +185,13 @@ void WorkspaceHistory::clearHistory() { m_algorithms.clear(); }
  */
 AlgorithmHistory_const_sptr
 WorkspaceHistory::getAlgorithmHistory(const size_t index) const {
-  if (index >= this->size()) {
+  boost::shared_ptr<const AlgorithmHistories> algorithms =
+      algorithmHistories();
+  if (index >= algorithms->size()) {
     throw std::out_of_range(
         "WorkspaceHistory::getAlgorithmHistory() - Index out of range");
   }
-  AlgorithmHistories::const_iterator start = m_algorithms.begin();
+  AlgorithmHistories::const_iterator start = algorithms->begin();
   std::advance(start, index);
   return *start;
 }
@@ -126,7 +222,7 @@ WorkspaceHistory::getAlgorithm(const size_t index) const {
  * @returns A shared pointer to the algorithm
  */
 boost::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
-  if (m_algorithms.empty()) {
+  if (empty()) {
     throw std::out_of_range(
         "WorkspaceHistory::lastAlgorithm() - History contains no algorithms.");
   }
@@ -142,10 +238,12 @@ void WorkspaceHistory::printSelf(std::ostream &os, const int indent) const {
 
   os << std::string(indent, ' ') << m_environment << std::endl;
 
+  boost::shared_ptr<const AlgorithmHistories> algorithms =
+      algorithmHistories();
   AlgorithmHistories::const_iterator it;
   os << std::string(indent, ' ') << "Histories:" << std::endl;
 
-  for (it = m_algorithms.begin(); it != m_algorithms.end(); ++it) {
+  for (it = algorithms->begin(); it != algorithms->end(); ++it) {
     os << std::endl;
     (*it)->printSelf(os, indent + 2);
   }
@@ -180,8 +278,10 @@ void WorkspaceHistory::saveNexus(::NeXus::File *file) const {
 
   // Algorithm History
   int algCount = 0;
-  AlgorithmHistories::const_iterator histIter = m_algorithms.begin();
-  for (; histIter != m_algorithms.end(); ++histIter) {
+  boost::shared_ptr<const AlgorithmHistories> algorithms =
+      algorithmHistories();
+  AlgorithmHistories::const_iterator histIter = algorithms->begin();
+  for (; histIter != algorithms->end(); ++histIter) {
     (*histIter)->saveNexus(file, algCount);
   }
 
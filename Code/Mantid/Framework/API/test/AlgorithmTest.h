@@ -6,6 +6,8 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidKernel/Property.h"
 #include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/AlgorithmObserver.h"
 #include "MantidTestHelpers/FakeObjects.h"
 #include "MantidKernel/ReadLock.h"
 #include "MantidKernel/WriteLock.h"
@@ -147,6 +149,19 @@ const std::string FailingAlgorithm::FAIL_MSG("Algorithm failed as requested");
 
 DECLARE_ALGORITHM(FailingAlgorithm)
 
+/// Counts the notifications sent by the algorithms it observes
+class CountingObserver : public AlgorithmObserver
+{
+public:
+  CountingObserver() : AlgorithmObserver(), nStarting(0), nStart(0), nFinish(0) {}
+  void startingHandle(IAlgorithm_sptr) { ++nStarting; }
+  void startHandle(const IAlgorithm *) { ++nStart; }
+  void finishHandle(const IAlgorithm *) { ++nFinish; }
+  int nStarting;
+  int nStart;
+  int nFinish;
+};
+
 class AlgorithmTest : public CxxTest::TestSuite
 {
 public:
@@ -249,6 +264,56 @@ public:
   }
 
 
+  void test_observers_receive_start_and_finish_notifications()
+  {
+    boost::shared_ptr<ToyAlgorithm> myAlg(new ToyAlgorithm);
+    myAlg->initialize();
+    CountingObserver observer;
+    observer.observeAll(myAlg);
+    TS_ASSERT_THROWS_NOTHING(myAlg->execute());
+    TS_ASSERT_EQUALS(observer.nStart, 1);
+    TS_ASSERT_EQUALS(observer.nFinish, 1);
+  }
+
+  void test_managed_algorithms_send_starting_notification_even_as_children()
+  {
+    CountingObserver observer;
+    observer.observeStarting();
+    // Both with and without a proxy
+    for (int makeProxy = 0; makeProxy < 2; ++makeProxy)
+    {
+      IAlgorithm_sptr alg = AlgorithmManager::Instance().create("ToyAlgorithm", 1, makeProxy == 1);
+      alg->setChild(true);
+      TS_ASSERT_THROWS_NOTHING(alg->execute());
+    }
+    TS_ASSERT_EQUALS(observer.nStarting, 2);
+
+    // Unmanaged children are not known to the manager
+    ToyAlgorithm parent;
+    Algorithm_sptr child = parent.createChildAlgorithm("ToyAlgorithm");
+    TS_ASSERT_THROWS_NOTHING(child->execute());
+    TS_ASSERT_EQUALS(observer.nStarting, 2);
+    observer.stopObservingManager();
+  }
+
+  void test_child_algorithm_can_be_executed_repeatedly()
+  {
+    ToyAlgorithm parent;
+    Algorithm_sptr child = parent.createChildAlgorithm("StubbedWorkspaceAlgorithm");
+    TS_ASSERT(child->isChild());
+    boost::shared_ptr<WorkspaceTester> input(new WorkspaceTester());
+    input->init(2, 2, 2);
+    child->setProperty("InputWorkspace1", boost::static_pointer_cast<MatrixWorkspace>(input));
+    for (int i = 0; i < 3; ++i)
+    {
+      child->setProperty("Number", static_cast<double>(i));
+      TS_ASSERT_THROWS_NOTHING(child->execute());
+      TS_ASSERT(child->isExecuted());
+      MatrixWorkspace_sptr output = child->getProperty("OutputWorkspace1");
+      TS_ASSERT_EQUALS(output->readY(0)[0], static_cast<double>(i));
+    }
+  }
+
   void testSetPropertyValue()
   {
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("prop1","val") )
@@ -789,6 +854,51 @@ private:
   MatrixWorkspace_sptr ws3;
 };
 
- 
+class AlgorithmTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmTestPerformance *createSuite() { return new AlgorithmTestPerformance(); }
+  static void destroySuite( AlgorithmTestPerformance *suite ) { delete suite; }
+
+  AlgorithmTestPerformance() : m_nCalls(100000)
+  {
+    Mantid::API::FrameworkManager::Instance();
+    Mantid::API::AlgorithmFactory::Instance().subscribe<ToyAlgorithm>();
+  }
+
+  ~AlgorithmTestPerformance()
+  {
+    Mantid::API::AlgorithmFactory::Instance().unsubscribe("ToyAlgorithm",1);
+  }
+
+  /// The overhead of creating, initializing and running a child algorithm
+  void test_create_and_execute_child_algorithm()
+  {
+    ToyAlgorithm parent;
+    for (int i = 0; i < m_nCalls; ++i)
+    {
+      Algorithm_sptr child = parent.createChildAlgorithm("ToyAlgorithm", -1, -1, true, 1);
+      child->setProperty("prop2", i);
+      child->execute();
+    }
+  }
+
+  /// The overhead of running a child algorithm that is created only once
+  void test_execute_child_algorithm()
+  {
+    ToyAlgorithm parent;
+    Algorithm_sptr child = parent.createChildAlgorithm("ToyAlgorithm", -1, -1, true, 1);
+    for (int i = 0; i < m_nCalls; ++i)
+    {
+      child->setProperty("prop2", i);
+      child->execute();
+    }
+  }
+
+private:
+  const int m_nCalls;
+};
 
 #endif /*ALGORITHMTEST_H_*/
@@ -0,0 +1,106 @@
+#ifndef MANTID_API_KEYEDLRUCACHETEST_H_
+#define MANTID_API_KEYEDLRUCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/KeyedLRUCache.h"
+#include <boost/make_shared.hpp>
+
+using Mantid::API::KeyedLRUCache;
+
+class KeyedLRUCacheTest : public CxxTest::TestSuite
+{
+private:
+  /// A value of the given size computed for an integer key
+  struct Value
+  {
+    Value(const int k, const size_t bytes) : key(k), bytes(bytes) {}
+    const int &cacheKey() const { return key; }
+    size_t memorySize() const { return bytes; }
+    int key;
+    size_t bytes;
+  };
+  typedef KeyedLRUCache<int, Value> TestCache;
+  typedef TestCache::Value_const_sptr Value_const_sptr;
+
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static KeyedLRUCacheTest *createSuite() { return new KeyedLRUCacheTest(); }
+  static void destroySuite( KeyedLRUCacheTest *suite ) { delete suite; }
+
+  void test_Find_Returns_Stored_Value_And_Counts_Hits()
+  {
+    TestCache cache;
+    TS_ASSERT(!cache.find(1));
+    Value_const_sptr value = createValue(1, 8);
+    cache.store(value);
+    TS_ASSERT_EQUALS(cache.find(1), value);
+    TS_ASSERT(!cache.find(2));
+    TS_ASSERT_EQUALS(cache.hits(), 1);
+    TS_ASSERT_EQUALS(cache.memorySize(), 8);
+  }
+
+  void test_Least_Recently_Used_Value_Is_Discarded()
+  {
+    TestCache cache(2);
+    cache.store(createValue(1, 8));
+    cache.store(createValue(2, 8));
+    TS_ASSERT(cache.find(1));
+    cache.store(createValue(3, 8));
+
+    TS_ASSERT_EQUALS(cache.size(), 2);
+    TS_ASSERT(cache.find(1));
+    TS_ASSERT(!cache.find(2));
+    TS_ASSERT(cache.find(3));
+    TS_ASSERT_EQUALS(cache.memorySize(), 16);
+  }
+
+  void test_Storing_The_Same_Key_Replaces_The_Value()
+  {
+    TestCache cache(2);
+    cache.store(createValue(1, 8));
+    Value_const_sptr replacement = createValue(1, 4);
+    cache.store(replacement);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT_EQUALS(cache.memorySize(), 4);
+    TS_ASSERT_EQUALS(cache.find(1), replacement);
+  }
+
+  void test_Memory_Limit_Discards_Old_Values_And_Rejects_Large_Ones()
+  {
+    TestCache cache(2);
+    cache.store(createValue(1, 8), 8);
+    cache.store(createValue(2, 8), 8);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT(!cache.find(1));
+    cache.store(createValue(3, 9), 8);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT(!cache.find(3));
+  }
+
+  void test_Zero_Capacity_Stores_Nothing()
+  {
+    TestCache cache(0);
+    cache.store(createValue(1, 8));
+    TS_ASSERT_EQUALS(cache.size(), 0);
+  }
+
+  void test_Clearing_The_AnalysisDataService_Releases_The_Values()
+  {
+    TestCache cache;
+    cache.store(createValue(1, 8));
+    Mantid::API::AnalysisDataService::Instance().clear();
+    TS_ASSERT_EQUALS(cache.size(), 0);
+    TS_ASSERT_EQUALS(cache.memorySize(), 0);
+  }
+
+private:
+  Value_const_sptr createValue(const int key, const size_t bytes)
+  {
+    return boost::make_shared<Value>(key, bytes);
+  }
+};
+
+#endif /* MANTID_API_KEYEDLRUCACHETEST_H_ */
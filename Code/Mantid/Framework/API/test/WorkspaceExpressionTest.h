@@ -0,0 +1,240 @@
+#ifndef MANTID_API_WORKSPACEEXPRESSIONTEST_H_
+#define MANTID_API_WORKSPACEEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/WorkspaceExpression.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <cmath>
+
+using namespace Mantid::API;
+
+class WorkspaceExpressionTest : public CxxTest::TestSuite
+{
+private:
+  /// An algorithm that only serves to be cancelled
+  class CancelledAlgorithm : public Algorithm
+  {
+  public:
+    const std::string name() const { return "CancelledAlgorithm"; }
+    int version() const { return 1; }
+    const std::string category() const { return "Cat"; }
+    const std::string summary() const { return "Test summary"; }
+    void init() {}
+    void exec() {}
+  };
+
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static WorkspaceExpressionTest *createSuite() { return new WorkspaceExpressionTest(); }
+  static void destroySuite( WorkspaceExpressionTest *suite ) { delete suite; }
+
+  WorkspaceExpressionTest()
+  {
+    // The output is created by the factory with the type of the first input
+    if (!WorkspaceFactory::Instance().exists("WorkspaceTester"))
+      WorkspaceFactory::Instance().subscribe<WorkspaceTester>("WorkspaceTester");
+  }
+
+  void test_single_operation()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(2.0, 1.0);
+    MatrixWorkspace_sptr b = createWorkspace(4.0, 1.0);
+    MatrixWorkspace_sptr result = (WorkspaceExpression(a) + b).evaluate();
+    checkAllBins(result, 6.0, std::sqrt(2.0));
+    // The inputs are untouched
+    checkAllBins(a, 2.0, 1.0);
+  }
+
+  void test_chained_operations_propagate_errors_like_the_algorithms()
+  {
+    MatrixWorkspace_sptr s = createWorkspace(10.0, 3.0);
+    MatrixWorkspace_sptr c = createWorkspace(5.0, 2.0);
+    MatrixWorkspace_sptr v = createWorkspace(2.0, 0.5);
+    WorkspaceExpression expr =
+        (WorkspaceExpression(s) - WorkspaceExpression(c) * 0.9) / v;
+    TS_ASSERT_EQUALS(expr.numberOfOperations(), 3);
+
+    // c * 0.9 = 4.5 +- 1.8
+    // s - c*0.9 = 5.5 +- sqrt(9 + 3.24)
+    // / v = 2.75 +- sqrt(12.24 + (5.5 * 0.5 / 2)^2) / 2
+    const double numeratorE = std::sqrt(9.0 + 1.8 * 1.8);
+    const double b = 5.5 * 0.5 / 2.0;
+    const double expectedE = std::sqrt(numeratorE * numeratorE + b * b) / 2.0;
+    checkAllBins(expr.evaluate(), 2.75, expectedE);
+  }
+
+  void test_values_on_the_left()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(4.0, 0.0);
+    checkAllBins((1.0 - WorkspaceExpression(a)).evaluate(), -3.0, 0.0);
+    checkAllBins((WorkspaceExpression(8.0) / a).evaluate(), 2.0, 0.0);
+  }
+
+  void test_constants_are_folded()
+  {
+    WorkspaceExpression folded = WorkspaceExpression(2.0, 1.0) * 3.0;
+    TS_ASSERT_EQUALS(folded.numberOfOperations(), 0);
+    TS_ASSERT_EQUALS(folded.toString(), "6(+-3)");
+  }
+
+  void test_power_and_exponential()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(2.0, 0.1);
+    checkAllBins(power(WorkspaceExpression(a), 2.0).evaluate(), 4.0, 0.4);
+    MatrixWorkspace_sptr zero = createWorkspace(0.0, 0.1);
+    checkAllBins(exponential(WorkspaceExpression(zero)).evaluate(), 1.0, 0.1);
+  }
+
+  void test_the_same_workspace_can_appear_more_than_once()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(3.0, 0.0);
+    WorkspaceExpression expr(a);
+    checkAllBins((expr * expr + expr).evaluate(), 12.0, 0.0);
+  }
+
+  void test_expression_without_a_workspace_throws()
+  {
+    WorkspaceExpression expr(1.0);
+    TS_ASSERT_THROWS(expr.evaluate(), std::invalid_argument);
+  }
+
+  void test_mismatched_sizes_throw()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    boost::shared_ptr<WorkspaceTester> tester = boost::make_shared<WorkspaceTester>();
+    tester->init(3, 6, 5);
+    MatrixWorkspace_sptr b = tester;
+    TS_ASSERT_THROWS((WorkspaceExpression(a) + b).evaluate(),
+                     std::invalid_argument);
+  }
+
+  void test_mismatched_x_values_throw()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    MatrixWorkspace_sptr b = createWorkspace(1.0, 0.0);
+    b->dataX(0)[1] = 100.0;
+    TS_ASSERT_THROWS((WorkspaceExpression(a) + b).evaluate(),
+                     std::invalid_argument);
+  }
+
+  void test_plain_histograms_are_fused()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    MatrixWorkspace_sptr b = createWorkspace(2.0, 0.0);
+    TS_ASSERT((WorkspaceExpression(a) * b + 1.0).isFused());
+  }
+
+  void test_masked_bins_are_left_to_the_algorithms()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    MatrixWorkspace_sptr b = createWorkspace(2.0, 0.0);
+    b->flagMasked(1, 2);
+    TS_ASSERT(!(WorkspaceExpression(a) + b).isFused());
+    TS_ASSERT(!power(WorkspaceExpression(b), 2.0).isFused());
+  }
+
+  void test_mismatched_y_units_are_left_to_the_algorithms()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    MatrixWorkspace_sptr b = createWorkspace(2.0, 0.0);
+    a->setYUnit("Counts");
+    TS_ASSERT(!(WorkspaceExpression(a) + b).isFused());
+    TS_ASSERT(!(WorkspaceExpression(a) - b).isFused());
+    b->setYUnit("Counts");
+    b->isDistribution(true);
+    TS_ASSERT(!(WorkspaceExpression(a) + b).isFused());
+    // Constants have no units
+    TS_ASSERT((WorkspaceExpression(a) + 1.0).isFused());
+  }
+
+  void test_y_units_follow_the_algorithms()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    MatrixWorkspace_sptr b = createWorkspace(2.0, 0.0);
+    a->setYUnit("Counts");
+    b->setYUnit("Counts");
+
+    // As Divide, the same units give a dimensionless distribution
+    MatrixWorkspace_sptr result = (WorkspaceExpression(a) / b).evaluate();
+    TS_ASSERT_EQUALS(result->YUnit(), "");
+    TS_ASSERT(result->isDistribution());
+
+    b->setYUnit("Monitor");
+    result = (WorkspaceExpression(a) / b).evaluate();
+    TS_ASSERT_EQUALS(result->YUnit(), "Counts/Monitor");
+    TS_ASSERT(!result->isDistribution());
+
+    // As Multiply, a constant is not a distribution
+    a->isDistribution(true);
+    result = (WorkspaceExpression(a) * 2.0).evaluate();
+    TS_ASSERT_EQUALS(result->YUnit(), "Counts");
+    TS_ASSERT(!result->isDistribution());
+
+    // Power and Exponential leave the units alone
+    result = exponential(WorkspaceExpression(a) + 1.0).evaluate();
+    TS_ASSERT_EQUALS(result->YUnit(), "Counts");
+    TS_ASSERT(result->isDistribution());
+  }
+
+  void test_runs_are_added_as_plus_does()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    MatrixWorkspace_sptr b = createWorkspace(2.0, 0.0);
+    a->mutableRun().setProtonCharge(1.5);
+    b->mutableRun().setProtonCharge(2.0);
+    MatrixWorkspace_sptr sum = (WorkspaceExpression(a) * 2.0 + b).evaluate();
+    TS_ASSERT_DELTA(sum->run().getProtonCharge(), 3.5, 1e-12);
+    MatrixWorkspace_sptr product = (WorkspaceExpression(a) * b).evaluate();
+    TS_ASSERT_DELTA(product->run().getProtonCharge(), 1.5, 1e-12);
+    // The inputs are untouched
+    TS_ASSERT_DELTA(a->run().getProtonCharge(), 1.5, 1e-12);
+  }
+
+  void test_cancelling_the_caller_stops_the_single_pass()
+  {
+    MatrixWorkspace_sptr a = createWorkspace(1.0, 0.0);
+    WorkspaceExpression expr = WorkspaceExpression(a) * 2.0;
+    TS_ASSERT(expr.isFused());
+    CancelledAlgorithm caller;
+    checkAllBins(expr.evaluate(&caller), 2.0, 0.0);
+    caller.cancel();
+    TS_ASSERT_THROWS(expr.evaluate(&caller), Algorithm::CancelException);
+  }
+
+private:
+  MatrixWorkspace_sptr createWorkspace(const double y, const double e)
+  {
+    boost::shared_ptr<WorkspaceTester> ws = boost::make_shared<WorkspaceTester>();
+    ws->init(3, 5, 4);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+    {
+      for (size_t j = 0; j < ws->readX(i).size(); ++j)
+        ws->dataX(i)[j] = static_cast<double>(j);
+      ws->dataY(i).assign(4, y);
+      ws->dataE(i).assign(4, e);
+    }
+    return ws;
+  }
+
+  void checkAllBins(MatrixWorkspace_const_sptr ws, const double y, const double e)
+  {
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 3);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+    {
+      TS_ASSERT_EQUALS(ws->readX(i).size(), 5);
+      TS_ASSERT_EQUALS(ws->readX(i)[4], 4.0);
+      for (size_t j = 0; j < ws->blocksize(); ++j)
+      {
+        TS_ASSERT_DELTA(ws->readY(i)[j], y, 1e-12);
+        TS_ASSERT_DELTA(ws->readE(i)[j], e, 1e-12);
+      }
+    }
+  }
+};
+
+#endif /* MANTID_API_WORKSPACEEXPRESSIONTEST_H_ */
@@ -140,6 +140,59 @@ public:
     TS_ASSERT_THROWS(emptyHistory.lastAlgorithm(), std::out_of_range);
     TS_ASSERT_THROWS(emptyHistory.getAlgorithm(1), std::out_of_range);
   }
+
+  void test_Copy_Shares_Entries_But_Not_Later_Additions()
+  {
+    WorkspaceHistory original;
+    AlgorithmHistory_sptr first = boost::make_shared<AlgorithmHistory>("First", 1, DateAndTime::defaultTime(), -1.0, 0);
+    original.addHistory(first);
+
+    WorkspaceHistory copy(original);
+    copy.addHistory(boost::make_shared<AlgorithmHistory>("Second", 1, DateAndTime::defaultTime(), -1.0, 1));
+
+    TS_ASSERT_EQUALS(original.size(), 1);
+    TS_ASSERT_EQUALS(copy.size(), 2);
+    // The common entry is the same object in both
+    TS_ASSERT_EQUALS(copy.getAlgorithmHistory(0), original.getAlgorithmHistory(0));
+    TS_ASSERT_EQUALS(copy.getAlgorithmHistory(1)->name(), "Second");
+  }
+
+  void test_Histories_List_Is_Unaffected_By_Later_Additions()
+  {
+    WorkspaceHistory history;
+    history.addHistory(boost::make_shared<AlgorithmHistory>("First", 1, DateAndTime::defaultTime(), -1.0, 0));
+    const AlgorithmHistories before = history.getAlgorithmHistories();
+    history.addHistory(boost::make_shared<AlgorithmHistory>("Second", 1, DateAndTime::defaultTime(), -1.0, 1));
+
+    TS_ASSERT_EQUALS(before.size(), 1);
+    TS_ASSERT_EQUALS((*before.begin())->name(), "First");
+    TS_ASSERT_EQUALS(history.getAlgorithmHistories().size(), 2);
+  }
+
+  void test_Adding_Histories_With_Common_Entries_Does_Not_Duplicate_Them()
+  {
+    WorkspaceHistory common;
+    common.addHistory(boost::make_shared<AlgorithmHistory>("Load", 1, DateAndTime::defaultTime(), -1.0, 0));
+    WorkspaceHistory left(common), right(common);
+    left.addHistory(boost::make_shared<AlgorithmHistory>("Left", 1, DateAndTime::defaultTime(), -1.0, 1));
+    right.addHistory(boost::make_shared<AlgorithmHistory>("Right", 1, DateAndTime::defaultTime(), -1.0, 2));
+
+    WorkspaceHistory merged;
+    merged.addHistory(left);
+    merged.addHistory(right);
+    merged.addHistory(left);
+    merged.addHistory(boost::make_shared<AlgorithmHistory>("Plus", 1, DateAndTime::defaultTime(), -1.0, 3));
+
+    TS_ASSERT_EQUALS(merged.size(), 4);
+    TS_ASSERT_EQUALS(merged.getAlgorithmHistory(0)->name(), "Load");
+    TS_ASSERT_EQUALS(merged.getAlgorithmHistory(1)->name(), "Left");
+    TS_ASSERT_EQUALS(merged.getAlgorithmHistory(2)->name(), "Right");
+    TS_ASSERT_EQUALS(merged.getAlgorithmHistory(3)->name(), "Plus");
+
+    merged.clearHistory();
+    TS_ASSERT(merged.empty());
+    TS_ASSERT_EQUALS(left.size(), 2);
+  }
 };
 
 class WorkspaceHistoryTestPerformance : public CxxTest::TestSuite
@@ -166,6 +219,23 @@ public:
     m_wsHist.addHistory(boost::make_shared<AlgorithmHistory>(algHist));
   }
 
+  void test_Long_History_Chain()
+  {
+    // Each workspace of a long pipeline is made from the previous one
+    WorkspaceHistory *previous = new WorkspaceHistory;
+    const size_t length = 100000;
+    for (size_t i = 0; i < length; ++i)
+    {
+      WorkspaceHistory *next = new WorkspaceHistory;
+      next->addHistory(*previous);
+      next->addHistory(boost::make_shared<AlgorithmHistory>("AnAlgorithm", 1, DateAndTime::defaultTime(), -1.0, i));
+      delete previous;
+      previous = next;
+    }
+    TS_ASSERT_EQUALS(previous->size(), length);
+    delete previous;
+  }
+
   void build_Algorithm_History(AlgorithmHistory& parent, int width, int depth=0)
   {
     if(depth > 0)
@@ -5,6 +5,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/Algorithm.h"
+#include "MantidAlgorithms/AbsorptionPathLengthCache.h"
 
 namespace Mantid {
 namespace Algorithms {
@@ -123,12 +124,15 @@ private:
 
   void retrieveBaseProperties();
   void constructSample(API::Sample &sample);
-  void calculateDistances(const Geometry::IDetector_const_sptr &detector,
-                          std::vector<double> &L2s) const;
+  Kernel::V3D
+  detectorPosition(const Geometry::IDetector_const_sptr &detector) const;
+  void calculateDistances(const Kernel::V3D &detectorPos, double *L2s) const;
   inline double doIntegration(const double &lambda,
-                              const std::vector<double> &L2s) const;
+                              const std::vector<double> &totalPaths,
+                              std::vector<double> &scratch) const;
   inline double doIntegration(const double &lambda_i, const double &lambda_f,
-                              const std::vector<double> &L2s) const;
+                              const double *L2s,
+                              std::vector<double> &scratch) const;
 
   double m_refAtten;   ///< The attenuation cross-section in 1/m at 1.8A
   double m_scattering; ///< The scattering cross-section in 1/m
@@ -0,0 +1,84 @@
+#ifndef MANTID_ALGORITHMS_ABSORPTIONPATHLENGTHCACHE_H_
+#define MANTID_ALGORITHMS_ABSORPTIONPATHLENGTHCACHE_H_
+
+#include "MantidAPI/KeyedLRUCache.h"
+#include "MantidKernel/SingletonHolder.h"
+#include "MantidKernel/System.h"
+#include "MantidKernel/V3D.h"
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Algorithms {
+
+/**
+  Describes everything that the sample-to-detector path lengths computed by
+  AbsorptionCorrection depend upon: the sample shape, the integration volume
+  elements and the position of the detector of each spectrum. Two
+  calculations with equal geometries produce identical path lengths.
+ */
+struct DLLExport PathLengthGeometry {
+  /// Equality operator
+  bool operator==(const PathLengthGeometry &other) const;
+
+  /// The XML definition of the sample shape
+  std::string shapeXML;
+  /// The position of each volume element
+  std::vector<Kernel::V3D> elementPositions;
+  /// The detector position used for each spectrum
+  std::vector<Kernel::V3D> detectorPositions;
+  /// Whether each spectrum has a detector
+  std::vector<bool> hasDetector;
+};
+
+/**
+  The sample-to-detector path lengths (L2) of every volume element for every
+  spectrum, stored row-major with one row per spectrum.
+ */
+struct DLLExport PathLengthTable {
+  /// Construct a table of zeroes sized for the given geometry
+  explicit PathLengthTable(const PathLengthGeometry &geom);
+  /// Return the start of the row of path lengths for a spectrum
+  double *row(const size_t spectrum) {
+    return &L2s[spectrum * geometry.elementPositions.size()];
+  }
+  /// Return the start of the row of path lengths for a spectrum
+  const double *row(const size_t spectrum) const {
+    return &L2s[spectrum * geometry.elementPositions.size()];
+  }
+  /// The memory needed for a table of the given geometry, in bytes
+  static size_t memorySize(const PathLengthGeometry &geom);
+  /// The memory taken by the path lengths, in bytes
+  size_t memorySize() const { return L2s.size() * sizeof(double); }
+  /// The key of the table in AbsorptionPathLengthCache
+  const PathLengthGeometry &cacheKey() const { return geometry; }
+
+  /// The geometry that the table was computed for
+  const PathLengthGeometry geometry;
+  /// The path lengths
+  std::vector<double> L2s;
+};
+
+/// Typedef for a shared pointer to a path-length table
+typedef boost::shared_ptr<PathLengthTable> PathLengthTable_sptr;
+/// Typedef for a shared pointer to a const path-length table
+typedef boost::shared_ptr<const PathLengthTable> PathLengthTable_const_sptr;
+
+/// The cache of path-length tables shared by the algorithms derived from
+/// AbsorptionCorrection, so that repeated corrections of runs with an
+/// unchanged sample and instrument do not trace every track again
+typedef API::KeyedLRUCache<PathLengthGeometry, PathLengthTable>
+    AbsorptionPathLengthCacheImpl;
+
+#ifdef _WIN32
+template class DLLExport
+    Kernel::SingletonHolder<AbsorptionPathLengthCacheImpl>;
+#endif
+typedef Kernel::SingletonHolder<AbsorptionPathLengthCacheImpl>
+    AbsorptionPathLengthCache;
+
+} // namespace Algorithms
+} // namespace Mantid
+
+#endif /* MANTID_ALGORITHMS_ABSORPTIONPATHLENGTHCACHE_H_ */
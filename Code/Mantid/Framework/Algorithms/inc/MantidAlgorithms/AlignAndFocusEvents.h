@@ -0,0 +1,77 @@
+#ifndef MANTID_ALGORITHMS_ALIGNANDFOCUSEVENTS_H_
+#define MANTID_ALGORITHMS_ALIGNANDFOCUSEVENTS_H_
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/OffsetsWorkspace.h"
+#include "MantidKernel/System.h"
+
+namespace Mantid {
+namespace Algorithms {
+
+/** Converts the events of a TOF EventWorkspace to d-spacing with the
+    calibration of each pixel and histograms them straight into the spectra
+    of their groups. This gives the same result as running AlignDetectors,
+    DiffractionFocussing (keeping the events) and Rebin in turn, but in a
+    single pass over the events and without copying them.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport AlignAndFocusEvents : public API::Algorithm {
+public:
+  AlignAndFocusEvents();
+  virtual ~AlignAndFocusEvents();
+
+  /// Algorithm's name for identification overriding a virtual method
+  virtual const std::string name() const { return "AlignAndFocusEvents"; }
+  /// Summary of algorithms purpose
+  virtual const std::string summary() const {
+    return "Converts events from TOF to dSpacing and histograms them into "
+           "the focussed spectra of their groups in a single pass.";
+  }
+
+  /// Algorithm's version for identification overriding a virtual method
+  virtual int version() const { return 1; }
+  /// Algorithm's category for identification overriding a virtual method
+  virtual const std::string category() const { return "Diffraction"; }
+
+private:
+  // Implement abstract Algorithm methods
+  void init();
+  void exec();
+
+  void loadCalibration(API::MatrixWorkspace_const_sptr inputWS);
+  int groupOfSpectrum(const std::set<detid_t> &detectors) const;
+
+  /// The calibration offsets
+  DataObjects::OffsetsWorkspace_sptr m_offsetsWS;
+  /// The grouping of the detectors
+  DataObjects::GroupingWorkspace_sptr m_groupWS;
+  /// The group of each detector ID
+  std::vector<int> m_detIDToGroup;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
+
+#endif /* MANTID_ALGORITHMS_ALIGNANDFOCUSEVENTS_H_ */
@@ -69,6 +69,8 @@ public:
   static std::map<detid_t, double> *calcTofToD_ConversionMap(
       Mantid::API::MatrixWorkspace_const_sptr inputWS,
       Mantid::DataObjects::OffsetsWorkspace_sptr offsetsWS);
+  static double calcConversionFromMap(std::map<detid_t, double> *tofToDmap,
+                                      const std::set<detid_t> &detectors);
 
 private:
   // Implement abstract Algorithm methods
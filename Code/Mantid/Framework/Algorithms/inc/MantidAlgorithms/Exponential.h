@@ -65,6 +65,10 @@ private:
   // Overridden UnaryOperation methods
   void performUnaryOperation(const double XIn, const double YIn,
                              const double EIn, double &YOut, double &EOut);
+  void performUnaryOperationOnSpectrum(const MantidVec &X,
+                                       const MantidVec &YIn,
+                                       const MantidVec &EIn, MantidVec &YOut,
+                                       MantidVec &EOut);
 
   /*
   void performBinaryOperation(const MantidVec& lhsX, const MantidVec& lhsY,
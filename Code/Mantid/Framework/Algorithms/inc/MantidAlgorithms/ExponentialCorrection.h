@@ -78,6 +78,10 @@ private:
   void retrieveProperties();
   void performUnaryOperation(const double XIn, const double YIn,
                              const double EIn, double &YOut, double &EOut);
+  void performUnaryOperationOnSpectrum(const MantidVec &X,
+                                       const MantidVec &YIn,
+                                       const MantidVec &EIn, MantidVec &YOut,
+                                       MantidVec &EOut);
 
   double m_c0,   ///< The constant by which to multiply the exponential
       m_c1;      ///< The constant term in the exponent
@@ -13,9 +13,17 @@
 
 namespace Mantid {
 namespace Algorithms {
+class FitOneSinglePeak;
+
 /** This algorithm searches for peaks in a dataset.
     The method used is detailed in: M.A.Mariscotti, NIM 50 (1967) 309.
 
+    The spectra are searched in parallel.  Each thread fits peaks with its own
+    copies of the peak and background functions and its own fitting objects,
+    which are created once and reused for every peak.  The rows of the output
+    table are ordered by spectrum whatever the order in which the spectra were
+    processed.
+
     Required Properties:
     <UL>
     <LI> InputWorkspace - The name of the Workspace to search for peaks. </LI>
@@ -85,9 +93,31 @@ public:
   int getVectorIndex(const MantidVec &vecX, double x);
 
 private:
+  /// The objects used by one thread to fit peaks.  They are created the first
+  /// time the thread needs them and are reused for all its peaks.
+  struct PeakFitContext {
+    /// Peak function to fit
+    API::IPeakFunction_sptr peakFunction;
+    /// Background function to fit
+    API::IBackgroundFunction_sptr backgroundFunction;
+    /// Fits the peak and background functions
+    boost::shared_ptr<FitOneSinglePeak> fitPeak;
+    /// Estimates the background and the range of a peak
+    API::IAlgorithm_sptr findPeakBackground;
+  };
+
   void init();
   void exec();
 
+  /// Get the peak fitting objects of the calling thread
+  PeakFitContext &getFitContext();
+
+  /// Reset the functions of a context to the starting values
+  void resetFitContext(PeakFitContext &context);
+
+  /// Copy the fitted peaks of all spectra to the output table
+  void writeOutputPeakTable();
+
   /// Process algorithm's properties
   void processAlgorithmProperties();
 
@@ -108,12 +138,14 @@ private:
   long long computePhi(const int &w) const;
 
   /// Fit peak confined in a given window (x-min, x-max)
-  void fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
+  void fitPeakInWindow(PeakFitContext &context,
+                       const API::MatrixWorkspace_sptr &input,
                        const int spectrum, const double centre,
                        const double xmin, const double xmax);
 
   /// Fit peak by given/guessed FWHM
-  void fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
+  void fitPeakGivenFWHM(PeakFitContext &context,
+                        const API::MatrixWorkspace_sptr &input,
                         const int spectrum, const double center_guess,
                         const int fitWidth, const bool hasleftpeak,
                         const double leftpeakcentre, const bool hasrightpeak,
@@ -121,7 +153,8 @@ private:
 
   /// Fit peak: this is a basic peak fit function as a root function for all
   /// different type of user input
-  void fitSinglePeak(const API::MatrixWorkspace_sptr &input, const int spectrum,
+  void fitSinglePeak(PeakFitContext &context,
+                     const API::MatrixWorkspace_sptr &input, const int spectrum,
                      const int i_min, const int i_max, const int i_centre);
 
   void fitPeakHighBackground(const API::MatrixWorkspace_sptr &input,
@@ -148,7 +181,8 @@ private:
   void createFunctions();
 
   /// Find peak background
-  bool findPeakBackground(const API::MatrixWorkspace_sptr &input, int spectrum,
+  bool findPeakBackground(PeakFitContext &context,
+                          const API::MatrixWorkspace_sptr &input, int spectrum,
                           size_t i_min, size_t i_max,
                           std::vector<double> &vecBkgdParamValues,
                           std::vector<double> &vecpeakrange);
@@ -177,7 +211,8 @@ private:
   std::vector<double> getStartingBkgdValues();
 
   /// Fit peak by calling 'FitPeak'
-  double callFitPeak(const API::MatrixWorkspace_sptr &dataws, int wsindex,
+  double callFitPeak(PeakFitContext &context,
+                     const API::MatrixWorkspace_sptr &dataws, int wsindex,
                      const API::IPeakFunction_sptr peakfunction,
                      const API::IBackgroundFunction_sptr backgroundfunction,
                      const std::vector<double> &vec_fitwindow,
@@ -194,6 +229,15 @@ private:
 
   /// Storage of the peak data
   API::ITableWorkspace_sptr m_outPeakTableWS;
+  /// Index of the first spectrum searched
+  int m_firstSpectrum;
+  /// Parameters and chi^2 of the peaks found in each spectrum searched, in the
+  /// order of the columns of the output table after the spectrum
+  std::vector<std::vector<double>> m_spectrumPeaks;
+  /// Peak fitting objects of each thread
+  std::vector<boost::shared_ptr<PeakFitContext>> m_fitContexts;
+  /// Peak and background types the fitting objects were created for
+  std::string m_fitContextTypes;
   /// Progress reporting
   API::Progress *m_progress;
 
@@ -15,6 +15,9 @@ namespace Algorithms {
 size_t getVectorIndex(const MantidVec &vecx, double x);
 
 /** FitOneSinglePeak: a class to perform peak fitting on a single peak
+  *
+  * One object can fit any number of peaks in turn.  The Fit child algorithms
+  * that it runs are created once and executed again for every fit.
   */
 class DLLExport FitOneSinglePeak : public API::Algorithm {
 public:
@@ -53,6 +56,9 @@ public:
 
   std::string getDebugMessage();
 
+  /// Discard the result and the debug messages of the previous peak
+  void resetFitResult();
+
   /// Fit peak and background together
   bool simpleFit();
 
@@ -143,6 +149,9 @@ private:
   API::IBackgroundFunction_sptr
   fitBackground(API::IBackgroundFunction_sptr bkgdfunc);
 
+  /// Get the Fit algorithm for single or multiple domain fitting
+  API::IAlgorithm_sptr getFitAlgorithm(bool multidomain);
+
   /// Flag to show whether fitting parameters are set
   bool m_fitMethodSet;
   /// Flag whether the peak range is set
@@ -221,6 +230,11 @@ private:
 
   /// String stream
   std::stringstream m_sstream;
+
+  /// Fit algorithm reused for all single domain fits
+  API::IAlgorithm_sptr m_fitSD;
+  /// Fit algorithm reused for all multiple domain fits
+  API::IAlgorithm_sptr m_fitMD;
 };
 
 /** FitPeak : Fit a single peak
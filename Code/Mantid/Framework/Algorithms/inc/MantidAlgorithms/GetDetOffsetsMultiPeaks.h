@@ -187,6 +187,9 @@ private:
   bool m_useFitWindowTable;
   /// Vector of fit windows (also in vector)
   std::vector<std::vector<double>> m_vecFitWindow;
+
+  /// FindPeaks algorithm of each thread, reused for all its spectra
+  std::vector<API::IAlgorithm_sptr> m_peakFinders;
 };
 
 } // namespace Algorithm
@@ -6,14 +6,16 @@
 //------------------------------------------------------------------------------
 #include "MantidAPI/Algorithm.h"
 #include "MantidGeometry/IComponent.h"
-
-#include <boost/random/mersenne_twister.hpp>
+#include "MantidGeometry/Objects/Track.h"
 
 namespace Mantid {
 namespace Geometry {
 class IDetector;
 class Object;
 }
+namespace Kernel {
+class Philox;
+}
 
 namespace Algorithms {
 /**
@@ -72,19 +74,30 @@ private:
   /// Execution code
   void exec();
 
-  /// Do the simulation for the given detector and wavelength
-  void doSimulation(const Geometry::IDetector *const detector,
-                    const double lambda, double &attenFactor, double &error);
+  /// Storage reused by every simulation carried out on a thread
+  struct SimulationScratch {
+    /// The scatter points of the current batch of events
+    std::vector<Kernel::V3D> scatterPoints;
+    /// Track from the scatter point towards the source
+    Geometry::Track beforeScatter;
+    /// Track from the scatter point towards the detector
+    Geometry::Track afterScatter;
+  };
+
+  /// Do the simulation for the given detector position and wavelength
+  void doSimulation(const Kernel::V3D &detectorPos, const double lambda,
+                    Kernel::Philox &rng, SimulationScratch &scratch,
+                    double &attenFactor, double &error) const;
   /// Randomly select the location initial point within the beam from a square
   /// distribution
   Kernel::V3D sampleBeamProfile() const;
   /// Select a random location within the sample + container environment
-  Kernel::V3D selectScatterPoint() const;
+  Kernel::V3D selectScatterPoint(Kernel::Philox &rng) const;
   /// Calculate the attenuation factor for the given single scatter setup
   bool attenuationFactor(const Kernel::V3D &startPos,
                          const Kernel::V3D &scatterPoint,
                          const Kernel::V3D &finalPos, const double lambda,
-                         double &factor);
+                         SimulationScratch &scratch, double &factor) const;
   /// Calculate the attenuation for a given length, material and wavelength
   double attenuation(const double length, const Kernel::Material &material,
                      const double lambda) const;
@@ -93,10 +106,6 @@ private:
   void retrieveInput();
   /// Initialise the caches used
   void initCaches();
-  /// Setting up the random number generator
-  void initRNG();
-  /// Return the random number generator for the current thread
-  boost::mt19937 &rgen() const;
   /// Checks if a given box has any corners inside the sample or container
   bool boxIntersectsSample(const double xmax, const double ymax,
                            const double zmax, const double xmin,
@@ -122,8 +131,8 @@ private:
   double m_blkHalfY;
   /// Half a single block width in Z
   double m_blkHalfZ;
-  /// Random number generator
-  std::vector<boost::mt19937> m_rngs;
+  /// Scratch storage for each thread
+  std::vector<SimulationScratch> m_scratch;
   //@}
 
   /// The input workspace
@@ -140,6 +149,12 @@ private:
   int m_xStepSize;
   /// The number of events per point
   int m_numberOfEvents;
+  /// The maximum number of events per point when converging adaptively
+  int m_maxNumberOfEvents;
+  /// The relative error at which the simulation of a point stops, 0 to disable
+  double m_relativeTolerance;
+  /// The seed of the random number generator
+  int m_seed;
 };
 }
 }
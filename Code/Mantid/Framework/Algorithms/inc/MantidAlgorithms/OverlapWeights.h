@@ -0,0 +1,111 @@
+#ifndef MANTID_ALGORITHMS_OVERLAPWEIGHTS_H_
+#define MANTID_ALGORITHMS_OVERLAPWEIGHTS_H_
+
+#include "MantidKernel/SingletonHolder.h"
+#include "MantidKernel/System.h"
+#include "MantidAPI/KeyedLRUCache.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Algorithms {
+
+/**
+  Describes everything that the overlaps of the input bins of a polygon
+  rebinning with the output grid depend upon. The algorithm fills in the
+  parameters it uses to build the input polygons, e.g. the bin edges and
+  detector angles, along with the output bin edges. Two rebinnings with equal
+  geometries produce identical overlap weights.
+ */
+struct DLLExport OverlapGeometry {
+  /// Equality operator
+  bool operator==(const OverlapGeometry &other) const;
+
+  /// Identifies how the parameters are turned into polygons
+  std::string method;
+  /// The values that define the input polygons and the output grid
+  std::vector<double> parameters;
+};
+
+/**
+  The overlap of one input bin with one output bin
+ */
+struct DLLExport OverlapWeight {
+  /// The index of the input bin, spectrum * bins-per-spectrum + bin
+  size_t inputIndex;
+  /// The bin within the output spectrum
+  size_t outputBin;
+  /// The fraction of the input bin that lies within the output bin
+  double weight;
+  /// The width in X of the overlap
+  double width;
+};
+
+/**
+  An overlap together with the output spectrum it belongs to, used while the
+  weights are being computed
+ */
+struct DLLExport OutputOverlap {
+  /// The output spectrum
+  size_t outputRow;
+  /// The overlap
+  OverlapWeight overlap;
+};
+
+/**
+  The sparse matrix of overlap weights between the bins of an input workspace
+  and those of an output workspace. The weights are grouped by output spectrum
+  so that the spectra can be filled independently.
+ */
+class DLLExport OverlapWeights {
+public:
+  /// Construct from the overlaps found for each input spectrum
+  OverlapWeights(const OverlapGeometry &geom, const size_t numberOfInputBins,
+                 const size_t numberOfOutputRows,
+                 const std::vector<std::vector<OutputOverlap>> &overlaps);
+
+  /// Add the weighted input to the output workspace
+  void apply(API::MatrixWorkspace_const_sptr inputWS,
+             API::MatrixWorkspace_sptr outputWS, const bool scaleByWidth,
+             const bool trackFractions) const;
+  /// The total number of weights
+  size_t size() const { return m_weights.size(); }
+  /// The approximate memory used in bytes
+  size_t memorySize() const;
+  /// The key of the weights in OverlapWeightsCache
+  const OverlapGeometry &cacheKey() const { return geometry; }
+
+  /// The geometry that the weights were computed for
+  const OverlapGeometry geometry;
+
+private:
+  /// The number of bins in each input spectrum
+  const size_t m_numberOfInputBins;
+  /// The weights, ordered by output spectrum then by input bin
+  std::vector<OverlapWeight> m_weights;
+  /// The position in m_weights of the first weight of each output spectrum
+  std::vector<size_t> m_rowStart;
+};
+
+/// Typedef for a shared pointer to a set of overlap weights
+typedef boost::shared_ptr<OverlapWeights> OverlapWeights_sptr;
+/// Typedef for a shared pointer to a const set of overlap weights
+typedef boost::shared_ptr<const OverlapWeights> OverlapWeights_const_sptr;
+
+/// The cache of overlap weights shared by Rebin2D and SofQW3, so that
+/// rebinning a series of runs with the same instrument and binning computes
+/// the polygon intersections only once
+typedef API::KeyedLRUCache<OverlapGeometry, OverlapWeights>
+    OverlapWeightsCacheImpl;
+
+#ifdef _WIN32
+template class DLLExport Kernel::SingletonHolder<OverlapWeightsCacheImpl>;
+#endif
+typedef Kernel::SingletonHolder<OverlapWeightsCacheImpl> OverlapWeightsCache;
+
+} // namespace Algorithms
+} // namespace Mantid
+
+#endif /* MANTID_ALGORITHMS_OVERLAPWEIGHTS_H_ */
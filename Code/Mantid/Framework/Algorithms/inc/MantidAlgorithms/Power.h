@@ -70,8 +70,10 @@ private:
   void retrieveProperties();
   void performUnaryOperation(const double XIn, const double YIn,
                              const double EIn, double &YOut, double &EOut);
-  /// calculate the power
-  inline double calculatePower(const double base, const double exponent);
+  void performUnaryOperationOnSpectrum(const MantidVec &X,
+                                       const MantidVec &YIn,
+                                       const MantidVec &EIn, MantidVec &YOut,
+                                       MantidVec &EOut);
   /// Exponent to raise the base workspace to
   double m_exponent;
 };
@@ -6,6 +6,7 @@
 //------------------------------------------------------------------------------
 #include "MantidKernel/System.h"
 #include "MantidAPI/Algorithm.h"
+#include "MantidAlgorithms/OverlapWeights.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
 #include "MantidDataObjects/RebinnedOutput.h"
 
@@ -65,12 +66,14 @@ protected:
                      API::MatrixWorkspace_const_sptr inputWS, const size_t i,
                      const size_t j, API::MatrixWorkspace_sptr outputWS,
                      const std::vector<double> &verticalAxis);
-  /// Rebin the input quadrilateral to to output grid
-  void rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
-                               API::MatrixWorkspace_const_sptr inputWS,
-                               const size_t i, const size_t j,
-                               DataObjects::RebinnedOutput_sptr outputWS,
-                               const std::vector<double> &verticalAxis);
+  /// Find the overlaps of the input quadrilateral with the output grid
+  void findOverlaps(const Geometry::Quadrilateral &inputQ,
+                    const size_t inputIndex,
+                    API::MatrixWorkspace_const_sptr outputWS,
+                    const std::vector<double> &verticalAxis,
+                    std::vector<OutputOverlap> &overlaps) const;
+  /// Keep the weights for later runs if the cache is switched on
+  void cacheOverlapWeights(const OverlapWeights_const_sptr &weights) const;
 
   /// Find the intersect region on the output grid
   bool getIntersectionRegion(API::MatrixWorkspace_const_sptr outputWS,
@@ -93,6 +93,14 @@ protected:
                                      const double EIn, double &YOut,
                                      double &EOut) = 0;
 
+  /// Carries out the Unary operation on a whole spectrum. Override this to
+  /// run the per-bin calculation as a vectorized Kernel::SIMD kernel.
+  virtual void performUnaryOperationOnSpectrum(const MantidVec &X,
+                                               const MantidVec &YIn,
+                                               const MantidVec &EIn,
+                                               MantidVec &YOut,
+                                               MantidVec &EOut);
+
   /// flag to use histogram representation instead of events for certain
   /// algorithms
   bool useHistogram;
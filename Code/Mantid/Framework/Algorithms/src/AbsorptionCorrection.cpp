@@ -9,6 +9,7 @@
 #include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/ConfigService.h"
 
 namespace Mantid {
 namespace Algorithms {
@@ -18,6 +19,23 @@ using namespace Geometry;
 using namespace API;
 using namespace Mantid::PhysicalConstants;
 
+namespace {
+/// The size, in MB, of the largest path-length table kept if
+/// AbsorptionCorrection.PathLengthCache.MaxSize is not set
+const int DEFAULT_MAX_CACHED_TABLE_MB = 64;
+
+/// @returns The size in bytes of the largest table that should be cached, 0 if
+/// caching is switched off
+size_t maxCachedTableSize() {
+  int maxMB = DEFAULT_MAX_CACHED_TABLE_MB;
+  Kernel::ConfigService::Instance().getValue(
+      "AbsorptionCorrection.PathLengthCache.MaxSize", maxMB);
+  if (maxMB <= 0)
+    return 0;
+  return static_cast<size_t>(maxMB) * 1024 * 1024;
+}
+}
+
 AbsorptionCorrection::AbsorptionCorrection()
     : API::Algorithm(), m_inputWS(), m_sampleObject(NULL), m_L1s(),
       m_elementVolumes(), m_elementPositions(), m_numVolumeElements(0),
@@ -139,6 +157,50 @@ void AbsorptionCorrection::exec() {
     }
   }
 
+  // Find the detector of each spectrum. The path lengths depend only on the
+  // sample shape, the volume elements and the detector positions so these
+  // make up the key for the cached tables.
+  std::vector<IDetector_const_sptr> detectors(numHists);
+  PathLengthGeometry geometry;
+  geometry.shapeXML = m_sampleObject->getShapeXML();
+  geometry.elementPositions = m_elementPositions;
+  geometry.detectorPositions.resize(numHists);
+  PARALLEL_FOR1(m_inputWS)
+  for (int64_t i = 0; i < int64_t(numHists); ++i) {
+    try {
+      detectors[i] = m_inputWS->getDetector(i);
+    } catch (Exception::NotFoundError &) {
+      // No detector, the spectrum is skipped below
+    }
+    if (detectors[i])
+      geometry.detectorPositions[i] = detectorPosition(detectors[i]);
+  }
+  geometry.hasDetector.resize(numHists);
+  for (int64_t i = 0; i < numHists; ++i) {
+    geometry.hasDetector[i] = static_cast<bool>(detectors[i]);
+  }
+
+  // Shapes built in code rather than from XML cannot be told apart so are
+  // never cached
+  const size_t maxTableSize = maxCachedTableSize();
+  const bool cacheable = !geometry.shapeXML.empty() && maxTableSize > 0;
+  PathLengthTable_const_sptr cachedTable;
+  PathLengthTable_sptr newTable;
+  if (cacheable) {
+    cachedTable = AbsorptionPathLengthCache::Instance().find(geometry);
+    if (cachedTable) {
+      g_log.information("Reusing cached sample-to-detector path lengths");
+    } else {
+      // The geometry has changed so the old table is of no further use
+      AbsorptionPathLengthCache::Instance().clear();
+      if (PathLengthTable::memorySize(geometry) <= maxTableSize) {
+        newTable = boost::make_shared<PathLengthTable>(geometry);
+      }
+    }
+  } else {
+    AbsorptionPathLengthCache::Instance().clear();
+  }
+
   Progress prog(this, 0.0, 1.0, numHists);
   // Loop over the spectra
   PARALLEL_FOR2(m_inputWS, correctionFactors)
@@ -149,23 +211,33 @@ void AbsorptionCorrection::exec() {
     const MantidVec &X = m_inputWS->readX(i);
     correctionFactors->dataX(i) = X;
 
-    // Get detector position
-    IDetector_const_sptr det;
-    try {
-      det = m_inputWS->getDetector(i);
-    } catch (Exception::NotFoundError &) {
-      // Catch if no detector. Next line tests whether this happened - test
-      // placed
-      // outside here because Mac Intel compiler doesn't like 'continue' in a
-      // catch
-      // in an openmp block.
-    }
     // If no detector found, skip onto the next spectrum
+    const IDetector_const_sptr &det = detectors[i];
     if (!det)
       continue;
 
-    std::vector<double> L2s(m_numVolumeElements);
-    calculateDistances(det, L2s);
+    // Take the path lengths from the cached table or trace them now
+    std::vector<double> L2Buffer;
+    const double *L2s(NULL);
+    if (cachedTable) {
+      L2s = cachedTable->row(i);
+    } else if (newTable) {
+      calculateDistances(geometry.detectorPositions[i], newTable->row(i));
+      L2s = newTable->row(i);
+    } else {
+      L2Buffer.resize(m_numVolumeElements);
+      calculateDistances(geometry.detectorPositions[i], &L2Buffer[0]);
+      L2s = &L2Buffer[0];
+    }
+    // For elastic scattering the exponent only depends on the total path
+    std::vector<double> totalPaths;
+    if (m_emode == 0) {
+      totalPaths.resize(m_numVolumeElements);
+      for (size_t k = 0; k < m_numVolumeElements; ++k) {
+        totalPaths[k] = m_L1s[k] + L2s[k];
+      }
+    }
+    std::vector<double> scratch(m_numVolumeElements);
 
     // If an indirect instrument, see if there's an efixed in the parameter map
     double lambda_f = m_lambdaFixed;
@@ -192,13 +264,13 @@ void AbsorptionCorrection::exec() {
       const double lambda = (isHist ? (0.5 * (X[j] + X[j + 1])) : X[j]);
       if (m_emode == 0) // Elastic
       {
-        Y[j] = this->doIntegration(lambda, L2s);
+        Y[j] = this->doIntegration(lambda, totalPaths, scratch);
       } else if (m_emode == 1) // Direct
       {
-        Y[j] = this->doIntegration(m_lambdaFixed, lambda, L2s);
+        Y[j] = this->doIntegration(m_lambdaFixed, lambda, L2s, scratch);
       } else if (m_emode == 2) // Indirect
       {
-        Y[j] = this->doIntegration(lambda, lambda_f, L2s);
+        Y[j] = this->doIntegration(lambda, lambda_f, L2s, scratch);
       }
       Y[j] /= m_sampleVolume; // Divide by total volume of the cylinder
 
@@ -220,6 +292,10 @@ void AbsorptionCorrection::exec() {
   }
   PARALLEL_CHECK_INTERUPT_REGION
 
+  if (newTable) {
+    AbsorptionPathLengthCache::Instance().store(newTable);
+  }
+
   g_log.information() << "Total number of elements in the integration was "
                       << m_L1s.size() << std::endl;
   setProperty("OutputWorkspace", correctionFactors);
@@ -311,13 +387,12 @@ void AbsorptionCorrection::constructSample(API::Sample &sample) {
   }
 }
 
-/// Calculate the distances traversed by the neutrons within the sample
+/// Return the position to use for a detector. For a group of detectors this
+/// is placed at the average scattering angles.
 /// @param detector :: The detector we are working on
-/// @param L2s :: A vector of the sample-detector distance for  each segment of
-/// the sample
-void
-AbsorptionCorrection::calculateDistances(const IDetector_const_sptr &detector,
-                                         std::vector<double> &L2s) const {
+/// @returns The position used to define the outgoing tracks
+V3D AbsorptionCorrection::detectorPosition(
+    const IDetector_const_sptr &detector) const {
   V3D detectorPos(detector->getPos());
   if (detector->nDets() > 1) {
     // We need to make sure this is right for grouped detectors - should use
@@ -327,7 +402,15 @@ AbsorptionCorrection::calculateDistances(const IDetector_const_sptr &detector,
                               M_PI,
                           detector->getPhi() * 180.0 / M_PI);
   }
+  return detectorPos;
+}
 
+/// Calculate the distances traversed by the neutrons within the sample
+/// @param detectorPos :: The position of the detector we are working on
+/// @param L2s :: Output. The sample-detector distance for each segment of the
+/// sample, must have space for m_numVolumeElements values
+void AbsorptionCorrection::calculateDistances(const V3D &detectorPos,
+                                              double *L2s) const {
   for (size_t i = 0; i < m_numVolumeElements; ++i) {
     // Create track for distance in cylinder between scattering point and
     // detector
@@ -372,42 +455,55 @@ AbsorptionCorrection::calculateDistances(const IDetector_const_sptr &detector,
 
 /// Carries out the numerical integration over the sample for elastic
 /// instruments
-double
-AbsorptionCorrection::doIntegration(const double &lambda,
-                                    const std::vector<double> &L2s) const {
+/// @param lambda :: The wavelength
+/// @param totalPaths :: The total path length, L1 + L2, for each element
+/// @param scratch :: Workspace of the same size as totalPaths
+double AbsorptionCorrection::doIntegration(const double &lambda,
+                                           const std::vector<double> &totalPaths,
+                                           std::vector<double> &scratch) const {
+  // Equation is exponent * element volume
+  // where exponent is e^(-mu * wavelength/1.8 * (L1+L2) )
+  const double mu = (m_refAtten * lambda) + m_scattering;
+  const size_t el = totalPaths.size();
+  // Keep the loops simple so that the compiler can vectorise them
+  for (size_t i = 0; i < el; ++i) {
+    scratch[i] = mu * totalPaths[i];
+  }
+  for (size_t i = 0; i < el; ++i) {
+    scratch[i] = EXPONENTIAL(scratch[i]);
+  }
   double integral = 0.0;
-
-  size_t el = L2s.size();
-  // Iterate over all the elements, summing up the integral
   for (size_t i = 0; i < el; ++i) {
-    // Equation is exponent * element volume
-    // where exponent is e^(-mu * wavelength/1.8 * (L1+L2) )
-    const double exponent =
-        ((m_refAtten * lambda) + m_scattering) * (m_L1s[i] + L2s[i]);
-    integral += (EXPONENTIAL(exponent) * (m_elementVolumes[i]));
+    integral += scratch[i] * m_elementVolumes[i];
   }
-
   return integral;
 }
 
 /// Carries out the numerical integration over the sample for inelastic
 /// instruments
-double
-AbsorptionCorrection::doIntegration(const double &lambda_i,
-                                    const double &lambda_f,
-                                    const std::vector<double> &L2s) const {
+/// @param lambda_i :: The incident wavelength
+/// @param lambda_f :: The final wavelength
+/// @param L2s :: The sample-detector distance for each element
+/// @param scratch :: Workspace with space for an entry per element
+double AbsorptionCorrection::doIntegration(const double &lambda_i,
+                                           const double &lambda_f,
+                                           const double *L2s,
+                                           std::vector<double> &scratch) const {
+  // Equation is exponent * element volume
+  // where exponent is e^(-mu * wavelength/1.8 * (L1+L2) )
+  const double mu_i = (m_refAtten * lambda_i) + m_scattering;
+  const double mu_f = (m_refAtten * lambda_f) + m_scattering;
+  const size_t el = m_numVolumeElements;
+  for (size_t i = 0; i < el; ++i) {
+    scratch[i] = mu_i * m_L1s[i] + mu_f * L2s[i];
+  }
+  for (size_t i = 0; i < el; ++i) {
+    scratch[i] = EXPONENTIAL(scratch[i]);
+  }
   double integral = 0.0;
-
-  size_t el = L2s.size();
-  // Iterate over all the elements, summing up the integral
   for (size_t i = 0; i < el; ++i) {
-    // Equation is exponent * element volume
-    // where exponent is e^(-mu * wavelength/1.8 * (L1+L2) )
-    double exponent = ((m_refAtten * lambda_i) + m_scattering) * m_L1s[i];
-    exponent += ((m_refAtten * lambda_f) + m_scattering) * L2s[i];
-    integral += (EXPONENTIAL(exponent) * (m_elementVolumes[i]));
+    integral += scratch[i] * m_elementVolumes[i];
   }
-
   return integral;
 }
 
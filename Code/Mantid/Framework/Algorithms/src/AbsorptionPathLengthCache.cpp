@@ -0,0 +1,44 @@
+#include "MantidAlgorithms/AbsorptionPathLengthCache.h"
+
+namespace Mantid {
+namespace Algorithms {
+
+//----------------------------------------------------------------------------------------------
+// PathLengthGeometry
+//----------------------------------------------------------------------------------------------
+/**
+ * The cheap comparisons are done first so that mismatched geometries are
+ * usually rejected without walking the position lists.
+ * @param other :: The geometry to compare with
+ * @returns True if the two geometries give identical path lengths
+ */
+bool PathLengthGeometry::operator==(const PathLengthGeometry &other) const {
+  return elementPositions.size() == other.elementPositions.size() &&
+         detectorPositions.size() == other.detectorPositions.size() &&
+         shapeXML == other.shapeXML && hasDetector == other.hasDetector &&
+         elementPositions == other.elementPositions &&
+         detectorPositions == other.detectorPositions;
+}
+
+//----------------------------------------------------------------------------------------------
+// PathLengthTable
+//----------------------------------------------------------------------------------------------
+/**
+ * @param geom :: The geometry the table will be filled for
+ */
+PathLengthTable::PathLengthTable(const PathLengthGeometry &geom)
+    : geometry(geom), L2s(geom.elementPositions.size() *
+                          geom.detectorPositions.size(),
+                          0.0) {}
+
+/**
+ * @param geom :: The geometry of a table
+ * @returns The number of bytes taken by the path lengths of the table
+ */
+size_t PathLengthTable::memorySize(const PathLengthGeometry &geom) {
+  return geom.elementPositions.size() * geom.detectorPositions.size() *
+         sizeof(double);
+}
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -0,0 +1,386 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAlgorithms/AlignAndFocusEvents.h"
+#include "MantidAlgorithms/AlignDetectors.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/WorkspaceValidators.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/RebinParamsValidator.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/VectorHelper.h"
+
+#include <boost/scoped_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Mantid::Kernel;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+namespace Mantid {
+namespace Algorithms {
+// Register the algorithm into the algorithm factory
+DECLARE_ALGORITHM(AlignAndFocusEvents)
+
+namespace {
+/**
+ * Finds the bin of a d-spacing value. With a single linear or logarithmic
+ * step the bin is calculated directly rather than searched for.
+ */
+class BinFinder {
+public:
+  BinFinder(const std::vector<double> &params, const MantidVec &X)
+      : m_X(X), m_nBins(static_cast<int>(X.size()) - 1), m_xMin(X.front()),
+        m_xMax(X.back()), m_linear(false), m_log(false), m_scale(0.0) {
+    if (params.size() == 3) {
+      if (params[1] > 0.0) {
+        m_linear = true;
+        m_scale = 1.0 / params[1];
+      } else if (params[1] < 0.0 && m_xMin > 0.0) {
+        m_log = true;
+        m_scale = 1.0 / std::log(1.0 - params[1]);
+      }
+    }
+  }
+
+  /// @return the bin holding d, or -1 if it is outside the range
+  int find(const double d) const {
+    if (!(d >= m_xMin && d < m_xMax)) // also rejects NaN
+      return -1;
+    if (!m_linear && !m_log)
+      return static_cast<int>(
+          std::upper_bound(m_X.begin(), m_X.end(), d) - m_X.begin()) - 1;
+
+    int bin = static_cast<int>(m_linear ? (d - m_xMin) * m_scale
+                                        : std::log(d / m_xMin) * m_scale);
+    // Rounding can put the value one bin out; the last bin may be narrower
+    if (bin >= m_nBins)
+      bin = m_nBins - 1;
+    while (bin > 0 && d < m_X[bin])
+      --bin;
+    while (bin < m_nBins - 1 && d >= m_X[bin + 1])
+      ++bin;
+    return bin;
+  }
+
+private:
+  const MantidVec &m_X;
+  const int m_nBins;
+  const double m_xMin;
+  const double m_xMax;
+  bool m_linear;
+  bool m_log;
+  double m_scale;
+};
+
+/**
+ * Convert a list of events to d-spacing and add them to a histogram
+ * @param events :: The events in TOF
+ * @param factor :: The TOF to d-spacing conversion factor of the spectrum
+ * @param bins :: The binning of the output
+ * @param Y :: The counts to add to
+ * @param E2 :: The squared errors to add to
+ */
+template <class T>
+void histogramEvents(const std::vector<T> &events, const double factor,
+                     const BinFinder &bins, double *Y, double *E2) {
+  typename std::vector<T>::const_iterator it;
+  for (it = events.begin(); it != events.end(); ++it) {
+    const int bin = bins.find(it->tof() * factor);
+    if (bin >= 0) {
+      Y[bin] += it->weight();
+      E2[bin] += it->errorSquared();
+    }
+  }
+}
+
+/**
+ * Convert the events of a spectrum to d-spacing and add them to a histogram
+ * @param el :: The events of the spectrum in TOF
+ * @param factor :: The TOF to d-spacing conversion factor of the spectrum
+ * @param bins :: The binning of the output
+ * @param Y :: The counts to add to
+ * @param E2 :: The squared errors to add to
+ */
+void histogramSpectrum(const EventList &el, const double factor,
+                       const BinFinder &bins, double *Y, double *E2) {
+  switch (el.getEventType()) {
+  case TOF:
+    histogramEvents(el.getEvents(), factor, bins, Y, E2);
+    break;
+  case WEIGHTED:
+    histogramEvents(el.getWeightedEvents(), factor, bins, Y, E2);
+    break;
+  case WEIGHTED_NOTIME:
+    histogramEvents(el.getWeightedEventsNoTime(), factor, bins, Y, E2);
+    break;
+  }
+}
+}
+
+//-----------------------------------------------------------------------
+/// (Empty) Constructor
+AlignAndFocusEvents::AlignAndFocusEvents() {}
+
+/// Destructor
+AlignAndFocusEvents::~AlignAndFocusEvents() {}
+
+//-----------------------------------------------------------------------
+void AlignAndFocusEvents::init() {
+  auto wsValidator = boost::make_shared<CompositeValidator>();
+  wsValidator->add<WorkspaceUnitValidator>("TOF");
+  wsValidator->add<InstrumentValidator>();
+  declareProperty(new WorkspaceProperty<EventWorkspace>(
+                      "InputWorkspace", "", Direction::Input, wsValidator),
+                  "An EventWorkspace with units of TOF");
+
+  declareProperty(new WorkspaceProperty<MatrixWorkspace>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "A workspace holding one histogram in dSpacing per group");
+
+  std::vector<std::string> exts;
+  exts.push_back(".cal");
+  declareProperty(
+      new FileProperty("CalibrationFile", "", FileProperty::OptionalLoad, exts),
+      "Optional: The .cal file containing the offsets and, unless "
+      "GroupingWorkspace is given, the grouping.");
+
+  declareProperty(
+      new WorkspaceProperty<OffsetsWorkspace>(
+          "OffsetsWorkspace", "", Direction::Input, PropertyMode::Optional),
+      "Optional: A OffsetsWorkspace containing the calibration offsets. Either "
+      "this or CalibrationFile needs to be specified.");
+
+  declareProperty(
+      new WorkspaceProperty<GroupingWorkspace>(
+          "GroupingWorkspace", "", Direction::Input, PropertyMode::Optional),
+      "Optional: A GroupingWorkspace giving the group of each detector. "
+      "Needed unless CalibrationFile is given.");
+
+  declareProperty(
+      new ArrayProperty<double>("Params",
+                                boost::make_shared<RebinParamsValidator>()),
+      "The binning of the output in dSpacing, as for Rebin: "
+      "x1, dx1, x2, ... A negative step gives logarithmic bins.");
+}
+
+//-----------------------------------------------------------------------
+/**
+ * Read the offsets and the grouping from the properties, loading the .cal
+ * file if one was given.
+ * @param inputWS :: The workspace whose instrument is calibrated
+ */
+void AlignAndFocusEvents::loadCalibration(MatrixWorkspace_const_sptr inputWS) {
+  const std::string calFileName = getProperty("CalibrationFile");
+  m_offsetsWS = getProperty("OffsetsWorkspace");
+  m_groupWS = getProperty("GroupingWorkspace");
+
+  if (m_offsetsWS && !calFileName.empty())
+    throw std::invalid_argument("You must specify either CalibrationFile or "
+                                "OffsetsWorkspace but not both.");
+  if (calFileName.empty()) {
+    if (!m_offsetsWS || !m_groupWS)
+      throw std::invalid_argument("You must specify either CalibrationFile or "
+                                  "OffsetsWorkspace and GroupingWorkspace.");
+    return;
+  }
+
+  IAlgorithm_sptr alg = createChildAlgorithm("LoadCalFile", 0.0, 0.1);
+  alg->setPropertyValue("CalFilename", calFileName);
+  alg->setProperty("InputWorkspace",
+                   boost::const_pointer_cast<MatrixWorkspace>(inputWS));
+  alg->setProperty<bool>("MakeGroupingWorkspace", !m_groupWS);
+  alg->setProperty<bool>("MakeOffsetsWorkspace", true);
+  alg->setProperty<bool>("MakeMaskWorkspace", false);
+  alg->setPropertyValue("WorkspaceName", "temp");
+  alg->executeAsChildAlg();
+  m_offsetsWS = alg->getProperty("OutputOffsetsWorkspace");
+  if (!m_groupWS)
+    m_groupWS = alg->getProperty("OutputGroupingWorkspace");
+}
+
+//-----------------------------------------------------------------------
+/**
+ * Find the group of a spectrum
+ * @param detectors :: The detector IDs of the spectrum
+ * @return the group, or -1 if the detectors are not all in the same group
+ */
+int AlignAndFocusEvents::groupOfSpectrum(
+    const std::set<detid_t> &detectors) const {
+  int group = -1;
+  std::set<detid_t>::const_iterator it;
+  for (it = detectors.begin(); it != detectors.end(); ++it) {
+    if (*it < 0 || static_cast<size_t>(*it) >= m_detIDToGroup.size())
+      return -1;
+    const int detGroup = m_detIDToGroup[*it];
+    if (detGroup <= 0 || (group != -1 && detGroup != group))
+      return -1;
+    group = detGroup;
+  }
+  return group;
+}
+
+//-----------------------------------------------------------------------
+/** Executes the algorithm
+ *  @throw std::invalid_argument If the calibration is not given properly
+ *  @throw std::runtime_error If no spectra are in a group
+ */
+void AlignAndFocusEvents::exec() {
+  EventWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  const std::vector<double> params = getProperty("Params");
+  if (params.size() < 3)
+    throw std::invalid_argument(
+        "Params must give the start and end of the binning.");
+
+  progress(0.0, "Reading calibration");
+  loadCalibration(inputWS);
+  boost::scoped_ptr<std::map<detid_t, double>> tofToDmap(
+      AlignDetectors::calcTofToD_ConversionMap(inputWS, m_offsetsWS));
+  int64_t nGroups = 0;
+  m_groupWS->makeDetectorIDToGroupVector(m_detIDToGroup, nGroups);
+
+  // The conversion factor and the output spectrum of each input spectrum
+  const int64_t numberOfSpectra =
+      static_cast<int64_t>(inputWS->getNumberHistograms());
+  std::vector<double> factors(numberOfSpectra, 0.0);
+  std::vector<int> groups(numberOfSpectra, -1);
+  std::map<int, int> groupToOutput;
+  for (int64_t i = 0; i < numberOfSpectra; ++i) {
+    const std::set<detid_t> &detectors =
+        inputWS->getSpectrum(static_cast<size_t>(i))->getDetectorIDs();
+    const int group = groupOfSpectrum(detectors);
+    const double factor =
+        AlignDetectors::calcConversionFromMap(tofToDmap.get(), detectors);
+    if (group > 0 && factor > 0.0) {
+      groups[i] = group;
+      factors[i] = factor;
+      groupToOutput[group] = 0;
+    }
+  }
+  if (groupToOutput.empty())
+    throw std::runtime_error("None of the spectra are in a group.");
+  // The output spectra are in the order of their group numbers
+  std::vector<int> outputGroups;
+  for (std::map<int, int>::iterator it = groupToOutput.begin();
+       it != groupToOutput.end(); ++it) {
+    it->second = static_cast<int>(outputGroups.size());
+    outputGroups.push_back(it->first);
+  }
+  // The input spectra of each output spectrum
+  std::vector<std::vector<size_t>> outputSpectra(outputGroups.size());
+  size_t numberGrouped(0);
+  for (int64_t i = 0; i < numberOfSpectra; ++i) {
+    if (groups[i] > 0) {
+      outputSpectra[groupToOutput[groups[i]]].push_back(static_cast<size_t>(i));
+      ++numberGrouped;
+    }
+  }
+
+  MantidVecPtr XValues;
+  const int nBins =
+      VectorHelper::createAxisFromRebinParams(params, XValues.access()) - 1;
+  const BinFinder bins(params, *XValues);
+  const size_t nOutput = outputGroups.size();
+  const size_t histSize = nOutput * static_cast<size_t>(nBins);
+
+  const int nThreads = PARALLEL_GET_MAX_THREADS;
+  MantidVec sumY, sumE2;
+  Progress prog(this, 0.1, 0.9, numberGrouped);
+  if (nOutput >= static_cast<size_t>(nThreads)) {
+    // Enough groups to keep every thread busy histogramming a group of its
+    // own, straight into the output
+    sumY.assign(histSize, 0.0);
+    sumE2.assign(histSize, 0.0);
+    const int64_t nOutput64 = static_cast<int64_t>(nOutput);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t wi = 0; wi < nOutput64; ++wi) {
+      PARALLEL_START_INTERUPT_REGION
+      const size_t offset = static_cast<size_t>(wi) * nBins;
+      const std::vector<size_t> &indices = outputSpectra[wi];
+      for (size_t k = 0; k < indices.size(); ++k) {
+        histogramSpectrum(inputWS->getEventList(indices[k]),
+                          factors[indices[k]], bins, &sumY[offset],
+                          &sumE2[offset]);
+        prog.report("Focussing events");
+      }
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+  } else {
+    // Only a few groups. Share the spectra out between the threads, each
+    // histogramming into its own copy of the output, then add the copies.
+    std::vector<std::pair<size_t, size_t>> spectra;
+    spectra.reserve(numberGrouped);
+    for (size_t wi = 0; wi < nOutput; ++wi) {
+      for (size_t k = 0; k < outputSpectra[wi].size(); ++k)
+        spectra.push_back(std::make_pair(wi, outputSpectra[wi][k]));
+    }
+    std::vector<MantidVec> partialY(nThreads, MantidVec(histSize, 0.0));
+    std::vector<MantidVec> partialE2(nThreads, MantidVec(histSize, 0.0));
+
+    const int64_t nSpectra = static_cast<int64_t>(spectra.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < nSpectra; ++i) {
+      PARALLEL_START_INTERUPT_REGION
+      const int thread = PARALLEL_THREAD_NUMBER;
+      const size_t offset = spectra[i].first * nBins;
+      const size_t index = spectra[i].second;
+      histogramSpectrum(inputWS->getEventList(index), factors[index], bins,
+                        &partialY[thread][offset], &partialE2[thread][offset]);
+      prog.report("Focussing events");
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+
+    progress(0.9, "Summing");
+    const int64_t histSize64 = static_cast<int64_t>(histSize);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t j = 0; j < histSize64; ++j) {
+      for (int thread = 1; thread < nThreads; ++thread) {
+        partialY[0][j] += partialY[thread][j];
+        partialE2[0][j] += partialE2[thread][j];
+      }
+    }
+    sumY.swap(partialY[0]);
+    sumE2.swap(partialE2[0]);
+  }
+
+  MatrixWorkspace_sptr outputWS = WorkspaceFactory::Instance().create(
+      "Workspace2D", nOutput, nBins + 1, nBins);
+  WorkspaceFactory::Instance().initializeFromParent(inputWS, outputWS, true);
+  outputWS->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+
+  // The detectors of each group
+  std::vector<std::vector<detid_t>> detectors(nOutput);
+  for (size_t wi = 0; wi < nOutput; ++wi) {
+    for (size_t k = 0; k < outputSpectra[wi].size(); ++k) {
+      const std::set<detid_t> &ids =
+          inputWS->getSpectrum(outputSpectra[wi][k])->getDetectorIDs();
+      detectors[wi].insert(detectors[wi].end(), ids.begin(), ids.end());
+    }
+  }
+
+  for (size_t wi = 0; wi < nOutput; ++wi) {
+    ISpectrum *outSpec = outputWS->getSpectrum(wi);
+    outSpec->setSpectrumNo(outputGroups[wi]);
+    outSpec->clearDetectorIDs();
+    std::sort(detectors[wi].begin(), detectors[wi].end());
+    outSpec->addDetectorIDs(detectors[wi]);
+    outSpec->setX(XValues);
+
+    const size_t offset = wi * nBins;
+    MantidVec &Y = outSpec->dataY();
+    MantidVec &E = outSpec->dataE();
+    for (int bin = 0; bin < nBins; ++bin) {
+      Y[bin] = sumY[offset + bin];
+      E[bin] = std::sqrt(sumE2[offset + bin]);
+    }
+  }
+
+  setProperty("OutputWorkspace", outputWS);
+}
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -86,8 +86,9 @@ std::map<detid_t, double> *AlignDetectors::calcTofToD_ConversionMap(
  * @return
  */
 
-double calcConversionFromMap(std::map<detid_t, double> *tofToDmap,
-                             const std::set<detid_t> &detectors) {
+double
+AlignDetectors::calcConversionFromMap(std::map<detid_t, double> *tofToDmap,
+                                      const std::set<detid_t> &detectors) {
   double factor = 0.;
   detid_t numDetectors = 0;
   for (std::set<detid_t>::const_iterator iter = detectors.begin();
@@ -16,6 +16,7 @@
 #include <limits>
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/SIMD.h"
 
 namespace Mantid {
 namespace Algorithms {
@@ -23,6 +24,33 @@ namespace Algorithms {
 // Register with the algorithm factory
 DECLARE_ALGORITHM(ConvertUnits)
 
+namespace {
+/// Kernel for the quick conversion x -> factor * x^power
+struct QuickConversion {
+  QuickConversion(const double factor, const double power)
+      : m_factor(factor), m_power(power) {}
+  inline double operator()(const double x) const {
+    return m_factor * std::pow(x, m_power);
+  }
+  const double m_factor;
+  const double m_power;
+};
+
+/// Kernel for a power law between two units converted via TOF. As in the
+/// units themselves, zero is replaced by DBL_MIN when it would be divided by.
+/// EventList::convertUnitsQuickly does the same for the events.
+struct ViaTOFConversion {
+  ViaTOFConversion(const double factor, const double power)
+      : m_factor(factor), m_power(power) {}
+  inline double operator()(const double x) const {
+    return m_factor * std::pow((x == 0.0 && m_power < 0.0) ? DBL_MIN : x,
+                               m_power);
+  }
+  const double m_factor;
+  const double m_power;
+};
+}
+
 using namespace Kernel;
 using namespace API;
 using namespace DataObjects;
@@ -294,11 +322,8 @@ void ConvertUnits::convertQuickly(API::MatrixWorkspace_sptr outputWS,
     // Only do the full check if the quick one passes
     if (commonBoundaries) {
       // Calculate the new (common) X values
-      MantidVec::iterator iter;
-      for (iter = outputWS->dataX(0).begin(); iter != outputWS->dataX(0).end();
-           ++iter) {
-        *iter = factor * std::pow(*iter, power);
-      }
+      MantidVec &X = outputWS->dataX(0);
+      SIMD::transform(X, X, QuickConversion(factor, power));
 
       MantidVecPtr xVals;
       xVals.access() = outputWS->dataX(0);
@@ -326,11 +351,8 @@ void ConvertUnits::convertQuickly(API::MatrixWorkspace_sptr outputWS,
   for (int64_t k = 0; k < numberOfSpectra_i; ++k) {
     PARALLEL_START_INTERUPT_REGION
     if (!commonBoundaries) {
-      MantidVec::iterator it;
-      for (it = outputWS->dataX(k).begin(); it != outputWS->dataX(k).end();
-           ++it) {
-        *it = factor * std::pow(*it, power);
-      }
+      MantidVec &X = outputWS->dataX(k);
+      SIMD::transform(X, X, QuickConversion(factor, power));
     }
     // Convert the events themselves if necessary. Inefficiently.
     if (m_inputEvents) {
@@ -453,6 +475,14 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
           ? bind(&MatrixWorkspace::detectorSignedTwoTheta, outputWS, _1)
           : bind(&MatrixWorkspace::detectorTwoTheta, outputWS, _1);
 
+  // Local copies of the units for each thread, so the loop can run in parallel
+  const int nThreads = PARALLEL_GET_MAX_THREADS;
+  std::vector<Unit_sptr> fromUnits(nThreads), outputUnits(nThreads);
+  for (int thread = 0; thread < nThreads; ++thread) {
+    fromUnits[thread] = Unit_sptr(fromUnit->clone());
+    outputUnits[thread] = Unit_sptr(outputUnit->clone());
+  }
+
   // Loop over the histograms (detector spectra)
   PARALLEL_FOR1(outputWS)
   for (int64_t i = 0; i < numberOfSpectra_i; ++i) {
@@ -497,34 +527,40 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
         }
       }
 
-      // Make local copies of the units. This allows running the loop in
-      // parallel
-      Unit *localFromUnit = fromUnit->clone();
-      Unit *localOutputUnit = outputUnit->clone();
+      const int thread = PARALLEL_THREAD_NUMBER;
+      Unit *localFromUnit = fromUnits[thread].get();
+      Unit *localOutputUnit = outputUnits[thread].get();
 
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
-      // Convert the input unit to time-of-flight
-      localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                           emode, efixed, delta);
-      // Convert from time-of-flight to the desired unit
-      localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                               emode, efixed, delta);
-
-      // EventWorkspace part, modifying the EventLists.
-      if (m_inputEvents) {
-        eventWS->getEventList(i)
-            .convertUnitsViaTof(localFromUnit, localOutputUnit);
-
-        //        std::vector<double> tofs;
-        //        eventWS->getEventList(i).getTofs(tofs);
-        //        localFromUnit->toTOF(tofs,emptyVec,l1,l2,twoTheta,emode,efixed,delta);
-        //        localOutputUnit->fromTOF(tofs,emptyVec,l1,l2,twoTheta,emode,efixed,delta);
-        //        eventWS->getEventList(i).setTofs(tofs);
+      localFromUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      localOutputUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+
+      // If both steps are power laws, so is the whole conversion for this
+      // spectrum: out = fromFactor * (toFactor * x^toPower)^fromPower
+      double toFactor, toPower, fromFactor, fromPower;
+      if (localFromUnit->powerLawToTOF(toFactor, toPower) &&
+          localOutputUnit->powerLawFromTOF(fromFactor, fromPower)) {
+        const double factor = fromFactor * std::pow(toFactor, fromPower);
+        const double power = toPower * fromPower;
+        MantidVec &X = outputWS->dataX(i);
+        SIMD::transform(X, X, ViaTOFConversion(factor, power));
+        if (m_inputEvents)
+          eventWS->getEventList(i).convertUnitsQuickly(factor, power, true);
+      } else {
+        // Convert the input unit to time-of-flight
+        localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
+                             emode, efixed, delta);
+        // Convert from time-of-flight to the desired unit
+        localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, l2,
+                                 twoTheta, emode, efixed, delta);
+
+        // EventWorkspace part, modifying the EventLists.
+        if (m_inputEvents) {
+          eventWS->getEventList(i)
+              .convertUnitsViaTof(localFromUnit, localOutputUnit);
+        }
       }
-      // Clear unit memory
-      delete localFromUnit;
-      delete localOutputUnit;
 
     } catch (Exception::NotFoundError &) {
       // Get to here if exception thrown when calculating distance to detector
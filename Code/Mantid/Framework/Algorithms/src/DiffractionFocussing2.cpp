@@ -12,8 +12,11 @@
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidAPI/Axis.h"
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 #include <fstream>
+#include <functional>
 #include <iterator>
 #include <numeric>
 #include "MantidAPI/ISpectrum.h"
@@ -30,6 +33,206 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(DiffractionFocussing2)
 
+namespace {
+/// The sums for one output spectrum before they are normalised
+struct GroupSums {
+  explicit GroupSums(const size_t nPoints)
+      : y(nPoints, 0.0), e(nPoints, 0.0), weight(nPoints, 0.0) {}
+  GroupSums &operator+=(const GroupSums &other) {
+    std::transform(y.begin(), y.end(), other.y.begin(), y.begin(),
+                   std::plus<double>());
+    std::transform(e.begin(), e.end(), other.e.begin(), e.begin(),
+                   std::plus<double>());
+    std::transform(weight.begin(), weight.end(), other.weight.begin(),
+                   weight.begin(), std::plus<double>());
+    return *this;
+  }
+  MantidVec y;      ///< The summed counts
+  MantidVec e;      ///< The summed squared errors
+  MantidVec weight; ///< How much of each bin the input spectra cover
+};
+
+/**
+ * Rebin one input spectrum straight into the sums of its group
+ * @param inputWS :: The input workspace
+ * @param wi :: The workspace index of the spectrum
+ * @param Xout :: The bin boundaries of the group
+ * @param sums :: The sums of the group
+ * @param EOutDummy :: Scratch space of the size of the output
+ * @param eventXMin :: The lowest X of an event workspace, or 0
+ * @param eventXMax :: The highest X of an event workspace, or 0
+ */
+void addSpectrum(const MatrixWorkspace &inputWS, const size_t wi,
+                 const MantidVec &Xout, GroupSums &sums, MantidVec &EOutDummy,
+                 const double eventXMin, const double eventXMax) {
+  // This is the input spectrum
+  const ISpectrum *inSpec = inputWS.getSpectrum(wi);
+  // Get reference to its old X,Y,and E.
+  const MantidVec &Xin = inSpec->readX();
+  const MantidVec &Yin = inSpec->readY();
+  const MantidVec &Ein = inSpec->readE();
+
+  try {
+    VectorHelper::rebinHistogram(Xin, Yin, Ein, Xout, sums.y, sums.e, true);
+  } catch (...) {
+    // Should never happen because Xout is constructed to envelop all of the
+    // Xin vectors
+    std::ostringstream mess;
+    mess << "Error in rebinning process for spectrum:" << wi;
+    throw std::runtime_error(mess.str());
+  }
+
+  // Check for masked bins in this spectrum
+  if (inputWS.hasMaskedBins(wi)) {
+    MantidVec weight_bins, weights;
+    weight_bins.push_back(Xin.front());
+    // If there are masked bins, get a reference to the list of them
+    const API::MatrixWorkspace::MaskList &mask = inputWS.maskedBins(wi);
+    // Now iterate over the list, adjusting the weights for the affected
+    // bins
+    for (API::MatrixWorkspace::MaskList::const_iterator it = mask.begin();
+         it != mask.end(); ++it) {
+      const double currentX = Xin[(*it).first];
+      // Add an intermediate bin with full weight if masked bins aren't
+      // consecutive
+      if (weight_bins.back() != currentX) {
+        weights.push_back(1.0);
+        weight_bins.push_back(currentX);
+      }
+      // The weight for this masked bin is 1 - the degree to which this bin
+      // is masked
+      weights.push_back(1.0 - (*it).second);
+      weight_bins.push_back(Xin[(*it).first + 1]);
+    }
+    // Add on a final bin with full weight if masking doesn't go up to the
+    // end
+    if (weight_bins.back() != Xin.back()) {
+      weights.push_back(1.0);
+      weight_bins.push_back(Xin.back());
+    }
+
+    // Create a zero vector for the errors because we don't care about them
+    // here
+    const MantidVec zeroes(weights.size(), 0.0);
+    // Rebin the weights - note that this is a distribution
+    VectorHelper::rebin(weight_bins, weights, zeroes, Xout, sums.weight,
+                        EOutDummy, true, true);
+  } else // If no masked bins we want to add 1 to the weight of the output
+         // bins that this input covers
+  {
+    const MantidVec weights_default(1, 1.0), emptyVec(1, 0.0);
+    MantidVec limits(2);
+    if (eventXMin > 0. && eventXMax > 0.) {
+      limits[0] = eventXMin;
+      limits[1] = eventXMax;
+    } else {
+      limits[0] = Xin.front();
+      limits[1] = Xin.back();
+    }
+
+    // Rebin the weights - note that this is a distribution
+    VectorHelper::rebin(limits, weights_default, emptyVec, Xout, sums.weight,
+                        EOutDummy, true, true);
+  }
+}
+
+/**
+ * Turn the sums of a group into the focussed spectrum
+ * @param Xout :: The bin boundaries of the group
+ * @param sums :: The sums of the group. Destroyed.
+ * @param groupSize :: The number of spectra in the group
+ * @param Yout :: Set to the counts
+ * @param Eout :: Set to the errors
+ */
+void normaliseGroup(const MantidVec &Xout, GroupSums &sums,
+                    const size_t groupSize, MantidVec &Yout, MantidVec &Eout) {
+  Yout.swap(sums.y);
+  Eout.swap(sums.e);
+
+  // Calculate the bin widths
+  std::vector<double> widths(Xout.size());
+  std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
+
+  // Take the square root of the errors
+  std::transform(Eout.begin(), Eout.end(), Eout.begin(),
+                 static_cast<double (*)(double)>(std::sqrt));
+
+  // Multiply the data and errors by the bin widths because the rebin
+  // function, when used
+  // in the fashion above for the weights, doesn't put it back in
+  std::transform(Yout.begin(), Yout.end(), widths.begin() + 1, Yout.begin(),
+                 std::multiplies<double>());
+  std::transform(Eout.begin(), Eout.end(), widths.begin() + 1, Eout.begin(),
+                 std::multiplies<double>());
+
+  // Now need to normalise the data (and errors) by the weights
+  const MantidVec &groupWgt = sums.weight;
+  std::transform(Yout.begin(), Yout.end(), groupWgt.begin(), Yout.begin(),
+                 std::divides<double>());
+  std::transform(Eout.begin(), Eout.end(), groupWgt.begin(), Eout.begin(),
+                 std::divides<double>());
+  // Now multiply by the number of spectra in the group
+  std::transform(Yout.begin(), Yout.end(), Yout.begin(),
+                 std::bind2nd(std::multiplies<double>(), groupSize));
+  std::transform(Eout.begin(), Eout.end(), Eout.begin(),
+                 std::bind2nd(std::multiplies<double>(), groupSize));
+}
+
+/// Copy events into out, starting at offset, converting their type
+template <class IN, class OUT>
+void copyEventsAt(const std::vector<IN> &in, std::vector<OUT> &out,
+                  const size_t offset) {
+  std::copy(in.begin(), in.end(), out.begin() + offset);
+}
+
+/**
+ * Copy the events of a list into a slot of a larger list. The slot must
+ * already exist and the output list must be of the same or a more general
+ * event type.
+ * @param in :: The list to copy
+ * @param out :: The list to copy into
+ * @param offset :: The index in out of the first event
+ */
+void copyEventList(const EventList &in, EventList &out, const size_t offset) {
+  switch (out.getEventType()) {
+  case TOF:
+    copyEventsAt(in.getEvents(), out.getEvents(), offset);
+    break;
+  case WEIGHTED:
+    if (in.getEventType() == TOF)
+      copyEventsAt(in.getEvents(), out.getWeightedEvents(), offset);
+    else
+      copyEventsAt(in.getWeightedEvents(), out.getWeightedEvents(), offset);
+    break;
+  case WEIGHTED_NOTIME:
+    if (in.getEventType() == TOF)
+      copyEventsAt(in.getEvents(), out.getWeightedEventsNoTime(), offset);
+    else if (in.getEventType() == WEIGHTED)
+      copyEventsAt(in.getWeightedEvents(), out.getWeightedEventsNoTime(),
+                   offset);
+    else
+      copyEventsAt(in.getWeightedEventsNoTime(), out.getWeightedEventsNoTime(),
+                   offset);
+    break;
+  }
+}
+
+/// Make room in a list for a number of events of its own type
+void resizeEventList(EventList &list, const size_t numEvents) {
+  switch (list.getEventType()) {
+  case TOF:
+    list.getEvents().resize(numEvents);
+    break;
+  case WEIGHTED:
+    list.getWeightedEvents().resize(numEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    list.getWeightedEventsNoTime().resize(numEvents);
+    break;
+  }
+}
+}
+
 /// Constructor
 DiffractionFocussing2::DiffractionFocussing2()
     : API::Algorithm(), udet2group(), groupAtWorkspaceIndex(), group2xvector(),
@@ -165,20 +368,81 @@ void DiffractionFocussing2::exec() {
   // No problem! It is a normal Workspace2D
   API::MatrixWorkspace_sptr out = API::WorkspaceFactory::Instance().create(
       m_matrixInputW, nGroups, nPoints + 1, nPoints);
-  // Caching containers that are either only read from or unused. Initialize
-  // them once.
-  // Helgrind will show a race-condition but the data is completely unused so it
-  // is irrelevant
-  MantidVec weights_default(1, 1.0), emptyVec(1, 0.0), EOutDummy(nPoints);
 
   Progress *prog;
   prog = new API::Progress(this, 0.2, 1.00,
                            static_cast<int>(totalHistProcess) + nGroups);
+
+  const int nValidGroups = static_cast<int>(m_validGroups.size());
+  const int nThreads = PARALLEL_GET_MAX_THREADS;
+  std::vector<GroupSums> groupSums;
+  if (nValidGroups >= nThreads) {
+    // Enough groups to keep every thread busy summing a group of its own
+    groupSums.assign(nValidGroups, GroupSums(nPoints));
+#ifndef __APPLE__
+    PARALLEL_FOR2(m_matrixInputW, out)
+#endif
+    for (int iGroup = 0; iGroup < nValidGroups; ++iGroup) {
+      PARALLEL_START_INTERUPT_REGION
+      const int group = m_validGroups[iGroup];
+      const MantidVec &Xout = *(group2xvector[group]);
+      MantidVec EOutDummy(nPoints);
+      const std::vector<size_t> &indices = m_wsIndices[group];
+      for (size_t i = 0; i < indices.size(); ++i) {
+        addSpectrum(*m_matrixInputW, indices[i], Xout, groupSums[iGroup],
+                    EOutDummy, eventXMin, eventXMax);
+        prog->report();
+      }
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+  } else {
+    // Only a few large groups. Share the spectra out between the threads,
+    // each summing into its own copy of every group, then add the copies
+    // together in pairs.
+    std::vector<std::pair<int, size_t>> spectra;
+    spectra.reserve(totalHistProcess);
+    for (int iGroup = 0; iGroup < nValidGroups; ++iGroup) {
+      const std::vector<size_t> &indices = m_wsIndices[m_validGroups[iGroup]];
+      for (size_t i = 0; i < indices.size(); ++i)
+        spectra.push_back(std::make_pair(iGroup, indices[i]));
+    }
+    std::vector<std::vector<GroupSums>> partialSums(
+        nThreads, std::vector<GroupSums>(nValidGroups, GroupSums(nPoints)));
+    std::vector<MantidVec> EOutDummy(nThreads, MantidVec(nPoints));
+
+    const int64_t nSpectra = static_cast<int64_t>(spectra.size());
+#ifndef __APPLE__
+    PARALLEL_FOR2(m_matrixInputW, out)
+#endif
+    for (int64_t i = 0; i < nSpectra; ++i) {
+      PARALLEL_START_INTERUPT_REGION
+      const int thread = PARALLEL_THREAD_NUMBER;
+      const int iGroup = spectra[i].first;
+      addSpectrum(*m_matrixInputW, spectra[i].second,
+                  *(group2xvector[m_validGroups[iGroup]]),
+                  partialSums[thread][iGroup], EOutDummy[thread], eventXMin,
+                  eventXMax);
+      prog->report();
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+
+    for (int step = 1; step < nThreads; step *= 2) {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int thread = 0; thread < nThreads - step; thread += 2 * step) {
+        for (int iGroup = 0; iGroup < nValidGroups; ++iGroup)
+          partialSums[thread][iGroup] += partialSums[thread + step][iGroup];
+      }
+    }
+    groupSums.swap(partialSums[0]);
+  }
+
+  // Fill in the output spectra
 #ifndef __APPLE__
   PARALLEL_FOR2(m_matrixInputW, out)
 #endif
-  for (int outWorkspaceIndex = 0;
-       outWorkspaceIndex < static_cast<int>(m_validGroups.size());
+  for (int outWorkspaceIndex = 0; outWorkspaceIndex < nValidGroups;
        outWorkspaceIndex++) {
     PARALLEL_START_INTERUPT_REGION
     int group = m_validGroups[outWorkspaceIndex];
@@ -199,122 +463,14 @@ void DiffractionFocussing2::exec() {
     // Also set the spectrum number to the group number
     outSpec->setSpectrumNo(group);
     outSpec->clearDetectorIDs();
+    const std::vector<size_t> &indices = m_wsIndices[group];
+    for (size_t i = 0; i < indices.size(); i++) {
+      outSpec->addDetectorIDs(
+          m_matrixInputW->getSpectrum(indices[i])->getDetectorIDs());
+    }
 
-    // Get the references to Y and E output and rebin
-    MantidVec &Yout = outSpec->dataY();
-    MantidVec &Eout = outSpec->dataE();
-
-    // Initialize the group's weight vector here and the dummy vector used for
-    // accumulating errors.
-    MantidVec groupWgt(nPoints, 0.0);
-
-    // loop through the contributing histograms
-    std::vector<size_t> indices = m_wsIndices[group];
-    const size_t groupSize = indices.size();
-    for (size_t i = 0; i < groupSize; i++) {
-      size_t inWorkspaceIndex = indices[i];
-      // This is the input spectrum
-      const ISpectrum *inSpec = m_matrixInputW->getSpectrum(inWorkspaceIndex);
-      // Get reference to its old X,Y,and E.
-      const MantidVec &Xin = inSpec->readX();
-      const MantidVec &Yin = inSpec->readY();
-      const MantidVec &Ein = inSpec->readE();
-
-      outSpec->addDetectorIDs(inSpec->getDetectorIDs());
-      try {
-        VectorHelper::rebinHistogram(Xin, Yin, Ein, Xout, Yout, Eout, true);
-      } catch (...) {
-        // Should never happen because Xout is constructed to envelop all of the
-        // Xin vectors
-        std::ostringstream mess;
-        mess << "Error in rebinning process for spectrum:" << inWorkspaceIndex;
-        throw std::runtime_error(mess.str());
-      }
-
-      // Check for masked bins in this spectrum
-      if (m_matrixInputW->hasMaskedBins(i)) {
-        MantidVec weight_bins, weights;
-        weight_bins.push_back(Xin.front());
-        // If there are masked bins, get a reference to the list of them
-        const API::MatrixWorkspace::MaskList &mask =
-            m_matrixInputW->maskedBins(i);
-        // Now iterate over the list, adjusting the weights for the affected
-        // bins
-        for (API::MatrixWorkspace::MaskList::const_iterator it = mask.begin();
-             it != mask.end(); ++it) {
-          const double currentX = Xin[(*it).first];
-          // Add an intermediate bin with full weight if masked bins aren't
-          // consecutive
-          if (weight_bins.back() != currentX) {
-            weights.push_back(1.0);
-            weight_bins.push_back(currentX);
-          }
-          // The weight for this masked bin is 1 - the degree to which this bin
-          // is masked
-          weights.push_back(1.0 - (*it).second);
-          weight_bins.push_back(Xin[(*it).first + 1]);
-        }
-        // Add on a final bin with full weight if masking doesn't go up to the
-        // end
-        if (weight_bins.back() != Xin.back()) {
-          weights.push_back(1.0);
-          weight_bins.push_back(Xin.back());
-        }
-
-        // Create a zero vector for the errors because we don't care about them
-        // here
-        const MantidVec zeroes(weights.size(), 0.0);
-        // Rebin the weights - note that this is a distribution
-        VectorHelper::rebin(weight_bins, weights, zeroes, Xout, groupWgt,
-                            EOutDummy, true, true);
-      } else // If no masked bins we want to add 1 to the weight of the output
-             // bins that this input covers
-      {
-        // Initialized within the loop to avoid having to wrap writing to it
-        // with a PARALLEL_CRITICAL sections
-        MantidVec limits(2);
-
-        if (eventXMin > 0. && eventXMax > 0.) {
-          limits[0] = eventXMin;
-          limits[1] = eventXMax;
-        } else {
-          limits[0] = Xin.front();
-          limits[1] = Xin.back();
-        }
-
-        // Rebin the weights - note that this is a distribution
-        VectorHelper::rebin(limits, weights_default, emptyVec, Xout, groupWgt,
-                            EOutDummy, true, true);
-      }
-      prog->report();
-    } // end of loop for input spectra
-
-    // Calculate the bin widths
-    std::vector<double> widths(Xout.size());
-    std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
-
-    // Take the square root of the errors
-    std::transform(Eout.begin(), Eout.end(), Eout.begin(),
-                   static_cast<double (*)(double)>(std::sqrt));
-
-    // Multiply the data and errors by the bin widths because the rebin
-    // function, when used
-    // in the fashion above for the weights, doesn't put it back in
-    std::transform(Yout.begin(), Yout.end(), widths.begin() + 1, Yout.begin(),
-                   std::multiplies<double>());
-    std::transform(Eout.begin(), Eout.end(), widths.begin() + 1, Eout.begin(),
-                   std::multiplies<double>());
-
-    // Now need to normalise the data (and errors) by the weights
-    std::transform(Yout.begin(), Yout.end(), groupWgt.begin(), Yout.begin(),
-                   std::divides<double>());
-    std::transform(Eout.begin(), Eout.end(), groupWgt.begin(), Eout.begin(),
-                   std::divides<double>());
-    // Now multiply by the number of spectra in the group
-    std::transform(Yout.begin(), Yout.end(), Yout.begin(),
-                   std::bind2nd(std::multiplies<double>(), groupSize));
-    std::transform(Eout.begin(), Eout.end(), Eout.begin(),
-                   std::bind2nd(std::multiplies<double>(), groupSize));
+    normaliseGroup(Xout, groupSums[outWorkspaceIndex], indices.size(),
+                   outSpec->dataY(), outSpec->dataE());
 
     prog->report();
     PARALLEL_END_INTERUPT_REGION
@@ -375,103 +531,65 @@ void DiffractionFocussing2::execEvent() {
   delete prog;
   prog = new Progress(this, 0.25, 0.3, totalHistProcess);
 
-  // This creates and reserves the space required
+  // This creates the space required. Each input list is given its own slot
+  // in its group's list, so the lists can be copied without locking.
+  std::vector<size_t> offsets;
+  offsets.reserve(totalHistProcess);
+  std::vector<std::pair<int, size_t>> spectra;
+  spectra.reserve(totalHistProcess);
   for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++) {
     const int group = this->m_validGroups[iGroup];
     EventList &groupEL = out->getOrAddEventList(iGroup);
     groupEL.switchTo(eventWtype);
-    groupEL.reserve(size_required[iGroup]);
+    resizeEventList(groupEL, size_required[iGroup]);
     groupEL.clearDetectorIDs();
     groupEL.setSpectrumNo(group);
-    prog->reportIncrement(1, "Allocating");
+
+    const std::vector<size_t> &indices = this->m_wsIndices[group];
+    std::vector<detid_t> detectorIDs;
+    size_t offset = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const EventList &inputEL = m_eventW->getEventList(indices[i]);
+      spectra.push_back(std::make_pair(static_cast<int>(iGroup), indices[i]));
+      offsets.push_back(offset);
+      offset += inputEL.getNumberEvents();
+      const std::set<detid_t> &ids = inputEL.getDetectorIDs();
+      detectorIDs.insert(detectorIDs.end(), ids.begin(), ids.end());
+    }
+    std::sort(detectorIDs.begin(), detectorIDs.end());
+    groupEL.addDetectorIDs(detectorIDs);
+    prog->reportIncrement(indices.size(), "Allocating");
   }
 
   // ----------- Focus ---------------
   delete prog;
   prog = new Progress(this, 0.3, 0.9, totalHistProcess);
 
-  if (this->m_validGroups.size() == 1) {
-    g_log.information() << "Performing focussing on a single group\n";
-    // Special case of a single group - parallelize differently
-    EventList &groupEL = out->getOrAddEventList(0);
-    const int group = m_validGroups[0];
-    const std::vector<size_t> &indices = this->m_wsIndices[group];
-
-    int chunkSize = 200;
-
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int wiChunk = 0; wiChunk < (totalHistProcess / chunkSize) + 1;
-         wiChunk++) {
-      PARALLEL_START_INTERUPT_REGION
-
-      // Perform in chunks for more efficiency
-      int max = (wiChunk + 1) * chunkSize;
-      if (max > totalHistProcess)
-        max = totalHistProcess;
-
-      // precalculate output size
-      /* size_t numEventsInChunk(0);
-      for (int wi=wiChunk*chunkSize; wi < max; wi++)
-      {
-        const int group = groupAtWorkspaceIndex[wi];
-        if (group == 1)
-        {
-          // Accumulate the chunk
-          numEventsInChunk += eventW->getEventList(wi).getNumberEvents();
-        }
-      } */
-
-      // Make a blank EventList that will accumulate the chunk.
-      EventList chunkEL;
-      chunkEL.switchTo(eventWtype);
-      // chunkEL.reserve(numEventsInChunk);
-
-      // process the chunk
-      for (int i = wiChunk * chunkSize; i < max; i++) {
-        // Accumulate the chunk
-        size_t wi = indices[i];
-        chunkEL += m_eventW->getEventList(wi);
-      }
-
-      // Rejoin the chunk with the rest.
-      PARALLEL_CRITICAL(DiffractionFocussing2_JoinChunks) {
-        groupEL += chunkEL;
-      }
-
-      PARALLEL_END_INTERUPT_REGION
-    }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } else {
-    // ------ PARALLELIZE BY GROUPS -------------------------
-
-    int nValidGroups = static_cast<int>(this->m_validGroups.size());
-    PARALLEL_FOR1(m_eventW)
-    for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
-      PARALLEL_START_INTERUPT_REGION
-      const int group = this->m_validGroups[iGroup];
-      const std::vector<size_t> &indices = this->m_wsIndices[group];
-      for (size_t i = 0; i < indices.size(); i++) {
-        size_t wi = indices[i];
-
-        // In workspace index iGroup, put what was in the OLD workspace index wi
-        out->getOrAddEventList(iGroup) += m_eventW->getEventList(wi);
-
-        prog->reportIncrement(1, "Appending Lists");
-
-        // When focussing in place, you can clear out old memory from the input
-        // one!
-        if (inPlace) {
-          boost::const_pointer_cast<EventWorkspace>(m_eventW)
-              ->getEventList(wi)
-              .clear();
-          Mantid::API::MemoryManager::Instance().releaseFreeMemory();
-        }
-      }
-      PARALLEL_END_INTERUPT_REGION
+  // The spectra are spread over all threads whatever the number of groups
+  const int nSpectra = static_cast<int>(spectra.size());
+  // cppcheck-suppress syntaxError
+  PRAGMA_OMP(parallel for schedule(dynamic, 100) )
+  for (int i = 0; i < nSpectra; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t wi = spectra[i].second;
+    // In workspace index iGroup, put what was in the OLD workspace index wi
+    copyEventList(m_eventW->getEventList(wi),
+                  out->getEventList(spectra[i].first), offsets[i]);
+    prog->reportIncrement(1, "Appending Lists");
+
+    // When focussing in place, you can clear out old memory from the input
+    // one!
+    if (inPlace) {
+      boost::const_pointer_cast<EventWorkspace>(m_eventW)
+          ->getEventList(wi)
+          .clear();
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } // (done with parallel by groups)
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+  if (inPlace) {
+    Mantid::API::MemoryManager::Instance().releaseFreeMemory();
+  }
 
   // Now that the data is cleaned up, go through it and set the X vectors to the
   // input workspace we first talked about.
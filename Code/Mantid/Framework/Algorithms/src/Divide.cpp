@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/Divide.h"
 #include "MantidDataObjects/WorkspaceSingleValue.h"
+#include "MantidKernel/SIMD.h"
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -13,6 +14,41 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(Divide)
 
+namespace {
+/// Per-bin kernel for dividing two uncorrelated values
+struct DivideKernel {
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    //  error dividing two uncorrelated numbers, re-arrange so that you don't
+    //  get infinity if leftY==0 (when rightY=0 the Y value and the result will
+    //  both be infinity)
+    // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
+    // (Sa c/a)2 + (Sb c/b)2 = (Sc)2
+    // = (Sa 1/b)2 + (Sb (a/b2))2
+    // (Sc)2 = (1/b)2( (Sa)2 + (Sb a/b)2 )
+    const double b = lhsY * rhsE / rhsY;
+    EOut = std::sqrt(lhsE * lhsE + b * b) / std::fabs(rhsY);
+    YOut = lhsY / rhsY;
+  }
+};
+
+/// Per-bin kernel for dividing by a single value
+struct DivideByValueKernel {
+  /// @param rhsFactor :: (rhsE/rhsY)^2, calculated once
+  explicit DivideByValueKernel(const double rhsFactor)
+      : m_rhsFactor(rhsFactor) {}
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double, double &YOut,
+                         double &EOut) const {
+    // see comment in DivideKernel for the error formula
+    EOut = std::sqrt(lhsE * lhsE + lhsY * lhsY * m_rhsFactor) / std::fabs(rhsY);
+    YOut = lhsY / rhsY;
+  }
+  const double m_rhsFactor;
+};
+}
+
 void Divide::init() {
   BinaryOperation::init();
   declareProperty("WarnOnZeroDivide", true, "Algorithm usually warns if "
@@ -33,29 +69,7 @@ void Divide::performBinaryOperation(const MantidVec &lhsX,
                                     const MantidVec &rhsE, MantidVec &YOut,
                                     MantidVec &EOut) {
   (void)lhsX; // Avoid compiler warning
-
-  const int bins = static_cast<int>(lhsE.size());
-
-  for (int j = 0; j < bins; ++j) {
-    // Get references to the input Y's
-    const double leftY = lhsY[j];
-    const double rightY = rhsY[j];
-
-    //  error dividing two uncorrelated numbers, re-arrange so that you don't
-    //  get infinity if leftY==0 (when rightY=0 the Y value and the result will
-    //  both be infinity)
-    // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
-    // (Sa c/a)2 + (Sb c/b)2 = (Sc)2
-    // = (Sa 1/b)2 + (Sb (a/b2))2
-    // (Sc)2 = (1/b)2( (Sa)2 + (Sb a/b)2 )
-    EOut[j] =
-        sqrt(pow(lhsE[j], 2) + pow(leftY * rhsE[j] / rightY, 2)) / fabs(rightY);
-
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY / rightY;
-    ;
-  }
+  SIMD::binary(DivideKernel(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
 }
 
 void Divide::performBinaryOperation(const MantidVec &lhsX,
@@ -72,17 +86,8 @@ void Divide::performBinaryOperation(const MantidVec &lhsX,
 
   // Do the right-hand part of the error calculation just once
   const double rhsFactor = pow(rhsE / rhsY, 2);
-  const int bins = static_cast<int>(lhsE.size());
-  for (int j = 0; j < bins; ++j) {
-    // Get reference to input Y
-    const double leftY = lhsY[j];
-
-    // see comment in the function above for the error formula
-    EOut[j] = sqrt(pow(lhsE[j], 2) + pow(leftY, 2) * rhsFactor) / fabs(rhsY);
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY / rhsY;
-  }
+  SIMD::binary(DivideByValueKernel(rhsFactor), lhsY, lhsE, rhsY, rhsE, YOut,
+               EOut);
 }
 
 void Divide::setOutputUnits(const API::MatrixWorkspace_const_sptr lhs,
@@ -2,6 +2,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/Exponential.h"
+#include "MantidKernel/SIMD.h"
 #include <math.h>
 
 using namespace Mantid::API;
@@ -12,15 +13,32 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(Exponential)
 
+namespace {
+/// Per-bin kernel
+struct ExponentialKernel {
+  inline void operator()(const double, const double YIn, const double EIn,
+                         double &YOut, double &EOut) const {
+    // Multiply the data and error by the correction factor
+    YOut = exp(YIn);
+    EOut = EIn * YOut;
+  }
+};
+}
+
 Exponential::Exponential() : UnaryOperation() { this->useHistogram = true; }
 
 void Exponential::performUnaryOperation(const double XIn, const double YIn,
                                         const double EIn, double &YOut,
                                         double &EOut) {
-  (void)XIn; // Avoid compiler warning
-  // Multiply the data and error by the correction factor
-  YOut = exp(YIn);
-  EOut = EIn * YOut;
+  ExponentialKernel()(XIn, YIn, EIn, YOut, EOut);
+}
+
+void Exponential::performUnaryOperationOnSpectrum(const MantidVec &X,
+                                                  const MantidVec &YIn,
+                                                  const MantidVec &EIn,
+                                                  MantidVec &YOut,
+                                                  MantidVec &EOut) {
+  SIMD::unary(ExponentialKernel(), X, YIn, EIn, YOut, EOut);
 }
 
 /*
@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/ExponentialCorrection.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/SIMD.h"
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -12,6 +13,28 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(ExponentialCorrection)
 
+namespace {
+/// Per-bin kernel
+struct ExponentialCorrectionKernel {
+  ExponentialCorrectionKernel(const double c0, const double c1,
+                              const bool divide)
+      : m_c0(c0), m_c1(c1), m_divide(divide) {}
+  inline void operator()(const double XIn, const double YIn, const double EIn,
+                         double &YOut, double &EOut) const {
+    double factor = m_c0 * exp(-1.0 * m_c1 * XIn);
+    if (m_divide)
+      factor = 1.0 / factor;
+
+    // Multiply the data and error by the correction factor
+    YOut = YIn * factor;
+    EOut = EIn * factor;
+  }
+  const double m_c0;
+  const double m_c1;
+  const bool m_divide;
+};
+}
+
 void ExponentialCorrection::defineProperties() {
   declareProperty(
       "C0", 1.0,
@@ -45,13 +68,14 @@ void ExponentialCorrection::performUnaryOperation(const double XIn,
                                                   const double YIn,
                                                   const double EIn,
                                                   double &YOut, double &EOut) {
-  double factor = m_c0 * exp(-1.0 * m_c1 * XIn);
-  if (m_divide)
-    factor = 1.0 / factor;
+  ExponentialCorrectionKernel(m_c0, m_c1, m_divide)(XIn, YIn, EIn, YOut, EOut);
+}
 
-  // Multiply the data and error by the correction factor
-  YOut = YIn * factor;
-  EOut = EIn * factor;
+void ExponentialCorrection::performUnaryOperationOnSpectrum(
+    const MantidVec &X, const MantidVec &YIn, const MantidVec &EIn,
+    MantidVec &YOut, MantidVec &EOut) {
+  SIMD::unary(ExponentialCorrectionKernel(m_c0, m_c1, m_divide), X, YIn, EIn,
+              YOut, EOut);
 }
 
 } // namespace Algorithms
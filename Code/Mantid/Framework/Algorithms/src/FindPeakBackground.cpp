@@ -1,5 +1,5 @@
 #include "MantidAlgorithms/FindPeakBackground.h"
-#include "MantidAlgorithms/FindPeaks.h"
+#include "MantidAlgorithms/FitPeak.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/WorkspaceFactory.h"
@@ -111,9 +111,8 @@ void FindPeakBackground::exec() {
   size_t l0 = 0;
 
   if (m_vecFitWindows.size() > 1) {
-    Mantid::Algorithms::FindPeaks fp;
-    l0 = fp.getVectorIndex(inpX, m_vecFitWindows[0]);
-    n = fp.getVectorIndex(inpX, m_vecFitWindows[1]);
+    l0 = getVectorIndex(inpX, m_vecFitWindows[0]);
+    n = getVectorIndex(inpX, m_vecFitWindows[1]);
     if (n < sizey)
       n++;
   }
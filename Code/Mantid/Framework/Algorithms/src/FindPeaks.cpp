@@ -40,7 +40,9 @@ DECLARE_ALGORITHM(FindPeaks)
   */
 FindPeaks::FindPeaks()
     : API::Algorithm(), m_peakParameterNames(), m_bkgdParameterNames(),
-      m_bkgdOrder(0), m_outPeakTableWS(), m_progress(NULL), m_dataWS(),
+      m_bkgdOrder(0), m_outPeakTableWS(), m_firstSpectrum(0),
+      m_spectrumPeaks(), m_fitContexts(), m_fitContextTypes(),
+      m_progress(NULL), m_dataWS(),
       m_inputPeakFWHM(0), m_wsIndex(0), singleSpectrum(false),
       m_highBackground(false), m_rawPeaksTable(false), m_numTableParams(0),
       m_peakFuncType(""), m_backgroundType(""), m_vecPeakCentre(),
@@ -185,6 +187,15 @@ void FindPeaks::exec() {
   // Set up output table workspace
   generateOutputPeakParameterTable();
 
+  // The peak fitting objects of a previous execution are kept as long as they
+  // are for the same functions
+  std::string functiontypes = m_peakFuncType + "," + m_backgroundType;
+  if (functiontypes != m_fitContextTypes) {
+    m_fitContexts.clear();
+    m_fitContextTypes = functiontypes;
+  }
+  m_fitContexts.resize(static_cast<size_t>(PARALLEL_GET_MAX_THREADS));
+
   // Fit
   if (!m_vecPeakCentre.empty()) {
     if (!m_vecFitWindows.empty()) {
@@ -201,6 +212,7 @@ void FindPeaks::exec() {
     m_usePeakPositionTolerance = false;
     this->findPeaksUsingMariscotti();
   }
+  writeOutputPeakTable();
 
   // Set output properties
   g_log.information() << "Total " << m_outPeakTableWS->rowCount()
@@ -334,9 +346,18 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
   const int end = singleSpectrum
                       ? m_wsIndex + 1
                       : static_cast<int>(m_dataWS->getNumberHistograms());
+  delete m_progress;
   m_progress = new Progress(this, 0.0, 1.0, end - start);
+  m_firstSpectrum = start;
+  m_spectrumPeaks.assign(static_cast<size_t>(end - start),
+                         std::vector<double>());
 
+  PARALLEL_FOR1(m_dataWS)
   for (int spec = start; spec < end; ++spec) {
+    PARALLEL_START_INTERUPT_REGION
+
+    PeakFitContext &context = getFitContext();
+    resetFitContext(context);
     const MantidVec &vecX = m_dataWS->readX(spec);
 
     for (std::size_t ipeak = 0; ipeak < numPeaks; ipeak++) {
@@ -354,8 +375,8 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
       // Check whether it is the in data range
       if (x_center > vecX.front() && x_center < vecX.back()) {
         if (useWindows)
-          fitPeakInWindow(m_dataWS, spec, x_center, fitwindows[2 * ipeak],
-                          fitwindows[2 * ipeak + 1]);
+          fitPeakInWindow(context, m_dataWS, spec, x_center,
+                          fitwindows[2 * ipeak], fitwindows[2 * ipeak + 1]);
         else {
           bool hasLeftPeak = (ipeak > 0);
           double leftpeakcentre = 0.;
@@ -367,7 +388,7 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
           if (hasRightPeak)
             rightpeakcentre = peakcentres[ipeak + 1];
 
-          fitPeakGivenFWHM(m_dataWS, spec, x_center, m_inputPeakFWHM,
+          fitPeakGivenFWHM(context, m_dataWS, spec, x_center, m_inputPeakFWHM,
                            hasLeftPeak, leftpeakcentre, hasRightPeak,
                            rightpeakcentre);
         }
@@ -381,7 +402,9 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
 
     m_progress->report();
 
+    PARALLEL_END_INTERUPT_REGION
   } // loop over spectra
+  PARALLEL_CHECK_INTERUPT_REGION
 }
 
 //----------------------------------------------------------------------------------------------
@@ -420,10 +443,19 @@ void FindPeaks::findPeaksUsingMariscotti() {
   const int end = singleSpectrum
                       ? m_wsIndex + 1
                       : static_cast<int>(smoothedData->getNumberHistograms());
+  delete m_progress;
   m_progress = new Progress(this, 0.0, 1.0, end - start);
+  m_firstSpectrum = start;
+  m_spectrumPeaks.assign(static_cast<size_t>(end - start),
+                         std::vector<double>());
   const int blocksize = static_cast<int>(smoothedData->blocksize());
 
+  PARALLEL_FOR2(m_dataWS, smoothedData)
   for (int k = start; k < end; ++k) {
+    PARALLEL_START_INTERUPT_REGION
+
+    PeakFitContext &context = getFitContext();
+    resetFitContext(context);
     const MantidVec &S = smoothedData->readY(k);
     const MantidVec &F = smoothedData->readE(k);
 
@@ -569,7 +601,7 @@ void FindPeaks::findPeaksUsingMariscotti() {
         if (i_max >= wssize)
           i_max = wssize - 1;
 
-        this->fitSinglePeak(m_dataWS, k, i_min, i_max, i4);
+        this->fitSinglePeak(context, m_dataWS, k, i_min, i_max, i4);
 
         // reset and go searching for the next peak
         i1 = 0, i2 = 0, i3 = 0, i4 = 0, i5 = 0;
@@ -579,7 +611,9 @@ void FindPeaks::findPeaksUsingMariscotti() {
 
     m_progress->report();
 
+    PARALLEL_END_INTERUPT_REGION
   } // loop over spectra
+  PARALLEL_CHECK_INTERUPT_REGION
 }
 
 //----------------------------------------------------------------------------------------------
@@ -789,7 +823,8 @@ int FindPeaks::getVectorIndex(const MantidVec &vecX, double x) {
   *right
   *  @param rightpeakcentre :: centre of the right peak if existed
   */
-void FindPeaks::fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
+void FindPeaks::fitPeakGivenFWHM(PeakFitContext &context,
+                                 const API::MatrixWorkspace_sptr &input,
                                  const int spectrum, const double center_guess,
                                  const int fitWidth, const bool hasleftpeak,
                                  const double leftpeakcentre,
@@ -839,7 +874,7 @@ void FindPeaks::fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
         << ", " << vecX[i_max];
   g_log.information(outss.str());
 
-  fitSinglePeak(input, spectrum, i_min, i_max, i_centre);
+  fitSinglePeak(context, input, spectrum, i_min, i_max, i_centre);
 
   return;
 }
@@ -855,7 +890,8 @@ void FindPeaks::fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
   *  @param xmin    Minimum x value to find the peak
   *  @param xmax    Maximum x value to find the peak
   */
-void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
+void FindPeaks::fitPeakInWindow(PeakFitContext &context,
+                                const API::MatrixWorkspace_sptr &input,
                                 const int spectrum, const double centre_guess,
                                 const double xmin, const double xmax) {
   // Check
@@ -895,7 +931,7 @@ void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
   }
 
   // finally do the actual fit
-  fitSinglePeak(input, spectrum, i_min, i_max, i_centre);
+  fitSinglePeak(context, input, spectrum, i_min, i_max, i_centre);
 
   return;
 }
@@ -904,9 +940,12 @@ void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
 /** Fit a single peak
   * This is the fundametary peak fit function used by all kinds of input
   */
-void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
+void FindPeaks::fitSinglePeak(PeakFitContext &context,
+                              const API::MatrixWorkspace_sptr &input,
                               const int spectrum, const int i_min,
                               const int i_max, const int i_centre) {
+  const IPeakFunction_sptr &peakfunction = context.peakFunction;
+  const IBackgroundFunction_sptr &bkgdfunction = context.backgroundFunction;
   const MantidVec &vecX = input->readX(spectrum);
   const MantidVec &vecY = input->readY(spectrum);
 
@@ -939,8 +978,8 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
   // Estimate background
   std::vector<double> vecbkgdparvalue(3, 0.);
   std::vector<double> vecpeakrange(3, 0.);
-  bool usefpdresult = findPeakBackground(input, spectrum, i_min, i_max,
-                                         vecbkgdparvalue, vecpeakrange);
+  bool usefpdresult = findPeakBackground(context, input, spectrum, i_min,
+                                         i_max, vecbkgdparvalue, vecpeakrange);
   if (!usefpdresult) {
     // Estimate background roughly for a failed case
     estimateBackground(vecX, vecY, i_min, i_max, vecbkgdparvalue);
@@ -948,7 +987,7 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
 
   for (size_t i = 0; i < vecbkgdparvalue.size(); ++i)
     if (i < m_bkgdOrder)
-      m_backgroundFunction->setParameter(i, vecbkgdparvalue[i]);
+      bkgdfunction->setParameter(i, vecbkgdparvalue[i]);
 
   // Estimate peak parameters
   double est_height(0.0), est_fwhm(0.0);
@@ -967,11 +1006,11 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
 
   // Set peak parameters to
   if (m_useObsCentre)
-    m_peakFunction->setCentre(vecX[i_obscentre]);
+    peakfunction->setCentre(vecX[i_obscentre]);
   else
-    m_peakFunction->setCentre(vecX[i_centre]);
-  m_peakFunction->setHeight(est_height);
-  m_peakFunction->setFwhm(est_fwhm);
+    peakfunction->setCentre(vecX[i_centre]);
+  peakfunction->setHeight(est_height);
+  peakfunction->setFwhm(est_fwhm);
 
   if (!usefpdresult) {
     // Estimate peak range based on estimated linear background and peak
@@ -990,13 +1029,13 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
   fitwindow[1] = vecX[i_max];
 
   double costfuncvalue =
-      callFitPeak(input, spectrum, m_peakFunction, m_backgroundFunction,
+      callFitPeak(context, input, spectrum, peakfunction, bkgdfunction,
                   fitwindow, vecpeakrange, m_minGuessedPeakWidth,
                   m_maxGuessedPeakWidth, m_stepGuessedPeakWidth);
 
   bool fitsuccess = false;
   if (costfuncvalue < DBL_MAX && costfuncvalue >= 0. &&
-      m_peakFunction->height() > m_minHeight)
+      peakfunction->height() > m_minHeight)
     fitsuccess = true;
 
   //-------------------------------------------------------------------------
@@ -1004,7 +1043,7 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
   //-------------------------------------------------------------------------
   // Update output
   if (fitsuccess)
-    addInfoRow(spectrum, m_peakFunction, m_backgroundFunction, m_rawPeaksTable,
+    addInfoRow(spectrum, peakfunction, bkgdfunction, m_rawPeaksTable,
                costfuncvalue);
   else
     addNonFitRecord(spectrum);
@@ -1016,14 +1055,15 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
 /** Find peak background given a certain range by
   * calling algorithm "FindPeakBackground"
   */
-bool FindPeaks::findPeakBackground(const MatrixWorkspace_sptr &input,
+bool FindPeaks::findPeakBackground(PeakFitContext &context,
+                                   const MatrixWorkspace_sptr &input,
                                    int spectrum, size_t i_min, size_t i_max,
                                    std::vector<double> &vecBkgdParamValues,
                                    std::vector<double> &vecpeakrange) {
   const MantidVec &vecX = input->readX(spectrum);
 
   // Call FindPeakBackground
-  IAlgorithm_sptr estimate = createChildAlgorithm("FindPeakBackground");
+  IAlgorithm_sptr estimate = context.findPeakBackground;
   estimate->setProperty("InputWorkspace", input);
   estimate->setProperty("WorkspaceIndex", spectrum);
   // estimate->setProperty("SigmaConstant", 1.0);
@@ -1358,7 +1398,8 @@ void FindPeaks::estimatePeakRange(const MantidVec &vecX, size_t i_centre,
 }
 
 //----------------------------------------------------------------------------------------------
-/** Add a row to the output table workspace.
+/** Add the parameters of a fitted peak to the peaks of its spectrum, which
+  * become a row of the output table workspace.
   * @param spectrum :: spectrum number
   * @param peakfunction :: peak function
   * @param bkgdfunction :: background function
@@ -1376,11 +1417,10 @@ void FindPeaks::addInfoRow(const size_t spectrum,
                              "method should not be called "
                              "under this circumstance. ");
 
-  // Add fitted parameters to output table workspace
-  API::TableRow t = m_outPeakTableWS->appendRow();
-
-  // spectrum
-  t << static_cast<int>(spectrum);
+  // Add fitted parameters to the peaks of the spectrum.  They are written to
+  // the output table workspace by writeOutputPeakTable()
+  std::vector<double> &t =
+      m_spectrumPeaks[spectrum - static_cast<size_t>(m_firstSpectrum)];
 
   // peak and background function parameters
   if (isoutputraw) {
@@ -1388,16 +1428,15 @@ void FindPeaks::addInfoRow(const size_t spectrum,
     size_t nparams = peakfunction->nParams();
     size_t nparamsb = bkgdfunction->nParams();
 
-    size_t numcols = m_outPeakTableWS->columnCount();
-    if (nparams + nparamsb + 2 != numcols) {
+    if (nparams + nparamsb != m_numTableParams) {
       throw std::runtime_error("Error 1307 number of columns do not matches");
     }
 
     for (size_t i = 0; i < nparams; ++i) {
-      t << peakfunction->getParameter(i);
+      t.push_back(peakfunction->getParameter(i));
     }
     for (size_t i = 0; i < nparamsb; ++i) {
-      t << bkgdfunction->getParameter(i);
+      t.push_back(bkgdfunction->getParameter(i));
     }
   } else {
     // Output of effective peak parameters
@@ -1406,7 +1445,9 @@ void FindPeaks::addInfoRow(const size_t spectrum,
     double fwhm = peakfunction->fwhm();
     double height = peakfunction->height();
 
-    t << peakcentre << fwhm << height;
+    t.push_back(peakcentre);
+    t.push_back(fwhm);
+    t.push_back(height);
 
     // Set up parameters to background function
 
@@ -1420,32 +1461,50 @@ void FindPeaks::addInfoRow(const size_t spectrum,
         bkgdfunction->name() != "FlatBackground")
       a2 = bkgdfunction->getParameter("A2");
 
-    t << a0 << a1 << a2;
+    t.push_back(a0);
+    t.push_back(a1);
+    t.push_back(a2);
   }
 
   // Minimum cost function value
-  t << mincost;
+  t.push_back(mincost);
 
   return;
 }
 
 //----------------------------------------------------------------------------------------------
-/** Add the fit record (failure) to output workspace
+/** Add the fit record (failure) to the peaks of a spectrum
   * @param spectrum :: spectrum where the peak is
   */
 void FindPeaks::addNonFitRecord(const size_t spectrum) {
-  // Add a new row
-  API::TableRow t = m_outPeakTableWS->appendRow();
-
-  // 1st column
-  t << static_cast<int>(spectrum);
+  std::vector<double> &t =
+      m_spectrumPeaks[spectrum - static_cast<size_t>(m_firstSpectrum)];
 
   // Parameters
-  for (std::size_t i = 0; i < m_numTableParams; i++)
-    t << 0.;
+  t.insert(t.end(), m_numTableParams, 0.);
 
   // HUGE chi-square
-  t << DBL_MAX;
+  t.push_back(DBL_MAX);
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Write the peaks of all the spectra searched to the output table workspace,
+  * in the order of the spectra
+  */
+void FindPeaks::writeOutputPeakTable() {
+  const size_t rowsize = m_numTableParams + 1;
+  for (size_t i = 0; i < m_spectrumPeaks.size(); ++i) {
+    const std::vector<double> &peaks = m_spectrumPeaks[i];
+    for (size_t j = 0; j + rowsize <= peaks.size(); j += rowsize) {
+      API::TableRow t = m_outPeakTableWS->appendRow();
+      t << m_firstSpectrum + static_cast<int>(i);
+      for (size_t k = 0; k < rowsize; ++k)
+        t << peaks[j + k];
+    }
+  }
+  m_spectrumPeaks.clear();
 
   return;
 }
@@ -1481,11 +1540,50 @@ void FindPeaks::createFunctions() {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Get the peak fitting objects of the calling thread.  They are created on the
+  * first call from a thread, with copies of the functions created by
+  * createFunctions().
+  * @return :: peak fitting objects
+  */
+FindPeaks::PeakFitContext &FindPeaks::getFitContext() {
+  boost::shared_ptr<PeakFitContext> &context =
+      m_fitContexts[static_cast<size_t>(PARALLEL_THREAD_NUMBER)];
+  if (!context) {
+    context = boost::make_shared<PeakFitContext>();
+    context->peakFunction =
+        boost::dynamic_pointer_cast<IPeakFunction>(m_peakFunction->clone());
+    context->backgroundFunction = boost::dynamic_pointer_cast<
+        IBackgroundFunction>(m_backgroundFunction->clone());
+    context->fitPeak = boost::make_shared<FitOneSinglePeak>();
+    context->findPeakBackground = createChildAlgorithm("FindPeakBackground");
+  }
+
+  return *context;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Set the parameters of the functions of a context to the values of the
+  * functions created by createFunctions().  Each spectrum starts from these
+  * values so that the result does not depend on which thread fits it.
+  * @param context :: peak fitting objects
+  */
+void FindPeaks::resetFitContext(PeakFitContext &context) {
+  for (size_t i = 0; i < m_peakFunction->nParams(); ++i)
+    context.peakFunction->setParameter(i, m_peakFunction->getParameter(i));
+  for (size_t i = 0; i < m_backgroundFunction->nParams(); ++i)
+    context.backgroundFunction->setParameter(
+        i, m_backgroundFunction->getParameter(i));
+
+  return;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Fit a single peak function with background by calling algorithm callFitPeak
   */
 double
-FindPeaks::callFitPeak(const MatrixWorkspace_sptr &dataws, int wsindex,
+FindPeaks::callFitPeak(PeakFitContext &context,
+                       const MatrixWorkspace_sptr &dataws, int wsindex,
                        const API::IPeakFunction_sptr peakfunction,
                        const API::IBackgroundFunction_sptr backgroundfunction,
                        const std::vector<double> &vec_fitwindow,
@@ -1497,10 +1595,11 @@ FindPeaks::callFitPeak(const MatrixWorkspace_sptr &dataws, int wsindex,
        << " of spectrum " << wsindex;
   g_log.information(dbss.str());
 
-  double userFWHM = m_peakFunction->fwhm();
+  double userFWHM = peakfunction->fwhm();
   bool fitwithsteppedfwhm = (guessedFWHMStep > 0);
 
-  FitOneSinglePeak fitpeak;
+  FitOneSinglePeak &fitpeak = *context.fitPeak;
+  fitpeak.resetFitResult();
   fitpeak.setWorskpace(dataws, wsindex);
   fitpeak.setFitWindow(vec_fitwindow[0], vec_fitwindow[1]);
   fitpeak.setFittingMethod(m_minimizer, m_costFunction);
@@ -40,7 +40,7 @@ namespace Algorithms {
 FitOneSinglePeak::FitOneSinglePeak()
     : m_fitMethodSet(false), m_peakRangeSet(false), m_peakWidthSet(false),
       m_peakWindowSet(false), m_usePeakPositionTolerance(false), m_wsIndex(0),
-      m_numFitCalls(0), m_sstream("") {}
+      m_numFitCalls(0), m_sstream(""), m_fitSD(), m_fitMD() {}
 
 //----------------------------------------------------------------------------------------------
 /** Destructor for FitOneSinglePeak
@@ -288,6 +288,23 @@ bool FitOneSinglePeak::hasSetupToFitPeak(std::string &errmsg) {
   */
 std::string FitOneSinglePeak::getDebugMessage() { return m_sstream.str(); }
 
+//----------------------------------------------------------------------------------------------
+/** Clear the result and the debug messages before the object is set up for the
+  * next peak
+  */
+void FitOneSinglePeak::resetFitResult() {
+  m_sstream.str("");
+  m_numFitCalls = 0;
+  m_bestRwp = DBL_MAX;
+  m_finalGoodnessValue = DBL_MAX;
+  m_bestPeakFunc.clear();
+  m_bestBkgdFunc.clear();
+  m_fitErrorPeakFunc.clear();
+  m_fitErrorBkgdFunc.clear();
+
+  return;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Fit peak with simple schemem
   */
@@ -639,15 +656,7 @@ double FitOneSinglePeak::fitFunctionSD(IFunction_sptr fitfunc,
   }
 
   // Set up sub algorithm fit
-  IAlgorithm_sptr fit;
-  try {
-    fit = createChildAlgorithm("Fit", -1, -1, false);
-  } catch (Exception::NotFoundError &) {
-    std::stringstream errss;
-    errss << "The FitPeak algorithm requires the CurveFitting library";
-    g_log.error(errss.str());
-    throw std::runtime_error(errss.str());
-  }
+  IAlgorithm_sptr fit = getFitAlgorithm(false);
 
   // Set the properties
   fit->setProperty("Function", fitfunc);
@@ -709,15 +718,7 @@ double FitOneSinglePeak::fitFunctionMD(IFunction_sptr fitfunc,
     throw runtime_error("Sizes of xmin and xmax (vectors) are not equal. ");
 
   // Set up sub algorithm fit
-  IAlgorithm_sptr fit;
-  try {
-    fit = createChildAlgorithm("Fit", -1, -1, true);
-  } catch (Exception::NotFoundError &) {
-    std::stringstream errss;
-    errss << "The FitPeak algorithm requires the CurveFitting library";
-    g_log.error(errss.str());
-    throw std::runtime_error(errss.str());
-  }
+  IAlgorithm_sptr fit = getFitAlgorithm(true);
 
   // This use multi-domain; but does not know how to set up
   boost::shared_ptr<MultiDomainFunction> funcmd =
@@ -773,6 +774,29 @@ double FitOneSinglePeak::fitFunctionMD(IFunction_sptr fitfunc,
   return chi2;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Get the Fit child algorithm to use.  It is created on the first call and
+  * reused afterwards, as creating and initializing an algorithm costs more
+  * than most of the small fits done here.
+  * @param multidomain :: flag to get the algorithm for multiple domain fits
+  * @return :: Fit algorithm
+  */
+IAlgorithm_sptr FitOneSinglePeak::getFitAlgorithm(bool multidomain) {
+  IAlgorithm_sptr &fit = multidomain ? m_fitMD : m_fitSD;
+  if (!fit) {
+    try {
+      fit = createChildAlgorithm("Fit", -1, -1, multidomain);
+    } catch (Exception::NotFoundError &) {
+      std::stringstream errss;
+      errss << "The FitPeak algorithm requires the CurveFitting library";
+      g_log.error(errss.str());
+      throw std::runtime_error(errss.str());
+    }
+  }
+
+  return fit;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Fit peak function and background function as composite function
   * @param peakfunc :: peak function to fit
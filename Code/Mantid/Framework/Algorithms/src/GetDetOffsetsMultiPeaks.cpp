@@ -473,6 +473,8 @@ void GetDetOffsetsMultiPeaks::calculateDetectorsOffsets() {
 
   // Fit all the spectra with a gaussian
   Progress prog(this, 0, 1.0, nspec);
+  m_peakFinders.assign(static_cast<size_t>(PARALLEL_GET_MAX_THREADS),
+                       API::IAlgorithm_sptr());
 
   // cppcheck-suppress syntaxError
     PRAGMA_OMP(parallel for schedule(dynamic, 1) )
@@ -541,6 +543,7 @@ void GetDetOffsetsMultiPeaks::calculateDetectorsOffsets() {
       PARALLEL_END_INTERUPT_REGION
     }
     PARALLEL_CHECK_INTERUPT_REGION
+    m_peakFinders.clear();
 
     return;
 }
@@ -874,9 +877,12 @@ int GetDetOffsetsMultiPeaks::fitSpectra(
     return 0;
   }
 
-  // Fit peaks
-  API::IAlgorithm_sptr findpeaks =
-      createChildAlgorithm("FindPeaks", -1, -1, false);
+  // Fit peaks.  Each thread reuses one FindPeaks, which keeps its peak fitting
+  // objects from one spectrum to the next
+  API::IAlgorithm_sptr &findpeaks =
+      m_peakFinders[static_cast<size_t>(PARALLEL_THREAD_NUMBER)];
+  if (!findpeaks)
+    findpeaks = createChildAlgorithm("FindPeaks", -1, -1, false);
   findpeaks->setProperty("InputWorkspace", inputW);
   findpeaks->setProperty<int>("FWHM", 7);
   findpeaks->setProperty<int>("Tolerance", 4);
@@ -885,8 +891,9 @@ int GetDetOffsetsMultiPeaks::fitSpectra(
 
   // Get the specified peak positions, which is optional
   findpeaks->setProperty("PeakPositions", peakPosToFit);
-  if (useFitWindows)
-    findpeaks->setProperty("FitWindows", fitWindowsToUse);
+  // The FitWindows of the previous spectrum must not be left in place
+  findpeaks->setProperty("FitWindows", useFitWindows ? fitWindowsToUse
+                                                     : std::vector<double>());
   findpeaks->setProperty<std::string>("PeakFunction", m_peakType);
   findpeaks->setProperty<std::string>("BackgroundType", m_backType);
   findpeaks->setProperty<bool>("HighBackground",
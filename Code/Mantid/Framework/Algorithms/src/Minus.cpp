@@ -2,7 +2,9 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/Minus.h"
-#include "MantidKernel/VectorHelper.h"
+#include "MantidKernel/SIMD.h"
+
+#include <cmath>
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -12,6 +14,25 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(Minus)
 
+namespace {
+/// Per-bin kernel: the errors add in quadrature
+struct MinusKernel {
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    YOut = lhsY - rhsY;
+    EOut = std::sqrt(lhsE * lhsE + rhsE * rhsE);
+  }
+};
+
+/// Subtracts a constant
+struct SubtractValue {
+  explicit SubtractValue(const double value) : m_value(value) {}
+  inline double operator()(const double y) const { return y - m_value; }
+  const double m_value;
+};
+}
+
 const std::string Minus::alias() const { return "Subtract"; }
 
 void Minus::performBinaryOperation(const MantidVec &lhsX, const MantidVec &lhsY,
@@ -19,10 +40,7 @@ void Minus::performBinaryOperation(const MantidVec &lhsX, const MantidVec &lhsY,
                                    const MantidVec &rhsE, MantidVec &YOut,
                                    MantidVec &EOut) {
   (void)lhsX; // Avoid compiler warning
-  std::transform(lhsY.begin(), lhsY.end(), rhsY.begin(), YOut.begin(),
-                 std::minus<double>());
-  std::transform(lhsE.begin(), lhsE.end(), rhsE.begin(), EOut.begin(),
-                 VectorHelper::SumGaussError<double>());
+  SIMD::binary(MinusKernel(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
 }
 
 void Minus::performBinaryOperation(const MantidVec &lhsX, const MantidVec &lhsY,
@@ -30,14 +48,13 @@ void Minus::performBinaryOperation(const MantidVec &lhsX, const MantidVec &lhsY,
                                    const double rhsE, MantidVec &YOut,
                                    MantidVec &EOut) {
   (void)lhsX; // Avoid compiler warning
-  std::transform(lhsY.begin(), lhsY.end(), YOut.begin(),
-                 std::bind2nd(std::minus<double>(), rhsY));
   // Only do E if non-zero, otherwise just copy
-  if (rhsE != 0)
-    std::transform(lhsE.begin(), lhsE.end(), EOut.begin(),
-                   std::bind2nd(VectorHelper::SumGaussError<double>(), rhsE));
-  else
+  if (rhsE != 0) {
+    SIMD::binary(MinusKernel(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
+  } else {
+    SIMD::transform(lhsY, YOut, SubtractValue(rhsY));
     EOut = lhsE;
+  }
 }
 
 // ===================================== EVENT LIST BINARY OPERATIONS
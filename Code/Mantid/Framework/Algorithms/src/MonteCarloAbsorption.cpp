@@ -9,12 +9,9 @@
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/NeutronAtom.h"
+#include "MantidKernel/Philox.h"
 #include "MantidKernel/VectorHelper.h"
 
-#include <boost/random/uniform_int.hpp>
-#include <boost/random/uniform_real.hpp>
-#include <boost/random/variate_generator.hpp>
-
 /// @cond
 namespace {
 /// Number of attempts to choose a random point within the object before it
@@ -23,6 +20,15 @@ const int MaxRandPointAttempts(500);
 
 /// Element size in mm
 const double ELEMENT_SIZE = 1.0;
+
+/// Number of scatter points generated before any of them are traced
+const int EVENT_BATCH_SIZE = 64;
+
+/// The standard error of the mean of n > 1 values from the sum of their
+/// squared deviations from the mean
+double standardErrorOfMean(const double sumSqDev, const int n) {
+  return std::sqrt(sumSqDev / (n - 1) / n);
+}
 }
 /// @endcond
 
@@ -44,9 +50,10 @@ using namespace Kernel;
  */
 MonteCarloAbsorption::MonteCarloAbsorption()
     : m_samplePos(), m_sourcePos(), m_blocks(), m_blkHalfX(0.0),
-      m_blkHalfY(0.0), m_blkHalfZ(0.0), m_rngs(0), m_inputWS(),
+      m_blkHalfY(0.0), m_blkHalfZ(0.0), m_scratch(), m_inputWS(),
       m_sampleShape(NULL), m_container(NULL), m_numberOfPoints(0),
-      m_xStepSize(0), m_numberOfEvents(300) {}
+      m_xStepSize(0), m_numberOfEvents(300), m_maxNumberOfEvents(0),
+      m_relativeTolerance(0.0), m_seed(0) {}
 
 /**
  * Destructor
@@ -83,6 +90,16 @@ void MonteCarloAbsorption::init() {
       "The number of \"neutron\" events to generate per simulated point");
   declareProperty("SeedValue", 123456789, positiveInt,
                   "Seed the random number generator with this value");
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<double>>();
+  mustBeNonNegative->setLower(0.0);
+  declareProperty("RelativeErrorTolerance", 0.0, mustBeNonNegative,
+                  "If greater than zero, the simulation of each point "
+                  "continues past EventsPerPoint until the relative error on "
+                  "the attenuation factor falls below this value "
+                  "(default: 0, always use EventsPerPoint)");
+  declareProperty("MaxEventsPerPoint", 100000, positiveInt,
+                  "The maximum number of events generated for a point when "
+                  "RelativeErrorTolerance is set");
 }
 
 /**
@@ -115,6 +132,12 @@ void MonteCarloAbsorption::exec() {
   for (int i = 0; i < numHists; ++i) {
     PARALLEL_START_INTERUPT_REGION
 
+    // Each simulated point draws from its own stream of random numbers,
+    // selected by its spectrum and bin, so that the results do not depend on
+    // the number of threads or the order in which the points are simulated
+    Philox rng(static_cast<size_t>(m_seed));
+    SimulationScratch &scratch = m_scratch[PARALLEL_THREAD_NUMBER];
+
     // Copy over the X-values
     const MantidVec &xValues = m_inputWS->readX(i);
     correctionFactors->dataX(i) = xValues;
@@ -128,6 +151,8 @@ void MonteCarloAbsorption::exec() {
     }
     if (!detector)
       continue;
+    // Absolute detector position
+    const V3D detectorPos(detector->getPos());
 
     MantidVec &yValues = correctionFactors->dataY(i);
     MantidVec &eValues = correctionFactors->dataE(i);
@@ -138,7 +163,9 @@ void MonteCarloAbsorption::exec() {
       const double lambda = isHistogram
                                 ? (0.5 * (xValues[bin] + xValues[bin + 1]))
                                 : xValues[bin];
-      doSimulation(detector.get(), lambda, yValues[bin], eValues[bin]);
+      rng.setStream(static_cast<uint64_t>(i) * numBins + bin);
+      doSimulation(detectorPos, lambda, rng, scratch, yValues[bin],
+                   eValues[bin]);
       // Ensure we have the last point for the interpolation
       if (m_xStepSize > 1 && bin + m_xStepSize >= numBins &&
           bin + 1 != numBins) {
@@ -161,16 +188,23 @@ void MonteCarloAbsorption::exec() {
 }
 
 /**
- * Perform the simulation
- * @param detector :: A pointer to the current detector
+ * Perform the simulation. Scatter points are generated in batches and each
+ * batch is then traced. If a relative error tolerance has been given the
+ * simulation continues, after the requested number of events, until the
+ * standard error of the mean factor is small enough.
+ * @param detectorPos :: The absolute position of the current detector
  * @param lambda :: The chosen wavelength
+ * @param rng :: The random number generator, set to the stream for this point
+ * @param scratch :: Storage for the batch of events
  * @param attenFactor :: [Output] The calculated attenuation factor for this
  * wavelength
  * @param error :: [Output] The value of the error on the factor
  */
-void MonteCarloAbsorption::doSimulation(const IDetector *const detector,
-                                        const double lambda,
-                                        double &attenFactor, double &error) {
+void MonteCarloAbsorption::doSimulation(const V3D &detectorPos,
+                                        const double lambda, Philox &rng,
+                                        SimulationScratch &scratch,
+                                        double &attenFactor,
+                                        double &error) const {
   /**
    Currently, assuming square beam profile to pick start position then randomly
    selecting
@@ -179,27 +213,46 @@ void MonteCarloAbsorption::doSimulation(const IDetector *const detector,
    lengths and final
    directional vector to the detector
    */
-  // Absolute detector position
-  const V3D detectorPos(detector->getPos());
-
+  const V3D startPos = sampleBeamProfile();
+  const bool adaptive = (m_relativeTolerance > 0.0);
+  const int maxEvents =
+      adaptive ? std::max(m_numberOfEvents, m_maxNumberOfEvents)
+               : m_numberOfEvents;
+
+  std::vector<V3D> &scatterPoints = scratch.scatterPoints;
+  scatterPoints.resize(EVENT_BATCH_SIZE);
   int numDetected(0);
-  attenFactor = 0.0;
-  error = 0.0;
-  while (numDetected < m_numberOfEvents) {
-    V3D startPos = sampleBeamProfile();
-    V3D scatterPoint = selectScatterPoint();
-    double eventFactor(0.0);
-    if (attenuationFactor(startPos, scatterPoint, detectorPos, lambda,
-                          eventFactor)) {
-      attenFactor += eventFactor;
-      ++numDetected;
+  // Running mean and sum of squared deviations of the event factors
+  double mean(0.0), sumSqDev(0.0);
+  while (numDetected < maxEvents) {
+    const int batchSize = std::min(EVENT_BATCH_SIZE, maxEvents - numDetected);
+    for (int j = 0; j < batchSize; ++j) {
+      scatterPoints[j] = selectScatterPoint(rng);
+    }
+    for (int j = 0; j < batchSize; ++j) {
+      double eventFactor(0.0);
+      if (attenuationFactor(startPos, scatterPoints[j], detectorPos, lambda,
+                            scratch, eventFactor)) {
+        ++numDetected;
+        const double delta = eventFactor - mean;
+        mean += delta / numDetected;
+        sumSqDev += delta * (eventFactor - mean);
+      }
+    }
+    if (adaptive && numDetected >= m_numberOfEvents && numDetected > 1) {
+      if (standardErrorOfMean(sumSqDev, numDetected) <=
+          m_relativeTolerance * mean)
+        break;
     }
   }
 
   // Attenuation factor is simply the average value
-  attenFactor /= numDetected;
-  // Error is 1/sqrt(nevents)
-  error = 1. / sqrt((double)numDetected);
+  attenFactor = mean;
+  // The error is the standard error of the mean, as used to stop early. With
+  // fewer than two events it cannot be estimated so the factor is given a
+  // relative error of one
+  error = (numDetected > 1) ? standardErrorOfMean(sumSqDev, numDetected)
+                            : mean;
 }
 
 /**
@@ -215,29 +268,26 @@ V3D MonteCarloAbsorption::sampleBeamProfile() const { return m_sourcePos; }
  * used as an approximation to generate a point and this is then tested for its
  * validity within
  * the shape.
+ * @param rng :: The random number generator to use
  * @returns Selected position as V3D object
  */
-V3D MonteCarloAbsorption::selectScatterPoint() const {
+V3D MonteCarloAbsorption::selectScatterPoint(Philox &rng) const {
   // Randomly select a block from the subdivided set and then randomly select a
   // point
   // within that block and test if it inside the sample/container. If yes then
   // accept, else
   // keep trying.
-  boost::uniform_int<size_t> uniIntDist(0, m_blocks.size() - 1);
-  boost::variate_generator<boost::mt19937 &, boost::uniform_int<size_t>> uniInt(
-      rgen(), uniIntDist);
-  boost::uniform_real<> uniRealDist(0, 1.0);
-  boost::variate_generator<boost::mt19937 &, boost::uniform_real<>> uniReal(
-      rgen(), uniRealDist);
-
+  const size_t numBlocks = m_blocks.size();
   V3D scatterPoint;
   int nattempts(0);
   while (nattempts < MaxRandPointAttempts) {
-    size_t index = uniInt();
+    const size_t index = std::min(
+        static_cast<size_t>(rng.nextValue() * static_cast<double>(numBlocks)),
+        numBlocks - 1);
     const auto &block = m_blocks[index];
-    const double x = m_blkHalfX * (2.0 * uniReal() - 1.0) + block.xMin();
-    const double y = m_blkHalfY * (2.0 * uniReal() - 1.0) + block.yMin();
-    const double z = m_blkHalfZ * (2.0 * uniReal() - 1.0) + block.zMin();
+    const double x = m_blkHalfX * (2.0 * rng.nextValue() - 1.0) + block.xMin();
+    const double y = m_blkHalfY * (2.0 * rng.nextValue() - 1.0) + block.yMin();
+    const double z = m_blkHalfZ * (2.0 * rng.nextValue() - 1.0) + block.zMin();
     scatterPoint(x, y, z);
     ++nattempts;
     if (ptIntersectsSample(scatterPoint)) {
@@ -259,6 +309,7 @@ V3D MonteCarloAbsorption::selectScatterPoint() const {
  * @param scatterPoint :: The point of scatter
  * @param finalPos :: The end point of the track
  * @param lambda :: The wavelength of the neutron
+ * @param scratch :: Holds the tracks that are reused for each event
  * @param factor :: Output parameter storing the attenuation factor
  * @returns True if the track was valid, false otherwise
  */
@@ -266,13 +317,18 @@ bool MonteCarloAbsorption::attenuationFactor(const V3D &startPos,
                                              const V3D &scatterPoint,
                                              const V3D &finalPos,
                                              const double lambda,
-                                             double &factor) {
+                                             SimulationScratch &scratch,
+                                             double &factor) const {
   // Start at one
   factor = 1.0;
   // Define two tracks, before and after scatter, and trace check their
   // intersections with the the environment and sample
-  Track beforeScatter(scatterPoint, (startPos - scatterPoint));
-  Track afterScatter(scatterPoint, (finalPos - scatterPoint));
+  Track &beforeScatter = scratch.beforeScatter;
+  beforeScatter.reset(scatterPoint, (startPos - scatterPoint));
+  beforeScatter.clearIntersectionResults();
+  Track &afterScatter = scratch.afterScatter;
+  afterScatter.reset(scatterPoint, (finalPos - scatterPoint));
+  afterScatter.clearIntersectionResults();
   // Theoretically this should never happen as there should always be an
   // intersection
   // but do to precision limitations points very close to the surface give
@@ -374,16 +430,18 @@ void MonteCarloAbsorption::retrieveInput() {
   }
 
   m_numberOfEvents = getProperty("EventsPerPoint");
+  m_maxNumberOfEvents = getProperty("MaxEventsPerPoint");
+  m_relativeTolerance = getProperty("RelativeErrorTolerance");
+  m_seed = getProperty("SeedValue");
 }
 
 /**
- * Initialise the caches used here including setting up the random
- * number generator
+ * Initialise the caches used here including the scratch storage for each
+ * thread
  */
 void MonteCarloAbsorption::initCaches() {
   g_log.debug() << "Caching input\n";
-  // Setup random number generators for parallel execution
-  initRNG();
+  m_scratch.resize(PARALLEL_GET_MAX_THREADS);
 
   m_samplePos = m_inputWS->getInstrument()->getSample()->getPos();
   m_sourcePos = m_inputWS->getInstrument()->getSource()->getPos();
@@ -461,28 +519,6 @@ void MonteCarloAbsorption::initCaches() {
         << " blocks that do not intersect with the sample + container\n";
 }
 
-/**
- */
-void MonteCarloAbsorption::initRNG() {
-  const int baseSeed = getProperty("SeedValue");
-  // For parallel execution use a vector of RNG, each with a seed one higher
-  // that the previous
-  m_rngs.resize(PARALLEL_GET_MAX_THREADS);
-  // Set the seeds
-  for (int i = 0; i < static_cast<int>(m_rngs.size()); ++i) {
-    m_rngs[i].seed(baseSeed + i);
-  }
-}
-
-/**
- * @return A reference to a boost::random::mt19937 object
- */
-boost::mt19937 &MonteCarloAbsorption::rgen() const {
-  // Const from point of view of caller
-  return const_cast<MonteCarloAbsorption *>(this)
-      ->m_rngs[PARALLEL_THREAD_NUMBER];
-}
-
 /**
  * @param xmax max x-coordinate of cuboid point
  * @param ymax max y-coordinate of cuboid point
@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/Multiply.h"
 #include "MantidDataObjects/WorkspaceSingleValue.h"
+#include "MantidKernel/SIMD.h"
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -14,6 +15,25 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(Multiply)
 
+namespace {
+/// Per-bin kernel for multiplying two uncorrelated values
+struct MultiplyKernel {
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    // error multiplying two uncorrelated numbers, re-arrange so that you don't
+    // get infinity if leftY or rightY == 0
+    // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
+    // (Sc)2 = (Sa c/a)2 + (Sb c/b)2
+    //       = (Sa b)2 + (Sb a)2
+    const double a = lhsE * rhsY;
+    const double b = rhsE * lhsY;
+    EOut = std::sqrt(a * a + b * b);
+    YOut = lhsY * rhsY;
+  }
+};
+}
+
 void Multiply::performBinaryOperation(const MantidVec &lhsX,
                                       const MantidVec &lhsY,
                                       const MantidVec &lhsE,
@@ -21,23 +41,7 @@ void Multiply::performBinaryOperation(const MantidVec &lhsX,
                                       const MantidVec &rhsE, MantidVec &YOut,
                                       MantidVec &EOut) {
   UNUSED_ARG(lhsX);
-  const size_t bins = lhsE.size();
-  for (size_t j = 0; j < bins; ++j) {
-    // Get references to the input Y's
-    const double leftY = lhsY[j];
-    const double rightY = rhsY[j];
-
-    // error multiplying two uncorrelated numbers, re-arrange so that you don't
-    // get infinity if leftY or rightY == 0
-    // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
-    // (Sc)2 = (Sa c/a)2 + (Sb c/b)2
-    //       = (Sa b)2 + (Sb a)2
-    EOut[j] = sqrt(pow(lhsE[j] * rightY, 2) + pow(rhsE[j] * leftY, 2));
-
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY * rightY;
-  }
+  SIMD::binary(MultiplyKernel(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
 }
 
 void Multiply::performBinaryOperation(const MantidVec &lhsX,
@@ -46,18 +50,7 @@ void Multiply::performBinaryOperation(const MantidVec &lhsX,
                                       const double rhsE, MantidVec &YOut,
                                       MantidVec &EOut) {
   UNUSED_ARG(lhsX);
-  const size_t bins = lhsE.size();
-  for (size_t j = 0; j < bins; ++j) {
-    // Get reference to input Y
-    const double leftY = lhsY[j];
-
-    // see comment in the function above for the error formula
-    EOut[j] = sqrt(pow(lhsE[j] * rhsY, 2) + pow(rhsE * leftY, 2));
-
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY * rhsY;
-  }
+  SIMD::binary(MultiplyKernel(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
 }
 
 void Multiply::setOutputUnits(const API::MatrixWorkspace_const_sptr lhs,
@@ -0,0 +1,122 @@
+#include "MantidAlgorithms/OverlapWeights.h"
+#include "MantidDataObjects/RebinnedOutput.h"
+
+#include <boost/math/special_functions/fpclassify.hpp>
+
+namespace Mantid {
+namespace Algorithms {
+
+using namespace API;
+using DataObjects::RebinnedOutput;
+
+//----------------------------------------------------------------------------------------------
+// OverlapGeometry
+//----------------------------------------------------------------------------------------------
+/**
+ * @param other :: The geometry to compare with
+ * @returns True if the two geometries give identical weights
+ */
+bool OverlapGeometry::operator==(const OverlapGeometry &other) const {
+  return parameters.size() == other.parameters.size() &&
+         method == other.method && parameters == other.parameters;
+}
+
+//----------------------------------------------------------------------------------------------
+// OverlapWeights
+//----------------------------------------------------------------------------------------------
+/**
+ * The overlaps of each output spectrum keep the order of the input spectra
+ * so that every output bin sums its contributions in the same order as a
+ * direct loop over the input bins would.
+ * @param geom :: The geometry the weights were computed for
+ * @param numberOfInputBins :: The number of bins in each input spectrum
+ * @param numberOfOutputRows :: The number of output spectra
+ * @param overlaps :: The overlaps found for each input spectrum, in order
+ */
+OverlapWeights::OverlapWeights(
+    const OverlapGeometry &geom, const size_t numberOfInputBins,
+    const size_t numberOfOutputRows,
+    const std::vector<std::vector<OutputOverlap>> &overlaps)
+    : geometry(geom), m_numberOfInputBins(numberOfInputBins), m_weights(),
+      m_rowStart(numberOfOutputRows + 1, 0) {
+  // Count the weights of each output spectrum, then place them
+  for (size_t i = 0; i < overlaps.size(); ++i) {
+    for (size_t k = 0; k < overlaps[i].size(); ++k) {
+      ++m_rowStart[overlaps[i][k].outputRow + 1];
+    }
+  }
+  for (size_t row = 0; row < numberOfOutputRows; ++row) {
+    m_rowStart[row + 1] += m_rowStart[row];
+  }
+  m_weights.resize(m_rowStart.back());
+  std::vector<size_t> next(m_rowStart.begin(), m_rowStart.end() - 1);
+  for (size_t i = 0; i < overlaps.size(); ++i) {
+    for (size_t k = 0; k < overlaps[i].size(); ++k) {
+      const OutputOverlap &item = overlaps[i][k];
+      m_weights[next[item.outputRow]++] = item.overlap;
+    }
+  }
+}
+
+/**
+ * Each output spectrum is filled independently so the spectra are processed
+ * in parallel. Input bins whose signal is NaN are skipped.
+ * @param inputWS :: The workspace containing the input signal and errors
+ * @param outputWS :: The workspace to accumulate into. The errors are
+ * accumulated as squares
+ * @param scaleByWidth :: If true the signal and errors are multiplied by the
+ * width of each overlap, as is required for distributions
+ * @param trackFractions :: If true the weights are accumulated in the
+ * fractional areas of the output, which must then be a RebinnedOutput
+ */
+void OverlapWeights::apply(MatrixWorkspace_const_sptr inputWS,
+                           MatrixWorkspace_sptr outputWS,
+                           const bool scaleByWidth,
+                           const bool trackFractions) const {
+  RebinnedOutput *fractionWS(NULL);
+  if (trackFractions) {
+    fractionWS = dynamic_cast<RebinnedOutput *>(outputWS.get());
+    if (!fractionWS)
+      throw std::invalid_argument(
+          "Fractional areas can only be accumulated in a RebinnedOutput");
+  }
+  const int64_t numberOfRows = static_cast<int64_t>(m_rowStart.size() - 1);
+
+  PARALLEL_FOR2(inputWS, outputWS)
+  for (int64_t row = 0; row < numberOfRows; ++row) {
+    MantidVec &outY = outputWS->dataY(row);
+    MantidVec &outE = outputWS->dataE(row);
+    MantidVec *outF = fractionWS ? &fractionWS->dataF(row) : NULL;
+    const size_t end = m_rowStart[row + 1];
+    for (size_t k = m_rowStart[row]; k < end; ++k) {
+      const OverlapWeight &item = m_weights[k];
+      const size_t i = item.inputIndex / m_numberOfInputBins;
+      const size_t j = item.inputIndex % m_numberOfInputBins;
+      double yValue = inputWS->readY(i)[j];
+      if (boost::math::isnan(yValue)) {
+        continue;
+      }
+      yValue *= item.weight;
+      double eValue = inputWS->readE(i)[j] * item.weight;
+      if (scaleByWidth) {
+        yValue *= item.width;
+        eValue *= item.width;
+      }
+      outY[item.outputBin] += yValue;
+      outE[item.outputBin] += eValue * eValue;
+      if (outF) {
+        (*outF)[item.outputBin] += item.weight;
+      }
+    }
+  }
+}
+
+/// @returns The approximate memory used by the weights in bytes
+size_t OverlapWeights::memorySize() const {
+  return m_weights.size() * sizeof(OverlapWeight) +
+         m_rowStart.size() * sizeof(size_t) +
+         geometry.parameters.size() * sizeof(double);
+}
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -2,7 +2,9 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/Plus.h"
-#include "MantidKernel/VectorHelper.h"
+#include "MantidKernel/SIMD.h"
+
+#include <cmath>
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -13,6 +15,25 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(Plus)
 
+namespace {
+/// Per-bin kernel: the errors add in quadrature
+struct PlusKernel {
+  inline void operator()(const double lhsY, const double lhsE,
+                         const double rhsY, const double rhsE, double &YOut,
+                         double &EOut) const {
+    YOut = lhsY + rhsY;
+    EOut = std::sqrt(lhsE * lhsE + rhsE * rhsE);
+  }
+};
+
+/// Adds a constant
+struct AddValue {
+  explicit AddValue(const double value) : m_value(value) {}
+  inline double operator()(const double y) const { return y + m_value; }
+  const double m_value;
+};
+}
+
 // ===================================== HISTOGRAM BINARY OPERATIONS
 // ==========================================
 //---------------------------------------------------------------------------------------------
@@ -21,10 +42,7 @@ void Plus::performBinaryOperation(const MantidVec &lhsX, const MantidVec &lhsY,
                                   const MantidVec &rhsE, MantidVec &YOut,
                                   MantidVec &EOut) {
   (void)lhsX; // Avoid compiler warning
-  std::transform(lhsY.begin(), lhsY.end(), rhsY.begin(), YOut.begin(),
-                 std::plus<double>());
-  std::transform(lhsE.begin(), lhsE.end(), rhsE.begin(), EOut.begin(),
-                 VectorHelper::SumGaussError<double>());
+  SIMD::binary(PlusKernel(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
 }
 
 //---------------------------------------------------------------------------------------------
@@ -33,14 +51,13 @@ void Plus::performBinaryOperation(const MantidVec &lhsX, const MantidVec &lhsY,
                                   const double rhsE, MantidVec &YOut,
                                   MantidVec &EOut) {
   (void)lhsX; // Avoid compiler warning
-  std::transform(lhsY.begin(), lhsY.end(), YOut.begin(),
-                 std::bind2nd(std::plus<double>(), rhsY));
   // Only do E if non-zero, otherwise just copy
-  if (rhsE != 0)
-    std::transform(lhsE.begin(), lhsE.end(), EOut.begin(),
-                   std::bind2nd(VectorHelper::SumGaussError<double>(), rhsE));
-  else
+  if (rhsE != 0) {
+    SIMD::binary(PlusKernel(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
+  } else {
+    SIMD::transform(lhsY, YOut, AddValue(rhsY));
     EOut = lhsE;
+  }
 }
 
 // ===================================== EVENT LIST BINARY OPERATIONS
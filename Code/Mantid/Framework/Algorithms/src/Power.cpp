@@ -3,6 +3,9 @@
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/Power.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/SIMD.h"
+
+#include <cmath>
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -13,6 +16,19 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(Power)
 
+namespace {
+/// Per-bin kernel
+struct PowerKernel {
+  explicit PowerKernel(const double exponent) : m_exponent(exponent) {}
+  inline void operator()(const double, const double YIn, const double EIn,
+                         double &YOut, double &EOut) const {
+    YOut = std::pow(YIn, m_exponent);
+    EOut = std::fabs(m_exponent * YOut * (EIn / YIn));
+  }
+  const double m_exponent;
+};
+}
+
 Power::Power() : UnaryOperation() { this->useHistogram = true; }
 
 ///////////////////////////////////
@@ -28,13 +44,15 @@ void Power::retrieveProperties() { m_exponent = getProperty("Exponent"); }
 void Power::performUnaryOperation(const double XIn, const double YIn,
                                   const double EIn, double &YOut,
                                   double &EOut) {
-  (void)XIn; // Avoid compiler warning
-  YOut = calculatePower(YIn, m_exponent);
-  EOut = std::fabs(m_exponent * YOut * (EIn / YIn));
+  const PowerKernel kernel(m_exponent);
+  kernel(XIn, YIn, EIn, YOut, EOut);
 }
 
-inline double Power::calculatePower(const double base, const double exponent) {
-  return std::pow(base, exponent);
+void Power::performUnaryOperationOnSpectrum(const MantidVec &X,
+                                            const MantidVec &YIn,
+                                            const MantidVec &EIn,
+                                            MantidVec &YOut, MantidVec &EOut) {
+  SIMD::unary(PowerKernel(m_exponent), X, YIn, EIn, YOut, EOut);
 }
 }
 }
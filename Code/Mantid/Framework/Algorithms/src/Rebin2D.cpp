@@ -4,6 +4,7 @@
 #include "MantidAlgorithms/Rebin2D.h"
 #include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/VectorHelper.h"
@@ -11,8 +12,9 @@
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidGeometry/Math/ConvexPolygon.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
-#include "MantidGeometry/Math/LaszloIntersection.h"
+#include "MantidGeometry/Math/RectangleIntersection.h"
 
+#include <boost/make_shared.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 
 namespace Mantid {
@@ -23,9 +25,8 @@ DECLARE_ALGORITHM(Rebin2D)
 
 using namespace API;
 using namespace DataObjects;
-using Geometry::ConvexPolygon;
+using Geometry::OverlapRegion;
 using Geometry::Quadrilateral;
-using Kernel::V2D;
 
 //--------------------------------------------------------------------------
 // Private methods
@@ -114,33 +115,60 @@ void Rebin2D::exec() {
   m_progress = boost::shared_ptr<API::Progress>(
       new API::Progress(this, 0.0, 1.0, nreports));
 
-  // PARALLEL_FOR2(inputWS, outputWS)
-  for (int64_t i = 0; i < static_cast<int64_t>(numYBins);
-       ++i) // signed for openmp
-  {
-    PARALLEL_START_INTERUPT_REGION
-
-    const double vlo = oldYEdges[i];
-    const double vhi = oldYEdges[i + 1];
-    for (size_t j = 0; j < numXBins; ++j) {
-      m_progress->report("Computing polygon intersections");
-      // For each input polygon test where it intersects with
-      // the output grid and assign the appropriate weights of Y/E
-      const double x_j = oldXEdges[j];
-      const double x_jp1 = oldXEdges[j + 1];
-      Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
-      if (!this->useFractionalArea) {
-        rebinToOutput(inputQ, inputWS, i, j, outputWS, newYBins);
-      } else {
-        rebinToFractionalOutput(
-            inputQ, inputWS, i, j,
-            boost::dynamic_pointer_cast<RebinnedOutput>(outputWS), newYBins);
+  // The overlaps depend only on the input and output bin edges so these make
+  // up the key for the cached weights
+  OverlapGeometry geometry;
+  geometry.method = name();
+  std::vector<double> &params = geometry.parameters;
+  params.push_back(static_cast<double>(oldXEdges.size()));
+  params.insert(params.end(), oldXEdges.begin(), oldXEdges.end());
+  params.push_back(static_cast<double>(oldYEdges.size()));
+  params.insert(params.end(), oldYEdges.begin(), oldYEdges.end());
+  params.push_back(static_cast<double>(newXBins->size()));
+  params.insert(params.end(), newXBins->begin(), newXBins->end());
+  params.push_back(static_cast<double>(newYBins.size()));
+  params.insert(params.end(), newYBins.begin(), newYBins.end());
+
+  OverlapWeights_const_sptr weights =
+      OverlapWeightsCache::Instance().find(geometry);
+  if (weights) {
+    g_log.information("Reusing cached overlap weights");
+  } else {
+    std::vector<std::vector<OutputOverlap>> overlaps(numYBins);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(numYBins);
+         ++i) // signed for openmp
+    {
+      PARALLEL_START_INTERUPT_REGION
+
+      const double vlo = oldYEdges[i];
+      const double vhi = oldYEdges[i + 1];
+      for (size_t j = 0; j < numXBins; ++j) {
+        m_progress->report("Computing polygon intersections");
+        // For each input polygon find where it intersects with the output
+        // grid and the fraction of it in each output bin
+        const double x_j = oldXEdges[j];
+        const double x_jp1 = oldXEdges[j + 1];
+        Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
+        findOverlaps(inputQ, i * numXBins + j, outputWS, newYBins,
+                     overlaps[i]);
       }
-    }
 
-    PARALLEL_END_INTERUPT_REGION
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+    weights = boost::make_shared<OverlapWeights>(geometry, numXBins,
+                                                 newYBins.size() - 1, overlaps);
+    cacheOverlapWeights(weights);
   }
-  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Don't remove the bin widths if already RebinnedOutput. This wreaks havoc
+  // on the data.
+  const bool scaleByWidth =
+      inputWS->isDistribution() &&
+      (!this->useFractionalArea || inputWS->id() != "RebinnedOutput");
+  weights->apply(inputWS, outputWS, scaleByWidth, this->useFractionalArea);
+
   if (this->useFractionalArea) {
     boost::dynamic_pointer_cast<RebinnedOutput>(outputWS)->finalize();
   }
@@ -183,22 +211,17 @@ void Rebin2D::rebinToOutput(const Geometry::Quadrilateral &inputQ,
     const double vlo = verticalAxis[qi];
     const double vhi = verticalAxis[qi + 1];
     for (size_t ei = en_start; ei < en_end; ++ei) {
-      const V2D ll(X[ei], vlo);
-      const V2D lr(X[ei + 1], vlo);
-      const V2D ur(X[ei + 1], vhi);
-      const V2D ul(X[ei], vhi);
-      const Quadrilateral outputQ(ll, lr, ur, ul);
-
       double yValue = inputWS->readY(i)[j];
       if (boost::math::isnan(yValue)) {
         continue;
       }
-      try {
-        ConvexPolygon overlap = intersectionByLaszlo(outputQ, inputQ);
-        const double weight = overlap.area() / inputQ.area();
+      OverlapRegion overlap;
+      if (intersectionWithRectangle(inputQ, X[ei], X[ei + 1], vlo, vhi,
+                                    overlap)) {
+        const double weight = overlap.area / inputQ.area();
         yValue *= weight;
         double eValue = inputWS->readE(i)[j] * weight;
-        const double overlapWidth = overlap.largestX() - overlap.smallestX();
+        const double overlapWidth = overlap.largestX - overlap.smallestX;
         if (inputWS->isDistribution()) {
           yValue *= overlapWidth;
           eValue *= overlapWidth;
@@ -208,72 +231,74 @@ void Rebin2D::rebinToOutput(const Geometry::Quadrilateral &inputQ,
           outputWS->dataY(qi)[ei] += yValue;
           outputWS->dataE(qi)[ei] += eValue;
         }
-      } catch (Geometry::NoIntersectionException &) {
       }
     }
   }
 }
 
 /**
- * Rebin the input quadrilateral to the output grid
+ * Find the fraction of the input quadrilateral that lies in each bin of the
+ * output grid
  * @param inputQ The input polygon
- * @param inputWS The input workspace containing the input intensity values
- * @param i The index in the vertical axis direction that inputQ references
- * @param j The index in the horizontal axis direction that inputQ references
- * @param outputWS A pointer to the output workspace that accumulates the data
+ * @param inputIndex The index of the input bin that inputQ represents
+ * @param outputWS A pointer to the output workspace
  * @param verticalAxis A vector containing the output vertical axis bin
  * boundaries
+ * @param overlaps [out] A list that the overlaps are appended to
  */
-void Rebin2D::rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
-                                      MatrixWorkspace_const_sptr inputWS,
-                                      const size_t i, const size_t j,
-                                      RebinnedOutput_sptr outputWS,
-                                      const std::vector<double> &verticalAxis) {
+void Rebin2D::findOverlaps(const Geometry::Quadrilateral &inputQ,
+                           const size_t inputIndex,
+                           MatrixWorkspace_const_sptr outputWS,
+                           const std::vector<double> &verticalAxis,
+                           std::vector<OutputOverlap> &overlaps) const {
   const MantidVec &X = outputWS->readX(0);
   size_t qstart(0), qend(verticalAxis.size() - 1), en_start(0),
       en_end(X.size() - 1);
   if (!getIntersectionRegion(outputWS, verticalAxis, inputQ, qstart, qend,
                              en_start, en_end))
     return;
+  const double inputArea = inputQ.area();
+  if (inputArea == 0.0)
+    return;
 
+  OutputOverlap item;
+  item.overlap.inputIndex = inputIndex;
+  OverlapRegion overlap;
   for (size_t qi = qstart; qi < qend; ++qi) {
     const double vlo = verticalAxis[qi];
     const double vhi = verticalAxis[qi + 1];
     for (size_t ei = en_start; ei < en_end; ++ei) {
-      const V2D ll(X[ei], vlo);
-      const V2D lr(X[ei + 1], vlo);
-      const V2D ur(X[ei + 1], vhi);
-      const V2D ul(X[ei], vhi);
-      const Quadrilateral outputQ(ll, lr, ur, ul);
-
-      double yValue = inputWS->readY(i)[j];
-      if (boost::math::isnan(yValue)) {
-        continue;
-      }
-      try {
-        ConvexPolygon overlap = intersectionByLaszlo(outputQ, inputQ);
-        const double weight = overlap.area() / inputQ.area();
-        yValue *= weight;
-        double eValue = inputWS->readE(i)[j] * weight;
-        const double overlapWidth = overlap.largestX() - overlap.smallestX();
-        // Don't do the overlap removal if already RebinnedOutput.
-        // This wreaks havoc on the data.
-        if (inputWS->isDistribution() && inputWS->id() != "RebinnedOutput") {
-          yValue *= overlapWidth;
-          eValue *= overlapWidth;
-        }
-        eValue *= eValue;
-        PARALLEL_CRITICAL(overlap) {
-          outputWS->dataY(qi)[ei] += yValue;
-          outputWS->dataE(qi)[ei] += eValue;
-          outputWS->dataF(qi)[ei] += weight;
-        }
-      } catch (Geometry::NoIntersectionException &) {
+      if (intersectionWithRectangle(inputQ, X[ei], X[ei + 1], vlo, vhi,
+                                    overlap)) {
+        item.outputRow = qi;
+        item.overlap.outputBin = ei;
+        item.overlap.weight = overlap.area / inputArea;
+        item.overlap.width = overlap.largestX - overlap.smallestX;
+        overlaps.push_back(item);
       }
     }
   }
 }
 
+/**
+ * The cache holds at most Rebin2D.OverlapWeightsCache.MaxSize MB of weights.
+ * Setting the key to 0 switches the cache off.
+ * @param weights The newly computed weights
+ */
+void Rebin2D::cacheOverlapWeights(
+    const OverlapWeights_const_sptr &weights) const {
+  int maxMB = 64;
+  Kernel::ConfigService::Instance().getValue(
+      "Rebin2D.OverlapWeightsCache.MaxSize", maxMB);
+  if (maxMB <= 0) {
+    OverlapWeightsCache::Instance().clear();
+    return;
+  }
+  OverlapWeightsCache::Instance().store(weights,
+                                        static_cast<size_t>(maxMB) * 1024 *
+                                            1024);
+}
+
 /**
  * Find the possible region of intersection on the output workspace for the
  * given polygon
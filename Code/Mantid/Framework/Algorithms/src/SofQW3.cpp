@@ -8,12 +8,13 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
-#include "MantidGeometry/Math/LaszloIntersection.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
 #include "MantidGeometry/Math/Vertex2D.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <boost/make_shared.hpp>
+
 namespace Mantid {
 namespace Algorithms {
 // Setup typedef for later use
@@ -104,80 +105,138 @@ void SofQW3::exec() {
   const MantidVec &X = inputWS->readX(0);
 
   int emode = m_EmodeProperties.m_emode;
-  /* PARALLEL_FOR2(inputWS, outputWS) */
-  for (int64_t i = 0; i < static_cast<int64_t>(nHistos);
-       ++i) // signed for openmp
-  {
-    /* PARALLEL_START_INTERUPT_REGION */
 
+  // The input polygons depend only on the energy bins and the angles, widths
+  // and fixed energy of each detector. Along with the output binning these
+  // make up the key for the cached weights.
+  OverlapGeometry geometry;
+  geometry.method = name();
+  std::vector<double> &params = geometry.parameters;
+  params.push_back(static_cast<double>(emode));
+  params.push_back(static_cast<double>(X.size()));
+  params.insert(params.end(), X.begin(), X.end());
+  params.push_back(static_cast<double>(m_Qout.size()));
+  params.insert(params.end(), m_Qout.begin(), m_Qout.end());
+  params.push_back(static_cast<double>(nHistos));
+  std::vector<double> efixed(nHistos, 0.0);
+  std::vector<detid_t> detIDs(nHistos, 0);
+  std::vector<bool> useSpectrum(nHistos, false);
+  for (size_t i = 0; i < nHistos; ++i) {
     DetConstPtr detector = inputWS->getDetector(i);
     if (detector->isMasked() || detector->isMonitor()) {
+      params.push_back(0.0);
       continue;
     }
+    useSpectrum[i] = true;
+    efixed[i] = m_EmodeProperties.getEFixed(detector);
+    detIDs[i] = detector->getID();
+    params.push_back(1.0);
+    params.push_back(m_theta[i]);
+    params.push_back(m_phi[i]);
+    params.push_back(m_thetaWidths[i]);
+    params.push_back(m_phiWidths[i]);
+    params.push_back(efixed[i]);
+  }
 
-    double theta = this->m_theta[i];
-    double phi = this->m_phi[i];
-    double thetaWidth = this->m_thetaWidths[i];
-    double phiWidth = this->m_phiWidths[i];
-
-    // Compute polygon points
-    double thetaHalfWidth = 0.5 * thetaWidth;
-    double phiHalfWidth = 0.5 * phiWidth;
-
-    const double thetaLower = theta - thetaHalfWidth;
-    const double thetaUpper = theta + thetaHalfWidth;
-
-    const double phiLower = phi - phiHalfWidth;
-    const double phiUpper = phi + phiHalfWidth;
+  OverlapWeights_const_sptr weights =
+      OverlapWeightsCache::Instance().find(geometry);
+  if (weights) {
+    g_log.information("Reusing cached overlap weights");
+  } else {
+    std::vector<std::vector<OutputOverlap>> overlaps(nHistos);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(nHistos);
+         ++i) // signed for openmp
+    {
+      PARALLEL_START_INTERUPT_REGION
+
+      if (!useSpectrum[i]) {
+        continue;
+      }
 
-    const double efixed = m_EmodeProperties.getEFixed(detector);
-    const specid_t specNo = inputWS->getSpectrum(i)->getSpectrumNo();
-    std::stringstream logStream;
-    for (size_t j = 0; j < nEnergyBins; ++j) {
-      m_progress->report("Computing polygon intersections");
-      // For each input polygon test where it intersects with
-      // the output grid and assign the appropriate weights of Y/E
-      const double dE_j = X[j];
-      const double dE_jp1 = X[j + 1];
+      double theta = this->m_theta[i];
+      double phi = this->m_phi[i];
+      double thetaWidth = this->m_thetaWidths[i];
+      double phiWidth = this->m_phiWidths[i];
+
+      // Compute polygon points
+      double thetaHalfWidth = 0.5 * thetaWidth;
+      double phiHalfWidth = 0.5 * phiWidth;
+
+      const double thetaLower = theta - thetaHalfWidth;
+      const double thetaUpper = theta + thetaHalfWidth;
+
+      const double phiLower = phi - phiHalfWidth;
+      const double phiUpper = phi + phiHalfWidth;
+
+      const specid_t specNo = inputWS->getSpectrum(i)->getSpectrumNo();
+      std::stringstream logStream;
+      for (size_t j = 0; j < nEnergyBins; ++j) {
+        m_progress->report("Computing polygon intersections");
+        // For each input polygon find where it intersects with the output
+        // grid and the fraction of it in each output bin
+        const double dE_j = X[j];
+        const double dE_jp1 = X[j + 1];
+
+        const V2D ll(dE_j, this->calculateQ(efixed[i], emode, dE_j,
+                                            thetaLower, phiLower));
+        const V2D lr(dE_jp1, this->calculateQ(efixed[i], emode, dE_jp1,
+                                              thetaLower, phiLower));
+        const V2D ur(dE_jp1, this->calculateQ(efixed[i], emode, dE_jp1,
+                                              thetaUpper, phiUpper));
+        const V2D ul(dE_j, this->calculateQ(efixed[i], emode, dE_j,
+                                            thetaUpper, phiUpper));
+        if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
+          logStream << "Spectrum=" << specNo << ", theta=" << theta
+                    << ",thetaWidth=" << thetaWidth << ", phi=" << phi
+                    << ", phiWidth=" << phiWidth << ". QE polygon: ll=" << ll
+                    << ", lr=" << lr << ", ur=" << ur << ", ul=" << ul
+                    << "\n";
+        }
 
-      const double lrQ =
-          this->calculateQ(efixed, emode, dE_jp1, thetaLower, phiLower);
-
-      const V2D ll(dE_j,
-                   this->calculateQ(efixed, emode, dE_j, thetaLower, phiLower));
-      const V2D lr(dE_jp1, lrQ);
-      const V2D ur(dE_jp1, this->calculateQ(efixed, emode, dE_jp1, thetaUpper,
-                                            phiUpper));
-      const V2D ul(dE_j,
-                   this->calculateQ(efixed, emode, dE_j, thetaUpper, phiUpper));
+        Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
+        this->findOverlaps(inputQ, i * nEnergyBins + j, outputWS, m_Qout,
+                           overlaps[i]);
+      }
       if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
-        logStream << "Spectrum=" << specNo << ", theta=" << theta
-                  << ",thetaWidth=" << thetaWidth << ", phi=" << phi
-                  << ", phiWidth=" << phiWidth << ". QE polygon: ll=" << ll
-                  << ", lr=" << lr << ", ur=" << ur << ", ul=" << ul << "\n";
+        g_log.debug(logStream.str());
       }
 
-      Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+    weights = boost::make_shared<OverlapWeights>(geometry, nEnergyBins,
+                                                 m_Qout.size() - 1, overlaps);
+    this->cacheOverlapWeights(weights);
+  }
 
-      this->rebinToFractionalOutput(inputQ, inputWS, i, j, outputWS, m_Qout);
+  // Don't remove the bin widths if already RebinnedOutput. This wreaks havoc
+  // on the data.
+  const bool scaleByWidth =
+      inputWS->isDistribution() && inputWS->id() != "RebinnedOutput";
+  weights->apply(inputWS, outputWS, scaleByWidth, true);
 
-      // Find which q bin this point lies in
+  // Map each detector to the Q bin holding the lower right corner of each of
+  // its polygons
+  for (size_t i = 0; i < nHistos; ++i) {
+    if (!useSpectrum[i]) {
+      continue;
+    }
+    const double thetaLower = m_theta[i] - 0.5 * m_thetaWidths[i];
+    const double phiLower = m_phi[i] - 0.5 * m_phiWidths[i];
+    for (size_t j = 0; j < nEnergyBins; ++j) {
+      const double lrQ =
+          this->calculateQ(efixed[i], emode, X[j + 1], thetaLower, phiLower);
       const MantidVec::difference_type qIndex =
           std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) - m_Qout.begin();
       if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
         // Add this spectra-detector pair to the mapping
         specNumberMapping.push_back(
             outputWS->getSpectrum(qIndex - 1)->getSpectrumNo());
-        detIDMapping.push_back(detector->getID());
+        detIDMapping.push_back(detIDs[i]);
       }
     }
-    if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
-      g_log.debug(logStream.str());
-    }
-
-    /* PARALLEL_END_INTERUPT_REGION */
   }
-  /* PARALLEL_CHECK_INTERUPT_REGION */
 
   outputWS->finalize();
   this->normaliseOutput(outputWS, inputWS);
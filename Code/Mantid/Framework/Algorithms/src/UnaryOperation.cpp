@@ -69,8 +69,6 @@ void UnaryOperation::exec() {
   retrieveProperties();
 
   const size_t numSpec = in_work->getNumberHistograms();
-  const size_t specSize = in_work->blocksize();
-  const bool isHist = in_work->isHistogramData();
 
   // Initialise the progress reporting object
   Progress progress(this, 0.0, 1.0, numSpec);
@@ -91,12 +89,7 @@ void UnaryOperation::exec() {
     const MantidVec &Y = in_work->readY(i);
     const MantidVec &E = in_work->readE(i);
 
-    for (size_t j = 0; j < specSize; ++j) {
-      // Use the bin centre for the X value if this is histogram data
-      const double XIn = isHist ? (X[j] + X[j + 1]) / 2.0 : X[j];
-      // Call the abstract function, passing in the current values
-      performUnaryOperation(XIn, Y[j], E[j], YOut[j], EOut[j]);
-    }
+    performUnaryOperationOnSpectrum(X, Y, E, YOut, EOut);
 
     progress.report();
     PARALLEL_END_INTERUPT_REGION
@@ -174,6 +167,29 @@ void UnaryOperation::execEvent() {
   }
 }
 
+/**
+ * The default calls performUnaryOperation() for each bin.
+ * @param X :: The X values. For a histogram the bin centres are used.
+ * @param YIn :: The input data
+ * @param EIn :: The input errors
+ * @param YOut :: The output data, which may be the input data
+ * @param EOut :: The output errors, which may be the input errors
+ */
+void UnaryOperation::performUnaryOperationOnSpectrum(const MantidVec &X,
+                                                     const MantidVec &YIn,
+                                                     const MantidVec &EIn,
+                                                     MantidVec &YOut,
+                                                     MantidVec &EOut) {
+  const size_t specSize = YIn.size();
+  const bool isHist = (X.size() == specSize + 1);
+  for (size_t j = 0; j < specSize; ++j) {
+    // Use the bin centre for the X value if this is histogram data
+    const double XIn = isHist ? (X[j] + X[j + 1]) / 2.0 : X[j];
+    // Call the abstract function, passing in the current values
+    performUnaryOperation(XIn, YIn[j], EIn[j], YOut[j], EOut[j]);
+  }
+}
+
 /// Helper for events, for use with different types of weighted events
 template <class T>
 void UnaryOperation::unaryOperationEventHelper(std::vector<T> &wevector) {
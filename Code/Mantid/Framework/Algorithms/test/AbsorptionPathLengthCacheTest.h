@@ -0,0 +1,118 @@
+#ifndef MANTID_ALGORITHMS_ABSORPTIONPATHLENGTHCACHETEST_H_
+#define MANTID_ALGORITHMS_ABSORPTIONPATHLENGTHCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAlgorithms/AbsorptionPathLengthCache.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::Algorithms;
+using Mantid::Kernel::V3D;
+
+class AbsorptionPathLengthCacheTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AbsorptionPathLengthCacheTest *createSuite() { return new AbsorptionPathLengthCacheTest(); }
+  static void destroySuite( AbsorptionPathLengthCacheTest *suite ) { delete suite; }
+
+  void test_Table_Is_Sized_From_Geometry()
+  {
+    PathLengthTable table(createGeometry("shape", 0.0));
+    TS_ASSERT_EQUALS(table.L2s.size(), 6);
+    table.row(1)[2] = 5.0;
+    TS_ASSERT_EQUALS(table.L2s[5], 5.0);
+  }
+
+  void test_Geometries_Compare_Equal_Only_When_Everything_Matches()
+  {
+    PathLengthGeometry geom = createGeometry("shape", 0.0);
+    TS_ASSERT(geom == createGeometry("shape", 0.0));
+    TS_ASSERT(!(geom == createGeometry("other", 0.0)));
+    TS_ASSERT(!(geom == createGeometry("shape", 1.0)));
+
+    PathLengthGeometry noDetector = createGeometry("shape", 0.0);
+    noDetector.hasDetector[0] = false;
+    TS_ASSERT(!(geom == noDetector));
+  }
+
+  void test_Find_Returns_Stored_Table()
+  {
+    AbsorptionPathLengthCacheImpl cache;
+    TS_ASSERT(!cache.find(createGeometry("shape", 0.0)));
+
+    PathLengthTable_const_sptr table = createTable("shape", 0.0);
+    cache.store(table);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT_EQUALS(cache.find(createGeometry("shape", 0.0)), table);
+    TS_ASSERT(!cache.find(createGeometry("shape", 2.0)));
+    TS_ASSERT_EQUALS(cache.hits(), 1);
+  }
+
+  void test_Table_Memory_Size()
+  {
+    TS_ASSERT_EQUALS(PathLengthTable::memorySize(createGeometry("shape", 0.0)),
+                     6 * sizeof(double));
+  }
+
+  void test_Clearing_The_AnalysisDataService_Releases_The_Tables()
+  {
+    AbsorptionPathLengthCacheImpl cache;
+    cache.store(createTable("shape", 0.0));
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    Mantid::API::AnalysisDataService::Instance().clear();
+    TS_ASSERT_EQUALS(cache.size(), 0);
+  }
+
+  void test_Least_Recently_Used_Table_Is_Discarded()
+  {
+    AbsorptionPathLengthCacheImpl cache(2);
+    PathLengthTable_const_sptr first = createTable("shape", 0.0);
+    PathLengthTable_const_sptr second = createTable("shape", 1.0);
+    cache.store(first);
+    cache.store(second);
+    // Touch the first so the second becomes the oldest
+    TS_ASSERT(cache.find(first->geometry));
+    cache.store(createTable("shape", 2.0));
+
+    TS_ASSERT_EQUALS(cache.size(), 2);
+    TS_ASSERT(cache.find(first->geometry));
+    TS_ASSERT(!cache.find(second->geometry));
+  }
+
+  void test_Storing_The_Same_Geometry_Replaces_The_Table()
+  {
+    AbsorptionPathLengthCacheImpl cache(2);
+    cache.store(createTable("shape", 0.0));
+    PathLengthTable_const_sptr replacement = createTable("shape", 0.0);
+    cache.store(replacement);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT_EQUALS(cache.find(replacement->geometry), replacement);
+
+    cache.clear();
+    TS_ASSERT_EQUALS(cache.size(), 0);
+  }
+
+private:
+  PathLengthGeometry createGeometry(const std::string &shape, const double shift)
+  {
+    PathLengthGeometry geom;
+    geom.shapeXML = shape;
+    geom.elementPositions.push_back(V3D(0.0, 0.0, 0.0));
+    geom.elementPositions.push_back(V3D(0.0, 0.0, 0.1));
+    geom.elementPositions.push_back(V3D(0.0, 0.1, 0.0));
+    geom.detectorPositions.push_back(V3D(1.0 + shift, 0.0, 0.0));
+    geom.detectorPositions.push_back(V3D(0.0, 1.0, 0.0));
+    geom.hasDetector.resize(2, true);
+    return geom;
+  }
+
+  PathLengthTable_const_sptr createTable(const std::string &shape, const double shift)
+  {
+    return boost::make_shared<PathLengthTable>(createGeometry(shape, shift));
+  }
+};
+
+#endif /* MANTID_ALGORITHMS_ABSORPTIONPATHLENGTHCACHETEST_H_ */
@@ -0,0 +1,180 @@
+#ifndef MANTID_ALGORITHMS_ALIGNANDFOCUSEVENTSTEST_H_
+#define MANTID_ALGORITHMS_ALIGNANDFOCUSEVENTSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAlgorithms/AlignAndFocusEvents.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/OffsetsWorkspace.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <boost/lexical_cast.hpp>
+
+using namespace Mantid::Algorithms;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+
+class AlignAndFocusEventsTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlignAndFocusEventsTest *createSuite() { return new AlignAndFocusEventsTest(); }
+  static void destroySuite( AlignAndFocusEventsTest *suite ) { delete suite; }
+
+  void test_Init()
+  {
+    AlignAndFocusEvents alg;
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    TS_ASSERT( alg.isInitialized() )
+  }
+
+  void test_needs_calibration()
+  {
+    setUpInput();
+    AlignAndFocusEvents alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", m_inputName);
+    alg.setPropertyValue("OutputWorkspace", "AlignAndFocusEventsTest_out");
+    alg.setPropertyValue("GroupingWorkspace", m_groupName);
+    alg.setPropertyValue("Params", "0.1,0.1,1");
+    TS_ASSERT_THROWS( alg.execute(), std::invalid_argument );
+    tearDownInput();
+  }
+
+  void test_linear_binning_matches_align_focus_rebin()
+  {
+    doTestMatchesChain(false);
+  }
+
+  void test_log_binning_matches_align_focus_rebin()
+  {
+    doTestMatchesChain(true);
+  }
+
+  void test_one_group_per_pixel_matches_align_focus_rebin()
+  {
+    doTestMatchesChain(false, true);
+  }
+
+private:
+  void setUpInput(bool groupPerPixel = false)
+  {
+    m_inputName = "AlignAndFocusEventsTest_in";
+    m_groupName = "AlignAndFocusEventsTest_group";
+    m_offsetsName = "AlignAndFocusEventsTest_offsets";
+
+    EventWorkspace_sptr ws = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(2, 3, false);
+    ws->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+    // Make one spectrum weighted
+    ws->getEventList(4).multiply(2.0, 0.5);
+    AnalysisDataService::Instance().addOrReplace(m_inputName, ws);
+
+    OffsetsWorkspace_sptr offsets(new OffsetsWorkspace(ws->getInstrument()));
+    for (size_t i = 0; i < offsets->getNumberHistograms(); i++)
+      offsets->dataY(i)[0] = 0.01 * static_cast<double>(i % 3);
+    AnalysisDataService::Instance().addOrReplace(m_offsetsName, offsets);
+
+    FrameworkManager::Instance().exec("CreateGroupingWorkspace", 6,
+        "InputWorkspace", m_inputName.c_str(),
+        "GroupNames", "bank1,bank2",
+        "OutputWorkspace", m_groupName.c_str());
+    if (groupPerPixel)
+    {
+      GroupingWorkspace_sptr groupWS = AnalysisDataService::Instance().retrieveWS<GroupingWorkspace>(m_groupName);
+      for (size_t i = 0; i < groupWS->getNumberHistograms(); i++)
+        groupWS->dataY(i)[0] = static_cast<double>(i + 1);
+    }
+  }
+
+  void tearDownInput()
+  {
+    AnalysisDataService::Instance().remove(m_inputName);
+    AnalysisDataService::Instance().remove(m_groupName);
+    AnalysisDataService::Instance().remove(m_offsetsName);
+  }
+
+  void doTestMatchesChain(bool logBinning, bool groupPerPixel = false)
+  {
+    setUpInput(groupPerPixel);
+    const std::string chainName("AlignAndFocusEventsTest_chain");
+    const std::string fusedName("AlignAndFocusEventsTest_fused");
+
+    FrameworkManager::Instance().exec("AlignDetectors", 6,
+        "InputWorkspace", m_inputName.c_str(),
+        "OutputWorkspace", chainName.c_str(),
+        "OffsetsWorkspace", m_offsetsName.c_str());
+    EventWorkspace_sptr aligned = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(chainName);
+    const double dMin = aligned->getTofMin();
+    const double dMax = aligned->getTofMax();
+    std::string params = boost::lexical_cast<std::string>(dMin) + ",";
+    if (logBinning)
+      params += "-0.02,";
+    else
+      params += boost::lexical_cast<std::string>((dMax - dMin) / 37.) + ",";
+    params += boost::lexical_cast<std::string>(dMax * 1.001);
+
+    FrameworkManager::Instance().exec("DiffractionFocussing", 6,
+        "InputWorkspace", chainName.c_str(),
+        "OutputWorkspace", chainName.c_str(),
+        "GroupingWorkspace", m_groupName.c_str());
+    FrameworkManager::Instance().exec("Rebin", 8,
+        "InputWorkspace", chainName.c_str(),
+        "OutputWorkspace", chainName.c_str(),
+        "Params", params.c_str(),
+        "PreserveEvents", "0");
+
+    AlignAndFocusEvents alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", m_inputName);
+    alg.setPropertyValue("OutputWorkspace", fusedName);
+    alg.setPropertyValue("OffsetsWorkspace", m_offsetsName);
+    alg.setPropertyValue("GroupingWorkspace", m_groupName);
+    alg.setPropertyValue("Params", params);
+    TS_ASSERT_THROWS_NOTHING( alg.execute() );
+    TS_ASSERT( alg.isExecuted() );
+
+    MatrixWorkspace_sptr chain = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(chainName);
+    MatrixWorkspace_sptr fused;
+    TS_ASSERT_THROWS_NOTHING( fused = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(fusedName) );
+    if (!fused) return;
+
+    TS_ASSERT_EQUALS( fused->getAxis(0)->unit()->unitID(), "dSpacing" );
+    TS_ASSERT_EQUALS( fused->getNumberHistograms(), groupPerPixel ? 18 : 2 );
+    TS_ASSERT_EQUALS( fused->blocksize(), chain->blocksize() );
+    if (fused->getNumberHistograms() != chain->getNumberHistograms() || fused->blocksize() != chain->blocksize())
+      return;
+
+    double total = 0;
+    for (size_t wi = 0; wi < fused->getNumberHistograms(); wi++)
+    {
+      TS_ASSERT_EQUALS( fused->getSpectrum(wi)->getSpectrumNo(), chain->getSpectrum(wi)->getSpectrumNo() );
+      TS_ASSERT_EQUALS( fused->getSpectrum(wi)->getDetectorIDs(), chain->getSpectrum(wi)->getDetectorIDs() );
+      for (size_t i = 0; i < fused->blocksize(); i++)
+      {
+        TS_ASSERT_DELTA( fused->readX(wi)[i], chain->readX(wi)[i], 1e-10 );
+        TS_ASSERT_DELTA( fused->readY(wi)[i], chain->readY(wi)[i], 1e-10 );
+        TS_ASSERT_DELTA( fused->readE(wi)[i], chain->readE(wi)[i], 1e-10 );
+        total += fused->readY(wi)[i];
+      }
+    }
+    // 18 pixels of 200 events, one of them weighted by 2
+    TS_ASSERT_DELTA( total, 19. * 200., 1e-6 );
+
+    AnalysisDataService::Instance().remove(chainName);
+    AnalysisDataService::Instance().remove(fusedName);
+    tearDownInput();
+  }
+
+  std::string m_inputName;
+  std::string m_groupName;
+  std::string m_offsetsName;
+};
+
+
+#endif /* MANTID_ALGORITHMS_ALIGNANDFOCUSEVENTSTEST_H_ */
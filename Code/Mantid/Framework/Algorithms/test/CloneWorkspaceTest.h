@@ -81,6 +81,30 @@ public:
     TS_ASSERT_EQUALS( checker.getPropertyValue("Result"), checker.successString() );
   }
 
+  void test_clone_of_Workspace2D_does_not_alias_the_data_of_the_input()
+  {
+    Workspace2D_sptr in = WorkspaceCreationHelper::Create2DWorkspaceBinned(3, 4);
+    AnalysisDataService::Instance().addOrReplace("in_cow", in);
+    // A reference held from before the clone, as a writable numpy view is
+    MantidVec & inY = in->dataY(1);
+    const double original = inY[0];
+
+    Mantid::Algorithms::CloneWorkspace alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace","in_cow");
+    alg.setPropertyValue("OutputWorkspace","out_cow");
+    TS_ASSERT( alg.execute() );
+    MatrixWorkspace_sptr out = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("out_cow");
+
+    TS_ASSERT_DIFFERS( &in->readY(1), &out->readY(1) );
+    TS_ASSERT_DIFFERS( &in->readE(1), &out->readE(1) );
+    inY[0] = original + 1.0;
+    TS_ASSERT_EQUALS( in->readY(1)[0], original + 1.0 );
+    TS_ASSERT_EQUALS( out->readY(1)[0], original );
+
+    AnalysisDataService::Instance().remove("in_cow");
+    AnalysisDataService::Instance().remove("out_cow");
+  }
 
   void testExecEvent()
   {
@@ -16,6 +16,8 @@
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidGeometry/Instrument.h"
+#include <algorithm>
+#include <cfloat>
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -334,6 +336,85 @@ public:
     TS_ASSERT_DIFFERS(a_x, WS->getEventList(wkspIndex).dataX()[1]);
   }
 
+  void testExecEvent_TOF_to_dSpacing_matchesUnitConversion()
+  {
+    this->setup_Event();
+    EventWorkspace_sptr WS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(inputSpace);
+    WS->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+    const size_t wkspIndex = 3;
+    const Mantid::MantidVec xIn = WS->readX(wkspIndex);
+    const double tofIn = WS->getEventList(wkspIndex).getEvents()[5].tof();
+
+    ConvertUnits conv;
+    conv.initialize();
+    conv.setPropertyValue("InputWorkspace", inputSpace);
+    conv.setPropertyValue("OutputWorkspace", "ConvertUnitsTest_dSpacing");
+    conv.setPropertyValue("Target", "dSpacing");
+    TS_ASSERT_THROWS_NOTHING( conv.execute() );
+    TS_ASSERT( conv.isExecuted() );
+    EventWorkspace_sptr out = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("ConvertUnitsTest_dSpacing");
+    TS_ASSERT( out );
+    if (!out) return;
+
+    // The same conversion done one value at a time by the unit
+    IComponent_const_sptr sample = WS->getInstrument()->getSample();
+    IDetector_const_sptr det = WS->getDetector(wkspIndex);
+    Units::dSpacing d;
+    d.initialize(WS->getInstrument()->getSource()->getDistance(*sample), det->getDistance(*sample),
+                 WS->detectorTwoTheta(det), 0, 0.0, 0.0);
+    const Mantid::MantidVec &xOut = out->readX(wkspIndex);
+    TS_ASSERT_EQUALS( xOut.size(), xIn.size() );
+    for (size_t i = 0; i < xOut.size() && i < xIn.size(); i++)
+      TS_ASSERT_DELTA( xOut[i], d.singleFromTOF(xIn[i]), 1e-12 * d.singleFromTOF(xIn[i]) );
+    const double dExpected = d.singleFromTOF(tofIn);
+    TS_ASSERT_DELTA( out->getEventList(wkspIndex).getEvents()[5].tof(), dExpected, 1e-12 * dExpected );
+
+    AnalysisDataService::Instance().remove("ConvertUnitsTest_dSpacing");
+  }
+
+  void testExecEvent_zero_is_converted_as_by_the_units()
+  {
+    this->setup_Event();
+    EventWorkspace_sptr WS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(inputSpace);
+    WS->getAxis(0)->unit() = UnitFactory::Instance().create("Energy");
+    const size_t wkspIndex = 2;
+    WS->getEventList(wkspIndex).addEventQuickly(TofEvent(0.0));
+    WS->dataX(wkspIndex)[0] = 0.0;
+
+    ConvertUnits conv;
+    conv.initialize();
+    conv.setPropertyValue("InputWorkspace", inputSpace);
+    conv.setPropertyValue("OutputWorkspace", "ConvertUnitsTest_zero");
+    conv.setPropertyValue("Target", "dSpacing");
+    TS_ASSERT_THROWS_NOTHING( conv.execute() );
+    TS_ASSERT( conv.isExecuted() );
+    EventWorkspace_sptr out = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("ConvertUnitsTest_zero");
+    TS_ASSERT( out );
+    if (!out) return;
+
+    // An energy of zero is taken as DBL_MIN by the units rather than giving inf
+    IComponent_const_sptr sample = WS->getInstrument()->getSample();
+    IDetector_const_sptr det = WS->getDetector(wkspIndex);
+    const double l1 = WS->getInstrument()->getSource()->getDistance(*sample);
+    const double l2 = det->getDistance(*sample);
+    const double twoTheta = WS->detectorTwoTheta(det);
+    Units::Energy e;
+    e.initialize(l1, l2, twoTheta, 0, 0.0, 0.0);
+    Units::dSpacing d;
+    d.initialize(l1, l2, twoTheta, 0, 0.0, 0.0);
+    const double dExpected = d.singleFromTOF(e.singleToTOF(0.0));
+    TS_ASSERT( dExpected < DBL_MAX );
+
+    const Mantid::MantidVec &xOut = out->readX(wkspIndex);
+    const double xMax = *std::max_element(xOut.begin(), xOut.end());
+    TS_ASSERT_DELTA( xMax, dExpected, 1e-12 * dExpected );
+    const std::vector<double> tofs = out->getEventList(wkspIndex).getTofs();
+    const double tofMax = *std::max_element(tofs.begin(), tofs.end());
+    TS_ASSERT_DELTA( tofMax, dExpected, 1e-12 * dExpected );
+
+    AnalysisDataService::Instance().remove("ConvertUnitsTest_zero");
+  }
+
   void testExecEvent_TwoStepConversionWithDeltaE()
   {
     // Test to make sure the TOF->DeltaE->Other Quantity works for
@@ -4,6 +4,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidAlgorithms/CylinderAbsorption.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
@@ -98,8 +99,114 @@ public:
     Mantid::API::AnalysisDataService::Instance().remove(outputWS);
   }
 
+  void testRepeatedRunsGiveIdenticalResults()
+  {
+    // The second run takes its path lengths from the cache
+    using Mantid::Algorithms::AbsorptionPathLengthCache;
+    AbsorptionPathLengthCache::Instance().clear();
+    const size_t hitsBefore = AbsorptionPathLengthCache::Instance().hits();
+    MatrixWorkspace_sptr testWS = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(4, 10);
+    testWS->getAxis(0)->unit() = Mantid::Kernel::UnitFactory::Instance().create("Wavelength");
+
+    MatrixWorkspace_sptr first = runCorrection(testWS);
+    TS_ASSERT_EQUALS( AbsorptionPathLengthCache::Instance().size(), 1 );
+    TS_ASSERT_EQUALS( AbsorptionPathLengthCache::Instance().hits(), hitsBefore );
+    MatrixWorkspace_sptr second = runCorrection(testWS);
+    TS_ASSERT_EQUALS( AbsorptionPathLengthCache::Instance().hits(), hitsBefore + 1 );
+    TS_ASSERT( first );
+    TS_ASSERT( second );
+    if ( !first || !second ) return;
+
+    for ( size_t i = 0; i < first->getNumberHistograms(); ++i )
+    {
+      TS_ASSERT_EQUALS( first->readY(i), second->readY(i) );
+    }
+
+    // Clearing the workspaces releases the table
+    Mantid::API::AnalysisDataService::Instance().clear();
+    TS_ASSERT_EQUALS( AbsorptionPathLengthCache::Instance().size(), 0 );
+  }
+
+  void testPathLengthCacheCanBeSwitchedOff()
+  {
+    using Mantid::Algorithms::AbsorptionPathLengthCache;
+    Mantid::Kernel::ConfigServiceImpl &config = Mantid::Kernel::ConfigService::Instance();
+    const std::string key("AbsorptionCorrection.PathLengthCache.MaxSize");
+    const std::string oldValue = config.getString(key);
+    config.setString(key, "0");
+
+    MatrixWorkspace_sptr testWS = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(4, 10);
+    testWS->getAxis(0)->unit() = Mantid::Kernel::UnitFactory::Instance().create("Wavelength");
+    const size_t hitsBefore = AbsorptionPathLengthCache::Instance().hits();
+    TS_ASSERT( runCorrection(testWS) );
+    TS_ASSERT( runCorrection(testWS) );
+    TS_ASSERT_EQUALS( AbsorptionPathLengthCache::Instance().size(), 0 );
+    TS_ASSERT_EQUALS( AbsorptionPathLengthCache::Instance().hits(), hitsBefore );
+
+    config.setString(key, oldValue);
+  }
+
 private:
+  MatrixWorkspace_sptr runCorrection(MatrixWorkspace_sptr inputWS)
+  {
+    Mantid::Algorithms::CylinderAbsorption alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty<MatrixWorkspace_sptr>("InputWorkspace", inputWS);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setPropertyValue("CylinderSampleHeight","4");
+    alg.setPropertyValue("CylinderSampleRadius","0.4");
+    alg.setPropertyValue("AttenuationXSection","5.08");
+    alg.setPropertyValue("ScatteringXSection","5.1");
+    alg.setPropertyValue("SampleNumberDensity","0.07192");
+    alg.setPropertyValue("NumberOfSlices","2");
+    alg.setPropertyValue("NumberOfAnnuli","2");
+    alg.execute();
+    if ( !alg.isExecuted() ) return MatrixWorkspace_sptr();
+    return alg.getProperty("OutputWorkspace");
+  }
+
   Mantid::Algorithms::CylinderAbsorption atten;
 };
 
+class CylinderAbsorptionTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CylinderAbsorptionTestPerformance *createSuite() { return new CylinderAbsorptionTestPerformance(); }
+  static void destroySuite( CylinderAbsorptionTestPerformance *suite ) { delete suite; }
+
+  void test_coarse_integration()
+  {
+    runCorrection(1000, 2, 2);
+  }
+
+  void test_fine_integration()
+  {
+    runCorrection(1000, 10, 10);
+  }
+
+private:
+  void runCorrection(const int nhist, const int nslices, const int nannuli)
+  {
+    MatrixWorkspace_sptr inputWS = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(nhist, 100);
+    inputWS->getAxis(0)->unit() = Mantid::Kernel::UnitFactory::Instance().create("Wavelength");
+
+    Mantid::Algorithms::CylinderAbsorption alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty<MatrixWorkspace_sptr>("InputWorkspace", inputWS);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setPropertyValue("CylinderSampleHeight","4");
+    alg.setPropertyValue("CylinderSampleRadius","0.4");
+    alg.setPropertyValue("AttenuationXSection","5.08");
+    alg.setPropertyValue("ScatteringXSection","5.1");
+    alg.setPropertyValue("SampleNumberDensity","0.07192");
+    alg.setProperty("NumberOfSlices", nslices);
+    alg.setProperty("NumberOfAnnuli", nannuli);
+    TS_ASSERT(alg.execute());
+  }
+};
+
 #endif /*CYLINDERABSORPTIONTEST_H_*/
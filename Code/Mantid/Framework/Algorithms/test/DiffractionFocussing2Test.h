@@ -116,6 +116,56 @@ public:
   }
 
 
+  void test_EventWorkspace_mixedEventTypes()
+  {
+    std::string wsName("DiffractionFocussing2Test_mixed");
+    EventWorkspace_sptr inputW = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(3, 4);
+    MantidVecPtr x;
+    x.access().push_back(0.0);
+    x.access().push_back(1e6);
+    inputW->setAllX(x);
+    for (size_t pix=0; pix < inputW->getNumberHistograms(); pix++)
+      inputW->getEventList(pix).addEventQuickly( TofEvent(1000.0) );
+    // The first pixel of bank3 holds a weighted event; the rest are plain TOF
+    inputW->getEventList(32).multiply(2.0);
+    AnalysisDataService::Instance().addOrReplace(wsName, inputW);
+
+    FrameworkManager::Instance().exec("CreateGroupingWorkspace", 6,
+        "InputWorkspace",  wsName.c_str(),
+        "GroupNames", "bank3",
+        "OutputWorkspace", "DiffractionFocussing2Test_mixed_group");
+
+    DiffractionFocussing2 alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", wsName);
+    alg.setPropertyValue("OutputWorkspace", wsName + "_focussed");
+    alg.setPropertyValue("GroupingWorkspace", "DiffractionFocussing2Test_mixed_group");
+    TS_ASSERT_THROWS_NOTHING( alg.execute(); );
+    TS_ASSERT( alg.isExecuted() );
+
+    EventWorkspace_const_sptr output;
+    TS_ASSERT_THROWS_NOTHING( output = AnalysisDataService::Instance().retrieveWS<const EventWorkspace>(wsName + "_focussed") );
+    if (!output) return;
+    TS_ASSERT_EQUALS( output->getNumberHistograms(), 1);
+    const EventList & el = output->getEventList(0);
+    TS_ASSERT_EQUALS( el.getEventType(), WEIGHTED );
+    TS_ASSERT_EQUALS( el.getNumberEvents(), 16 );
+    TS_ASSERT_EQUALS( el.getDetectorIDs().size(), 16 );
+    double totalWeight = 0;
+    const std::vector<WeightedEvent> & events = el.getWeightedEvents();
+    for (size_t i = 0; i < events.size(); i++)
+    {
+      TS_ASSERT_DELTA( events[i].tof(), 1000.0, 1e-6 );
+      totalWeight += events[i].weight();
+    }
+    TS_ASSERT_DELTA( totalWeight, 17.0, 1e-6 );
+
+    AnalysisDataService::Instance().remove(wsName);
+    AnalysisDataService::Instance().remove(wsName + "_focussed");
+    AnalysisDataService::Instance().remove("DiffractionFocussing2Test_mixed_group");
+  }
+
+
   void dotestEventWorkspace(bool inplace, size_t numgroups, bool preserveEvents = true, int bankWidthInPixels=16 )
   {
     std::string nxsWSname("DiffractionFocussing2Test_ws");
@@ -245,8 +295,108 @@ public:
 
 
 
+  void test_Workspace2D_maskedBins_are_left_out_of_the_group()
+  {
+    // Flat spectra, so leaving the masked bins out and normalising by what
+    // is left must give the same focussed counts as no masking at all. (The
+    // errors grow, as they come from fewer counts.)
+    Workspace2D_sptr unmasked = WorkspaceCreationHelper::create2DWorkspaceWithRectangularInstrument(3, 4, 10);
+    Workspace2D_sptr masked = WorkspaceCreationHelper::create2DWorkspaceWithRectangularInstrument(3, 4, 10);
+    AnalysisDataService::Instance().addOrReplace("DiffractionFocussing2Test_masked", masked);
+    // Only bank3 (workspace indices 32 to 47) is masked, so a check by the
+    // position of a spectrum in its group would look at bank1 and miss it
+    MaskBins mask;
+    mask.initialize();
+    mask.setPropertyValue("InputWorkspace", "DiffractionFocussing2Test_masked");
+    mask.setPropertyValue("OutputWorkspace", "DiffractionFocussing2Test_masked");
+    mask.setPropertyValue("XMin", "3.0");
+    mask.setPropertyValue("XMax", "4.0");
+    mask.setPropertyValue("SpectraList", "32-47");
+    TS_ASSERT_THROWS_NOTHING( mask.execute() );
+    masked = AnalysisDataService::Instance().retrieveWS<Workspace2D>("DiffractionFocussing2Test_masked");
+    TS_ASSERT( masked->hasMaskedBins(32) );
+    TS_ASSERT( !masked->hasMaskedBins(0) );
+
+    MatrixWorkspace_sptr expected = focusHistograms(unmasked, "bank3");
+    MatrixWorkspace_sptr output = focusHistograms(masked, "bank3");
+    if (!expected || !output) return;
+    TS_ASSERT_EQUALS( output->getNumberHistograms(), 1 );
+
+    const MantidVec & X = output->readX(0);
+    const MantidVec & Y = output->readY(0);
+    size_t overlapping = 0;
+    for (size_t i = 0; i < Y.size(); ++i)
+    {
+      if (X[i] < 4.0 && X[i + 1] > 3.0) ++overlapping;
+      TS_ASSERT_DELTA( Y[i], expected->readY(0)[i], 1e-10 );
+    }
+    TSM_ASSERT( "Some output bins cover the masked range", overlapping > 0 );
+
+    AnalysisDataService::Instance().remove("DiffractionFocussing2Test_masked");
+  }
+
+  void test_Workspace2D_oneGroup_is_the_same_for_any_number_of_threads()
+  {
+    // One group of 64 spectra, each different, so that with several threads
+    // the spectra are shared out and the partial sums added together
+    Workspace2D_sptr inputW = WorkspaceCreationHelper::create2DWorkspaceWithRectangularInstrument(2, 8, 20);
+    for (size_t wi = 0; wi < inputW->getNumberHistograms(); ++wi)
+    {
+      MantidVec & Y = inputW->dataY(wi);
+      MantidVec & E = inputW->dataE(wi);
+      for (size_t i = 0; i < Y.size(); ++i)
+      {
+        Y[i] = 1.0 + static_cast<double>((wi * 7 + i * 3) % 11);
+        E[i] = std::sqrt(Y[i]);
+      }
+    }
+
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(1);
+    MatrixWorkspace_sptr serial = focusHistograms(inputW, "bank2");
+    PARALLEL_SET_NUM_THREADS(4);
+    MatrixWorkspace_sptr threaded = focusHistograms(inputW, "bank2");
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    if (!serial || !threaded) return;
+
+    TS_ASSERT_EQUALS( threaded->getNumberHistograms(), 1 );
+    TS_ASSERT_EQUALS( threaded->readX(0), serial->readX(0) );
+    TS_ASSERT_EQUALS( threaded->getSpectrum(0)->getDetectorIDs(), serial->getSpectrum(0)->getDetectorIDs() );
+    // Only the order of the additions differs
+    for (size_t i = 0; i < serial->blocksize(); ++i)
+    {
+      TS_ASSERT_DELTA( threaded->readY(0)[i], serial->readY(0)[i], 1e-10 * serial->readY(0)[i] );
+      TS_ASSERT_DELTA( threaded->readE(0)[i], serial->readE(0)[i], 1e-10 * serial->readE(0)[i] );
+    }
+  }
 
 private:
+  /// Focus the histograms of the named banks into one group each
+  MatrixWorkspace_sptr focusHistograms(Workspace2D_sptr inputW, const std::string & groupNames)
+  {
+    const std::string wsName("DiffractionFocussing2Test_histograms");
+    const std::string groupWSName("DiffractionFocussing2Test_histograms_group");
+    AnalysisDataService::Instance().addOrReplace(wsName, inputW);
+    FrameworkManager::Instance().exec("CreateGroupingWorkspace", 6,
+        "InputWorkspace",  wsName.c_str(),
+        "GroupNames", groupNames.c_str(),
+        "OutputWorkspace", groupWSName.c_str());
+
+    DiffractionFocussing2 alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", boost::static_pointer_cast<MatrixWorkspace>(inputW));
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setPropertyValue("GroupingWorkspace", groupWSName);
+    TS_ASSERT_THROWS_NOTHING( alg.execute() );
+    TS_ASSERT( alg.isExecuted() );
+
+    AnalysisDataService::Instance().remove(wsName);
+    AnalysisDataService::Instance().remove(groupWSName);
+    MatrixWorkspace_sptr output = alg.getProperty("OutputWorkspace");
+    return output;
+  }
+
   DiffractionFocussing2 focus;
 };
 
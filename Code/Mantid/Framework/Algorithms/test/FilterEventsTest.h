@@ -802,6 +802,83 @@ public:
 };
 
 
+class FilterEventsTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FilterEventsTestPerformance *createSuite() { return new FilterEventsTestPerformance(); }
+  static void destroySuite( FilterEventsTestPerformance *suite ) { delete suite; }
+
+  FilterEventsTestPerformance()
+    : runstart(20000000000), pulsedt(100*1000*1000), numpulses(200)
+  {
+  }
+
+  void setUp()
+  {
+    // 1000 detectors with 10 events in each of 200 pulses: 2 million events
+    EventWorkspace_sptr eventWS =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(10, 10, true);
+    eventWS->mutableRun().addProperty("run_start", Kernel::DateAndTime(runstart).toISO8601String(), true);
+    for (size_t i = 0; i < eventWS->getNumberHistograms(); ++i)
+    {
+      EventList* elist = eventWS->getEventListPtr(i);
+      for (int64_t pid = 0; pid < static_cast<int64_t>(numpulses); ++pid)
+      {
+        Kernel::DateAndTime pulsetime(runstart + pid*pulsedt);
+        for (size_t e = 0; e < 10; ++e)
+          elist->addEventQuickly(TofEvent(static_cast<double>(e*10000), pulsetime));
+      }
+    }
+    AnalysisDataService::Instance().addOrReplace("FilterEventsPerfInput", eventWS);
+  }
+
+  void tearDown()
+  {
+    AnalysisDataService::Instance().clear();
+  }
+
+  /// Three long splitters covering the run
+  void test_filter_by_few_splitters()
+  {
+    SplittersWorkspace_sptr splitters(new SplittersWorkspace);
+    const int64_t third = static_cast<int64_t>(numpulses)*pulsedt/3;
+    for (int i = 0; i < 3; ++i)
+      splitters->addSplitter(Kernel::SplittingInterval(runstart + i*third, runstart + (i+1)*third, i));
+    runFilter(splitters);
+  }
+
+  /// Two splitters within every pulse, as made from a fast sample log
+  void test_filter_by_many_splitters()
+  {
+    SplittersWorkspace_sptr splitters(new SplittersWorkspace);
+    for (int64_t i = 0; i < static_cast<int64_t>(numpulses); ++i)
+    {
+      const int64_t pulse = runstart + i*pulsedt;
+      splitters->addSplitter(Kernel::SplittingInterval(pulse + pulsedt/5, pulse + 2*pulsedt/5, 0));
+      splitters->addSplitter(Kernel::SplittingInterval(pulse + 3*pulsedt/5, pulse + 4*pulsedt/5, 1));
+    }
+    runFilter(splitters);
+  }
+
+private:
+  void runFilter(SplittersWorkspace_sptr splitters)
+  {
+    AnalysisDataService::Instance().addOrReplace("FilterEventsPerfSplitters", splitters);
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "FilterEventsPerfInput");
+    filter.setProperty("OutputWorkspaceBaseName", "FilterEventsPerfOutput");
+    filter.setProperty("SplitterWorkspace", "FilterEventsPerfSplitters");
+    TS_ASSERT(filter.execute());
+  }
+
+  int64_t runstart;
+  int64_t pulsedt;
+  size_t numpulses;
+};
+
 #endif /* MANTID_ALGORITHMS_FILTEREVENTSTEST_H_ */
 
 
@@ -25,6 +25,19 @@ using namespace Mantid::DataObjects;
 
 using namespace std;
 
+namespace
+{
+  /// A Gaussian on a flat background whose centre moves with the spectrum
+  struct MovingPeak
+  {
+    double operator()(double x, int spec)
+    {
+      const double c = 4.0 + 0.02 * spec;
+      return 1.0 + 30.0 * exp(-0.5 * (x - c) * (x - c) / (0.1 * 0.1));
+    }
+  };
+}
+
 class FindPeaksTest : public CxxTest::TestSuite
 {
 public:
@@ -110,6 +123,41 @@ public:
     AnalysisDataService::Instance().remove("FoundedSinglePeakTable");
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Test that the peaks of all spectra are in the output table in the order
+    * of the spectra, whichever thread fitted them
+    */
+  void test_findPeaksInAllSpectraAreOrderedBySpectrum()
+  {
+    const int nspec = 16;
+    MatrixWorkspace_sptr dataws =
+        WorkspaceCreationHelper::Create2DWorkspaceFromFunction(MovingPeak(), nspec, 0.0, 10.0, 0.02);
+
+    FindPeaks finder;
+    finder.initialize();
+    finder.setChild(true);
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("InputWorkspace", dataws) );
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("PeakPositions", "4.15") );
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("FitWindows", "3.5, 5.5") );
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("BackgroundType", "Flat") );
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("PeaksList", "unused") );
+
+    TS_ASSERT_THROWS_NOTHING( finder.execute() );
+    TS_ASSERT( finder.isExecuted() );
+
+    ITableWorkspace_sptr peaks = finder.getProperty("PeaksList");
+    TS_ASSERT_EQUALS( peaks->rowCount(), static_cast<size_t>(nspec) );
+    if (peaks->rowCount() != static_cast<size_t>(nspec))
+      return;
+
+    for (int i = 0; i < nspec; ++i)
+    {
+      TS_ASSERT_EQUALS( peaks->Int(i, 0), i );
+      TS_ASSERT_DELTA( peaks->getRef<double>("centre", i), 4.0 + 0.02 * i, 0.01 );
+      TS_ASSERT_DELTA( peaks->getRef<double>("height", i), 30.0, 1.0 );
+    }
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Test find peaks automaticallyclear
     */
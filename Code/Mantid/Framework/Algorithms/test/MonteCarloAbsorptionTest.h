@@ -56,10 +56,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("InputWorkspace", inputName));
     const std::string outputName("mcabsorb-factors");
     TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("OutputWorkspace",outputName));
-    const int numOMPThreads = FrameworkManager::Instance().getNumOMPThreads();
-    FrameworkManager::Instance().setNumOMPThreads(1); // To ensure reproducible results
     TS_ASSERT_THROWS_NOTHING(mcAbsorb->execute());
-    FrameworkManager::Instance().setNumOMPThreads(numOMPThreads);
 
     AnalysisDataServiceImpl & dataStore = AnalysisDataService::Instance();
     MatrixWorkspace_sptr factorWS =
@@ -73,18 +70,18 @@ public:
     // Pick out some random values
     const double delta(1e-08);
     const size_t middle_index = (nbins/2) - 1;
-    TS_ASSERT_DELTA(factorWS->readY(0).front(), 0.005869405757, delta);
-    TS_ASSERT_DELTA(factorWS->readY(0)[middle_index], 0.000104368636, delta);
-    TS_ASSERT_DELTA(factorWS->readY(0).back(), 0.000004337609, delta);
+    TS_ASSERT_DELTA(factorWS->readY(0).front(), 0.006447033942, delta);
+    TS_ASSERT_DELTA(factorWS->readY(0)[middle_index], 0.000058966746, delta);
+    TS_ASSERT_DELTA(factorWS->readY(0).back(), 0.000050359114, delta);
 
     // Different spectra
-    TS_ASSERT_DELTA(factorWS->readY(2).front(), 0.007355971026, delta);
-    TS_ASSERT_DELTA(factorWS->readY(2)[middle_index], 0.000092901957, delta);
-    TS_ASSERT_DELTA(factorWS->readY(2).back(), 0.000003265731, delta);
+    TS_ASSERT_DELTA(factorWS->readY(2).front(), 0.004409544246, delta);
+    TS_ASSERT_DELTA(factorWS->readY(2)[middle_index], 0.000231558469, delta);
+    TS_ASSERT_DELTA(factorWS->readY(2).back(), 0.000000402047, delta);
 
-    TS_ASSERT_DELTA(factorWS->readY(4).front(), 0.004037809093, delta);
-    TS_ASSERT_DELTA(factorWS->readY(4)[middle_index], 0.000190782521, delta);
-    TS_ASSERT_DELTA(factorWS->readY(4).back(), 0.000019473169, delta);
+    TS_ASSERT_DELTA(factorWS->readY(4).front(), 0.004909494366, delta);
+    TS_ASSERT_DELTA(factorWS->readY(4)[middle_index], 0.000507221027, delta);
+    TS_ASSERT_DELTA(factorWS->readY(4).back(), 0.000003510573, delta);
 
     dataStore.remove(inputName);
     dataStore.remove(outputName);
@@ -115,14 +112,102 @@ public:
     // Pick out some random values
     const double delta(1e-08);
     const size_t middle_index = (nbins/2) - 1;
-    TS_ASSERT_DELTA(factorWS->readY(0).front(), 0.005122949, delta);
-    TS_ASSERT_DELTA(factorWS->readY(0)[middle_index], 0.000238143162, delta);
-    TS_ASSERT_DELTA(factorWS->readY(0).back(), 0.000003069996, delta);
+    TS_ASSERT_DELTA(factorWS->readY(0).front(), 0.006317961822, delta);
+    TS_ASSERT_DELTA(factorWS->readY(0)[middle_index], 0.000280009260, delta);
+    TS_ASSERT_DELTA(factorWS->readY(0).back(), 0.000014415897, delta);
 
     dataStore.remove(inputName);
     dataStore.remove(outputName);
   }
 
+  void test_Results_Do_Not_Depend_On_The_Number_Of_Threads()
+  {
+    using namespace Mantid::API;
+
+    AnalysisDataServiceImpl & dataStore = AnalysisDataService::Instance();
+    const std::string inputName("mcabsorb-input");
+    setUpWS(inputName);
+
+    const int numOMPThreads = FrameworkManager::Instance().getNumOMPThreads();
+    FrameworkManager::Instance().setNumOMPThreads(1);
+    auto serialWS = runAlgorithm(inputName, "mcabsorb-serial");
+    FrameworkManager::Instance().setNumOMPThreads(std::max(numOMPThreads, 4));
+    auto parallelWS = runAlgorithm(inputName, "mcabsorb-parallel");
+    FrameworkManager::Instance().setNumOMPThreads(numOMPThreads);
+
+    TS_ASSERT(serialWS);
+    TS_ASSERT(parallelWS);
+    if( !serialWS || !parallelWS ) return;
+    for(size_t i = 0; i < serialWS->getNumberHistograms(); ++i)
+    {
+      TS_ASSERT_EQUALS(serialWS->readY(i), parallelWS->readY(i));
+    }
+
+    dataStore.remove(inputName);
+    dataStore.remove("mcabsorb-serial");
+    dataStore.remove("mcabsorb-parallel");
+  }
+
+  void test_Relative_Error_Tolerance_Generates_Extra_Events_Up_To_The_Maximum()
+  {
+    using namespace Mantid::API;
+
+    AnalysisDataServiceImpl & dataStore = AnalysisDataService::Instance();
+    const std::string inputName("mcabsorb-input");
+    setUpWS(inputName, 1, 10);
+
+    auto mcAbsorb = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("InputWorkspace", inputName));
+    const std::string outputName("mcabsorb-factors");
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("OutputWorkspace",outputName));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setProperty("RelativeErrorTolerance", 0.2));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setProperty("MaxEventsPerPoint", 1000));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->execute());
+
+    auto factorWS = boost::dynamic_pointer_cast<MatrixWorkspace>(dataStore.retrieve(outputName));
+    TS_ASSERT(factorWS);
+    if( !factorWS ) TS_FAIL("Cannot retrieve output workspace");
+
+    // The error is the standard error of the mean. The first point meets the
+    // tolerance while the last stops at the maximum number of events
+    const double delta(1e-08);
+    TS_ASSERT_LESS_THAN_EQUALS(factorWS->readE(0).front(), 0.2 * factorWS->readY(0).front());
+    TS_ASSERT_LESS_THAN(0.2 * factorWS->readY(0).back(), factorWS->readE(0).back());
+    TS_ASSERT_DELTA(factorWS->readY(0).front(), 0.006231575287, delta);
+
+    dataStore.remove(inputName);
+    dataStore.remove(outputName);
+  }
+
+  void test_Reported_Error_Tracks_The_Relative_Error_Tolerance()
+  {
+    using namespace Mantid::API;
+
+    AnalysisDataServiceImpl & dataStore = AnalysisDataService::Instance();
+    const std::string inputName("mcabsorb-input");
+    setUpWS(inputName, 1, 10);
+
+    MatrixWorkspace_sptr looseWS = runWithTolerance(inputName, "mcabsorb-loose", 0.2);
+    MatrixWorkspace_sptr tightWS = runWithTolerance(inputName, "mcabsorb-tight", 0.05);
+    TS_ASSERT(looseWS);
+    TS_ASSERT(tightWS);
+    if( !looseWS || !tightWS ) return;
+
+    const double looseY = looseWS->readY(0).front();
+    const double looseE = looseWS->readE(0).front();
+    const double tightY = tightWS->readY(0).front();
+    const double tightE = tightWS->readE(0).front();
+    TS_ASSERT_LESS_THAN(0.0, looseE);
+    TS_ASSERT_LESS_THAN_EQUALS(looseE, 0.2 * looseY);
+    TS_ASSERT_LESS_THAN(0.0, tightE);
+    TS_ASSERT_LESS_THAN_EQUALS(tightE, 0.05 * tightY);
+    TS_ASSERT_LESS_THAN(tightE, looseE);
+
+    dataStore.remove(inputName);
+    dataStore.remove("mcabsorb-loose");
+    dataStore.remove("mcabsorb-tight");
+  }
+
 
 private:
 
@@ -173,6 +258,33 @@ private:
     AnalysisDataService::Instance().add(name, space);
   }
 
+  Mantid::API::MatrixWorkspace_sptr runWithTolerance(const std::string & inputName,
+                                                     const std::string & outputName,
+                                                     const double tolerance)
+  {
+    using namespace Mantid::API;
+    auto mcAbsorb = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("InputWorkspace", inputName));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("OutputWorkspace",outputName));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setProperty("RelativeErrorTolerance", tolerance));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setProperty("MaxEventsPerPoint", 100000));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->execute());
+    return boost::dynamic_pointer_cast<MatrixWorkspace>(
+        AnalysisDataService::Instance().retrieve(outputName));
+  }
+
+  Mantid::API::MatrixWorkspace_sptr runAlgorithm(const std::string & inputName,
+                                                 const std::string & outputName)
+  {
+    using namespace Mantid::API;
+    auto mcAbsorb = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("InputWorkspace", inputName));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->setPropertyValue("OutputWorkspace",outputName));
+    TS_ASSERT_THROWS_NOTHING(mcAbsorb->execute());
+    return boost::dynamic_pointer_cast<MatrixWorkspace>(
+        AnalysisDataService::Instance().retrieve(outputName));
+  }
+
   Mantid::API::IAlgorithm_sptr createAlgorithm()
   {
     auto mcAbsorb = boost::shared_ptr<Mantid::API::IAlgorithm>(new Mantid::Algorithms::MonteCarloAbsorption());
@@ -0,0 +1,169 @@
+#ifndef MANTID_ALGORITHMS_OVERLAPWEIGHTSTEST_H_
+#define MANTID_ALGORITHMS_OVERLAPWEIGHTSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAlgorithms/OverlapWeights.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::Algorithms;
+using Mantid::API::MatrixWorkspace_sptr;
+
+class OverlapWeightsTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static OverlapWeightsTest *createSuite() { return new OverlapWeightsTest(); }
+  static void destroySuite( OverlapWeightsTest *suite ) { delete suite; }
+
+  void test_Geometries_Compare_Equal_Only_When_Everything_Matches()
+  {
+    OverlapGeometry geom = createGeometry("Rebin2D", 1.0);
+    TS_ASSERT(geom == createGeometry("Rebin2D", 1.0));
+    TS_ASSERT(!(geom == createGeometry("SofQW3", 1.0)));
+    TS_ASSERT(!(geom == createGeometry("Rebin2D", 2.0)));
+  }
+
+  void test_Apply_Adds_Weighted_Input_To_Each_Output_Bin()
+  {
+    // 2 input spectra of 2 bins, all Y=2 and E=sqrt(2)
+    MatrixWorkspace_sptr inputWS = WorkspaceCreationHelper::Create2DWorkspaceBinned(2, 2);
+    MatrixWorkspace_sptr outputWS = WorkspaceCreationHelper::Create2DWorkspaceBinned(2, 2);
+    for(size_t i = 0; i < 2; ++i)
+    {
+      outputWS->dataY(i).assign(2, 0.0);
+      outputWS->dataE(i).assign(2, 0.0);
+    }
+    inputWS->dataY(1)[0] = 4.0;
+
+    // Output row 1 receives half of input bin (1,0) and a quarter of (0,1),
+    // listed out of order to check they are sorted by input spectrum
+    std::vector<std::vector<OutputOverlap>> overlaps(2);
+    overlaps[1].push_back(createOverlap(1, 2, 0, 0.5, 1.0));
+    overlaps[0].push_back(createOverlap(1, 1, 0, 0.25, 2.0));
+    overlaps[0].push_back(createOverlap(0, 0, 1, 1.0, 1.0));
+
+    OverlapWeights weights(createGeometry("Rebin2D", 1.0), 2, 2, overlaps);
+    TS_ASSERT_EQUALS(weights.size(), 3);
+
+    weights.apply(inputWS, outputWS, false, false);
+    TS_ASSERT_DELTA(outputWS->readY(0)[0], 0.0, 1e-12);
+    TS_ASSERT_DELTA(outputWS->readY(0)[1], 2.0, 1e-12);
+    TS_ASSERT_DELTA(outputWS->readY(1)[0], 0.25 * 2.0 + 0.5 * 4.0, 1e-12);
+    TS_ASSERT_DELTA(outputWS->readE(1)[0], 0.0625 * 2.0 + 0.25 * 2.0, 1e-12);
+
+    // Scaling by width applies to both the signal and the errors
+    weights.apply(inputWS, outputWS, true, false);
+    TS_ASSERT_DELTA(outputWS->readY(1)[0], 2.5 + 0.25 * 2.0 * 2.0 + 0.5 * 4.0, 1e-12);
+  }
+
+  void test_Apply_Skips_NaN_Input()
+  {
+    MatrixWorkspace_sptr inputWS = WorkspaceCreationHelper::Create2DWorkspaceBinned(1, 1);
+    MatrixWorkspace_sptr outputWS = WorkspaceCreationHelper::Create2DWorkspaceBinned(1, 1);
+    outputWS->dataY(0)[0] = 0.0;
+    outputWS->dataE(0)[0] = 0.0;
+    inputWS->dataY(0)[0] = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<std::vector<OutputOverlap>> overlaps(1);
+    overlaps[0].push_back(createOverlap(0, 0, 0, 1.0, 1.0));
+    OverlapWeights weights(createGeometry("Rebin2D", 1.0), 1, 1, overlaps);
+    weights.apply(inputWS, outputWS, false, false);
+    TS_ASSERT_EQUALS(outputWS->readY(0)[0], 0.0);
+    TS_ASSERT_EQUALS(outputWS->readE(0)[0], 0.0);
+  }
+
+  void test_Fractions_Require_A_RebinnedOutput()
+  {
+    MatrixWorkspace_sptr inputWS = WorkspaceCreationHelper::Create2DWorkspaceBinned(1, 1);
+    std::vector<std::vector<OutputOverlap>> overlaps(1);
+    OverlapWeights weights(createGeometry("Rebin2D", 1.0), 1, 1, overlaps);
+    TS_ASSERT_THROWS(weights.apply(inputWS, inputWS, false, true), std::invalid_argument);
+  }
+
+  void test_Cache_Finds_Stored_Weights_And_Discards_Least_Recently_Used()
+  {
+    OverlapWeightsCacheImpl cache(2);
+    TS_ASSERT(!cache.find(createGeometry("Rebin2D", 1.0)));
+
+    cache.store(createWeights(1.0));
+    cache.store(createWeights(2.0));
+    // Using the first makes the second the oldest
+    TS_ASSERT(cache.find(createGeometry("Rebin2D", 1.0)));
+    cache.store(createWeights(3.0));
+
+    TS_ASSERT_EQUALS(cache.size(), 2);
+    TS_ASSERT(cache.find(createGeometry("Rebin2D", 1.0)));
+    TS_ASSERT(!cache.find(createGeometry("Rebin2D", 2.0)));
+    TS_ASSERT(cache.find(createGeometry("Rebin2D", 3.0)));
+
+    // Storing the same geometry again replaces the old weights
+    cache.store(createWeights(3.0));
+    TS_ASSERT_EQUALS(cache.size(), 2);
+
+    cache.clear();
+    TS_ASSERT_EQUALS(cache.size(), 0);
+  }
+
+  void test_Cache_Keeps_Within_Memory_Limit()
+  {
+    OverlapWeightsCacheImpl cache(2);
+    OverlapWeights_const_sptr first = createWeights(1.0);
+    const size_t oneSet = first->memorySize();
+
+    cache.store(first, oneSet);
+    TS_ASSERT_EQUALS(cache.memorySize(), oneSet);
+    // Only one set fits, so the older is discarded
+    cache.store(createWeights(2.0), oneSet);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT_EQUALS(cache.memorySize(), oneSet);
+    TS_ASSERT(!cache.find(first->geometry));
+    // Weights larger than the limit are not kept at all
+    cache.store(createWeights(3.0), oneSet - 1);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT(!cache.find(createGeometry("Rebin2D", 3.0)));
+  }
+
+  void test_Clearing_The_AnalysisDataService_Releases_The_Weights()
+  {
+    OverlapWeightsCacheImpl cache(2);
+    cache.store(createWeights(1.0));
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    Mantid::API::AnalysisDataService::Instance().clear();
+    TS_ASSERT_EQUALS(cache.size(), 0);
+    TS_ASSERT_EQUALS(cache.memorySize(), 0);
+  }
+
+private:
+  OverlapGeometry createGeometry(const std::string & method, const double edge)
+  {
+    OverlapGeometry geom;
+    geom.method = method;
+    geom.parameters.push_back(0.0);
+    geom.parameters.push_back(edge);
+    return geom;
+  }
+
+  OutputOverlap createOverlap(const size_t row, const size_t inputIndex, const size_t outputBin,
+                              const double weight, const double width)
+  {
+    OutputOverlap item;
+    item.outputRow = row;
+    item.overlap.inputIndex = inputIndex;
+    item.overlap.outputBin = outputBin;
+    item.overlap.weight = weight;
+    item.overlap.width = width;
+    return item;
+  }
+
+  OverlapWeights_const_sptr createWeights(const double edge)
+  {
+    return boost::make_shared<OverlapWeights>(createGeometry("Rebin2D", edge), 1, 1,
+                                              std::vector<std::vector<OutputOverlap>>(1));
+  }
+
+};
+
+#endif /* MANTID_ALGORITHMS_OVERLAPWEIGHTSTEST_H_ */
@@ -6,9 +6,11 @@
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidAPI/NumericAxis.h"
 
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Timer.h"
 
 using Mantid::Algorithms::Rebin2D;
+using Mantid::Algorithms::OverlapWeightsCache;
 using namespace Mantid::API;
 
 namespace
@@ -158,6 +160,56 @@ public:
 
   }
 
+  void test_Rerun_With_Same_Binning_Reuses_Cached_Weights()
+  {
+    OverlapWeightsCache::Instance().clear();
+    MatrixWorkspace_sptr inputWS = makeInputWS(false);
+    MatrixWorkspace_sptr firstWS = runAlgorithm(inputWS, "5.,1.8,15", "-0.5,2.5,9.5");
+    TS_ASSERT_EQUALS(OverlapWeightsCache::Instance().size(), 1);
+
+    // Different data with the same binning
+    MatrixWorkspace_sptr scaledWS = makeInputWS(false);
+    for(size_t i = 0; i < scaledWS->getNumberHistograms(); ++i)
+    {
+      Mantid::MantidVec & Y = scaledWS->dataY(i);
+      Mantid::MantidVec & E = scaledWS->dataE(i);
+      for(size_t j = 0; j < Y.size(); ++j)
+      {
+        Y[j] *= 3.0;
+        E[j] *= 3.0;
+      }
+    }
+    MatrixWorkspace_sptr secondWS = runAlgorithm(scaledWS, "5.,1.8,15", "-0.5,2.5,9.5");
+    TS_ASSERT_EQUALS(OverlapWeightsCache::Instance().size(), 1);
+
+    TS_ASSERT_EQUALS(secondWS->getNumberHistograms(), firstWS->getNumberHistograms());
+    for(size_t i = 0; i < secondWS->getNumberHistograms(); ++i)
+    {
+      for(size_t j = 0; j < secondWS->blocksize(); ++j)
+      {
+        TS_ASSERT_DELTA(secondWS->readY(i)[j], 3.0*firstWS->readY(i)[j], 1e-10);
+        TS_ASSERT_DELTA(secondWS->readE(i)[j], 3.0*firstWS->readE(i)[j], 1e-10);
+      }
+    }
+    AnalysisDataService::Instance().remove(secondWS->getName());
+    OverlapWeightsCache::Instance().clear();
+  }
+
+  void test_Weights_Are_Not_Cached_When_Switched_Off()
+  {
+    Mantid::Kernel::ConfigServiceImpl & config = Mantid::Kernel::ConfigService::Instance();
+    const std::string key("Rebin2D.OverlapWeightsCache.MaxSize");
+    const std::string oldValue = config.getString(key);
+    config.setString(key, "0");
+
+    OverlapWeightsCache::Instance().clear();
+    MatrixWorkspace_sptr outputWS = runAlgorithm(makeInputWS(false), "5.,1.8,15", "-0.5,2.5,9.5");
+    TS_ASSERT_EQUALS(OverlapWeightsCache::Instance().size(), 0);
+    AnalysisDataService::Instance().remove(outputWS->getName());
+
+    config.setString(key, oldValue);
+  }
+
 
 private:
   
@@ -4,6 +4,7 @@
 #include <cxxtest/TestSuite.h>
 #include "MantidAlgorithms/SofQW3.h"
 #include "MantidDataHandling/LoadNexusProcessed.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
 #include <iomanip>
 
@@ -90,5 +91,62 @@ public:
 };
 
 
+class SofQW3TestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SofQW3TestPerformance *createSuite() { return new SofQW3TestPerformance(); }
+  static void destroySuite( SofQW3TestPerformance *suite ) { delete suite; }
+
+  void tearDown()
+  {
+    AnalysisDataService::Instance().remove("SofQW3TestPerformance_out");
+  }
+
+  void test_100_spectra()
+  {
+    runSofQW3(createInputWorkspace(100, 2000));
+  }
+
+  void test_1000_spectra()
+  {
+    runSofQW3(createInputWorkspace(1000, 2000));
+  }
+
+private:
+  /// Direct geometry data in energy transfer, -10 to 10 meV, with common bins
+  MatrixWorkspace_sptr createInputWorkspace(const int nhist, const int nbins)
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(nhist, nbins);
+    ws->getAxis(0)->setUnit("DeltaE");
+    Mantid::MantidVecPtr x;
+    x.access().resize(nbins + 1);
+    const double width = 20.0 / nbins;
+    for (int i = 0; i <= nbins; ++i)
+    {
+      x.access()[i] = -10.0 + i * width;
+    }
+    for (int i = 0; i < nhist; ++i)
+    {
+      ws->setX(i, x);
+    }
+    return ws;
+  }
+
+  void runSofQW3(MatrixWorkspace_sptr inputWS)
+  {
+    SofQW3 sqw;
+    sqw.initialize();
+    sqw.setProperty("InputWorkspace", inputWS);
+    sqw.setPropertyValue("OutputWorkspace", "SofQW3TestPerformance_out");
+    sqw.setPropertyValue("QAxisBinning", "0,0.05,5");
+    sqw.setPropertyValue("EMode", "Direct");
+    sqw.setPropertyValue("EFixed", "25");
+    TS_ASSERT(sqw.execute());
+  }
+};
+
+
 #endif /* MANTID_ALGORITHMS_SOFQW2TEST_H_ */
 
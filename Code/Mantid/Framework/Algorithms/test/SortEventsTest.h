@@ -132,5 +132,58 @@ public:
 };
 
 
+class SortEventsTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SortEventsTestPerformance *createSuite() { return new SortEventsTestPerformance(); }
+  static void destroySuite( SortEventsTestPerformance *suite ) { delete suite; }
+
+  SortEventsTestPerformance() : wsName("SortEventsTestPerformance_events")
+  {
+  }
+
+  void setUp()
+  {
+    // 10 million events in 10000 spectra
+    EventWorkspace_sptr ws = WorkspaceCreationHelper::CreateRandomEventWorkspace(1000, 10000);
+    AnalysisDataService::Instance().addOrReplace(wsName, ws);
+  }
+
+  void tearDown()
+  {
+    AnalysisDataService::Instance().remove(wsName);
+  }
+
+  void test_sort_by_tof()
+  {
+    runSort("X Value");
+  }
+
+  void test_sort_by_pulse_time()
+  {
+    runSort("Pulse Time");
+  }
+
+  void test_sort_by_pulse_time_then_tof()
+  {
+    runSort("Pulse Time + TOF");
+  }
+
+private:
+  void runSort(const std::string & sortBy)
+  {
+    SortEvents sort;
+    sort.initialize();
+    sort.setPropertyValue("InputWorkspace", wsName);
+    sort.setPropertyValue("SortBy", sortBy);
+    TS_ASSERT(sort.execute());
+  }
+
+  std::string wsName;
+};
+
+
 #endif /* MANTID_ALGORITHMS_SORTEVENTSTEST_H_ */
 
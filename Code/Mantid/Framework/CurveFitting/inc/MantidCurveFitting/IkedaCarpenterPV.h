@@ -94,6 +94,13 @@ private:
   void convertVoigtToPseudo(const double &voigtSigmaSq,
                             const double &voigtGamma, double &H,
                             double &eta) const;
+
+  /// convert voigt params to pseudo voigt params with their derivatives
+  void convertVoigtToPseudoDeriv(const double &voigtSigmaSq,
+                                 const double &voigtGamma, double &H,
+                                 double &eta, double &dHdSigmaSq,
+                                 double &dHdGamma, double &dEtadSigmaSq,
+                                 double &dEtadGamma) const;
 };
 
 } // namespace CurveFitting
@@ -0,0 +1,135 @@
+#ifndef MANTID_CURVEFITTING_MULTISPECTRUMFITTER_H_
+#define MANTID_CURVEFITTING_MULTISPECTRUMFITTER_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidKernel/System.h"
+#include "MantidAPI/IFunction.h"
+#include "MantidAPI/MatrixWorkspace.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+//----------------------------------------------------------------------
+// Forward declarations
+//----------------------------------------------------------------------
+class FitMW;
+
+/**
+Fits many spectra independently with the same function without going through
+the Fit algorithm for each of them.
+
+The function string is parsed once for each thread that will do fitting and
+the parsed function and domain creator are reused for every spectrum that the
+thread fits. Only the minimizer and cost function, which hold the state of a
+single minimization, are created for each fit. The fit itself follows the
+same steps as the Fit algorithm with its default options.
+
+Call prepare() before fitting. After that fit() may be called concurrently as
+long as each thread passes its own thread number.
+
+Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MultiSpectrumFitter {
+public:
+  /// The outcome of fitting one spectrum
+  struct Result {
+    /// Fitted values of all of the function's parameters
+    std::vector<double> parameters;
+    /// Errors of all of the function's parameters
+    std::vector<double> errors;
+    /// Cost function value divided by the number of degrees of freedom
+    double chi2;
+    /// The status string reported by the minimizer
+    std::string status;
+  };
+
+  /// Constructor
+  MultiSpectrumFitter(const std::string &function,
+                      const std::string &minimizer,
+                      const std::string &costFunction);
+  /// Destructor
+  ~MultiSpectrumFitter();
+
+  /// Set the fitting range, EMPTY_DBL() for both uses the whole spectrum
+  void setRange(const double startX, const double endX);
+  /// Set the maximum number of minimizer iterations for each fit
+  void setMaxIterations(const size_t maxIterations);
+  /// Set whether the workspace index is passed to WorkspaceIndex attributes
+  void setPassWorkspaceIndex(const bool on);
+
+  /// Number of parameters of the function
+  size_t nParams() const;
+  /// Name of a parameter of the function
+  std::string parameterName(const size_t i) const;
+  /// Parameter values of the function as given by the function string
+  const std::vector<double> &initialParameters() const {
+    return m_initialParameters;
+  }
+
+  /// Create the per-thread state for the given number of threads
+  void prepare(const size_t nThreads);
+  /// Fit one spectrum using the state of the given thread
+  void fit(const size_t thread, API::MatrixWorkspace_sptr ws,
+           const size_t wsIndex, const std::vector<double> &startParameters,
+           Result &result) const;
+
+private:
+  /// Disable copy and assignment
+  MultiSpectrumFitter(const MultiSpectrumFitter &);
+  MultiSpectrumFitter &operator=(const MultiSpectrumFitter &);
+
+  /// Set any WorkspaceIndex attributes in a function and its members
+  static void setWorkspaceIndexAttribute(API::IFunction_sptr fun,
+                                         const int wsIndex);
+
+  /// The function string
+  const std::string m_functionString;
+  /// Name of the minimizer, as known to FuncMinimizerFactory
+  const std::string m_minimizer;
+  /// Name of the cost function, as known to CostFunctionFactory
+  const std::string m_costFunction;
+  /// Lower end of the fitting range
+  double m_startX;
+  /// Upper end of the fitting range
+  double m_endX;
+  /// Maximum number of minimizer iterations
+  size_t m_maxIterations;
+  /// If true set WorkspaceIndex attributes before each fit
+  bool m_passWorkspaceIndex;
+  /// Function parsed from the string, used for names and starting values
+  API::IFunction_sptr m_template;
+  /// Parameter values of m_template
+  std::vector<double> m_initialParameters;
+  /// A parsed function for each thread
+  std::vector<API::IFunction_sptr> m_functions;
+  /// A domain creator for each thread
+  std::vector<boost::shared_ptr<FitMW>> m_creators;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /*MANTID_CURVEFITTING_MULTISPECTRUMFITTER_H_*/
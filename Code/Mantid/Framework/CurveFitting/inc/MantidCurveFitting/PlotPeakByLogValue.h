@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/IFunction.h"
+#include "MantidAPI/ITableWorkspace.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -77,6 +78,19 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
     std::vector<int> indx; ///< a list of ws indices to fit if i and spec < 0
   };
 
+  /** A single spectrum to fit and the values that identify it in the output
+    */
+  struct FitJob {
+    /// Constructor
+    FitJob(const std::string &src, API::MatrixWorkspace_sptr w, int j,
+           double lv)
+        : source(src), ws(w), wsIndex(j), logValue(lv) {}
+    std::string source;           ///< Name of the workspace or file
+    API::MatrixWorkspace_sptr ws; ///< The workspace containing the spectrum
+    int wsIndex;                  ///< Workspace index of the spectrum
+    double logValue;              ///< Value to plot the parameters against
+  };
+
 public:
   /// Default constructor
   PlotPeakByLogValue() : API::Algorithm(){};
@@ -107,6 +121,17 @@ private:
 
   /// Create a list of input workspace names
   std::vector<InputData> makeNames() const;
+
+  /// Create the list of spectra to fit
+  std::vector<FitJob> makeJobs(const std::vector<InputData> &wsNames);
+
+  /// Fit the spectra with the Fit algorithm, creating its output workspaces
+  void fitWithOutput(const std::vector<FitJob> &jobs, API::IFunction_sptr ifun,
+                     API::ITableWorkspace_sptr result, bool isDataName);
+
+  /// Fit the spectra without creating output workspaces
+  void fitInBatch(const std::vector<FitJob> &jobs, const std::string &fun,
+                  API::ITableWorkspace_sptr result, bool isDataName);
 };
 
 } // namespace CurveFitting
@@ -116,6 +116,9 @@ private:
   /// Derivative
   virtual void functionDeriv(const API::FunctionDomain &domain,
                              API::Jacobian &jacobian);
+  /// Derivative within the peak range
+  virtual void functionDeriv1D(API::Jacobian *out, const double *xValues,
+                               const size_t nData);
 
   /// Overwrite IFunction base class method, which declare function parameters
   virtual void init();
@@ -135,6 +138,18 @@ private:
                   const double sigma2, const double invert_sqrt2sigma,
                   const bool explicitoutput = false) const;
 
+  /// Derivatives of TOF_h, alpha, beta, sigma^2 and gamma by the parameters
+  void calProfileDerivatives(std::vector<double> &derivs) const;
+
+  /// Calculate Omega and its derivatives by TOF_h, alpha, beta, sigma^2, gamma
+  double calOmegaDerivatives(const double x,
+                             const std::vector<double> &profileDerivs,
+                             double *dOmega) const;
+
+  /// Set the derivatives by all parameters at one data point
+  void setDerivatives(API::Jacobian *out, const size_t id, const double xValue,
+                      const std::vector<double> &profileDerivs) const;
+
   /// Set 2 functions to be hidden from client
   /*
   virtual void setCentre(const double c);
@@ -123,13 +123,72 @@ void BackToBackExponential::function1D(double *out, const double *xValues,
 }
 
 /**
- * Evaluate function derivatives numerically.
+ * Evaluate function derivatives analytically. Writing the function as
+ * I*N*(E1 + E2) with E1 = exp(u1)*erfc(y1) and E2 = exp(u2)*erfc(y2), the
+ * derivative of each term is E*du - 2/sqrt(pi)*exp(u - y^2)*dy and
+ * u - y^2 = -diff^2/(2*S^2) for both of them. So all the derivatives at a
+ * point cost one more exp on top of the function value.
  */
 void BackToBackExponential::functionDeriv1D(Jacobian *jacobian,
                                             const double *xValues,
                                             const size_t nData) {
-  FunctionDomain1DView domain(xValues, nData);
-  this->calNumericalDeriv(domain, *jacobian);
+  const double I = getParameter(0);
+  const double a = getParameter(1);
+  const double b = getParameter(2);
+  const double x0 = getParameter(3);
+  const double s = getParameter(4);
+
+  // find the reasonable extent of the peak ~100 fwhm
+  double extent = expWidth();
+  if (s > extent)
+    extent = s;
+  extent *= 100;
+
+  // the function depends on S through S^2 only
+  const double s2 = s * s;
+  const double sAbs = fabs(s);
+  const double sSign = s < 0.0 ? -1.0 : 1.0;
+  const double sqrt2s = sqrt(2 * s2);
+  const double twoOverSqrtPi = 2.0 / sqrt(M_PI);
+  double normFactor = a * b / (a + b) / 2;
+  // derivatives of normFactor with respect to A and B
+  double dNda = b * b / ((a + b) * (a + b)) / 2;
+  double dNdb = a * a / ((a + b) * (a + b)) / 2;
+  // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
+  if (normFactor == 0.0) {
+    normFactor = 1.0;
+    dNda = 0.0;
+    dNdb = 0.0;
+  }
+  for (size_t i = 0; i < nData; i++) {
+    double diff = xValues[i] - x0;
+    if (fabs(diff) < extent) {
+      double arg1 = a / 2 * (a * s2 + 2 * diff);
+      const double e1 =
+          exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) / sqrt2s));
+      double arg2 = b / 2 * (b * s2 - 2 * diff);
+      const double e2 =
+          exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) / sqrt2s));
+      const double g = twoOverSqrtPi * exp(-diff * diff / (2 * s2));
+
+      const double de1da = e1 * (a * s2 + diff) - g * sAbs / M_SQRT2;
+      const double de2db = e2 * (b * s2 - diff) - g * sAbs / M_SQRT2;
+      const double de1dx0 = -a * e1 + g / sqrt2s;
+      const double de2dx0 = b * e2 - g / sqrt2s;
+      const double de1ds = a * a * sAbs * e1 - g * (a - diff / s2) / M_SQRT2;
+      const double de2ds = b * b * sAbs * e2 - g * (b + diff / s2) / M_SQRT2;
+
+      jacobian->set(i, 0, normFactor * (e1 + e2));
+      jacobian->set(i, 1, I * (dNda * (e1 + e2) + normFactor * de1da));
+      jacobian->set(i, 2, I * (dNdb * (e1 + e2) + normFactor * de2db));
+      jacobian->set(i, 3, I * normFactor * (de1dx0 + de2dx0));
+      jacobian->set(i, 4, sSign * I * normFactor * (de1ds + de2ds));
+    } else {
+      for (size_t j = 0; j < 5; ++j) {
+        jacobian->set(i, j, 0.0);
+      }
+    }
+  }
 }
 
 /**
@@ -197,13 +197,22 @@ void Fit::addWorkspace(const std::string &workspacePropertyName,
     boost::shared_ptr<MultiDomainCreator> multiCreator =
         boost::dynamic_pointer_cast<MultiDomainCreator>(m_domainCreator);
     if (!multiCreator) {
+      if (index == 0 &&
+          !boost::dynamic_pointer_cast<API::MultiDomainFunction>(fun)) {
+        // A single domain fit is being reused with a new workspace
+        m_domainCreator.reset(creator);
+        creator->declareDatasetProperties(suffix, false);
+        return;
+      }
+      delete creator;
       throw std::runtime_error(
           std::string("MultiDomainCreator expected, found ") +
           typeid(*m_domainCreator.get()).name());
     }
-    if (!multiCreator->hasCreator(index)) {
-      creator->declareDatasetProperties(suffix, addProperties);
-    }
+    // The dataset properties of a replaced creator exist already but the new
+    // creator still needs to know their names
+    creator->declareDatasetProperties(
+        suffix, addProperties && !multiCreator->hasCreator(index));
     multiCreator->setCreator(index, creator);
   }
 }
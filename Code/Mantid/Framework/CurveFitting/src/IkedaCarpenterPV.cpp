@@ -355,15 +355,224 @@ void IkedaCarpenterPV::functionLocal(double *out, const double *xValues,
   }
 }
 
-void IkedaCarpenterPV::functionDerivLocal(API::Jacobian *, const double *,
-                                          const size_t) {
-  throw Mantid::Kernel::Exception::NotImplementedError(
-      "functionDerivLocal is not implemented for IkedaCarpenterPV.");
+/** Calculate the derivatives analytically.
+ *
+ *  The function is I*N*((1-eta)*sum_j Nj*gj - eta*2/pi*sum_j Nj*Lj) where j
+ *  runs over the four terms u, v, s and r. Each term is a function of the
+ *  distance to the centre, its decay rate, the width and the pseudo-Voigt
+ *  parameters, and its derivatives are found in the same pass as its value:
+ *  - gj = exp(ej)*erfc(yj) and exp(ej - yj^2) is the same Gaussian for all
+ *    terms
+ *  - Lj = Im(F(zj)) with F(z) = exp(z)*E1(z), for which F'(z) = F(z) - 1/z
+ *  The derivatives with respect to the pseudo-Voigt FWHM and eta are then
+ *  carried to SigmaSquared and Gamma through convertVoigtToPseudo.
+ *
+ *  @param out :: The Jacobian to fill
+ *  @param xValues :: x values
+ *  @param nData :: length of xValues
+ */
+void IkedaCarpenterPV::functionDerivLocal(API::Jacobian *out,
+                                          const double *xValues,
+                                          const size_t nData) {
+  const double I = getParameter("I");
+  const double alpha0 = getParameter("Alpha0");
+  const double alpha1 = getParameter("Alpha1");
+  const double beta0 = getParameter("Beta0");
+  const double kappa = getParameter("Kappa");
+  const double voigtsigmaSquared = getParameter("SigmaSquared");
+  const double voigtgamma = getParameter("Gamma");
+  const double X0 = getParameter("X0");
+
+  // cal pseudo voigt sigmaSq and gamma and eta and their derivatives
+  double gamma = 1.0; // dummy initialization
+  double eta = 0.5;   // dummy initialization
+  double dGammadVS(0.0), dGammadVG(0.0), dEtadVS(0.0), dEtadVG(0.0);
+  convertVoigtToPseudoDeriv(voigtsigmaSquared, voigtgamma, gamma, eta,
+                            dGammadVS, dGammadVG, dEtadVS, dEtadVG);
+  const double sigmaSquared = gamma * gamma / (8.0 * M_LN2);
+  const double sigma = sqrt(sigmaSquared);
+  const double someConst = 1 / sqrt(2.0 * sigmaSquared);
+  // derivative of sigmaSquared with respect to the pseudo voigt FWHM
+  const double dSigmaSqdGamma = gamma / (4.0 * M_LN2);
+
+  const double beta = 1 / beta0;
+  const double k = 0.05;
+  const double twoOverSqrtPi = 2.0 / sqrt(M_PI);
+  const std::complex<double> halfI(0.0, 0.5);
+
+  // update wavelength vector
+  calWavelengthAtEachDataPoint(xValues, nData);
+
+  for (size_t i = 0; i < nData; i++) {
+    const double diff = xValues[i] - X0;
+    const double lambda = m_waveLength[i];
+
+    const double R = exp(-81.799 / (lambda * lambda * kappa));
+    const double alpha = 1.0 / (alpha0 + lambda * alpha1);
+
+    const double a_minus = alpha * (1 - k);
+    const double a_plus = alpha * (1 + k);
+    const double x = a_minus - beta;
+    const double y = alpha - beta;
+    const double z = a_plus - beta;
+
+    // normalisations of the terms, in the order u, v, s, r
+    const double Nj[4] = {1 - R * a_minus / x, 1 - R * a_plus / z,
+                          -2 * (1 - R * alpha / y),
+                          2 * R * alpha * alpha * beta * k * k / (x * y * z)};
+    // and their derivatives
+    const double dNjdR[4] = {-a_minus / x, -a_plus / z, 2 * alpha / y,
+                             2 * alpha * alpha * beta * k * k / (x * y * z)};
+    const double dNjdAlpha[4] = {
+        R * (1 - k) * beta / (x * x), R * (1 + k) * beta / (z * z),
+        -2 * R * beta / (y * y),
+        Nj[3] * (2 / alpha - (1 - k) / x - 1 / y - (1 + k) / z)};
+    const double dNjdBeta[4] = {-R * a_minus / (x * x), -R * a_plus / (z * z),
+                                2 * R * alpha / (y * y),
+                                Nj[3] * (1 / beta + 1 / x + 1 / y + 1 / z)};
+
+    // decay rates of the Gaussian and Lorentzian parts of the terms and
+    // their derivatives with respect to alpha. Only the r term depends on
+    // beta and with unit slope.
+    const double rate[4] = {a_minus, a_plus, alpha, beta};
+    const double dRatedAlpha[4] = {1 - k, 1 + k, 1, 0};
+    const double lorentzRate[4] = {(1 - k) * alpha, (1 - k) * alpha, alpha,
+                                   beta};
+    const double dLorentzRatedAlpha[4] = {1 - k, 1 - k, 1, 0};
+
+    const double gauss =
+        twoOverSqrtPi * exp(-diff * diff / (2 * sigmaSquared));
+    const std::complex<double> w(-diff, 0.5 * gamma);
+
+    double sumG(0.0), sumL(0.0);
+    double dG_dDiff(0.0), dL_dDiff(0.0), dG_dSigmaSq(0.0), dL_dGamma(0.0);
+    double dG_dAlpha(0.0), dL_dAlpha(0.0), dG_dBeta(0.0), dL_dBeta(0.0);
+    double dG_dR(0.0), dL_dR(0.0);
+    for (size_t j = 0; j < 4; ++j) {
+      const double c = rate[j];
+      const double e = c * (c * sigmaSquared - 2 * diff) / 2.0;
+      const double yj = (c * sigmaSquared - diff) * someConst;
+      const double g = exp(e + gsl_sf_log_erfc(yj));
+      const double dgdc =
+          g * (c * sigmaSquared - diff) - gauss * sigma / M_SQRT2;
+      const double dgdDiff = -c * g + gauss * someConst;
+      const double dgdSigmaSq =
+          g * c * c / 2.0 -
+          gauss * (c / M_SQRT2 + diff / (M_SQRT2 * sigmaSquared)) /
+              (2.0 * sigma);
+
+      const double cl = lorentzRate[j];
+      const std::complex<double> zj = cl * w;
+      const std::complex<double> F = exponentialIntegral(zj);
+      const std::complex<double> dF = F - 1.0 / zj;
+      const double L = F.imag();
+      const double dLdc = (dF * w).imag();
+      const double dLdDiff = -cl * dF.imag();
+      const double dLdGamma = (dF * cl * halfI).imag();
+
+      sumG += Nj[j] * g;
+      sumL += Nj[j] * L;
+      dG_dDiff += Nj[j] * dgdDiff;
+      dL_dDiff += Nj[j] * dLdDiff;
+      dG_dSigmaSq += Nj[j] * dgdSigmaSq;
+      dL_dGamma += Nj[j] * dLdGamma;
+      dG_dAlpha += dNjdAlpha[j] * g + Nj[j] * dgdc * dRatedAlpha[j];
+      dL_dAlpha += dNjdAlpha[j] * L + Nj[j] * dLdc * dLorentzRatedAlpha[j];
+      dG_dBeta += dNjdBeta[j] * g;
+      dL_dBeta += dNjdBeta[j] * L;
+      dG_dR += dNjdR[j] * g;
+      dL_dR += dNjdR[j] * L;
+      if (j == 3) {
+        dG_dBeta += Nj[j] * dgdc;
+        dL_dBeta += Nj[j] * dLdc;
+      }
+    }
+
+    // the bracketed part of the function, P, and its derivatives
+    const double lorentzFactor = eta * 2.0 / M_PI;
+    const double P = (1 - eta) * sumG - lorentzFactor * sumL;
+    const double dPdDiff = (1 - eta) * dG_dDiff - lorentzFactor * dL_dDiff;
+    const double dPdAlpha = (1 - eta) * dG_dAlpha - lorentzFactor * dL_dAlpha;
+    const double dPdBeta = (1 - eta) * dG_dBeta - lorentzFactor * dL_dBeta;
+    const double dPdR = (1 - eta) * dG_dR - lorentzFactor * dL_dR;
+    const double dPdGamma =
+        (1 - eta) * dG_dSigmaSq * dSigmaSqdGamma - lorentzFactor * dL_dGamma;
+    const double dPdEta = -sumG - 2.0 / M_PI * sumL;
+
+    const double N = 0.25 * alpha * (1 - k * k) / (k * k);
+    // dN/dalpha = N/alpha
+    const double dOutdAlpha = I * (N / alpha * P + N * dPdAlpha);
+    const double IN = I * N;
+
+    out->set(i, 0, N * P);
+    out->set(i, 1, -dOutdAlpha * alpha * alpha);
+    out->set(i, 2, -dOutdAlpha * alpha * alpha * lambda);
+    out->set(i, 3, -IN * dPdBeta * beta * beta);
+    out->set(i, 4, IN * dPdR * R * 81.799 / (lambda * lambda * kappa * kappa));
+    out->set(i, 5, IN * (dPdGamma * dGammadVS + dPdEta * dEtadVS));
+    out->set(i, 6, IN * (dPdGamma * dGammadVG + dPdEta * dEtadVG));
+    out->set(i, 7, -IN * dPdDiff);
+  }
 }
 
+/** The analytic derivatives need a positive Voigt width. Otherwise they are
+ *  calculated numerically.
+ *  @param domain :: The domain to calculate the derivatives on
+ *  @param jacobian :: The Jacobian to fill
+ */
 void IkedaCarpenterPV::functionDeriv(const API::FunctionDomain &domain,
                                      API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  if (getParameter("SigmaSquared") > 0.0 && getParameter("Gamma") >= 0.0) {
+    IFunction1D::functionDeriv(domain, jacobian);
+  } else {
+    calNumericalDeriv(domain, jacobian);
+  }
+}
+
+/** As convertVoigtToPseudo and also calculate the derivatives of H and eta
+ *  with respect to the voigt params
+ *
+ *  @param voigtSigmaSq :: voigt param, must be positive
+ *  @param voigtGamma :: voigt param
+ *  @param H :: pseudo voigt param
+ *  @param eta :: pseudo voigt param
+ *  @param dHdSigmaSq :: derivative of H with respect to voigtSigmaSq
+ *  @param dHdGamma :: derivative of H with respect to voigtGamma
+ *  @param dEtadSigmaSq :: derivative of eta with respect to voigtSigmaSq
+ *  @param dEtadGamma :: derivative of eta with respect to voigtGamma
+ */
+void IkedaCarpenterPV::convertVoigtToPseudoDeriv(
+    const double &voigtSigmaSq, const double &voigtGamma, double &H,
+    double &eta, double &dHdSigmaSq, double &dHdGamma, double &dEtadSigmaSq,
+    double &dEtadGamma) const {
+  convertVoigtToPseudo(voigtSigmaSq, voigtGamma, H, eta);
+
+  const double fwhmG = sqrt(8.0 * M_LN2 * voigtSigmaSq);
+  const double fwhmL = voigtGamma;
+  const double G2 = fwhmG * fwhmG;
+  const double L2 = fwhmL * fwhmL;
+  // H^5 is a polynomial in fwhmG and fwhmL
+  const double dH5dG = 5.0 * G2 * G2 + 4.0 * 2.69269 * G2 * fwhmG * fwhmL +
+                       3.0 * 2.42843 * G2 * L2 +
+                       2.0 * 4.47163 * fwhmG * L2 * fwhmL + 0.07842 * L2 * L2;
+  const double dH5dL = 2.69269 * G2 * G2 + 2.0 * 2.42843 * G2 * fwhmG * fwhmL +
+                       3.0 * 4.47163 * G2 * L2 +
+                       4.0 * 0.07842 * fwhmG * L2 * fwhmL + 5.0 * L2 * L2;
+  const double H4 = H * H * H * H;
+  const double dHdG = dH5dG / (5.0 * H4);
+  const double dHdL = dH5dL / (5.0 * H4);
+  const double dGdSigmaSq = 4.0 * M_LN2 / fwhmG;
+
+  const double tmp = fwhmL / H;
+  const double dEtadTmp =
+      1.36603 - 2.0 * 0.47719 * tmp + 3.0 * 0.11116 * tmp * tmp;
+  const double dTmpdG = -tmp / H * dHdG;
+  const double dTmpdL = 1.0 / H - tmp / H * dHdL;
+
+  dHdSigmaSq = dHdG * dGdSigmaSq;
+  dHdGamma = dHdL;
+  dEtadSigmaSq = dEtadTmp * dTmpdG * dGdSigmaSq;
+  dEtadGamma = dEtadTmp * dTmpdL;
 }
 
 } // namespace CurveFitting
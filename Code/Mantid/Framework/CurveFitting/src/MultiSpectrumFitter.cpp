@@ -0,0 +1,208 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidCurveFitting/MultiSpectrumFitter.h"
+#include "MantidCurveFitting/CostFuncFitting.h"
+#include "MantidCurveFitting/FitMW.h"
+#include "MantidCurveFitting/GSLMatrix.h"
+#include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidKernel/EmptyValues.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+#include <stdexcept>
+
+namespace Mantid {
+namespace CurveFitting {
+
+using namespace API;
+
+/**
+ * @param function :: A function string understood by the FunctionFactory
+ * @param minimizer :: The name of the minimizer
+ * @param costFunction :: The name of the cost function, which must be a
+ * fitting cost function
+ */
+MultiSpectrumFitter::MultiSpectrumFitter(const std::string &function,
+                                         const std::string &minimizer,
+                                         const std::string &costFunction)
+    : m_functionString(function), m_minimizer(minimizer),
+      m_costFunction(costFunction), m_startX(EMPTY_DBL()),
+      m_endX(EMPTY_DBL()), m_maxIterations(500), m_passWorkspaceIndex(false),
+      m_template(), m_initialParameters(), m_functions(), m_creators() {
+  m_template = FunctionFactory::Instance().createInitialized(function);
+  if (!m_template) {
+    throw std::invalid_argument("Fitting function failed to initialize");
+  }
+  m_initialParameters.resize(m_template->nParams());
+  for (size_t i = 0; i < m_initialParameters.size(); ++i) {
+    m_initialParameters[i] = m_template->getParameter(i);
+  }
+}
+
+/// Defined here where FitMW is a complete type
+MultiSpectrumFitter::~MultiSpectrumFitter() {}
+
+/**
+ * @param startX :: The lowest x value to fit
+ * @param endX :: The highest x value to fit
+ */
+void MultiSpectrumFitter::setRange(const double startX, const double endX) {
+  m_startX = startX;
+  m_endX = endX;
+}
+
+/// @param maxIterations :: The maximum number of minimizer iterations
+void MultiSpectrumFitter::setMaxIterations(const size_t maxIterations) {
+  m_maxIterations = maxIterations;
+}
+
+/// @param on :: If true WorkspaceIndex attributes are set to the index fitted
+void MultiSpectrumFitter::setPassWorkspaceIndex(const bool on) {
+  m_passWorkspaceIndex = on;
+}
+
+/// @returns The number of parameters of the function
+size_t MultiSpectrumFitter::nParams() const { return m_template->nParams(); }
+
+/**
+ * @param i :: The index of a parameter
+ * @returns The name of the parameter
+ */
+std::string MultiSpectrumFitter::parameterName(const size_t i) const {
+  return m_template->parameterName(i);
+}
+
+/**
+ * The function string is parsed here, on the calling thread, so that fit()
+ * does not use the FunctionFactory.
+ * @param nThreads :: The number of threads that will call fit()
+ */
+void MultiSpectrumFitter::prepare(const size_t nThreads) {
+  while (m_functions.size() < nThreads) {
+    m_functions.push_back(
+        FunctionFactory::Instance().createInitialized(m_functionString));
+    m_creators.push_back(boost::make_shared<FitMW>());
+  }
+}
+
+/**
+ * The steps are those of Fit::exec() with CalcErrors set and no output
+ * workspaces.
+ * @param thread :: The number of the calling thread, less than the number
+ * given to prepare()
+ * @param ws :: The workspace containing the spectrum
+ * @param wsIndex :: The workspace index of the spectrum
+ * @param startParameters :: The parameter values to start the fit from
+ * @param result :: [Output] The fitted parameters, errors and chi-squared
+ */
+void MultiSpectrumFitter::fit(const size_t thread, MatrixWorkspace_sptr ws,
+                              const size_t wsIndex,
+                              const std::vector<double> &startParameters,
+                              Result &result) const {
+  if (thread >= m_functions.size()) {
+    throw std::runtime_error("MultiSpectrumFitter: prepare() has not been "
+                             "called for thread " +
+                             boost::lexical_cast<std::string>(thread));
+  }
+  IFunction_sptr function = m_functions[thread];
+  FitMW &creator = *m_creators[thread];
+
+  const size_t np = function->nParams();
+  for (size_t i = 0; i < np; ++i) {
+    function->setParameter(i, startParameters[i]);
+  }
+  if (m_passWorkspaceIndex) {
+    setWorkspaceIndexAttribute(function, static_cast<int>(wsIndex));
+  }
+  function->setUpForFit();
+
+  creator.setWorkspace(ws);
+  creator.setWorkspaceIndex(wsIndex);
+  // FitMW replaces an empty range with the limits of the spectrum
+  creator.setRange(m_startX, m_endX);
+  FunctionDomain_sptr domain;
+  FunctionValues_sptr values;
+  creator.createDomain(domain, values);
+  creator.initFunction(function);
+
+  boost::shared_ptr<CostFuncFitting> costFunc =
+      boost::dynamic_pointer_cast<CostFuncFitting>(
+          CostFunctionFactory::Instance().create(m_costFunction));
+  if (!costFunc) {
+    throw std::invalid_argument(m_costFunction +
+                                " is not a fitting cost function");
+  }
+  costFunc->setFittingFunction(function, domain, values);
+  IFuncMinimizer_sptr minimizer =
+      FuncMinimizerFactory::Instance().createMinimizer(m_minimizer);
+  minimizer->initialize(costFunc, m_maxIterations);
+
+  size_t iter = 0;
+  std::string errorString;
+  while (iter < m_maxIterations) {
+    function->iterationStarting();
+    if (!minimizer->iterate(iter)) {
+      errorString = minimizer->getError();
+      if (errorString.empty())
+        errorString = "success";
+      break;
+    }
+    function->iterationFinished();
+    ++iter;
+  }
+  if (iter >= m_maxIterations) {
+    if (!errorString.empty())
+      errorString += '\n';
+    errorString += "Failed to converge after " +
+                   boost::lexical_cast<std::string>(m_maxIterations) +
+                   " iterations.";
+  }
+
+  size_t dof = domain->size() - costFunc->nParams();
+  if (dof == 0)
+    dof = 1;
+  const double rawCostFuncVal = minimizer->costFunctionVal();
+  if (costFunc->nParams() > 0) {
+    GSLMatrix covar;
+    costFunc->calCovarianceMatrix(covar);
+    costFunc->calFittingErrors(covar, rawCostFuncVal);
+  }
+
+  result.parameters.resize(np);
+  result.errors.resize(np);
+  for (size_t i = 0; i < np; ++i) {
+    result.parameters[i] = function->getParameter(i);
+    result.errors[i] = function->getError(i);
+  }
+  result.chi2 = rawCostFuncVal / static_cast<double>(dof);
+  result.status = errorString;
+}
+
+/**
+ * @param fun :: The function
+ * @param wsIndex :: Value for WorkspaceIndex attributes to set.
+ */
+void MultiSpectrumFitter::setWorkspaceIndexAttribute(IFunction_sptr fun,
+                                                     const int wsIndex) {
+  const std::string attName = "WorkspaceIndex";
+  if (fun->hasAttribute(attName)) {
+    fun->setAttributeValue(attName, wsIndex);
+  }
+
+  CompositeFunction_sptr cf =
+      boost::dynamic_pointer_cast<CompositeFunction>(fun);
+  if (cf) {
+    for (size_t i = 0; i < cf->nFunctions(); ++i) {
+      setWorkspaceIndexAttribute(cf->getFunction(i), wsIndex);
+    }
+  }
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -11,6 +11,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "MantidCurveFitting/PlotPeakByLogValue.h"
+#include "MantidCurveFitting/MultiSpectrumFitter.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
 #include "MantidAPI/CostFunctionFactory.h"
@@ -26,6 +27,7 @@
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -136,12 +138,7 @@ void PlotPeakByLogValue::exec() {
   std::string fun = getPropertyValue("Function");
   // int wi = getProperty("WorkspaceIndex");
   std::string logName = getProperty("LogValue");
-  bool individual = getPropertyValue("FitType") == "Individual";
-  bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
   bool createFitOutput = getProperty("CreateOutput");
-  bool outputCompositeMembers = getProperty("OutputCompositeMembers");
-  bool outputConvolvedMembers = getProperty("ConvolveMembers");
-  std::string baseName = getPropertyValue("OutputWorkspace");
 
   bool isDataName = false; // if true first output column is of type string and
                            // is the data source name
@@ -162,14 +159,6 @@ void PlotPeakByLogValue::exec() {
     throw std::invalid_argument("Fitting function failed to initialize");
   }
 
-  // for inidividual fittings store the initial parameters
-  std::vector<double> initialParams(ifun->nParams());
-  if (individual) {
-    for (size_t i = 0; i < initialParams.size(); ++i) {
-      initialParams[i] = ifun->getParameter(i);
-    }
-  }
-
   for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
     result->addColumn("double", ifun->parameterName(iPar));
     result->addColumn("double", ifun->parameterName(iPar) + "_Err");
@@ -178,13 +167,26 @@ void PlotPeakByLogValue::exec() {
 
   setProperty("OutputWorkspace", result);
 
-  std::vector<std::string> covariance_workspaces;
-  std::vector<std::string> fit_workspaces;
-  std::vector<std::string> parameter_workspaces;
+  const std::vector<FitJob> jobs = makeJobs(wsNames);
+  if (createFitOutput) {
+    fitWithOutput(jobs, ifun, result, isDataName);
+  } else {
+    fitInBatch(jobs, fun, result, isDataName);
+  }
+}
 
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
-  for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
+/**
+ * Open the inputs and find the spectra to fit in each of them, in the order
+ * the rows of the output table will have.
+ * @param wsNames :: The inputs as given by makeNames()
+ * @return A job for every spectrum to fit
+ */
+std::vector<PlotPeakByLogValue::FitJob>
+PlotPeakByLogValue::makeJobs(const std::vector<InputData> &wsNames) {
+  const std::string logName = getProperty("LogValue");
+
+  std::vector<FitJob> jobs;
+  for (size_t i = 0; i < wsNames.size(); ++i) {
     InputData data = getWorkspace(wsNames[i]);
 
     if (!data.ws) {
@@ -207,15 +209,7 @@ void PlotPeakByLogValue::exec() {
       jend = data.indx.back() + 1;
     }
 
-    if (createFitOutput) {
-      covariance_workspaces.reserve(covariance_workspaces.size() + jend);
-      fit_workspaces.reserve(fit_workspaces.size() + jend);
-      parameter_workspaces.reserve(parameter_workspaces.size() + jend);
-    }
-
-    dProg /= abs(jend - j);
     for (; j < jend; ++j) {
-
       // Find the log value: it is either a log-file value or simply the
       // workspace number
       double logValue = 0;
@@ -232,113 +226,218 @@ void PlotPeakByLogValue::exec() {
             dynamic_cast<TimeSeriesProperty<double> *>(prop);
         logValue = logp->lastValue();
       }
+      jobs.push_back(FitJob(wsNames[i].name, data.ws, j, logValue));
+    }
+  }
+  return jobs;
+}
 
-      double chi2;
-
-      try {
-        if (passWSIndexToFunction) {
-          setWorkspaceIndexAttribute(ifun, j);
-        }
+/**
+ * Run the Fit algorithm for each spectrum so that it creates its output
+ * workspaces, then group those workspaces.
+ * @param jobs :: The spectra to fit
+ * @param ifun :: The fitting function
+ * @param result :: The table to append a row of results to for each spectrum
+ * @param isDataName :: If true the first column holds the source name
+ */
+void PlotPeakByLogValue::fitWithOutput(const std::vector<FitJob> &jobs,
+                                       IFunction_sptr ifun,
+                                       ITableWorkspace_sptr result,
+                                       bool isDataName) {
+  bool individual = getPropertyValue("FitType") == "Individual";
+  bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
+  bool outputCompositeMembers = getProperty("OutputCompositeMembers");
+  bool outputConvolvedMembers = getProperty("ConvolveMembers");
+  std::string baseName = getPropertyValue("OutputWorkspace");
 
-        g_log.debug() << "Fitting " << data.ws->name() << " index " << j
-                      << " with " << std::endl;
-        g_log.debug() << ifun->asString() << std::endl;
-
-        std::string spectrum_index = boost::lexical_cast<std::string>(j);
-        std::string wsBaseName = "";
-
-        if (createFitOutput)
-          wsBaseName = wsNames[i].name + "_" + spectrum_index;
-
-        // Fit the function
-        API::IAlgorithm_sptr fit =
-            AlgorithmManager::Instance().createUnmanaged("Fit");
-        fit->initialize();
-        fit->setProperty("Function", ifun);
-        fit->setProperty("InputWorkspace", data.ws);
-        fit->setProperty("WorkspaceIndex", j);
-        fit->setPropertyValue("StartX", getPropertyValue("StartX"));
-        fit->setPropertyValue("EndX", getPropertyValue("EndX"));
-        fit->setPropertyValue("Minimizer", getPropertyValue("Minimizer"));
-        fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
-        fit->setProperty("CalcErrors", true);
-        fit->setProperty("CreateOutput", createFitOutput);
-        fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
-        fit->setProperty("ConvolveMembers", outputConvolvedMembers);
-        fit->setProperty("Output", wsBaseName);
-        fit->execute();
-
-        if (!fit->isExecuted()) {
-          throw std::runtime_error("Fit child algorithm failed: " +
-                                   data.ws->name());
-        }
+  // for inidividual fittings store the initial parameters
+  std::vector<double> initialParams(ifun->nParams());
+  if (individual) {
+    for (size_t i = 0; i < initialParams.size(); ++i) {
+      initialParams[i] = ifun->getParameter(i);
+    }
+  }
 
-        ifun = fit->getProperty("Function");
-        chi2 = fit->getProperty("OutputChi2overDoF");
+  std::vector<std::string> covariance_workspaces;
+  std::vector<std::string> fit_workspaces;
+  std::vector<std::string> parameter_workspaces;
+  covariance_workspaces.reserve(jobs.size());
+  fit_workspaces.reserve(jobs.size());
+  parameter_workspaces.reserve(jobs.size());
 
-        if (createFitOutput) {
-          covariance_workspaces.push_back(wsBaseName +
-                                          "_NormalisedCovarianceMatrix");
-          parameter_workspaces.push_back(wsBaseName + "_Parameters");
-          fit_workspaces.push_back(wsBaseName + "_Workspace");
-        }
+  Progress prog(this, 0.0, 1.0, jobs.size());
+  for (size_t k = 0; k < jobs.size(); ++k) {
+    const FitJob &job = jobs[k];
+    const int j = job.wsIndex;
 
-        g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                      << ' ' << chi2 << std::endl;
+    double chi2;
 
-      } catch (...) {
-        g_log.error("Error in Fit ChildAlgorithm");
-        throw;
+    try {
+      if (passWSIndexToFunction) {
+        setWorkspaceIndexAttribute(ifun, j);
       }
 
-      // Extract the fitted parameters and put them into the result table
-      TableRow row = result->appendRow();
-      if (isDataName) {
-        row << wsNames[i].name;
-      } else {
-        row << logValue;
+      g_log.debug() << "Fitting " << job.ws->name() << " index " << j
+                    << " with " << std::endl;
+      g_log.debug() << ifun->asString() << std::endl;
+
+      std::string spectrum_index = boost::lexical_cast<std::string>(j);
+      std::string wsBaseName = job.source + "_" + spectrum_index;
+
+      // Fit the function
+      API::IAlgorithm_sptr fit =
+          AlgorithmManager::Instance().createUnmanaged("Fit");
+      fit->initialize();
+      fit->setProperty("Function", ifun);
+      fit->setProperty("InputWorkspace", job.ws);
+      fit->setProperty("WorkspaceIndex", j);
+      fit->setPropertyValue("StartX", getPropertyValue("StartX"));
+      fit->setPropertyValue("EndX", getPropertyValue("EndX"));
+      fit->setPropertyValue("Minimizer", getPropertyValue("Minimizer"));
+      fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
+      fit->setProperty("CalcErrors", true);
+      fit->setProperty("CreateOutput", true);
+      fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
+      fit->setProperty("ConvolveMembers", outputConvolvedMembers);
+      fit->setProperty("Output", wsBaseName);
+      fit->execute();
+
+      if (!fit->isExecuted()) {
+        throw std::runtime_error("Fit child algorithm failed: " +
+                                 job.ws->name());
       }
 
-      for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-        row << ifun->getParameter(iPar) << ifun->getError(iPar);
-      }
-      row << chi2;
+      ifun = fit->getProperty("Function");
+      chi2 = fit->getProperty("OutputChi2overDoF");
 
-      Prog += dProg;
-      progress(Prog);
-      interruption_point();
+      covariance_workspaces.push_back(wsBaseName +
+                                      "_NormalisedCovarianceMatrix");
+      parameter_workspaces.push_back(wsBaseName + "_Parameters");
+      fit_workspaces.push_back(wsBaseName + "_Workspace");
 
-      if (individual) {
-        for (size_t i = 0; i < initialParams.size(); ++i) {
-          ifun->setParameter(i, initialParams[i]);
-        }
+      g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
+                    << ' ' << chi2 << std::endl;
+
+    } catch (...) {
+      g_log.error("Error in Fit ChildAlgorithm");
+      throw;
+    }
+
+    // Extract the fitted parameters and put them into the result table
+    TableRow row = result->appendRow();
+    if (isDataName) {
+      row << job.source;
+    } else {
+      row << job.logValue;
+    }
+
+    for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
+      row << ifun->getParameter(iPar) << ifun->getError(iPar);
+    }
+    row << chi2;
+
+    prog.report();
+    interruption_point();
+
+    if (individual) {
+      for (size_t i = 0; i < initialParams.size(); ++i) {
+        ifun->setParameter(i, initialParams[i]);
       }
+    }
+  }
 
-    } // for(;j < jend;++j)
+  // collect output of fit for each spectrum into workspace groups
+  API::IAlgorithm_sptr groupAlg =
+      AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+  groupAlg->initialize();
+  groupAlg->setProperty("InputWorkspaces", covariance_workspaces);
+  groupAlg->setProperty("OutputWorkspace",
+                        baseName + "_NormalisedCovarianceMatrices");
+  groupAlg->execute();
+
+  groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+  groupAlg->initialize();
+  groupAlg->setProperty("InputWorkspaces", parameter_workspaces);
+  groupAlg->setProperty("OutputWorkspace", baseName + "_Parameters");
+  groupAlg->execute();
+
+  groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+  groupAlg->initialize();
+  groupAlg->setProperty("InputWorkspaces", fit_workspaces);
+  groupAlg->setProperty("OutputWorkspace", baseName + "_Workspaces");
+  groupAlg->execute();
+}
+
+/**
+ * Fit the spectra with a MultiSpectrumFitter, writing the results straight
+ * into the table. Individual fits are independent of each other and are
+ * spread over the available threads. Sequential fits each start from the
+ * result of the previous one and so are done in order on one thread.
+ * @param jobs :: The spectra to fit
+ * @param fun :: The function string
+ * @param result :: The table to fill with a row of results for each spectrum
+ * @param isDataName :: If true the first column holds the source name
+ */
+void PlotPeakByLogValue::fitInBatch(const std::vector<FitJob> &jobs,
+                                    const std::string &fun,
+                                    ITableWorkspace_sptr result,
+                                    bool isDataName) {
+  const bool individual = getPropertyValue("FitType") == "Individual";
+  const double startX = getProperty("StartX");
+  const double endX = getProperty("EndX");
+
+  MultiSpectrumFitter fitter(fun, getPropertyValue("Minimizer"),
+                             getPropertyValue("CostFunction"));
+  fitter.setRange(startX, endX);
+  fitter.setPassWorkspaceIndex(getProperty("PassWSIndexToFunction"));
+
+  bool threadSafe = individual;
+  for (size_t k = 0; threadSafe && k < jobs.size(); ++k) {
+    threadSafe = jobs[k].ws->threadSafe();
   }
+  fitter.prepare(threadSafe ? PARALLEL_GET_MAX_THREADS : 1);
+
+  const size_t firstRow = result->rowCount();
+  result->setRowCount(firstRow + jobs.size());
+  const size_t nParams = fitter.nParams();
+  std::vector<double> startParameters(fitter.initialParameters());
+
+  Progress prog(this, 0.0, 1.0, jobs.size());
+  const int nJobs = static_cast<int>(jobs.size());
+  PARALLEL_FOR_IF(threadSafe)
+  for (int k = 0; k < nJobs; ++k) {
+    PARALLEL_START_INTERUPT_REGION
+    const FitJob &job = jobs[k];
+    g_log.debug() << "Fitting " << job.ws->name() << " index " << job.wsIndex
+                  << std::endl;
+
+    MultiSpectrumFitter::Result fitResult;
+    fitter.fit(PARALLEL_THREAD_NUMBER, job.ws, job.wsIndex,
+               individual ? fitter.initialParameters() : startParameters,
+               fitResult);
+    if (!individual) {
+      startParameters = fitResult.parameters;
+    }
+    g_log.debug() << "Fit result " << fitResult.status << ' '
+                  << fitResult.chi2 << std::endl;
 
-  if (createFitOutput) {
-    // collect output of fit for each spectrum into workspace groups
-    API::IAlgorithm_sptr groupAlg =
-        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", covariance_workspaces);
-    groupAlg->setProperty("OutputWorkspace",
-                          baseName + "_NormalisedCovarianceMatrices");
-    groupAlg->execute();
-
-    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", parameter_workspaces);
-    groupAlg->setProperty("OutputWorkspace", baseName + "_Parameters");
-    groupAlg->execute();
-
-    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", fit_workspaces);
-    groupAlg->setProperty("OutputWorkspace", baseName + "_Workspaces");
-    groupAlg->execute();
+    // Each thread writes to its own row only
+    const size_t row = firstRow + static_cast<size_t>(k);
+    if (isDataName) {
+      result->cell<std::string>(row, 0) = job.source;
+    } else {
+      result->cell<double>(row, 0) = job.logValue;
+    }
+    for (size_t iPar = 0; iPar < nParams; ++iPar) {
+      result->cell<double>(row, 1 + 2 * iPar) = fitResult.parameters[iPar];
+      result->cell<double>(row, 2 + 2 * iPar) = fitResult.errors[iPar];
+    }
+    result->cell<double>(row, 1 + 2 * nParams) = fitResult.chi2;
+
+    prog.report();
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 }
 
 /** Get a workspace identified by an InputData structure.
@@ -451,20 +451,331 @@ void ThermalNeutronBk2BkExpConvPVoigt::function(
 }
 
 //----------------------------------------------------------------------------------------------
-/** Disabled derivative
+/** Calculate the derivatives analytically without a peak range.
+ * See functionDeriv1D.
 */
-void ThermalNeutronBk2BkExpConvPVoigt::functionDerivLocal(API::Jacobian *,
-                                                          const double *,
-                                                          const size_t) {
-  throw Mantid::Kernel::Exception::NotImplementedError(
-      "functionDerivLocal is not implemented for IkedaCarpenterPV.");
+void ThermalNeutronBk2BkExpConvPVoigt::functionDerivLocal(API::Jacobian *out,
+                                                          const double *xValues,
+                                                          const size_t nData) {
+  if (m_hasNewParameterValue)
+    calculateParameters(false);
+
+  std::vector<double> profileDerivs;
+  calProfileDerivatives(profileDerivs);
+  for (size_t id = 0; id < nData; ++id) {
+    setDerivatives(out, id, xValues[id], profileDerivs);
+  }
 }
 
-/** Calculate derivative of this peak function
+/** Calculate derivative of this peak function. The analytic derivatives need
+ * a physical peak, otherwise they are calculated numerically.
 */
 void ThermalNeutronBk2BkExpConvPVoigt::functionDeriv(
     const API::FunctionDomain &domain, API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  if (m_hasNewParameterValue)
+    calculateParameters(false);
+  if (m_parameterValid && m_Sigma2 > 0. && m_Gamma >= 0.) {
+    IFunction1D::functionDeriv(domain, jacobian);
+  } else {
+    calNumericalDeriv(domain, jacobian);
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Calculate the derivatives analytically over the same peak range as
+ * function1D. The profile is Height*Omega(x - TOF_h) where Omega depends on
+ * the parameters through TOF_h, alpha, beta, sigma^2 and gamma. The
+ * derivatives of these five with respect to the parameters do not depend on
+ * x and are calculated once by calProfileDerivatives.
+ */
+void ThermalNeutronBk2BkExpConvPVoigt::functionDeriv1D(API::Jacobian *out,
+                                                       const double *xValues,
+                                                       const size_t nData) {
+  if (m_hasNewParameterValue)
+    calculateParameters(false);
+
+  const double c = centre();
+  const double dx = fabs(s_peakRadius * this->fwhm());
+  std::vector<double> profileDerivs;
+  calProfileDerivatives(profileDerivs);
+  for (size_t id = 0; id < nData; ++id) {
+    if (fabs(xValues[id] - c) < dx) {
+      setDerivatives(out, id, xValues[id], profileDerivs);
+    } else {
+      for (size_t ip = 0; ip < nParams(); ++ip)
+        out->set(id, ip, 0.0);
+    }
+  }
+}
+
+/** Set the derivatives of one data point
+ * @param out :: The Jacobian
+ * @param id :: The index of the data point
+ * @param xValue :: The x value of the data point
+ * @param profileDerivs :: The derivatives from calProfileDerivatives
+ */
+void ThermalNeutronBk2BkExpConvPVoigt::setDerivatives(
+    API::Jacobian *out, const size_t id, const double xValue,
+    const std::vector<double> &profileDerivs) const {
+  const double height = getParameter(0);
+  const size_t np = nParams();
+
+  const double dT = xValue - m_centre;
+  double dOmega[5] = {0., 0., 0., 0., 0.};
+  double omega(0.);
+  if (fabs(dT) < m_fwhm * PEAKRANGE) {
+    omega = calOmegaDerivatives(dT, profileDerivs, dOmega);
+  }
+
+  out->set(id, HEIGHTINDEX, omega);
+  for (size_t ip = 0; ip < np; ++ip) {
+    if (ip == HEIGHTINDEX)
+      continue;
+    double deriv = 0.;
+    for (size_t q = 0; q < 5; ++q) {
+      deriv += dOmega[q] * profileDerivs[q * np + ip];
+    }
+    out->set(id, ip, height * deriv);
+  }
+}
+
+/** Calculate the derivatives of TOF_h, alpha, beta, sigma^2 and gamma, in this
+ * order, with respect to each parameter. They follow calculateParameters.
+ * @param derivs :: [Output] The derivative of quantity q with respect to
+ * parameter i is at q*nParams() + i. It also holds the derivatives of H and
+ * eta with respect to sigma^2 and gamma at 5*nParams() onwards.
+ */
+void ThermalNeutronBk2BkExpConvPVoigt::calProfileDerivatives(
+    std::vector<double> &derivs) const {
+  const size_t np = nParams();
+  derivs.assign(5 * np + 4, 0.0);
+
+  const double dtt1 = getParameter(1);
+  const double dtt1t = getParameter(3);
+  const double dtt2t = getParameter(4);
+  const double zero = getParameter(5);
+  const double zerot = getParameter(6);
+  const double wcross = getParameter(7);
+  const double Tcross = getParameter(8);
+
+  const double alph0 = getParameter(9);
+  const double alph1 = getParameter(10);
+  const double beta0 = getParameter(11);
+  const double beta1 = getParameter(12);
+  const double alph0t = getParameter(13);
+  const double alph1t = getParameter(14);
+  const double beta0t = getParameter(15);
+  const double beta1t = getParameter(16);
+
+  const double sig0 = getParameter(17);
+  const double sig1 = getParameter(18);
+  const double sig2 = getParameter(19);
+  const double gam1 = getParameter(21);
+  const double gam2 = getParameter(22);
+
+  const double latticeconstant = getParameter(LATTICEINDEX);
+  const double dh = m_dcentre;
+  const double dh2 = dh * dh;
+
+  // crossover function and its derivatives
+  const double t = wcross * (Tcross - 1 / dh);
+  const double n = 0.5 * gsl_sf_erfc(t);
+  const double dndt = -exp(-t * t) / sqrt(PI);
+  const double dndw = dndt * (Tcross - 1 / dh);
+  const double dndT = dndt * wcross;
+  const double dnddh = dndt * wcross / dh2;
+
+  // d-spacing of a cubic cell is proportional to the lattice constant
+  const double ddhda = dh / latticeconstant;
+
+  // peak position
+  const double Th_e = zero + dtt1 * dh;
+  const double Th_t = zerot + dtt1t * dh - dtt2t / dh;
+  double *dTof = &derivs[0];
+  dTof[5] = n;
+  dTof[1] = n * dh;
+  dTof[6] = 1 - n;
+  dTof[3] = (1 - n) * dh;
+  dTof[4] = -(1 - n) / dh;
+  dTof[7] = (Th_e - Th_t) * dndw;
+  dTof[8] = (Th_e - Th_t) * dndT;
+  dTof[LATTICEINDEX] = (n * dtt1 + (1 - n) * (dtt1t + dtt2t / dh2) +
+                        (Th_e - Th_t) * dnddh) *
+                       ddhda;
+
+  // alpha = 1/A, dalpha = -alpha^2 dA
+  const double alpha_e = alph0 + alph1 * dh;
+  const double alpha_t = alph0t - alph1t / dh;
+  const double a2 = -m_Alpha * m_Alpha;
+  double *dAlpha = &derivs[np];
+  dAlpha[9] = a2 * n;
+  dAlpha[10] = a2 * n * dh;
+  dAlpha[13] = a2 * (1 - n);
+  dAlpha[14] = -a2 * (1 - n) / dh;
+  dAlpha[7] = a2 * (alpha_e - alpha_t) * dndw;
+  dAlpha[8] = a2 * (alpha_e - alpha_t) * dndT;
+  dAlpha[LATTICEINDEX] = a2 * (n * alph1 + (1 - n) * alph1t / dh2 +
+                               (alpha_e - alpha_t) * dnddh) *
+                         ddhda;
+
+  // beta = 1/B, dbeta = -beta^2 dB
+  const double beta_e = beta0 + beta1 * dh;
+  const double beta_t = beta0t - beta1t / dh;
+  const double b2 = -m_Beta * m_Beta;
+  double *dBeta = &derivs[2 * np];
+  dBeta[11] = b2 * n;
+  dBeta[12] = b2 * n * dh;
+  dBeta[15] = b2 * (1 - n);
+  dBeta[16] = -b2 * (1 - n) / dh;
+  dBeta[7] = b2 * (beta_e - beta_t) * dndw;
+  dBeta[8] = b2 * (beta_e - beta_t) * dndT;
+  dBeta[LATTICEINDEX] = b2 * (n * beta1 + (1 - n) * beta1t / dh2 +
+                              (beta_e - beta_t) * dnddh) *
+                        ddhda;
+
+  // sigma^2
+  double *dSigma2 = &derivs[3 * np];
+  dSigma2[17] = 2 * sig0;
+  dSigma2[18] = 2 * sig1 * dh2;
+  dSigma2[19] = 2 * sig2 * dh2 * dh2;
+  dSigma2[LATTICEINDEX] =
+      (2 * sig1 * sig1 * dh + 4 * sig2 * sig2 * dh2 * dh) * ddhda;
+
+  // gamma
+  double *dGamma = &derivs[4 * np];
+  dGamma[20] = 1;
+  dGamma[21] = dh;
+  dGamma[22] = dh2;
+  dGamma[LATTICEINDEX] = (gam1 + 2 * gam2 * dh) * ddhda;
+
+  // H and eta, see calHandEta
+  const double H_G = sqrt(8.0 * m_Sigma2 * log(2.0));
+  const double H_L = m_Gamma;
+  const double G2 = H_G * H_G;
+  const double L2 = H_L * H_L;
+  const double dH5dG = 5 * G2 * G2 + 4 * 2.69269 * G2 * H_G * H_L +
+                       3 * 2.42843 * G2 * L2 + 2 * 4.47163 * H_G * L2 * H_L +
+                       0.07842 * L2 * L2;
+  const double dH5dL = 2.69269 * G2 * G2 + 2 * 2.42843 * G2 * H_G * H_L +
+                       3 * 4.47163 * G2 * L2 + 4 * 0.07842 * H_G * L2 * H_L +
+                       5 * L2 * L2;
+  const double H4 = std::pow(m_fwhm, 4);
+  const double dHdG = dH5dG / (5 * H4);
+  const double dHdL = dH5dL / (5 * H4);
+  const double dGdSigma2 = 4.0 * log(2.0) / H_G;
+  const double gam_pv = H_L / m_fwhm;
+  const double dEtadGam =
+      1.36603 - 2 * 0.47719 * gam_pv + 3 * 0.11116 * gam_pv * gam_pv;
+  // dH/dsigma^2, dH/dgamma, deta/dsigma^2 and deta/dgamma
+  derivs[5 * np] = dHdG * dGdSigma2;
+  derivs[5 * np + 1] = dHdL;
+  derivs[5 * np + 2] = -dEtadGam * gam_pv / m_fwhm * derivs[5 * np];
+  derivs[5 * np + 3] = dEtadGam * (1 - gam_pv * dHdL) / m_fwhm;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Calculate Omega as calOmega and its derivatives with respect to TOF_h,
+ * alpha, beta, sigma^2 and gamma.
+ *
+ * For each of the two exponential terms exp(u)*erfc(y), u - y^2 is
+ * -x^2/(2 sigma^2), so their derivatives share a single Gaussian. For the
+ * Lorentzian terms Im(exp(p)*E1(p)) the derivative of exp(p)*E1(p) is
+ * exp(p)*E1(p) - 1/p.
+ * @param x :: Distance from the peak centre
+ * @param profileDerivs :: The derivatives from calProfileDerivatives
+ * @param dOmega :: [Output] The five derivatives
+ * @return Omega
+ */
+double ThermalNeutronBk2BkExpConvPVoigt::calOmegaDerivatives(
+    const double x, const std::vector<double> &profileDerivs,
+    double *dOmega) const {
+  const double eta = m_eta;
+  const double N = m_N;
+  const double alpha = m_Alpha;
+  const double beta = m_Beta;
+  const double sigma2 = m_Sigma2;
+  const double sigma = sqrt(sigma2);
+  const double invert_sqrt2sigma = 1.0 / sqrt(2.0 * sigma2);
+  const double gauss = 2. / sqrt(PI) * exp(-0.5 * x * x / sigma2);
+
+  const double u = 0.5 * alpha * (alpha * sigma2 + 2. * x);
+  const double y = (alpha * sigma2 + x) * invert_sqrt2sigma;
+  const double v = 0.5 * beta * (beta * sigma2 - 2. * x);
+  const double z = (beta * sigma2 - x) * invert_sqrt2sigma;
+
+  double part1(0.), dp1dx(0.), dp1da(0.), dp1ds(0.);
+  const double erfcy = gsl_sf_erfc(y);
+  if (fabs(erfcy) > DBL_MIN) {
+    part1 = exp(u) * erfcy;
+    dp1dx = alpha * part1 - gauss * invert_sqrt2sigma;
+    dp1da = part1 * (alpha * sigma2 + x) - gauss * sigma / M_SQRT2;
+    dp1ds = part1 * alpha * alpha / 2. -
+            gauss * (alpha - x / sigma2) / M_SQRT2 / (2. * sigma);
+  }
+
+  double part2(0.), dp2dx(0.), dp2db(0.), dp2ds(0.);
+  const double erfcz = gsl_sf_erfc(z);
+  if (fabs(erfcz) > DBL_MIN) {
+    part2 = exp(v) * erfcz;
+    dp2dx = -beta * part2 + gauss * invert_sqrt2sigma;
+    dp2db = part2 * (beta * sigma2 - x) - gauss * sigma / M_SQRT2;
+    dp2ds = part2 * beta * beta / 2. -
+            gauss * (beta + x / sigma2) / M_SQRT2 / (2. * sigma);
+  }
+
+  const double sumExp = part1 + part2;
+  double omega = (1. - eta) * N * sumExp;
+  double dOdx = (1. - eta) * N * (dp1dx + dp2dx);
+  double dOda = (1. - eta) * N * dp1da;
+  double dOdb = (1. - eta) * N * dp2db;
+  double dOds = (1. - eta) * N * (dp1ds + dp2ds);
+  double dOdN = (1. - eta) * sumExp;
+  double dOdeta = -N * sumExp;
+  double dOdH = 0.;
+
+  if (eta >= 1.0E-8) {
+    const double SQRT_H_5 = sqrt(m_fwhm) * .5;
+    const std::complex<double> wp(x, SQRT_H_5);
+    const std::complex<double> wq(-x, SQRT_H_5);
+    const std::complex<double> p = alpha * wp;
+    const std::complex<double> q = beta * wq;
+    const std::complex<double> Fp = exp(p) * Mantid::API::E1(p);
+    const std::complex<double> Fq = exp(q) * Mantid::API::E1(q);
+    const std::complex<double> dFp = Fp - 1.0 / p;
+    const std::complex<double> dFq = Fq - 1.0 / q;
+    const std::complex<double> i(0., 1.);
+    // d(SQRT_H_5)/dH
+    const double dShdH = 0.25 / sqrt(m_fwhm);
+
+    const double sumLor = imag(Fp) + imag(Fq);
+    const double scale = N * eta * TWO_OVER_PI;
+    omega -= scale * sumLor;
+    dOdx -= scale * (alpha * imag(dFp) - beta * imag(dFq));
+    dOda -= scale * imag(dFp * wp);
+    dOdb -= scale * imag(dFq * wq);
+    dOdH -= scale * dShdH * (alpha * imag(dFp * i) + beta * imag(dFq * i));
+    dOdN -= eta * TWO_OVER_PI * sumLor;
+    dOdeta -= N * TWO_OVER_PI * sumLor;
+  }
+
+  // N = alpha*beta/(2*(alpha+beta))
+  const double apb2 = (alpha + beta) * (alpha + beta);
+  dOda += dOdN * 0.5 * beta * beta / apb2;
+  dOdb += dOdN * 0.5 * alpha * alpha / apb2;
+
+  const size_t hetaIndex = 5 * nParams();
+  const double dHds = profileDerivs[hetaIndex];
+  const double dHdg = profileDerivs[hetaIndex + 1];
+  const double dEtads = profileDerivs[hetaIndex + 2];
+  const double dEtadg = profileDerivs[hetaIndex + 3];
+
+  dOmega[0] = -dOdx;
+  dOmega[1] = dOda;
+  dOmega[2] = dOdb;
+  dOmega[3] = dOds + dOdH * dHds + dOdeta * dEtads;
+  dOmega[4] = dOdH * dHdg + dOdeta * dEtadg;
+
+  return omega;
 }
 
 /** Get the center of the peak
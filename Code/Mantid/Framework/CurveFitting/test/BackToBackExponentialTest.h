@@ -6,7 +6,9 @@
 #include "MantidCurveFitting/BackToBackExponential.h"
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
+#include "MantidCurveFitting/Jacobian.h"
 
+#include <algorithm>
 #include <cmath>
 
 using Mantid::CurveFitting::BackToBackExponential;
@@ -185,7 +187,79 @@ public:
     }
 }
 
+  void test_analytic_derivatives_match_central_differences()
+  {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 2.1);
+    b2bExp.setParameter("A", 1.3);
+    b2bExp.setParameter("B", 0.7);
+    b2bExp.setParameter("X0", 0.5);
+    b2bExp.setParameter("S", 0.8);
+
+    Mantid::API::FunctionDomain1DVector x(-6, 6, 25);
+    Mantid::CurveFitting::Jacobian analytic(x.size(), b2bExp.nParams());
+    b2bExp.functionDeriv(x, analytic);
+
+    Mantid::API::FunctionValues plus(x), minus(x);
+    for(size_t j = 0; j < b2bExp.nParams(); ++j)
+    {
+      const double p = b2bExp.getParameter(j);
+      const double h = 1e-6 * std::max(1.0, fabs(p));
+      b2bExp.setParameter(j, p + h);
+      b2bExp.function(x, plus);
+      b2bExp.setParameter(j, p - h);
+      b2bExp.function(x, minus);
+      b2bExp.setParameter(j, p);
+      for(size_t i = 0; i < x.size(); ++i)
+      {
+        const double numeric = (plus[i] - minus[i]) / (2 * h);
+        TS_ASSERT_DELTA( analytic.get(i, j), numeric, 1e-6 );
+      }
+    }
+  }
+
+
+};
+
+class BackToBackExponentialTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BackToBackExponentialTestPerformance *createSuite() { return new BackToBackExponentialTestPerformance(); }
+  static void destroySuite( BackToBackExponentialTestPerformance *suite ) { delete suite; }
+
+  BackToBackExponentialTestPerformance() : m_x(-10, 10, 20000), m_jacobian(20000, 5)
+  {
+    m_b2bExp.initialize();
+    m_b2bExp.setParameter("I", 2.1);
+    m_b2bExp.setParameter("A", 1.3);
+    m_b2bExp.setParameter("B", 0.7);
+    m_b2bExp.setParameter("X0", 0.5);
+    m_b2bExp.setParameter("S", 0.8);
+  }
+
+  void test_analytic_derivatives()
+  {
+    for(int i = 0; i < 100; ++i)
+    {
+      m_b2bExp.functionDeriv(m_x, m_jacobian);
+    }
+  }
+
+  void test_numerical_derivatives()
+  {
+    for(int i = 0; i < 100; ++i)
+    {
+      m_b2bExp.calNumericalDeriv(m_x, m_jacobian);
+    }
+  }
 
+private:
+  BackToBackExponential m_b2bExp;
+  Mantid::API::FunctionDomain1DVector m_x;
+  Mantid::CurveFitting::Jacobian m_jacobian;
 };
 
 #endif /*BACKTOBACKEXPONENTIALTEST_H_*/
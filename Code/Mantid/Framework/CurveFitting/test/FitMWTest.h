@@ -193,6 +193,38 @@ public:
 
   }
 
+  void test_exec_can_be_repeated_with_new_workspace()
+  {
+    auto ws1 = createTestWorkspace(false);
+    auto ws2 = createTestWorkspace(true);
+
+    Fit fit;
+    fit.initialize();
+
+    API::IFunction_sptr fun(new ExpDecay);
+    fun->setParameter("Height",1.);
+    fun->setParameter("Lifetime",1.);
+    fit.setProperty("Function",fun);
+    fit.setProperty("InputWorkspace",ws1);
+    fit.setProperty("WorkspaceIndex",0);
+    fit.execute();
+    TS_ASSERT(fit.isExecuted());
+    TS_ASSERT_DELTA( fun->getParameter("Height"), 10.0, 1e-3);
+    TS_ASSERT_DELTA( fun->getParameter("Lifetime"), 0.5, 1e-4);
+
+    // A new function and workspace for the same algorithm instance
+    API::IFunction_sptr fun1(new ExpDecay);
+    fun1->setParameter("Height",1.);
+    fun1->setParameter("Lifetime",1.);
+    fit.setProperty("Function",fun1);
+    TS_ASSERT_THROWS_NOTHING( fit.setProperty("InputWorkspace",ws2) );
+    fit.setProperty("WorkspaceIndex",1);
+    fit.execute();
+    TS_ASSERT(fit.isExecuted());
+    TS_ASSERT_DELTA( fun1->getParameter("Height"), 11.5639, 1e-3);
+    TS_ASSERT_DELTA( fun1->getParameter("Lifetime"), 1.0, 1e-4);
+  }
+
   // test that errors of the calculated output are reasonable
   void test_output_errors()
   {
@@ -3,6 +3,7 @@
 
 #include <cxxtest/TestSuite.h>
 #include "MantidTestHelpers/FakeObjects.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
 #include "MantidCurveFitting/Fit.h"
 
@@ -12,6 +13,8 @@
 #include "MantidAPI/IFuncMinimizer.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
 
+#include <cmath>
+
 using namespace Mantid;
 using namespace Mantid::CurveFitting;
 using namespace Mantid::API;
@@ -133,4 +136,52 @@ public:
 
 };
 
+namespace
+{
+  /// A Gaussian on a sloping background
+  struct GaussianOnLinear
+  {
+    double operator()(double x, int)
+    {
+      return 1.0 + 0.1 * x + 10.0 * exp(-0.5 * (x - 5.0) * (x - 5.0) / 0.04);
+    }
+  };
+}
+
+class FitTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FitTestPerformance *createSuite() { return new FitTestPerformance(); }
+  static void destroySuite( FitTestPerformance *suite ) { delete suite; }
+
+  FitTestPerformance()
+  {
+    FrameworkManager::Instance();
+  }
+
+  void test_fit_1000_points()
+  {
+    runFit(0.01);
+  }
+
+  void test_fit_1000000_points()
+  {
+    runFit(0.00001);
+  }
+
+private:
+  void runFit(const double dx)
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(GaussianOnLinear(), 1, 0.0, 10.0, dx);
+    Fit fit;
+    fit.initialize();
+    fit.setProperty("Function", "name=LinearBackground,A0=0.5,A1=0;name=Gaussian,Height=8,PeakCentre=4.9,Sigma=0.3");
+    fit.setProperty("InputWorkspace", ws);
+    fit.setProperty("CreateOutput", false);
+    TS_ASSERT(fit.execute());
+  }
+};
+
 #endif /*CURVEFITTING_FITMWTEST_H_*/
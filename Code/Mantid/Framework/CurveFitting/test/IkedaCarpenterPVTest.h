@@ -5,10 +5,14 @@
 
 #include "MantidCurveFitting/IkedaCarpenterPV.h"
 #include "MantidCurveFitting/Fit.h"
+#include "MantidCurveFitting/Jacobian.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidKernel/ConfigService.h"
 
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include <boost/scoped_array.hpp>
+#include <algorithm>
 
 class IkedaCarpenterPVTest : public CxxTest::TestSuite
 {
@@ -214,6 +218,52 @@ public:
 
   }
 
+  void test_analytic_derivatives_match_central_differences()
+  {
+    using namespace Mantid::API;
+    using namespace Mantid::CurveFitting;
+
+    IkedaCarpenterPV icpv;
+    icpv.initialize();
+    setPeakParameters(icpv);
+
+    // Without a workspace all wavelengths are one
+    FunctionDomain1DVector x(45.0, 52.0, 36);
+    Mantid::CurveFitting::Jacobian analytic(x.size(), icpv.nParams());
+    // functionDeriv is not public in the peak function
+    static_cast<Mantid::API::IFunction &>(icpv).functionDeriv(x, analytic);
+
+    FunctionValues plus(x), minus(x);
+    for(size_t j = 0; j < icpv.nParams(); ++j)
+    {
+      const double p = icpv.getParameter(j);
+      const double h = 1e-6 * std::max(1.0, fabs(p));
+      icpv.setParameter(j, p + h);
+      icpv.function(x, plus);
+      icpv.setParameter(j, p - h);
+      icpv.function(x, minus);
+      icpv.setParameter(j, p);
+      for(size_t i = 0; i < x.size(); ++i)
+      {
+        const double numeric = (plus[i] - minus[i]) / (2 * h);
+        TS_ASSERT_DELTA( analytic.get(i, j), numeric, 1e-5 * std::max(1.0, fabs(numeric)) );
+      }
+    }
+  }
+
+  /// Parameters close to the result of fitting the mock data
+  static void setPeakParameters(Mantid::CurveFitting::IkedaCarpenterPV & icpv)
+  {
+    icpv.setParameter("I", 374.93);
+    icpv.setParameter("Alpha0", 1.597107);
+    icpv.setParameter("Alpha1", 1.496805);
+    icpv.setParameter("Beta0", 31.891718);
+    icpv.setParameter("Kappa", 46.025921);
+    icpv.setParameter("SigmaSquared", 0.0338);
+    icpv.setParameter("Gamma", 0.0484);
+    icpv.setParameter("X0", 48.229);
+  }
+
 private:
 
   Mantid::API::MatrixWorkspace_sptr createMockDataWorkspaceNoInstrument()
@@ -285,4 +335,40 @@ private:
   std::string m_preSetupPeakRadius;
 };
 
+class IkedaCarpenterPVTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static IkedaCarpenterPVTestPerformance *createSuite() { return new IkedaCarpenterPVTestPerformance(); }
+  static void destroySuite( IkedaCarpenterPVTestPerformance *suite ) { delete suite; }
+
+  IkedaCarpenterPVTestPerformance() : m_x(46.0, 51.0, 20000), m_jacobian(20000, 8)
+  {
+    m_icpv.initialize();
+    IkedaCarpenterPVTest::setPeakParameters(m_icpv);
+  }
+
+  void test_analytic_derivatives()
+  {
+    for(int i = 0; i < 10; ++i)
+    {
+      static_cast<Mantid::API::IFunction &>(m_icpv).functionDeriv(m_x, m_jacobian);
+    }
+  }
+
+  void test_numerical_derivatives()
+  {
+    for(int i = 0; i < 10; ++i)
+    {
+      m_icpv.calNumericalDeriv(m_x, m_jacobian);
+    }
+  }
+
+private:
+  Mantid::CurveFitting::IkedaCarpenterPV m_icpv;
+  Mantid::API::FunctionDomain1DVector m_x;
+  Mantid::CurveFitting::Jacobian m_jacobian;
+};
+
 #endif /*IKEDACARPENTERPVTEST_H_*/
@@ -0,0 +1,110 @@
+#ifndef MULTISPECTRUMFITTERTEST_H_
+#define MULTISPECTRUMFITTERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/MultiSpectrumFitter.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cmath>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using Mantid::CurveFitting::MultiSpectrumFitter;
+
+namespace
+{
+  /// A Gaussian on a flat background whose centre moves with the spectrum
+  struct MovingPeak
+  {
+    double operator()(double x, int spec)
+    {
+      const double c = 4.0 + 0.05 * spec;
+      return 1.0 + 3.0 * exp(-0.5 * (x - c) * (x - c) / (0.25 * 0.25));
+    }
+  };
+}
+
+class MultiSpectrumFitterTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MultiSpectrumFitterTest *createSuite() { return new MultiSpectrumFitterTest(); }
+  static void destroySuite( MultiSpectrumFitterTest *suite ) { delete suite; }
+
+  MultiSpectrumFitterTest()
+  {
+    FrameworkManager::Instance();
+  }
+
+  void test_parameters_are_taken_from_the_function_string()
+  {
+    MultiSpectrumFitter fitter(functionString(), "Levenberg-Marquardt", "Least squares");
+    TS_ASSERT_EQUALS(fitter.nParams(), 4);
+    TS_ASSERT_EQUALS(fitter.parameterName(0), "f0.A0");
+    TS_ASSERT_EQUALS(fitter.parameterName(2), "f1.PeakCentre");
+    TS_ASSERT_EQUALS(fitter.initialParameters().size(), 4);
+    TS_ASSERT_DELTA(fitter.initialParameters()[2], 4.5, 1e-12);
+  }
+
+  void test_fit_without_prepare_throws()
+  {
+    MultiSpectrumFitter fitter(functionString(), "Levenberg-Marquardt", "Least squares");
+    MatrixWorkspace_sptr ws = createWorkspace(1);
+    MultiSpectrumFitter::Result result;
+    TS_ASSERT_THROWS(fitter.fit(0, ws, 0, fitter.initialParameters(), result), std::runtime_error);
+  }
+
+  void test_each_spectrum_is_fitted_independently()
+  {
+    const int nSpec = 16;
+    MatrixWorkspace_sptr ws = createWorkspace(nSpec);
+    MultiSpectrumFitter fitter(functionString(), "Levenberg-Marquardt", "Least squares");
+    fitter.prepare(PARALLEL_GET_MAX_THREADS);
+
+    std::vector<MultiSpectrumFitter::Result> results(nSpec);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < nSpec; ++i)
+    {
+      fitter.fit(PARALLEL_THREAD_NUMBER, ws, i, fitter.initialParameters(), results[i]);
+    }
+
+    for (int i = 0; i < nSpec; ++i)
+    {
+      TS_ASSERT_EQUALS(results[i].status, "success");
+      TS_ASSERT_DELTA(results[i].parameters[0], 1.0, 1e-6);
+      TS_ASSERT_DELTA(results[i].parameters[1], 3.0, 1e-6);
+      TS_ASSERT_DELTA(results[i].parameters[2], 4.0 + 0.05 * i, 1e-6);
+      TS_ASSERT_DELTA(results[i].parameters[3], 0.25, 1e-6);
+      TS_ASSERT_DELTA(results[i].chi2, 0.0, 1e-6);
+    }
+  }
+
+  void test_restricted_range_is_used()
+  {
+    MatrixWorkspace_sptr ws = createWorkspace(1);
+    MultiSpectrumFitter fitter("name=FlatBackground,A0=0", "Levenberg-Marquardt", "Least squares");
+    // Far enough from the peak that only the background is seen
+    fitter.setRange(8.0, 10.0);
+    fitter.prepare(1);
+    MultiSpectrumFitter::Result result;
+    fitter.fit(0, ws, 0, fitter.initialParameters(), result);
+    TS_ASSERT_DELTA(result.parameters[0], 1.0, 1e-6);
+  }
+
+private:
+  std::string functionString() const
+  {
+    return "name=FlatBackground,A0=0.5;name=Gaussian,Height=2,PeakCentre=4.5,Sigma=0.3";
+  }
+
+  MatrixWorkspace_sptr createWorkspace(const int nSpec) const
+  {
+    return WorkspaceCreationHelper::Create2DWorkspaceFromFunction(MovingPeak(), nSpec, 0.0, 10.0, 0.02);
+  }
+};
+
+#endif /*MULTISPECTRUMFITTERTEST_H_*/
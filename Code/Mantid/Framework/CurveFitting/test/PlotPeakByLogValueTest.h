@@ -237,6 +237,34 @@ public:
 
   }
 
+  void test_individual_fits_keep_the_order_of_the_spectra()
+  {
+    auto ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(Fun(),20,-5.0,5.0,0.1,false);
+    AnalysisDataService::Instance().add( "PLOTPEAKBYLOGVALUETEST_WS", ws );
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input","PLOTPEAKBYLOGVALUETEST_WS,v1:20");
+    alg.setPropertyValue("OutputWorkspace","PlotPeakResult");
+    alg.setPropertyValue("FitType","Individual");
+    alg.setPropertyValue("Function","name=FlatBackground,A0=0.5");
+    alg.execute();
+
+    TS_ASSERT( alg.isExecuted() );
+
+    TWS_type result =  WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+    TS_ASSERT( result );
+    TS_ASSERT_EQUALS( result->rowCount(), 20 );
+
+    // spectrum i contains values equal to its spectrum number
+    for(size_t i = 0; i < result->rowCount(); ++i)
+    {
+      TS_ASSERT_DELTA( result->Double(i,0), double(i + 1), 1e-15 );
+      TS_ASSERT_DELTA( result->Double(i,1), double(i + 1), 1e-10 );
+    }
+
+    AnalysisDataService::Instance().clear();
+  }
+
   void test_passWorkspaceIndexToFunction()
   {
     auto ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(Fun(),3,-5.0,5.0,0.1,false);
@@ -5,8 +5,13 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
+#include <boost/scoped_ptr.hpp>
 
 #include "MantidCurveFitting/ThermalNeutronBk2BkExpConvPVoigt.h"
+#include "MantidCurveFitting/Jacobian.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 
 using namespace Mantid;
 using namespace Kernel;
@@ -308,6 +313,78 @@ public:
     return;
   }
 
+  /** Test that the analytic derivatives agree with central differences.
+    * A non-zero Gamma makes the Lorentzian part contribute.
+   */
+  void test_analytic_derivatives_match_central_differences()
+  {
+    ThermalNeutronBk2BkExpConvPVoigt peak;
+    peak.initialize();
+    setPeakParameters(peak);
+
+    const double tof_h = peak.centre();
+    const double fwhm = peak.fwhm();
+    API::FunctionDomain1DVector x(tof_h - 2 * fwhm, tof_h + 2 * fwhm, 41);
+    CurveFitting::Jacobian analytic(x.size(), peak.nParams());
+    // functionDeriv is not public in the peak function
+    static_cast<Mantid::API::IFunction &>(peak).functionDeriv(x, analytic);
+
+    API::FunctionValues plus(x), minus(x);
+    for (size_t j = 0; j < peak.nParams(); ++j)
+    {
+      const double p = peak.getParameter(j);
+      const double h = 1.0E-6 * std::max(1.0, fabs(p));
+      peak.setParameter(j, p + h);
+      peak.function(x, plus);
+      peak.setParameter(j, p - h);
+      peak.function(x, minus);
+      peak.setParameter(j, p);
+      for (size_t i = 0; i < x.size(); ++i)
+      {
+        const double numeric = (plus[i] - minus[i]) / (2 * h);
+        TS_ASSERT_DELTA(analytic.get(i, j), numeric, 1.0E-4 * std::max(1.0, fabs(numeric)));
+      }
+    }
+  }
+
+  /** Set the parameters of the (111) peak with a Lorentzian part
+   */
+  static void setPeakParameters(ThermalNeutronBk2BkExpConvPVoigt& peak)
+  {
+    peak.setMillerIndex(1, 1, 1);
+
+    peak.setParameter("Dtt1", 29671.7500);
+    peak.setParameter("Dtt2", 0.0);
+    peak.setParameter("Dtt1t", 29671.750);
+    peak.setParameter("Dtt2t", 0.30);
+
+    peak.setParameter("Zero", 0.0);
+    peak.setParameter("Zerot", 33.70);
+
+    peak.setParameter("Alph0", 4.026);
+    peak.setParameter("Alph1", 7.362);
+    peak.setParameter("Beta0", 3.489);
+    peak.setParameter("Beta1", 19.535);
+
+    peak.setParameter("Alph0t", 60.683);
+    peak.setParameter("Alph1t", 39.730);
+    peak.setParameter("Beta0t", 96.864);
+    peak.setParameter("Beta1t", 96.864);
+
+    peak.setParameter("Sig2",  sqrt(11.380));
+    peak.setParameter("Sig1",  sqrt(9.901));
+    peak.setParameter("Sig0",  sqrt(17.370));
+
+    peak.setParameter("Width", 1.0055);
+    peak.setParameter("Tcross", 0.4700);
+
+    peak.setParameter("Gam0", 0.0);
+    peak.setParameter("Gam1", 5.744);
+    peak.setParameter("Gam2", 0.0);
+
+    peak.setParameter("LatticeConstant", 4.156890);
+    peak.setParameter("Height", 1370.0/0.008);
+  }
 
   /** Generate a set of powder diffraction data with 2 peaks (110 and 111)
    */
@@ -569,4 +646,44 @@ public:
 
 };
 
+class ThermalNeutronBk2BkExpConvPVoigtTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThermalNeutronBk2BkExpConvPVoigtTestPerformance *createSuite() { return new ThermalNeutronBk2BkExpConvPVoigtTestPerformance(); }
+  static void destroySuite( ThermalNeutronBk2BkExpConvPVoigtTestPerformance *suite ) { delete suite; }
+
+  ThermalNeutronBk2BkExpConvPVoigtTestPerformance() : m_jacobian(NDATA, 24)
+  {
+    m_peak.initialize();
+    ThermalNeutronBk2BkExpConvPVoigtTest::setPeakParameters(m_peak);
+    const double tof_h = m_peak.centre();
+    const double fwhm = m_peak.fwhm();
+    m_x.reset(new API::FunctionDomain1DVector(tof_h - 5 * fwhm, tof_h + 5 * fwhm, NDATA));
+  }
+
+  void test_analytic_derivatives()
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      static_cast<API::IFunction &>(m_peak).functionDeriv(*m_x, m_jacobian);
+    }
+  }
+
+  void test_numerical_derivatives()
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      m_peak.calNumericalDeriv(*m_x, m_jacobian);
+    }
+  }
+
+private:
+  static const size_t NDATA = 10000;
+  ThermalNeutronBk2BkExpConvPVoigt m_peak;
+  boost::scoped_ptr<API::FunctionDomain1DVector> m_x;
+  CurveFitting::Jacobian m_jacobian;
+};
+
 #endif /* MANTID_CURVEFITTING_THERMALNEUTRONBK2BKEXPCONVPVTEST_H_ */
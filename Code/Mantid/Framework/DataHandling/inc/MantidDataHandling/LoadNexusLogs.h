@@ -76,6 +76,22 @@ public:
   }
 
 private:
+  /// The arrays of a time series log as read from the file. Converting them
+  /// into a TimeSeriesProperty needs no file access.
+  struct RawTimeSeries {
+    RawTimeSeries() : type(DOUBLE), itemLength(0) {}
+    enum ValueType { INT, DOUBLE, STRING };
+    std::string name;  ///< The name of the property
+    std::string start; ///< The ISO8601 start time of the log
+    std::string units; ///< The units of the values
+    std::vector<double> times; ///< Offsets from the start in seconds
+    ValueType type;            ///< Which of the value arrays is filled
+    std::vector<int> intValues;
+    std::vector<double> doubleValues;
+    std::string charValues; ///< Fixed length strings, one after the other
+    size_t itemLength;      ///< The length of each string
+  };
+
   /// Overwrites Algorithm method.
   void init();
   /// Overwrites Algorithm method
@@ -83,11 +99,15 @@ private:
   /// Load log data from a group
   void loadLogs(::NeXus::File &file, const std::string &entry_name,
                 const std::string &entry_class,
-                boost::shared_ptr<API::MatrixWorkspace> workspace) const;
-  /// Load an NXlog entry
+                boost::shared_ptr<API::MatrixWorkspace> workspace);
+  /// Read an NXlog entry
   void loadNXLog(::NeXus::File &file, const std::string &entry_name,
                  const std::string &entry_class,
-                 boost::shared_ptr<API::MatrixWorkspace> workspace) const;
+                 boost::shared_ptr<API::MatrixWorkspace> workspace,
+                 std::vector<RawTimeSeries> &pending) const;
+  /// Convert the logs that have been read and add them to the workspace
+  void addTimeSeries(std::vector<RawTimeSeries> &pending,
+                     boost::shared_ptr<API::MatrixWorkspace> workspace);
   /// Load an IXseblock entry
   void loadSELog(::NeXus::File &file, const std::string &entry_name,
                  boost::shared_ptr<API::MatrixWorkspace> workspace) const;
@@ -97,6 +117,11 @@ private:
   /// Create a time series property
   Kernel::Property *createTimeSeries(::NeXus::File &file,
                                      const std::string &prop_name) const;
+  /// Read the arrays of a time series log
+  void readTimeSeries(::NeXus::File &file, const std::string &prop_name,
+                      RawTimeSeries &raw) const;
+  /// Create a time series property from the arrays read from the file
+  Kernel::Property *buildTimeSeries(RawTimeSeries &raw) const;
   /// Progress reporting object
   boost::shared_ptr<API::Progress> m_progress;
 
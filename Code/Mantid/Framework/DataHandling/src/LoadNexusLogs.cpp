@@ -265,7 +265,9 @@ void LoadNexusLogs::loadVetoPulses(
 }
 
 /**
- * Load log entries from the given group
+ * Load log entries from the given group. The file can only be read from one
+ * thread, so the NXlog entries are read first and then converted to
+ * properties in parallel.
  * @param file :: A reference to the NeXus file handle opened such that the
  * next call can be to open the named group
  * @param entry_name :: The name of the log entry
@@ -275,36 +277,44 @@ void LoadNexusLogs::loadVetoPulses(
 void LoadNexusLogs::loadLogs(
     ::NeXus::File &file, const std::string &entry_name,
     const std::string &entry_class,
-    boost::shared_ptr<API::MatrixWorkspace> workspace) const {
+    boost::shared_ptr<API::MatrixWorkspace> workspace) {
   file.openGroup(entry_name, entry_class);
   std::map<std::string, std::string> entries = file.getEntries();
+  std::vector<RawTimeSeries> pending;
+  pending.reserve(entries.size());
   std::map<std::string, std::string>::const_iterator iend = entries.end();
   for (std::map<std::string, std::string>::const_iterator itr = entries.begin();
        itr != iend; ++itr) {
     std::string log_class = itr->second;
     if (log_class == "NXlog" || log_class == "NXpositioner") {
-      loadNXLog(file, itr->first, log_class, workspace);
+      loadNXLog(file, itr->first, log_class, workspace, pending);
     } else if (log_class == "IXseblock") {
+      // The name of an SE log depends on the logs already added
+      addTimeSeries(pending, workspace);
       loadSELog(file, itr->first, workspace);
     }
   }
+  addTimeSeries(pending, workspace);
   loadVetoPulses(file, workspace);
 
   file.closeGroup();
 }
 
 /**
- * Load an NX log entry a group type that has value and time entries.
+ * Read an NX log entry a group type that has value and time entries.
  * @param file :: A reference to the NeXus file handle opened at the parent
  * group
  * @param entry_name :: The name of the log entry
  * @param entry_class :: The type of the entry
  * @param workspace :: A pointer to the workspace to store the logs
+ * @param pending :: The arrays of the log are appended to this, to be added
+ * to the workspace by addTimeSeries()
  */
 void LoadNexusLogs::loadNXLog(
     ::NeXus::File &file, const std::string &entry_name,
     const std::string &entry_class,
-    boost::shared_ptr<API::MatrixWorkspace> workspace) const {
+    boost::shared_ptr<API::MatrixWorkspace> workspace,
+    std::vector<RawTimeSeries> &pending) const {
   g_log.debug() << "processing " << entry_name << ":" << entry_class << "\n";
 
   file.openGroup(entry_name, entry_class);
@@ -321,8 +331,14 @@ void LoadNexusLogs::loadNXLog(
   bool overwritelogs = this->getProperty("OverwriteLogs");
   try {
     if (overwritelogs || !(workspace->run().hasProperty(entry_name))) {
-      Kernel::Property *logValue = createTimeSeries(file, entry_name);
-      workspace->mutableRun().addProperty(logValue, overwritelogs);
+      pending.push_back(RawTimeSeries());
+      pending.back().name = entry_name;
+      try {
+        readTimeSeries(file, entry_name, pending.back());
+      } catch (::NeXus::Exception &) {
+        pending.pop_back();
+        throw;
+      }
     }
   } catch (::NeXus::Exception &e) {
     g_log.warning() << "NXlog entry " << entry_name
@@ -406,6 +422,37 @@ void LoadNexusLogs::loadSELog(
   file.closeGroup();
 }
 
+/**
+ * Convert the time series logs that have been read from the file into
+ * properties, in parallel, and add them to the workspace in the order they
+ * were read.
+ * @param pending :: The arrays read by loadNXLog(). Emptied on return.
+ * @param workspace :: A pointer to the workspace to store the logs
+ */
+void LoadNexusLogs::addTimeSeries(
+    std::vector<RawTimeSeries> &pending,
+    boost::shared_ptr<API::MatrixWorkspace> workspace) {
+  const int64_t numLogs = static_cast<int64_t>(pending.size());
+  std::vector<Kernel::Property *> properties(pending.size(), NULL);
+  PARALLEL_FOR_IF(numLogs > 1)
+  for (int64_t i = 0; i < numLogs; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    properties[i] = buildTimeSeries(pending[i]);
+    PARALLEL_END_INTERUPT_REGION
+  }
+  pending.clear();
+  if (m_parallelException) {
+    for (size_t i = 0; i < properties.size(); ++i)
+      delete properties[i];
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  const bool overwritelogs = this->getProperty("OverwriteLogs");
+  for (size_t i = 0; i < properties.size(); ++i) {
+    workspace->mutableRun().addProperty(properties[i], overwritelogs);
+  }
+}
+
 /**
  * Creates a time series property from the currently opened log entry. It is
  * assumed to
@@ -418,6 +465,22 @@ void LoadNexusLogs::loadSELog(
 Kernel::Property *
 LoadNexusLogs::createTimeSeries(::NeXus::File &file,
                                 const std::string &prop_name) const {
+  RawTimeSeries raw;
+  readTimeSeries(file, prop_name, raw);
+  raw.name = prop_name;
+  return buildTimeSeries(raw);
+}
+
+/**
+ * Reads the time and value arrays of the currently opened log entry. It is
+ * assumed to have been checked to have a time field.
+ * @param file :: A reference to the file handle
+ * @param prop_name :: The name of the property, for messages
+ * @param raw :: Filled with the arrays and attributes of the log
+ */
+void LoadNexusLogs::readTimeSeries(::NeXus::File &file,
+                                   const std::string &prop_name,
+                                   RawTimeSeries &raw) const {
   file.openData("time");
   //----- Start time is an ISO8601 string date and time. ------
   std::string start;
@@ -436,9 +499,8 @@ LoadNexusLogs::createTimeSeries(::NeXus::File &file,
   if (start.compare("No Time") == 0) {
     start = freqStart;
   }
+  raw.start = start;
 
-  // Convert to date and time
-  Kernel::DateAndTime start_time = Kernel::DateAndTime(start);
   std::string time_units;
   file.getAttr("units", time_units);
   if (time_units.compare("second") < 0 && time_units != "s" &&
@@ -448,7 +510,7 @@ LoadNexusLogs::createTimeSeries(::NeXus::File &file,
     throw ::NeXus::Exception("Unsupported time unit '" + time_units + "'");
   }
   //--- Load the seconds into a double array ---
-  std::vector<double> time_double;
+  std::vector<double> &time_double = raw.times;
   try {
     file.getDataCoerce(time_double);
   } catch (::NeXus::Exception &e) {
@@ -475,6 +537,7 @@ LoadNexusLogs::createTimeSeries(::NeXus::File &file,
     // Ignore missing units field.
     value_units = "";
   }
+  raw.units = value_units;
 
   // Now the actual data
   ::NeXus::Info info = file.getInfo();
@@ -485,22 +548,16 @@ LoadNexusLogs::createTimeSeries(::NeXus::File &file,
   }
   if (file.isDataInt()) // Int type
   {
-    std::vector<int> values;
+    raw.type = RawTimeSeries::INT;
     try {
-      file.getDataCoerce(values);
+      file.getDataCoerce(raw.intValues);
       file.closeData();
     } catch (::NeXus::Exception &) {
       file.closeData();
       throw;
     }
-    // Make an int TSP
-    TimeSeriesProperty<int> *tsp = new TimeSeriesProperty<int>(prop_name);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    g_log.debug() << "   done reading \"value\" array\n";
-    return tsp;
   } else if (info.type == ::NeXus::CHAR) {
-    std::string values;
+    raw.type = RawTimeSeries::STRING;
     const int64_t item_length = info.dims[1];
     try {
       const int64_t nitems = info.dims[0];
@@ -508,46 +565,73 @@ LoadNexusLogs::createTimeSeries(::NeXus::File &file,
       boost::scoped_array<char> val_array(new char[total_length]);
       file.getData(val_array.get());
       file.closeData();
-      values = std::string(val_array.get(), total_length);
+      raw.charValues = std::string(val_array.get(), total_length);
     } catch (::NeXus::Exception &) {
       file.closeData();
       throw;
     }
-    // The string may contain non-printable (i.e. control) characters, replace
-    // these
-    std::replace_if(values.begin(), values.end(), iscntrl, ' ');
-    TimeSeriesProperty<std::string> *tsp =
-        new TimeSeriesProperty<std::string>(prop_name);
-    std::vector<DateAndTime> times;
-    DateAndTime::createVector(start_time, time_double, times);
-    const size_t ntimes = times.size();
-    for (size_t i = 0; i < ntimes; ++i) {
-      std::string value_i =
-          std::string(values.data() + i * item_length, item_length);
-      tsp->addValue(times[i], value_i);
-    }
-    tsp->setUnits(value_units);
-    g_log.debug() << "   done reading \"value\" array\n";
-    return tsp;
+    raw.itemLength = static_cast<size_t>(item_length);
   } else if (info.type == ::NeXus::FLOAT32 || info.type == ::NeXus::FLOAT64) {
-    std::vector<double> values;
+    raw.type = RawTimeSeries::DOUBLE;
     try {
-      file.getDataCoerce(values);
+      file.getDataCoerce(raw.doubleValues);
       file.closeData();
     } catch (::NeXus::Exception &) {
       file.closeData();
       throw;
     }
-    TimeSeriesProperty<double> *tsp = new TimeSeriesProperty<double>(prop_name);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    g_log.debug() << "   done reading \"value\" array\n";
-    return tsp;
   } else {
     throw ::NeXus::Exception(
         "Invalid value type for time series. Only int, double or strings are "
         "supported");
   }
+  g_log.debug() << "   done reading \"value\" array of " << prop_name << "\n";
+}
+
+/**
+ * Creates a time series property from the arrays of a log. This does not
+ * touch the file so may be called from several threads at once.
+ * @param raw :: The arrays read by readTimeSeries(). Their memory is
+ * released.
+ * @returns A pointer to a new property containing the time series
+ */
+Kernel::Property *LoadNexusLogs::buildTimeSeries(RawTimeSeries &raw) const {
+  // Convert to date and time
+  const Kernel::DateAndTime start_time = Kernel::DateAndTime(raw.start);
+  Kernel::Property *result(NULL);
+  if (raw.type == RawTimeSeries::INT) {
+    TimeSeriesProperty<int> *tsp = new TimeSeriesProperty<int>(raw.name);
+    tsp->create(start_time, raw.times, raw.intValues);
+    result = tsp;
+  } else if (raw.type == RawTimeSeries::STRING) {
+    std::string &values = raw.charValues;
+    // The string may contain non-printable (i.e. control) characters, replace
+    // these
+    std::replace_if(values.begin(), values.end(), iscntrl, ' ');
+    TimeSeriesProperty<std::string> *tsp =
+        new TimeSeriesProperty<std::string>(raw.name);
+    std::vector<DateAndTime> times;
+    DateAndTime::createVector(start_time, raw.times, times);
+    const size_t ntimes = times.size();
+    for (size_t i = 0; i < ntimes; ++i) {
+      std::string value_i =
+          std::string(values.data() + i * raw.itemLength, raw.itemLength);
+      tsp->addValue(times[i], value_i);
+    }
+    result = tsp;
+  } else {
+    TimeSeriesProperty<double> *tsp = new TimeSeriesProperty<double>(raw.name);
+    tsp->create(start_time, raw.times, raw.doubleValues);
+    result = tsp;
+  }
+  result->setUnits(raw.units);
+
+  // The property has its own copy now
+  std::vector<double>().swap(raw.times);
+  std::vector<int>().swap(raw.intValues);
+  std::vector<double>().swap(raw.doubleValues);
+  std::string().swap(raw.charValues);
+  return result;
 }
 
 } // namespace DataHandling
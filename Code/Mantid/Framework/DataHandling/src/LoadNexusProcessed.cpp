@@ -1270,7 +1270,9 @@ API::Workspace_sptr LoadNexusProcessed::loadEntry(NXRoot &root,
       fracarea = wksp_cls.openNXDouble("frac_area");
     }
 
-    int64_t blocksize(8);
+    // Read as many spectra at a time as are stored in one chunk of the file
+    int64_t blocksize(
+        static_cast<int64_t>(NexusFileIO::spectraPerChunk(nchannels)));
     // const int fullblocks = nspectra / blocksize;
     // size of the workspace
     int64_t fullblocks = total_specs / blocksize;
@@ -1729,25 +1731,21 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
     farea_end = farea_start + nchannels;
     rb_workspace = boost::dynamic_pointer_cast<RebinnedOutput>(local_workspace);
   }
-  int64_t final(hist + blocksize);
-  while (hist < final) {
-    MantidVec &Y = local_workspace->dataY(hist);
-    Y.assign(data_start, data_end);
-    data_start += nchannels;
-    data_end += nchannels;
-    MantidVec &E = local_workspace->dataE(hist);
-    E.assign(err_start, err_end);
-    err_start += nchannels;
-    err_end += nchannels;
+  PARALLEL_FOR1(local_workspace)
+  for (int64_t i = 0; i < blocksize; ++i) {
+    const int64_t offset(i * nchannels);
+    const int64_t index(hist + i);
+    MantidVec &Y = local_workspace->dataY(index);
+    Y.assign(data_start + offset, data_end + offset);
+    MantidVec &E = local_workspace->dataE(index);
+    E.assign(err_start + offset, err_end + offset);
     if (hasFArea) {
-      MantidVec &F = rb_workspace->dataF(hist);
-      F.assign(farea_start, farea_end);
-      farea_start += nchannels;
-      farea_end += nchannels;
+      MantidVec &F = rb_workspace->dataF(index);
+      F.assign(farea_start + offset, farea_end + offset);
     }
-    local_workspace->setX(hist, m_xbins);
-    ++hist;
+    local_workspace->setX(index, m_xbins);
   }
+  hist += blocksize;
 }
 
 /**
@@ -1786,26 +1784,22 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
     farea_end = farea_start + nchannels;
     rb_workspace = boost::dynamic_pointer_cast<RebinnedOutput>(local_workspace);
   }
-  int64_t final(hist + blocksize);
-  while (hist < final) {
-    MantidVec &Y = local_workspace->dataY(wsIndex);
-    Y.assign(data_start, data_end);
-    data_start += nchannels;
-    data_end += nchannels;
-    MantidVec &E = local_workspace->dataE(wsIndex);
-    E.assign(err_start, err_end);
-    err_start += nchannels;
-    err_end += nchannels;
+  PARALLEL_FOR1(local_workspace)
+  for (int64_t i = 0; i < blocksize; ++i) {
+    const int64_t offset(i * nchannels);
+    const int64_t index(wsIndex + i);
+    MantidVec &Y = local_workspace->dataY(index);
+    Y.assign(data_start + offset, data_end + offset);
+    MantidVec &E = local_workspace->dataE(index);
+    E.assign(err_start + offset, err_end + offset);
     if (hasFArea) {
-      MantidVec &F = rb_workspace->dataF(wsIndex);
-      F.assign(farea_start, farea_end);
-      farea_start += nchannels;
-      farea_end += nchannels;
+      MantidVec &F = rb_workspace->dataF(index);
+      F.assign(farea_start + offset, farea_end + offset);
     }
-    local_workspace->setX(wsIndex, m_xbins);
-    ++hist;
-    ++wsIndex;
+    local_workspace->setX(index, m_xbins);
   }
+  hist += blocksize;
+  wsIndex += blocksize;
 }
 
 /**
@@ -1849,29 +1843,23 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
   const int64_t nxbins(nchannels + 1);
   double *xbin_start = xbins();
   double *xbin_end = xbin_start + nxbins;
-  int64_t final(hist + blocksize);
-  while (hist < final) {
-    MantidVec &Y = local_workspace->dataY(wsIndex);
-    Y.assign(data_start, data_end);
-    data_start += nchannels;
-    data_end += nchannels;
-    MantidVec &E = local_workspace->dataE(wsIndex);
-    E.assign(err_start, err_end);
-    err_start += nchannels;
-    err_end += nchannels;
+  PARALLEL_FOR1(local_workspace)
+  for (int64_t i = 0; i < blocksize; ++i) {
+    const int64_t offset(i * nchannels);
+    const int64_t index(wsIndex + i);
+    MantidVec &Y = local_workspace->dataY(index);
+    Y.assign(data_start + offset, data_end + offset);
+    MantidVec &E = local_workspace->dataE(index);
+    E.assign(err_start + offset, err_end + offset);
     if (hasFArea) {
-      MantidVec &F = rb_workspace->dataF(wsIndex);
-      F.assign(farea_start, farea_end);
-      farea_start += nchannels;
-      farea_end += nchannels;
+      MantidVec &F = rb_workspace->dataF(index);
+      F.assign(farea_start + offset, farea_end + offset);
     }
-    MantidVec &X = local_workspace->dataX(wsIndex);
-    X.assign(xbin_start, xbin_end);
-    xbin_start += nxbins;
-    xbin_end += nxbins;
-    ++hist;
-    ++wsIndex;
+    MantidVec &X = local_workspace->dataX(index);
+    X.assign(xbin_start + i * nxbins, xbin_end + i * nxbins);
   }
+  hist += blocksize;
+  wsIndex += blocksize;
 }
 
 /**
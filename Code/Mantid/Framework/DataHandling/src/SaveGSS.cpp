@@ -445,7 +445,7 @@ void SaveGSS::writeHeaders(const std::string &format, std::stringstream &os,
     // print whether it is normalized by monitor or pcharge
     bool norm_by_current = false;
     bool norm_by_monitor = false;
-    const Mantid::API::AlgorithmHistories &algohist =
+    const Mantid::API::AlgorithmHistories algohist =
         inputWS->getHistory().getAlgorithmHistories();
     for (Mantid::API::AlgorithmHistories::const_iterator it = algohist.begin();
          it != algohist.end(); ++it) {
@@ -108,6 +108,24 @@ public:
     TS_ASSERT_EQUALS(dlog->size(),172);
   }
 
+  void test_existing_logs_are_kept_if_not_overwriting()
+  {
+    LoadNexusLogs loader;
+    loader.initialize();
+    MatrixWorkspace_sptr testWS = createTestWorkspace();
+    testWS->mutableRun().addProperty("Speed3", std::string("kept"));
+    loader.setProperty("Workspace",testWS);
+    loader.setPropertyValue("Filename","REF_L_32035.nxs");
+    loader.setProperty("OverwriteLogs", false);
+    TS_ASSERT_THROWS_NOTHING(loader.execute());
+    TS_ASSERT(loader.isExecuted());
+
+    const API::Run & run = testWS->run();
+    TS_ASSERT_EQUALS(run.getLogData().size(), 74);
+    TS_ASSERT_EQUALS(run.getLogData("Speed3")->value(), "kept");
+    TS_ASSERT(dynamic_cast<TimeSeriesProperty<double>*>(run.getLogData("Phase1")));
+  }
+
 private:
   
   API::MatrixWorkspace_sptr createTestWorkspace()
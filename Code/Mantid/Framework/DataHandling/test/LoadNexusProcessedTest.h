@@ -10,6 +10,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidDataHandling/LoadNexusProcessed.h"
 #include "MantidDataHandling/SaveNexusProcessed.h"
+#include "MantidNexus/NexusFileIO.h"
 #include "MantidDataHandling/Load.h"
 #include "SaveNexusProcessedTest.h"
 #include <cxxtest/TestSuite.h>
@@ -809,6 +810,74 @@ public:
     do_load_multiperiod_workspace(false /*Use old route*/);
   }
 
+  void test_workspace_spanning_several_chunks_is_read_back_exactly()
+  {
+    // Enough spectra that the data is written and read in more than one chunk
+    const size_t nbins(10);
+    const int nhist(static_cast<int>(
+        2 * Mantid::NeXus::NexusFileIO::spectraPerChunk(nbins) + 3));
+    MatrixWorkspace_sptr inputWS =
+        WorkspaceCreationHelper::Create2DWorkspace(nhist, static_cast<int>(nbins));
+    for (size_t i = 0; i < inputWS->getNumberHistograms(); ++i)
+    {
+      Mantid::MantidVec &Y = inputWS->dataY(i);
+      Mantid::MantidVec &E = inputWS->dataE(i);
+      for (size_t j = 0; j < nbins; ++j)
+      {
+        Y[j] = static_cast<double>(i * nbins + j);
+        E[j] = 0.5 * Y[j];
+      }
+    }
+    ScopedWorkspace inputEntry(inputWS);
+    std::string savedFileName("LoadNexusProcessedTest_SeveralChunks.nxs");
+
+    SaveNexusProcessed saveAlg;
+    saveAlg.initialize();
+    saveAlg.setPropertyValue("InputWorkspace", inputEntry.name());
+    saveAlg.setPropertyValue("Filename", savedFileName);
+    TS_ASSERT_THROWS_NOTHING( saveAlg.execute());
+    if (!saveAlg.isExecuted())
+      return; // Nothing to check
+    savedFileName = saveAlg.getPropertyValue("Filename");
+
+    // The whole workspace and a range crossing the first chunk boundary
+    const int specMin(nhist / 2 - 5), specMax(nhist / 2 + 5);
+    for (int useRange = 0; useRange < 2; ++useRange)
+    {
+      LoadNexusProcessed loadAlg;
+      loadAlg.setChild(true);
+      loadAlg.initialize();
+      loadAlg.setPropertyValue("Filename", savedFileName);
+      loadAlg.setPropertyValue("OutputWorkspace", "dummy");
+      if (useRange)
+      {
+        loadAlg.setPropertyValue("SpectrumMin", boost::lexical_cast<std::string>(specMin));
+        loadAlg.setPropertyValue("SpectrumMax", boost::lexical_cast<std::string>(specMax));
+      }
+      TS_ASSERT_THROWS_NOTHING( loadAlg.execute());
+      if (!loadAlg.isExecuted())
+        break;
+
+      Workspace_sptr loaded = loadAlg.getProperty("OutputWorkspace");
+      MatrixWorkspace_sptr outputWS = boost::dynamic_pointer_cast<MatrixWorkspace>(loaded);
+      TS_ASSERT( outputWS);
+      if (!outputWS)
+        break;
+      const size_t firstIndex = useRange ? static_cast<size_t>(specMin - 1) : 0;
+      const size_t expectedHist = useRange ? static_cast<size_t>(specMax - specMin + 1)
+                                           : static_cast<size_t>(nhist);
+      TS_ASSERT_EQUALS( outputWS->getNumberHistograms(), expectedHist);
+      for (size_t i = 0; i < outputWS->getNumberHistograms(); ++i)
+      {
+        TS_ASSERT_EQUALS( outputWS->readY(i), inputWS->readY(firstIndex + i));
+        TS_ASSERT_EQUALS( outputWS->readE(i), inputWS->readE(firstIndex + i));
+        TS_ASSERT_EQUALS( outputWS->readX(i), inputWS->readX(firstIndex + i));
+      }
+    }
+
+    Poco::File(savedFileName).remove();
+  }
+
 private:
   void doHistoryTest(MatrixWorkspace_sptr matrix_ws)
   {
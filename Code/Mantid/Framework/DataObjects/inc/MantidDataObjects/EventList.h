@@ -100,6 +100,8 @@ public:
 
   EventList &operator+=(const EventList &more_events);
 
+  EventList &mergeByTof(const EventList &more_events);
+
   EventList &operator-=(const EventList &more_events);
 
   bool operator==(const EventList &rhs) const;
@@ -295,6 +297,7 @@ public:
                                                  const double &tofOffset) const;
 
   std::vector<double> getTofs() const;
+  const double *readTofs(std::size_t &stride) const;
 
   /// Return the list of event weight  values
   std::vector<double> getWeights() const;
@@ -350,7 +353,8 @@ public:
 
   void convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
                           Mantid::Kernel::Unit *toUnit);
-  void convertUnitsQuickly(const double &factor, const double &power);
+  void convertUnitsQuickly(const double &factor, const double &power,
+                           const bool avoidZero = false);
 
 private:
   /// List of TofEvent (no weights).
@@ -443,6 +447,9 @@ private:
   static void getTofsHelper(const std::vector<T> &events,
                             std::vector<double> &tofs);
   template <class T>
+  static const double *tofColumnHelper(const std::vector<T> &events,
+                                       std::size_t &stride);
+  template <class T>
   static void getWeightsHelper(const std::vector<T> &events,
                                std::vector<double> &weights);
   template <class T>
@@ -502,7 +509,8 @@ private:
                                 Mantid::Kernel::Unit *toUnit);
   template <class T>
   void convertUnitsQuicklyHelper(typename std::vector<T> &events,
-                                 const double &factor, const double &power);
+                                 const double &factor, const double &power,
+                                 const bool avoidZero);
 };
 
 // Methods overloaded to get event vectors.
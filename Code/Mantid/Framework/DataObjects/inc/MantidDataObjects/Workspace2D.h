@@ -16,6 +16,13 @@ namespace DataObjects {
     Concrete workspace implementation. Data is a vector of Histogram1D.
     Since Histogram1D have share ownership of X, Y or E arrays,
     duplication is avoided for workspaces for example with identical time bins.
+    The histograms themselves are held in a single block so that creating
+    a workspace does not make an allocation for each spectrum.
+
+    The X, Y and E arrays of each spectrum are separate vectors, shared and
+    copied on write one spectrum at a time. There is no contiguous storage of
+    the Y or E of all spectra, so it cannot be handed out as a single 2D
+    array without copying.
 
     \author Laurent C Chapon, ISIS, RAL
     \date 26/09/2007
@@ -101,6 +108,9 @@ protected:
   /// A vector that holds the 1D histograms
   std::vector<Mantid::API::ISpectrum *> data;
 
+  /// The histograms pointed to by data, allocated as one block
+  std::vector<Histogram1D> m_histograms;
+
 private:
   /// Private copy constructor. NO COPY ALLOWED
   Workspace2D(const Workspace2D &);
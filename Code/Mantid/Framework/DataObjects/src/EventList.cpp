@@ -5,6 +5,7 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
+#include <algorithm>
 #include <cfloat>
 
 #include <functional>
@@ -484,6 +485,49 @@ EventList &EventList::operator+=(const EventList &more_events) {
   return *this;
 }
 
+// --------------------------------------------------------------------------
+/** Merge the events appended after a sorted run into that run.
+ * @param events :: A vector sorted by TOF up to start and from start on
+ * @param start :: Index of the first appended event
+ */
+template <class T>
+static void mergeAppendedByTof(std::vector<T> &events, const size_t start) {
+  std::inplace_merge(events.begin(), events.begin() + start, events.end(),
+                     compareEventTof<T>);
+}
+
+/** Append another EventList to this event list, keeping the result sorted
+ * by TOF.
+ * Only the incoming events need sorting. The merge that follows still takes
+ * time linear in the length of the whole list, so adding k events to a
+ * sorted list of n costs O(k log k + n) rather than the O(n log n) of
+ * appending them and sorting everything again.
+ *
+ * @param more_events :: Another EventList. It is sorted by TOF if it is not
+ *already.
+ * @return reference to this
+ * */
+EventList &EventList::mergeByTof(const EventList &more_events) {
+  this->sortTof();
+  more_events.sortTof();
+  const size_t start = this->getNumberEvents();
+  this->operator+=(more_events);
+
+  switch (eventType) {
+  case TOF:
+    mergeAppendedByTof(events, start);
+    break;
+  case WEIGHTED:
+    mergeAppendedByTof(weightedEvents, start);
+    break;
+  case WEIGHTED_NOTIME:
+    mergeAppendedByTof(weightedEventsNoTime, start);
+    break;
+  }
+  this->order = TOF_SORT;
+  return *this;
+}
+
 // --------------------------------------------------------------------------
 /** SUBTRACT another EventList from this event list.
  * The event lists are concatenated, but the weights of the incoming
@@ -2755,6 +2799,42 @@ std::vector<double> EventList::getTofs() const {
   return tofs;
 }
 
+/** Get a pointer to the m_tof member of the first event in a list
+ *
+ * @param events :: source vector of events
+ * @param stride :: set to the size of an event
+ * @return a pointer to the first TOF, or NULL if there are no events
+ */
+template <class T>
+const double *EventList::tofColumnHelper(const std::vector<T> &events,
+                                         std::size_t &stride) {
+  stride = sizeof(T);
+  if (events.empty())
+    return NULL;
+  return &(events.front().m_tof);
+}
+
+/** Get the times-of-flight of the events in place, without copying. The
+ * values are not contiguous: each is stride bytes after the previous one.
+ * The pointer is invalidated by anything that changes the number or type of
+ * the events.
+ *
+ * @param stride :: set to the distance in bytes between consecutive TOFs
+ * @return a pointer to the first TOF, or NULL if the list is empty
+ */
+const double *EventList::readTofs(std::size_t &stride) const {
+  switch (eventType) {
+  case TOF:
+    return this->tofColumnHelper(this->events, stride);
+  case WEIGHTED:
+    return this->tofColumnHelper(this->weightedEvents, stride);
+  case WEIGHTED_NOTIME:
+    return this->tofColumnHelper(this->weightedEventsNoTime, stride);
+  }
+  throw std::runtime_error("EventList::readTofs() called on an EventList "
+                           "that has an invalid eventType.");
+}
+
 // --------------------------------------------------------------------------
 /** Get the weight member of all events in a list
  *
@@ -4499,16 +4579,28 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
  *  @param events :: templated class for the list of events
  *  @param factor :: the conversion factor a to apply
  *  @param power :: the Power b to apply to the conversion
+ *  @param avoidZero :: replace an input of zero by DBL_MIN if the power is
+ *                      negative
  */
 template <class T>
 void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
                                           const double &factor,
-                                          const double &power) {
+                                          const double &power,
+                                          const bool avoidZero) {
   typename std::vector<T>::iterator itev = events.begin();
   typename std::vector<T>::iterator itev_end = events.end();
+  if (power == 1.0) {
+    // e.g. TOF to dSpacing; no need to go through pow()
+    for (; itev != itev_end; itev++)
+      itev->m_tof *= factor;
+    return;
+  }
+  const bool replaceZero = avoidZero && power < 0.0;
   for (; itev != itev_end; itev++) {
     // Output unit = factor * (input) ^ power
-    itev->m_tof = factor * std::pow(itev->m_tof, power);
+    const double input =
+        (replaceZero && itev->m_tof == 0.0) ? DBL_MIN : itev->m_tof;
+    itev->m_tof = factor * std::pow(input, power);
   }
 }
 
@@ -4517,17 +4609,21 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  * (input^b) relationship
  *  @param factor :: the conversion factor a to apply
  *  @param power :: the Power b to apply to the conversion
+ *  @param avoidZero :: replace an input of zero by DBL_MIN if the power is
+ *                      negative, as the units do when converting via TOF
  */
-void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+void EventList::convertUnitsQuickly(const double &factor, const double &power,
+                                    const bool avoidZero) {
   switch (eventType) {
   case TOF:
-    convertUnitsQuicklyHelper(this->events, factor, power);
+    convertUnitsQuicklyHelper(this->events, factor, power, avoidZero);
     break;
   case WEIGHTED:
-    convertUnitsQuicklyHelper(this->weightedEvents, factor, power);
+    convertUnitsQuicklyHelper(this->weightedEvents, factor, power, avoidZero);
     break;
   case WEIGHTED_NOTIME:
-    convertUnitsQuicklyHelper(this->weightedEventsNoTime, factor, power);
+    convertUnitsQuicklyHelper(this->weightedEventsNoTime, factor, power,
+                              avoidZero);
     break;
   }
 }
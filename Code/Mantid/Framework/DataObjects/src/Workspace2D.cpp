@@ -33,13 +33,19 @@ Workspace2D::~Workspace2D() {
 // memory.
 // See
 // http://social.msdn.microsoft.com/Forums/en-US/2fe4cfc7-ca5c-4665-8026-42e0ba634214/visual-studio-2012-slow-deallocation-when-new-called-within-openmp-loop?forum=vcgeneral
+// The histograms live in one block so drop their arrays here rather than
+// leaving them all to the serial destruction of the block.
 
 #ifdef _MSC_VER
+  const MantidVecPtr empty;
   PARALLEL_FOR1(this)
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(data.size()); i++) {
-    delete data[i];
+  for (int64_t i = 0; i < static_cast<int64_t>(m_histograms.size()); i++) {
+    Histogram1D &spec = m_histograms[i];
+    spec.setX(empty);
+    spec.setDx(empty);
+    spec.setData(empty, empty);
   }
+#endif
 }
 
 /** Sets the size of the workspace and initializes arrays to zero
@@ -53,20 +59,21 @@ Workspace2D::~Workspace2D() {
 void Workspace2D::init(const std::size_t &NVectors, const std::size_t &XLength,
                        const std::size_t &YLength) {
   m_noVectors = NVectors;
-  data.resize(m_noVectors);
 
   MantidVecPtr t1, t2;
   t1.access().resize(XLength); // this call initializes array to zero
   t2.access().resize(YLength);
+  // Every spectrum starts as a copy of this one and so shares its arrays
+  Histogram1D prototype;
+  prototype.setX(t1);
+  prototype.setDx(t1);
+  prototype.setData(t2, t2);
+  m_histograms.assign(m_noVectors, prototype);
+
+  data.resize(m_noVectors);
   for (size_t i = 0; i < m_noVectors; i++) {
-    // Create the spectrum upon init
-    Histogram1D *spec = new Histogram1D();
+    Histogram1D *spec = &m_histograms[i];
     data[i] = spec;
-    // Set the data and X
-    spec->setX(t1);
-    spec->setDx(t1);
-    // Y,E arrays populated
-    spec->setData(t2, t2);
     // Default spectrum number = starts at 1, for workspace index 0.
     spec->setSpectrumNo(specid_t(i + 1));
     spec->setDetectorID(detid_t(i + 1));
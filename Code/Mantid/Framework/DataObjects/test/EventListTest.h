@@ -178,6 +178,29 @@ public:
     TS_ASSERT_EQUALS(rel[5].tof(), 50);
   }
 
+  void test_mergeByTof_keeps_the_list_sorted()
+  {
+    EventList accum;
+    accum += TofEvent(30, 0);
+    accum += TofEvent(10, 0);
+    accum.addDetectorID(1);
+    EventList chunk;
+    chunk += TofEvent(40, 0);
+    chunk += TofEvent(5, 0);
+    chunk += TofEvent(20, 0);
+    chunk.addDetectorID(2);
+    chunk.switchTo(WEIGHTED);
+
+    accum.mergeByTof(chunk);
+    TS_ASSERT( accum.isSortedByTof() );
+    TS_ASSERT_EQUALS( accum.getEventType(), WEIGHTED );
+    TS_ASSERT_EQUALS( accum.getNumberEvents(), 5 );
+    const double expected[5] = {5, 10, 20, 30, 40};
+    for (size_t i = 0; i < 5; ++i)
+      TS_ASSERT_EQUALS( accum.getEvent(i).tof(), expected[i] );
+    TS_ASSERT( accum.hasDetectorID(2) );
+  }
+
   void test_DetectorIDs()
   {
     EventList el1;
@@ -1309,6 +1332,33 @@ public:
     }
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_readTofs_reads_the_events_in_place()
+  {
+    // Go through each possible EventType as the input
+    for (int this_type = 0; this_type < 3; this_type++)
+    {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      el.sortTof();
+
+      size_t stride(0);
+      const double *tofs = el.readTofs(stride);
+      TSM_ASSERT(this_type, tofs);
+      const char *first = reinterpret_cast<const char *>(tofs);
+      for (size_t i = 0; i < el.getNumberEvents(); i += 100)
+      {
+        const double *tof = reinterpret_cast<const double *>(first + i * stride);
+        TSM_ASSERT_EQUALS(this_type, *tof, el.getEvent(i).tof());
+      }
+
+    }
+
+    EventList empty;
+    size_t stride(0);
+    TS_ASSERT(!empty.readTofs(stride));
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_getPulseTimes()
   {
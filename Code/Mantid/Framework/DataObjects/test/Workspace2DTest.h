@@ -72,6 +72,22 @@ public:
     }
   }
 
+  void test_initialized_spectra_share_arrays_until_written()
+  {
+    Workspace2D ws2D;
+    ws2D.initialize(3, 4, 3);
+    TS_ASSERT_EQUALS( &ws2D.readY(0), &ws2D.readY(2) );
+    TS_ASSERT_EQUALS( &ws2D.readX(0), &ws2D.readX(1) );
+    TS_ASSERT_EQUALS( ws2D.getSpectrum(2)->getSpectrumNo(), 3 );
+    TS_ASSERT( ws2D.getSpectrum(2)->hasDetectorID(3) );
+
+    ws2D.dataY(1)[0] = 1.5;
+    TS_ASSERT_DIFFERS( &ws2D.readY(0), &ws2D.readY(1) );
+    TS_ASSERT_EQUALS( ws2D.readY(0)[0], 0.0 );
+    TS_ASSERT_EQUALS( ws2D.readY(1)[0], 1.5 );
+    TS_ASSERT_EQUALS( ws2D.readY(2)[0], 0.0 );
+  }
+
   void testId()
   {
     TS_ASSERT_EQUALS( ws->id(), "Workspace2D" );
@@ -253,6 +253,9 @@ public:
   ContainsState containsRectDetectors() const;
 
 private:
+  /// Reads the caches directly to store and restore them
+  friend class InstrumentBinaryCache;
+
   /// Save information about a set of detectors to Nexus
   void saveDetectorSetInfoToNexus(::NeXus::File *file,
                                   std::vector<detid_t> detIDs) const;
@@ -0,0 +1,97 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_
+#define MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Instrument.h"
+
+#include <map>
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+class Object;
+
+/**
+Stores a fully built base Instrument in a binary file so that later processes
+can rebuild it without parsing the instrument definition XML.
+
+The file holds the component tree in depth-first order (names, relative
+positions and rotations, detector IDs and monitor flags), the shapes as their
+XML with the IDF type they belong to, the source, sample and chopper points,
+the reference frame, default view and validity dates and the parameters of
+the logfile cache. The pixels of a RectangularDetector are regenerated from
+its parameters and only their positions and rotations are stored.
+
+Each file is tagged with a key, normally made by key(), so that a file
+written for a different definition or Mantid version is ignored. The file is
+memory mapped for reading. As its contents are trusted, a file that is not
+owned by the current user, or that others could have changed, is ignored.
+The default directory is in the user properties directory and trim() keeps
+it to a configured size and age.
+
+Instruments with a neutronic (indirect) geometry, or containing component
+types other than CompAssembly, ObjComponent, Detector and
+RectangularDetector, cannot be stored and write() throws for them.
+
+Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>.
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL InstrumentBinaryCache {
+public:
+  /// The shapes of an instrument keyed by the name of their IDF type
+  typedef std::map<std::string, boost::shared_ptr<Object>> ShapeMap;
+
+  /// Constructor taking the path of the cache file
+  explicit InstrumentBinaryCache(const std::string &filename);
+
+  /// The key for an instrument definition
+  static std::string key(const std::string &instName,
+                         const std::string &xmlText);
+  /// The cache file for a key in the configured cache directory
+  static std::string defaultFilename(const std::string &instName,
+                                     const std::string &key);
+  /// The configured cache directory
+  static std::string defaultDirectory();
+  /// Remove old cache files from a directory
+  static void trim(const std::string &directory, const uint64_t maxBytes,
+                   const double maxAgeDays);
+  /// Trim the configured cache directory to the configured limits
+  static void trimDefaultDirectory();
+  /// True if the binary cache is switched on in the ConfigService
+  static bool isEnabled();
+
+  /// The path of the cache file
+  const std::string &filename() const { return m_filename; }
+  /// Write an instrument to the file
+  void write(const Instrument &instrument, const ShapeMap &shapes,
+             const std::string &key) const;
+  /// Rebuild the instrument stored in the file
+  Instrument_sptr read(const std::string &key, ShapeMap &shapes) const;
+
+private:
+  /// The path of the cache file
+  const std::string m_filename;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_ */
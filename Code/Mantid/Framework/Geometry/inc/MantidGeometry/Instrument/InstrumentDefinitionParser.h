@@ -196,6 +196,11 @@ private:
   /// positions
   void createNeutronicInstrument();
 
+  /// Replaces the instrument with one from the binary instrument cache
+  bool readBinaryCache(const std::string &key);
+  /// Stores the instrument in the binary instrument cache
+  void writeBinaryCache(const std::string &key) const;
+
   /// Takes as input a \<type\> element containing a
   /// <combine-components-into-one-shape>, and
   /// adjust the \<type\> element by replacing its containing \<component\>
@@ -0,0 +1,62 @@
+#ifndef MANTID_GEOMETRY_RECTANGLEINTERSECTION_H_
+#define MANTID_GEOMETRY_RECTANGLEINTERSECTION_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Math/Quadrilateral.h"
+
+namespace Mantid {
+namespace Geometry {
+/**
+This header defines the intersection of a quadrilateral with an axis-aligned
+rectangle, such as a bin of a 2D workspace. The quadrilateral is clipped
+against each side of the rectangle in turn (Sutherland-Hodgman). The clipped
+polygon has at most eight vertices so it is held on the stack: unlike
+intersectionByLaszlo nothing is allocated and no exception is thrown when the
+shapes do not overlap.
+
+Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+
+/// The size of the region where two polygons overlap
+struct MANTID_GEOMETRY_DLL OverlapRegion {
+  /// The area of the overlap, with the same sign convention as
+  /// ConvexPolygon::area
+  double area;
+  /// The smallest X value in the overlap
+  double smallestX;
+  /// The largest X value in the overlap
+  double largestX;
+};
+
+/// Compute the overlap of a quadrilateral with an axis-aligned rectangle
+MANTID_GEOMETRY_DLL
+bool intersectionWithRectangle(const Quadrilateral &poly, const double xmin,
+                               const double xmax, const double ymin,
+                               const double ymax, OverlapRegion &overlap);
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_RECTANGLEINTERSECTION_H_ */
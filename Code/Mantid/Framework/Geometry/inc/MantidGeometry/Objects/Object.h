@@ -172,7 +172,14 @@ private:
                int &compUnit) const;
   CompGrp *procComp(Rule *) const;
   int checkSurfaceValid(const Kernel::V3D &, const Kernel::V3D &) const;
+  /// Calculate the bounding box from the rule tree
+  void calcBoundingBox();
   BoundingBox m_boundingBox; ///< Object's bounding box
+  /// True once m_boundingBox has been calculated or defined
+  bool m_boundingBoxValid;
+  /// True if m_boundingBox was calculated from the surfaces, so is known to
+  /// enclose the object and can be used to reject tracks
+  bool m_boundingBoxComputed;
 
   // -- DEPRECATED --
   mutable double AABBxMax,  ///< xmax of Axis aligned bounding box cache
@@ -0,0 +1,880 @@
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument/CompAssembly.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ObjComponent.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/Object.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/ChecksumHelper.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MantidVersion.h"
+
+#include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+#include <Poco/SharedMemory.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::DateAndTime;
+using Kernel::Quat;
+using Kernel::V3D;
+
+namespace {
+/// static logger
+Kernel::Logger g_log("InstrumentBinaryCache");
+
+/// Identifies a cache file
+const char MAGIC[8] = {'M', 'T', 'D', 'I', 'N', 'S', 'T', 'C'};
+/// The extension of the cache files
+const char EXTENSION[] = ".instcache";
+/// The size of the default cache directory in MB if it is not configured
+const int DEFAULT_MAX_SIZE = 256;
+/// The age in days after which files are removed if it is not configured
+const int DEFAULT_MAX_AGE = 30;
+
+/**
+ * A cache file is only read if no other user could have written or changed
+ * it, as its contents are trusted to be a valid instrument. The file must be
+ * a regular file owned by the current user that only they can write to, in a
+ * directory owned by them or root that others cannot write to, unless it has
+ * the sticky bit set as /tmp does.
+ * @param filename :: The path of the cache file
+ * @return True if the file can be trusted
+ */
+bool isTrusted(const std::string &filename) {
+#ifdef _WIN32
+  // User profile directories are private on Windows
+  UNUSED_ARG(filename);
+  return true;
+#else
+  struct stat info;
+  if (::lstat(filename.c_str(), &info) != 0 || !S_ISREG(info.st_mode) ||
+      info.st_uid != ::geteuid() || (info.st_mode & (S_IWGRP | S_IWOTH)))
+    return false;
+  const std::string directory = Poco::Path(filename).parent().toString();
+  if (::stat(directory.c_str(), &info) != 0 ||
+      (info.st_uid != ::geteuid() && info.st_uid != 0))
+    return false;
+  return !(info.st_mode & (S_IWGRP | S_IWOTH)) || (info.st_mode & S_ISVTX);
+#endif
+}
+
+/// A cache file found when trimming the cache directory
+struct CacheFile {
+  Poco::Timestamp modified;
+  Poco::File::FileSize size;
+  std::string path;
+  bool operator<(const CacheFile &other) const {
+    return modified < other.modified;
+  }
+};
+
+/// Remove a file, ignoring failures as another process may have removed it
+bool removeCacheFile(const std::string &path) {
+  try {
+    Poco::File(path).remove();
+    return true;
+  } catch (std::exception &e) {
+    g_log.debug() << "Unable to remove " << path << ": " << e.what() << "\n";
+    return false;
+  }
+}
+/// Bumped whenever the layout of the file changes
+const uint32_t FORMAT_VERSION = 1;
+/// Written in native byte order to reject files from other architectures
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// The component types that can be stored
+enum RecordType {
+  CompAssemblyRecord = 0,
+  ObjComponentRecord = 1,
+  DetectorRecord = 2,
+  RectangularDetectorRecord = 3
+};
+
+/// How a detector is registered with the instrument
+enum DetectorMark { NotMarked = 0, MarkedAsDetector = 1, MarkedAsMonitor = 2 };
+
+/// Writes plain values to a binary stream
+class Writer {
+public:
+  explicit Writer(std::ostream &os) : m_os(os) {}
+
+  template <typename T> void write(const T value) {
+    m_os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void writeString(const std::string &value) {
+    write<uint32_t>(static_cast<uint32_t>(value.size()));
+    m_os.write(value.data(), value.size());
+  }
+  void writeV3D(const V3D &value) {
+    write<double>(value.X());
+    write<double>(value.Y());
+    write<double>(value.Z());
+  }
+  void writeQuat(const Quat &value) {
+    write<double>(value.real());
+    write<double>(value.imagI());
+    write<double>(value.imagJ());
+    write<double>(value.imagK());
+  }
+
+private:
+  std::ostream &m_os;
+};
+
+/// Reads plain values from a block of memory, throwing if it runs out
+class Reader {
+public:
+  Reader(const char *begin, const char *end) : m_pos(begin), m_end(end) {}
+
+  template <typename T> T read() {
+    require(sizeof(T));
+    T value;
+    std::memcpy(&value, m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+  std::string readString() {
+    const uint32_t size = read<uint32_t>();
+    require(size);
+    std::string value(m_pos, size);
+    m_pos += size;
+    return value;
+  }
+  V3D readV3D() {
+    const double x = read<double>();
+    const double y = read<double>();
+    const double z = read<double>();
+    return V3D(x, y, z);
+  }
+  Quat readQuat() {
+    const double w = read<double>();
+    const double a = read<double>();
+    const double b = read<double>();
+    const double c = read<double>();
+    return Quat(w, a, b, c);
+  }
+  /// Compare the next size bytes with data, moving past them if they match
+  bool match(const char *data, const size_t size) {
+    if (!has(size) || std::memcmp(m_pos, data, size) != 0)
+      return false;
+    m_pos += size;
+    return true;
+  }
+
+private:
+  bool has(const size_t size) const {
+    return static_cast<size_t>(m_end - m_pos) >= size;
+  }
+  void require(const size_t size) const {
+    if (!has(size))
+      throw std::runtime_error("Instrument cache file is truncated");
+  }
+
+  const char *m_pos;
+  const char *const m_end;
+};
+
+/// Appends the descendants of an assembly in depth-first order
+void appendDescendants(const ICompAssembly &assembly,
+                       std::vector<const IComponent *> &out) {
+  for (int i = 0; i < assembly.nelements(); ++i) {
+    const IComponent *child = assembly.getChild(i).get();
+    out.push_back(child);
+    const ICompAssembly *childAssembly =
+        dynamic_cast<const ICompAssembly *>(child);
+    if (childAssembly)
+      appendDescendants(*childAssembly, out);
+  }
+}
+
+/// The components of an instrument in the order they are stored
+struct ComponentTable {
+  /// All components, including those RectangularDetector::initialize creates
+  std::vector<const IComponent *> components;
+  /// Index of the parent of each component, -1 for the instrument
+  std::vector<int32_t> parents;
+  /// True for the components created by a RectangularDetector
+  std::vector<bool> generated;
+  /// Index of each component
+  std::map<const IComponent *, int32_t> index;
+
+  void add(const IComponent *comp, const int32_t parent, const bool gen) {
+    index[comp] = static_cast<int32_t>(components.size());
+    components.push_back(comp);
+    parents.push_back(parent);
+    generated.push_back(gen);
+  }
+
+  void collect(const ICompAssembly &assembly, const int32_t parent) {
+    for (int i = 0; i < assembly.nelements(); ++i) {
+      const IComponent *child = assembly.getChild(i).get();
+      const int32_t childIndex = static_cast<int32_t>(components.size());
+      add(child, parent, false);
+      if (const RectangularDetector *bank =
+              dynamic_cast<const RectangularDetector *>(child)) {
+        std::vector<const IComponent *> pixels;
+        appendDescendants(*bank, pixels);
+        for (size_t j = 0; j < pixels.size(); ++j)
+          add(pixels[j], -2, true);
+      } else if (typeid(*child) == typeid(CompAssembly)) {
+        collect(*dynamic_cast<const CompAssembly *>(child), childIndex);
+      }
+    }
+  }
+
+  int32_t indexOf(const IComponent *comp, const Instrument &instrument) const {
+    if (comp == &instrument)
+      return -1;
+    std::map<const IComponent *, int32_t>::const_iterator it =
+        index.find(comp);
+    if (it == index.end())
+      throw std::runtime_error("Component " + comp->getName() +
+                               " is not part of the instrument");
+    return it->second;
+  }
+};
+}
+
+/**
+ * Constructor
+ * @param filename :: The path of the cache file
+ */
+InstrumentBinaryCache::InstrumentBinaryCache(const std::string &filename)
+    : m_filename(filename) {}
+
+/**
+ * The key identifying an instrument definition. It changes whenever the
+ * definition or the version of Mantid changes.
+ * @param instName :: The name of the instrument
+ * @param xmlText :: The contents of the instrument definition file
+ * @return The SHA-1 of the name, Mantid version and definition
+ */
+std::string InstrumentBinaryCache::key(const std::string &instName,
+                                       const std::string &xmlText) {
+  std::string text = instName;
+  text += '\n';
+  text += Kernel::MantidVersion::version();
+  text += '\n';
+  text += xmlText;
+  return Kernel::ChecksumHelper::sha1FromString(text);
+}
+
+/**
+ * The file for a key in defaultDirectory()
+ * @param instName :: The name of the instrument
+ * @param key :: The key of the definition
+ * @return The full path of the cache file
+ */
+std::string InstrumentBinaryCache::defaultFilename(const std::string &instName,
+                                                   const std::string &key) {
+  Poco::Path path(defaultDirectory());
+  path.setFileName(instName + "_" + key + EXTENSION);
+  return path.toString();
+}
+
+/**
+ * The directory given by the instrumentDefinition.binaryCache.directory
+ * property, or instrument-cache in the user properties directory if it is
+ * empty. The default is private to the user as the files are trusted when
+ * they are read.
+ * @return The full path of the directory
+ */
+std::string InstrumentBinaryCache::defaultDirectory() {
+  Kernel::ConfigServiceImpl &config = Kernel::ConfigService::Instance();
+  const std::string directory =
+      config.getString("instrumentDefinition.binaryCache.directory");
+  Poco::Path path;
+  if (directory.empty()) {
+    path = Poco::Path(config.getUserPropertiesDir());
+    path.makeDirectory();
+    path.pushDirectory("instrument-cache");
+  } else {
+    path = Poco::Path(directory);
+    path.makeDirectory();
+  }
+  return path.toString();
+}
+
+/**
+ * Remove the cache files in a directory that are older than maxAgeDays, then
+ * the oldest of the rest until they take up no more than maxBytes. Only
+ * files with the cache extension are touched.
+ * @param directory :: The directory to trim
+ * @param maxBytes :: The most space the files may take up
+ * @param maxAgeDays :: Files last written longer ago than this are removed
+ */
+void InstrumentBinaryCache::trim(const std::string &directory,
+                                 const uint64_t maxBytes,
+                                 const double maxAgeDays) {
+  std::vector<CacheFile> files;
+  try {
+    if (!Poco::File(directory).exists())
+      return;
+    Poco::DirectoryIterator end;
+    for (Poco::DirectoryIterator it(directory); it != end; ++it) {
+      if (Poco::Path(it->path()).getExtension() != EXTENSION + 1 ||
+          !it->isFile())
+        continue;
+      CacheFile file;
+      file.modified = it->getLastModified();
+      file.size = it->getSize();
+      file.path = it->path();
+      files.push_back(file);
+    }
+  } catch (std::exception &e) {
+    g_log.debug() << "Unable to list " << directory << ": " << e.what()
+                  << "\n";
+    return;
+  }
+  std::sort(files.begin(), files.end());
+
+  const Poco::Timestamp::TimeDiff maxAge =
+      static_cast<Poco::Timestamp::TimeDiff>(maxAgeDays * 86400.) *
+      Poco::Timestamp::resolution();
+  uint64_t total(0);
+  for (size_t i = 0; i < files.size(); ++i)
+    total += files[i].size;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (total <= maxBytes && !files[i].modified.isElapsed(maxAge))
+      break;
+    if (removeCacheFile(files[i].path)) {
+      g_log.debug() << "Removed old instrument cache " << files[i].path
+                    << "\n";
+      total -= files[i].size;
+    }
+  }
+}
+
+/**
+ * Trim defaultDirectory() to the limits given by the
+ * instrumentDefinition.binaryCache.maxSize (MB) and
+ * instrumentDefinition.binaryCache.maxAge (days) properties
+ */
+void InstrumentBinaryCache::trimDefaultDirectory() {
+  Kernel::ConfigServiceImpl &config = Kernel::ConfigService::Instance();
+  int maxSize(DEFAULT_MAX_SIZE), maxAge(DEFAULT_MAX_AGE);
+  if (config.getValue("instrumentDefinition.binaryCache.maxSize", maxSize) ==
+          0 ||
+      maxSize < 0)
+    maxSize = DEFAULT_MAX_SIZE;
+  if (config.getValue("instrumentDefinition.binaryCache.maxAge", maxAge) == 0 ||
+      maxAge < 0)
+    maxAge = DEFAULT_MAX_AGE;
+  trim(defaultDirectory(), static_cast<uint64_t>(maxSize) * 1024 * 1024,
+       static_cast<double>(maxAge));
+}
+
+/**
+ * @return True if instrumentDefinition.binaryCache.enabled is set to a non-zero
+ * value
+ */
+bool InstrumentBinaryCache::isEnabled() {
+  int enabled(0);
+  if (Kernel::ConfigService::Instance().getValue(
+          "instrumentDefinition.binaryCache.enabled", enabled) == 0)
+    return false;
+  return enabled != 0;
+}
+
+/**
+ * Write a base instrument to the file. The file is written under a temporary
+ * name and then moved into place so that readers never see a partial file.
+ * @param instrument :: The instrument to store
+ * @param shapes :: The shapes of the instrument keyed by their IDF type
+ * @param key :: The key to tag the file with
+ * @throw std::invalid_argument if the instrument is parametrized
+ * @throw std::runtime_error if the instrument cannot be stored or the file
+ * cannot be written
+ */
+void InstrumentBinaryCache::write(const Instrument &instrument,
+                                  const ShapeMap &shapes,
+                                  const std::string &key) const {
+  if (instrument.isParametrized())
+    throw std::invalid_argument(
+        "Only a base instrument can be written to the instrument cache");
+  if (instrument.getPhysicalInstrument())
+    throw std::runtime_error(
+        "Instruments with neutronic positions cannot be cached");
+
+  ComponentTable table;
+  table.collect(instrument, -1);
+
+  // The shapes of the IDF types come first so that read() can hand them back
+  std::vector<const Object *> shapeTable;
+  std::vector<std::string> shapeTypes;
+  std::map<const Object *, int32_t> shapeIndex;
+  for (ShapeMap::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
+    if (!it->second || shapeIndex.count(it->second.get()))
+      continue;
+    shapeIndex[it->second.get()] = static_cast<int32_t>(shapeTable.size());
+    shapeTable.push_back(it->second.get());
+    shapeTypes.push_back(it->first);
+  }
+
+  // Check every component can be stored and pick up any other shapes
+  for (size_t i = 0; i < table.components.size(); ++i) {
+    if (table.generated[i])
+      continue;
+    const IComponent *comp = table.components[i];
+    const std::type_info &type = typeid(*comp);
+    const Object *shape(NULL);
+    if (type == typeid(ObjComponent) || type == typeid(Detector))
+      shape = dynamic_cast<const ObjComponent *>(comp)->shape().get();
+    else if (type == typeid(RectangularDetector))
+      shape = dynamic_cast<const RectangularDetector *>(comp)->shape().get();
+    else if (type != typeid(CompAssembly))
+      throw std::runtime_error("Component " + comp->getName() + " of type " +
+                               type.name() + " cannot be cached");
+    if (shape && !shapeIndex.count(shape)) {
+      shapeIndex[shape] = static_cast<int32_t>(shapeTable.size());
+      shapeTable.push_back(shape);
+      shapeTypes.push_back("");
+    }
+  }
+  for (size_t i = 0; i < shapeTable.size(); ++i) {
+    if (shapeTable[i]->getShapeXML().empty())
+      throw std::runtime_error("A shape of the instrument has no XML "
+                               "definition and cannot be cached");
+  }
+
+  Poco::File(Poco::Path(m_filename).parent()).createDirectories();
+  const std::string tempFilename =
+      m_filename + "." +
+      boost::lexical_cast<std::string>(Poco::Process::id()) + ".tmp";
+  std::ofstream file(tempFilename.c_str(),
+                     std::ios_base::out | std::ios_base::binary);
+  if (!file)
+    throw std::runtime_error("Unable to open " + tempFilename);
+  Writer out(file);
+
+  // Header
+  file.write(MAGIC, sizeof(MAGIC));
+  out.write<uint32_t>(FORMAT_VERSION);
+  out.write<uint32_t>(BYTE_ORDER_MARK);
+  out.writeString(key);
+
+  // Instrument level information
+  out.writeString(instrument.getName());
+  boost::shared_ptr<const ReferenceFrame> frame =
+      instrument.getReferenceFrame();
+  out.write<int32_t>(frame->pointingUp());
+  out.write<int32_t>(frame->pointingAlongBeam());
+  out.write<int32_t>(frame->getHandedness());
+  out.writeString(frame->origin());
+  out.writeString(instrument.getDefaultView());
+  out.writeString(instrument.getDefaultAxis());
+  out.write<int64_t>(instrument.getValidFromDate().totalNanoseconds());
+  out.write<int64_t>(instrument.getValidToDate().totalNanoseconds());
+  const std::map<std::string, std::string> &units = instrument.m_logfileUnit;
+  out.write<uint32_t>(static_cast<uint32_t>(units.size()));
+  for (std::map<std::string, std::string>::const_iterator it = units.begin();
+       it != units.end(); ++it) {
+    out.writeString(it->first);
+    out.writeString(it->second);
+  }
+
+  // Shapes
+  out.write<uint32_t>(static_cast<uint32_t>(shapeTable.size()));
+  for (size_t i = 0; i < shapeTable.size(); ++i) {
+    out.writeString(shapeTypes[i]);
+    out.write<int32_t>(shapeTable[i]->getName());
+    out.writeString(shapeTable[i]->getShapeXML());
+  }
+
+  // Components, with the pixels of a RectangularDetector inside its record
+  size_t numRecords(0);
+  for (size_t i = 0; i < table.components.size(); ++i) {
+    if (!table.generated[i])
+      ++numRecords;
+  }
+  out.write<uint32_t>(static_cast<uint32_t>(numRecords));
+  for (size_t i = 0; i < table.components.size(); ++i) {
+    if (table.generated[i])
+      continue;
+    const IComponent *comp = table.components[i];
+    const std::type_info &type = typeid(*comp);
+    if (type == typeid(CompAssembly))
+      out.write<uint8_t>(CompAssemblyRecord);
+    else if (type == typeid(ObjComponent))
+      out.write<uint8_t>(ObjComponentRecord);
+    else if (type == typeid(Detector))
+      out.write<uint8_t>(DetectorRecord);
+    else
+      out.write<uint8_t>(RectangularDetectorRecord);
+    out.write<int32_t>(table.parents[i]);
+    out.writeString(comp->getName());
+    out.writeV3D(comp->getRelativePos());
+    out.writeQuat(comp->getRelativeRot());
+
+    if (type == typeid(ObjComponent) || type == typeid(Detector)) {
+      const Object *shape =
+          dynamic_cast<const ObjComponent *>(comp)->shape().get();
+      out.write<int32_t>(shape ? shapeIndex[shape] : -1);
+    }
+    if (type == typeid(Detector)) {
+      const Detector *det = dynamic_cast<const Detector *>(comp);
+      out.write<int32_t>(det->getID());
+      std::map<detid_t, IDetector_const_sptr>::const_iterator cached =
+          instrument.m_detectorCache.find(det->getID());
+      if (cached == instrument.m_detectorCache.end() ||
+          cached->second.get() != det)
+        out.write<uint8_t>(NotMarked);
+      else
+        out.write<uint8_t>(det->isMonitor() ? MarkedAsMonitor
+                                            : MarkedAsDetector);
+    } else if (type == typeid(RectangularDetector)) {
+      const RectangularDetector *bank =
+          dynamic_cast<const RectangularDetector *>(comp);
+      const Object *shape = bank->shape().get();
+      out.write<int32_t>(shape ? shapeIndex[shape] : -1);
+      out.write<int32_t>(bank->xpixels());
+      out.write<double>(bank->xstart());
+      out.write<double>(bank->xstep());
+      out.write<int32_t>(bank->ypixels());
+      out.write<double>(bank->ystart());
+      out.write<double>(bank->ystep());
+      out.write<int32_t>(bank->idstart());
+      out.write<uint8_t>(bank->idfillbyfirst_y());
+      out.write<int32_t>(bank->idstepbyrow());
+      out.write<int32_t>(bank->idstep());
+      // initialize() recreates the pixels, but the parser may have turned
+      // them afterwards so their final placement is kept
+      size_t numPixels(0);
+      while (i + 1 + numPixels < table.components.size() &&
+             table.generated[i + 1 + numPixels])
+        ++numPixels;
+      out.write<uint32_t>(static_cast<uint32_t>(numPixels));
+      for (size_t j = i + 1; j <= i + numPixels; ++j) {
+        const IComponent *pixel = table.components[j];
+        out.writeV3D(pixel->getRelativePos());
+        out.writeQuat(pixel->getRelativeRot());
+        const IDetector *det = dynamic_cast<const IDetector *>(pixel);
+        uint8_t mark(NotMarked);
+        if (det) {
+          std::map<detid_t, IDetector_const_sptr>::const_iterator cached =
+              instrument.m_detectorCache.find(det->getID());
+          if (cached != instrument.m_detectorCache.end() &&
+              cached->second.get() == det)
+            mark = det->isMonitor() ? MarkedAsMonitor : MarkedAsDetector;
+        }
+        out.write<uint8_t>(mark);
+      }
+    }
+  }
+
+  // Special components
+  out.write<int32_t>(instrument.m_sourceCache
+                         ? table.indexOf(instrument.m_sourceCache, instrument)
+                         : -1);
+  out.write<int32_t>(instrument.m_sampleCache
+                         ? table.indexOf(instrument.m_sampleCache, instrument)
+                         : -1);
+  const std::vector<const ObjComponent *> &choppers =
+      *instrument.m_chopperPoints;
+  out.write<uint32_t>(static_cast<uint32_t>(choppers.size()));
+  for (size_t i = 0; i < choppers.size(); ++i)
+    out.write<int32_t>(table.indexOf(choppers[i], instrument));
+
+  // Parameters that are resolved against the sample logs
+  const InstrumentParameterCache &params = instrument.getLogfileCache();
+  out.write<uint32_t>(static_cast<uint32_t>(params.size()));
+  for (InstrumentParameterCache::const_iterator it = params.begin();
+       it != params.end(); ++it) {
+    const XMLInstrumentParameter &param = *it->second;
+    out.writeString(it->first.first);
+    out.write<int32_t>(table.indexOf(it->first.second, instrument));
+    out.write<int32_t>(table.indexOf(param.m_component, instrument));
+    out.writeString(param.m_logfileID);
+    out.writeString(param.m_value);
+    if (param.m_interpolation) {
+      std::ostringstream interpolation;
+      interpolation.precision(17);
+      interpolation << *param.m_interpolation;
+      out.write<uint8_t>(1);
+      out.writeString(interpolation.str());
+    } else {
+      out.write<uint8_t>(0);
+    }
+    out.writeString(param.m_formula);
+    out.writeString(param.m_formulaUnit);
+    out.writeString(param.m_resultUnit);
+    out.writeString(param.m_paramName);
+    out.writeString(param.m_type);
+    out.writeString(param.m_tie);
+    out.write<uint32_t>(static_cast<uint32_t>(param.m_constraint.size()));
+    for (size_t i = 0; i < param.m_constraint.size(); ++i)
+      out.writeString(param.m_constraint[i]);
+    out.writeString(param.m_penaltyFactor);
+    out.writeString(param.m_fittingFunction);
+    out.writeString(param.m_extractSingleValueAs);
+    out.writeString(param.m_eq);
+    out.write<double>(param.m_angleConvertConst);
+  }
+
+  file.close();
+  if (!file) {
+    Poco::File(tempFilename).remove();
+    throw std::runtime_error("Error writing " + tempFilename);
+  }
+#ifndef _WIN32
+  // Only the owner may change it, whatever the umask, or read() will refuse it
+  ::chmod(tempFilename.c_str(), S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+#endif
+  Poco::File(tempFilename).renameTo(m_filename);
+  g_log.debug() << "Wrote instrument cache " << m_filename << "\n";
+}
+
+/**
+ * Rebuild the instrument stored in the file.
+ * @param key :: The key the file must have been written with
+ * @param shapes :: Filled with the shapes of the IDF types
+ * @return The instrument, or an empty pointer if there is no file or it was
+ * written for a different key or format
+ * @throw std::runtime_error if the file is corrupt
+ */
+Instrument_sptr InstrumentBinaryCache::read(const std::string &key,
+                                            ShapeMap &shapes) const {
+  Poco::File file(m_filename);
+  if (!file.exists() || file.getSize() == 0)
+    return Instrument_sptr();
+  if (!isTrusted(m_filename)) {
+    g_log.warning() << "Ignoring instrument cache " << m_filename
+                    << " as it is not owned by the current user or others "
+                       "can change it\n";
+    return Instrument_sptr();
+  }
+
+  Poco::SharedMemory mapped(file, Poco::SharedMemory::AM_READ);
+  Reader in(mapped.begin(), mapped.end());
+
+  // Header
+  if (!in.match(MAGIC, sizeof(MAGIC))) {
+    g_log.debug() << m_filename << " is not an instrument cache file\n";
+    return Instrument_sptr();
+  }
+  if (in.read<uint32_t>() != FORMAT_VERSION ||
+      in.read<uint32_t>() != BYTE_ORDER_MARK || in.readString() != key) {
+    g_log.debug() << m_filename << " was written for a different instrument "
+                                   "definition or format\n";
+    return Instrument_sptr();
+  }
+
+  // Instrument level information
+  Instrument_sptr instrument = boost::make_shared<Instrument>(in.readString());
+  const PointingAlong up = static_cast<PointingAlong>(in.read<int32_t>());
+  const PointingAlong along = static_cast<PointingAlong>(in.read<int32_t>());
+  const Handedness handedness = static_cast<Handedness>(in.read<int32_t>());
+  const std::string origin = in.readString();
+  instrument->setReferenceFrame(
+      boost::make_shared<ReferenceFrame>(up, along, handedness, origin));
+  instrument->setDefaultView(in.readString());
+  instrument->setDefaultViewAxis(in.readString());
+  instrument->setValidFromDate(DateAndTime(in.read<int64_t>()));
+  instrument->setValidToDate(DateAndTime(in.read<int64_t>()));
+  std::map<std::string, std::string> &units = instrument->getLogfileUnit();
+  const uint32_t numUnits = in.read<uint32_t>();
+  for (uint32_t i = 0; i < numUnits; ++i) {
+    const std::string name = in.readString();
+    units[name] = in.readString();
+  }
+
+  // Shapes
+  ShapeFactory shapeCreator;
+  const uint32_t numShapes = in.read<uint32_t>();
+  std::vector<boost::shared_ptr<Object>> shapeTable(numShapes);
+  for (uint32_t i = 0; i < numShapes; ++i) {
+    const std::string typeName = in.readString();
+    const int32_t name = in.read<int32_t>();
+    shapeTable[i] = shapeCreator.createShape(in.readString(), false);
+    shapeTable[i]->setName(name);
+    if (!typeName.empty())
+      shapes[typeName] = shapeTable[i];
+  }
+
+  // Components
+  std::vector<IComponent *> components;
+  const uint32_t numRecords = in.read<uint32_t>();
+  for (uint32_t record = 0; record < numRecords; ++record) {
+    const uint8_t type = in.read<uint8_t>();
+    const int32_t parentIndex = in.read<int32_t>();
+    const std::string name = in.readString();
+    const V3D pos = in.readV3D();
+    const Quat rot = in.readQuat();
+
+    ICompAssembly *parent(instrument.get());
+    if (parentIndex >= 0) {
+      if (static_cast<size_t>(parentIndex) >= components.size() ||
+          !(parent = dynamic_cast<ICompAssembly *>(components[parentIndex])))
+        throw std::runtime_error("Instrument cache file has an invalid parent");
+    }
+
+    IComponent *comp(NULL);
+    Detector *det(NULL);
+    uint8_t mark(NotMarked);
+    std::vector<const IComponent *> pixels;
+    if (type == CompAssemblyRecord) {
+      comp = new CompAssembly(name);
+    } else if (type == ObjComponentRecord || type == DetectorRecord) {
+      const int32_t shape = in.read<int32_t>();
+      if (shape >= static_cast<int32_t>(numShapes))
+        throw std::runtime_error("Instrument cache file has an invalid shape");
+      boost::shared_ptr<Object> obj;
+      if (shape >= 0)
+        obj = shapeTable[shape];
+      if (type == ObjComponentRecord) {
+        comp = new ObjComponent(name, obj);
+      } else {
+        const int32_t id = in.read<int32_t>();
+        mark = in.read<uint8_t>();
+        det = new Detector(name, id, obj, NULL);
+        comp = det;
+      }
+    } else if (type == RectangularDetectorRecord) {
+      const int32_t shape = in.read<int32_t>();
+      if (shape < 0 || shape >= static_cast<int32_t>(numShapes))
+        throw std::runtime_error("Instrument cache file has an invalid shape");
+      const int32_t xpixels = in.read<int32_t>();
+      const double xstart = in.read<double>();
+      const double xstep = in.read<double>();
+      const int32_t ypixels = in.read<int32_t>();
+      const double ystart = in.read<double>();
+      const double ystep = in.read<double>();
+      const int32_t idstart = in.read<int32_t>();
+      const bool idfillbyfirst_y = in.read<uint8_t>() != 0;
+      const int32_t idstepbyrow = in.read<int32_t>();
+      const int32_t idstep = in.read<int32_t>();
+      RectangularDetector *bank = new RectangularDetector(name);
+      bank->initialize(shapeTable[shape], xpixels, xstart, xstep, ypixels,
+                       ystart, ystep, idstart, idfillbyfirst_y, idstepbyrow,
+                       idstep);
+      appendDescendants(*bank, pixels);
+      comp = bank;
+    } else {
+      throw std::runtime_error("Instrument cache file has an unknown record");
+    }
+    parent->add(comp);
+    comp->setPos(pos);
+    comp->setRot(rot);
+    components.push_back(comp);
+    if (mark == MarkedAsMonitor)
+      instrument->markAsMonitor(det);
+    else if (mark == MarkedAsDetector)
+      instrument->markAsDetector(det);
+
+    if (type == RectangularDetectorRecord) {
+      if (in.read<uint32_t>() != pixels.size())
+        throw std::runtime_error(
+            "Instrument cache file does not match the RectangularDetector " +
+            name);
+      for (size_t i = 0; i < pixels.size(); ++i) {
+        IComponent *pixel = const_cast<IComponent *>(pixels[i]);
+        pixel->setPos(in.readV3D());
+        pixel->setRot(in.readQuat());
+        const uint8_t pixelMark = in.read<uint8_t>();
+        IDetector *pixelDet = dynamic_cast<IDetector *>(pixel);
+        if (pixelDet && pixelMark == MarkedAsMonitor)
+          instrument->markAsMonitor(pixelDet);
+        else if (pixelDet && pixelMark == MarkedAsDetector)
+          instrument->markAsDetector(pixelDet);
+        components.push_back(pixel);
+      }
+    }
+  }
+
+  // Special components
+  const int32_t source = in.read<int32_t>();
+  if (source >= static_cast<int32_t>(components.size()))
+    throw std::runtime_error("Instrument cache file has an invalid source");
+  if (source >= 0)
+    instrument->markAsSource(components[source]);
+  const int32_t sample = in.read<int32_t>();
+  if (sample >= static_cast<int32_t>(components.size()))
+    throw std::runtime_error("Instrument cache file has an invalid sample");
+  if (sample >= 0)
+    instrument->markAsSamplePos(components[sample]);
+  const uint32_t numChoppers = in.read<uint32_t>();
+  for (uint32_t i = 0; i < numChoppers; ++i) {
+    const int32_t chopper = in.read<int32_t>();
+    const ObjComponent *obj(NULL);
+    if (chopper >= 0 && chopper < static_cast<int32_t>(components.size()))
+      obj = dynamic_cast<const ObjComponent *>(components[chopper]);
+    if (!obj)
+      throw std::runtime_error("Instrument cache file has an invalid chopper");
+    instrument->markAsChopperPoint(obj);
+  }
+
+  // Parameters that are resolved against the sample logs
+  InstrumentParameterCache &params = instrument->getLogfileCache();
+  const uint32_t numParams = in.read<uint32_t>();
+  for (uint32_t i = 0; i < numParams; ++i) {
+    const std::string paramName = in.readString();
+    const int32_t keyIndex = in.read<int32_t>();
+    const int32_t compIndex = in.read<int32_t>();
+    if (keyIndex >= static_cast<int32_t>(components.size()) ||
+        compIndex >= static_cast<int32_t>(components.size()))
+      throw std::runtime_error("Instrument cache file has an invalid "
+                               "parameter component");
+    const IComponent *keyComp =
+        keyIndex < 0 ? instrument.get() : components[keyIndex];
+    const IComponent *comp =
+        compIndex < 0 ? instrument.get() : components[compIndex];
+    const std::string logfileID = in.readString();
+    const std::string value = in.readString();
+    boost::shared_ptr<Kernel::Interpolation> interpolation;
+    if (in.read<uint8_t>() != 0) {
+      interpolation = boost::make_shared<Kernel::Interpolation>();
+      std::istringstream is(in.readString());
+      is >> *interpolation;
+    }
+    const std::string formula = in.readString();
+    const std::string formulaUnit = in.readString();
+    const std::string resultUnit = in.readString();
+    const std::string name = in.readString();
+    const std::string type = in.readString();
+    const std::string tie = in.readString();
+    std::vector<std::string> constraint(in.read<uint32_t>());
+    for (size_t j = 0; j < constraint.size(); ++j)
+      constraint[j] = in.readString();
+    std::string penaltyFactor = in.readString();
+    const std::string fitFunc = in.readString();
+    const std::string extractSingleValueAs = in.readString();
+    const std::string eq = in.readString();
+    const double angleConvertConst = in.read<double>();
+    params[std::make_pair(paramName, keyComp)] =
+        boost::make_shared<XMLInstrumentParameter>(
+            logfileID, value, interpolation, formula, formulaUnit, resultUnit,
+            name, type, tie, constraint, penaltyFactor, fitFunc,
+            extractSingleValueAs, eq, comp, angleConvertConst);
+  }
+
+  g_log.debug() << "Read instrument " << instrument->getName() << " from "
+                << m_filename << "\n";
+  return instrument;
+}
+
+} // namespace Geometry
+} // namespace Mantid
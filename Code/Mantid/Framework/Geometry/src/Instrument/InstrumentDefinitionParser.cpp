@@ -1,5 +1,6 @@
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -182,6 +183,17 @@ InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *prog) {
     throw std::runtime_error(
         "Call InstrumentDefinitionParser::initialize() before parseXML.");
 
+  // An earlier parse of the same definition may have stored the result
+  std::string binaryCacheKey;
+  if (InstrumentBinaryCache::isEnabled()) {
+    binaryCacheKey =
+        InstrumentBinaryCache::key(m_instName, m_instrument->getXmlText());
+    if (readBinaryCache(binaryCacheKey)) {
+      m_cachingOption = setupGeometryCache();
+      return m_instrument;
+    }
+  }
+
   setValidityRange(pRootElem);
   readDefaults(pRootElem->getChildElement("defaults"));
   // create maps: isTypeAssembly and mapTypeNameToShape
@@ -436,6 +448,9 @@ InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *prog) {
   if (m_indirectPositions)
     createNeutronicInstrument();
 
+  if (!binaryCacheKey.empty())
+    writeBinaryCache(binaryCacheKey);
+
   // And give back what we created
   return m_instrument;
 }
@@ -2263,6 +2278,55 @@ InstrumentDefinitionParser::getAppliedCachingOption() const {
   return m_cachingOption;
 }
 
+/** Replace the instrument being built with the one stored in the binary
+ *  instrument cache by an earlier parse of the same definition. The shapes of
+ *  the types are read back into mapTypeNameToShape.
+ *
+ *  @param key :: The key of the instrument definition
+ *  @return True if the instrument was read from the cache
+ */
+bool InstrumentDefinitionParser::readBinaryCache(const std::string &key) {
+  InstrumentBinaryCache cache(
+      InstrumentBinaryCache::defaultFilename(m_instName, key));
+  Instrument_sptr cached;
+  try {
+    cached = cache.read(key, mapTypeNameToShape);
+  } catch (std::exception &e) {
+    g_log.information() << "Unable to read instrument cache "
+                        << cache.filename() << ": " << e.what() << "\n";
+    mapTypeNameToShape.clear();
+    return false;
+  }
+  if (!cached)
+    return false;
+
+  cached->setFilename(m_instrument->getFilename());
+  cached->setXmlText(m_instrument->getXmlText());
+  m_instrument = cached;
+  g_log.debug() << "Instrument " << m_instName << " read from "
+                << cache.filename() << "\n";
+  return true;
+}
+
+/** Store the instrument that has been built in the binary instrument cache.
+ *  Failures are logged and otherwise ignored as the instrument is still valid.
+ *
+ *  @param key :: The key of the instrument definition
+ */
+void InstrumentDefinitionParser::writeBinaryCache(
+    const std::string &key) const {
+  InstrumentBinaryCache cache(
+      InstrumentBinaryCache::defaultFilename(m_instName, key));
+  try {
+    cache.write(*m_instrument, mapTypeNameToShape, key);
+    InstrumentBinaryCache::trimDefaultDirectory();
+  } catch (std::exception &e) {
+    g_log.debug() << "Instrument " << m_instName
+                  << " not written to the instrument cache: " << e.what()
+                  << "\n";
+  }
+}
+
 void InstrumentDefinitionParser::createNeutronicInstrument() {
   // Create a copy of the instrument
   Instrument_sptr physical(new Instrument(*m_instrument));
@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidGeometry/Math/RectangleIntersection.h"
+#include <stdexcept>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// The most vertices a quadrilateral can have after clipping to a rectangle.
+/// A convex quadrilateral gains at most one vertex per side, but a twisted
+/// one can double its vertices at each of the four sides, so allow for that.
+const int MAX_CLIPPED_VERTICES = 4 * 2 * 2 * 2 * 2;
+
+/// The sides of the rectangle
+enum ClipEdge { Left, Right, Bottom, Top };
+
+/// Is the point on the inside of the given side of the rectangle
+inline bool inside(const double x, const double y, const ClipEdge edge,
+                   const double bound) {
+  switch (edge) {
+  case Left:
+    return x >= bound;
+  case Right:
+    return x <= bound;
+  case Bottom:
+    return y >= bound;
+  default:
+    return y <= bound;
+  }
+}
+
+/**
+ * Clip a polygon against one side of the rectangle
+ * @param inX :: The X values of the vertices to clip
+ * @param inY :: The Y values of the vertices to clip
+ * @param nin :: The number of vertices to clip
+ * @param edge :: The side of the rectangle to clip against
+ * @param bound :: The position of the side
+ * @param outX :: [Output] The X values of the clipped vertices
+ * @param outY :: [Output] The Y values of the clipped vertices
+ * @param maxOut :: The number of vertices that outX and outY can hold
+ * @returns The number of clipped vertices
+ * @throws std::length_error if the output buffers are too small
+ */
+int clipAgainstEdge(const double *inX, const double *inY, const int nin,
+                    const ClipEdge edge, const double bound, double *outX,
+                    double *outY, const int maxOut) {
+  // Each input vertex adds at most two output vertices
+  if (2 * nin > maxOut) {
+    throw std::length_error("clipAgainstEdge - Too many vertices to clip");
+  }
+  int nout(0);
+  for (int i = 0; i < nin; ++i) {
+    const int prev = (i == 0) ? nin - 1 : i - 1;
+    const bool curIn = inside(inX[i], inY[i], edge, bound);
+    const bool prevIn = inside(inX[prev], inY[prev], edge, bound);
+    if (curIn != prevIn) {
+      // The edge from prev to i crosses the side
+      double x, y;
+      if (edge == Left || edge == Right) {
+        const double t = (bound - inX[prev]) / (inX[i] - inX[prev]);
+        x = bound;
+        y = inY[prev] + t * (inY[i] - inY[prev]);
+      } else {
+        const double t = (bound - inY[prev]) / (inY[i] - inY[prev]);
+        x = inX[prev] + t * (inX[i] - inX[prev]);
+        y = bound;
+      }
+      outX[nout] = x;
+      outY[nout] = y;
+      ++nout;
+    }
+    if (curIn) {
+      outX[nout] = inX[i];
+      outY[nout] = inY[i];
+      ++nout;
+    }
+  }
+  return nout;
+}
+}
+
+/**
+ * @param poly :: The quadrilateral
+ * @param xmin :: The lower X bound of the rectangle
+ * @param xmax :: The upper X bound of the rectangle
+ * @param ymin :: The lower Y bound of the rectangle
+ * @param ymax :: The upper Y bound of the rectangle
+ * @param overlap :: [Output] The area and X extent of the overlap. Only set if
+ * the shapes overlap
+ * @returns True if the overlap has a non-zero area
+ */
+bool intersectionWithRectangle(const Quadrilateral &poly, const double xmin,
+                               const double xmax, const double ymin,
+                               const double ymax, OverlapRegion &overlap) {
+  double bufX[2][MAX_CLIPPED_VERTICES], bufY[2][MAX_CLIPPED_VERTICES];
+  for (int i = 0; i < 4; ++i) {
+    const Kernel::V2D &vertex = poly[i];
+    bufX[0][i] = vertex.X();
+    bufY[0][i] = vertex.Y();
+  }
+  int nvertices(4);
+  const ClipEdge edges[4] = {Left, Right, Bottom, Top};
+  const double bounds[4] = {xmin, xmax, ymin, ymax};
+  int current(0);
+  for (int i = 0; i < 4 && nvertices > 0; ++i) {
+    nvertices =
+        clipAgainstEdge(bufX[current], bufY[current], nvertices, edges[i],
+                        bounds[i], bufX[1 - current], bufY[1 - current],
+                        MAX_CLIPPED_VERTICES);
+    current = 1 - current;
+  }
+  if (nvertices < 3)
+    return false;
+
+  const double *x = bufX[current];
+  const double *y = bufY[current];
+  double twiceArea(0.0), lowestX(x[0]), highestX(x[0]);
+  for (int i = 0; i < nvertices; ++i) {
+    const int next = (i + 1 == nvertices) ? 0 : i + 1;
+    twiceArea += y[i] * x[next] - x[i] * y[next];
+    if (x[i] < lowestX)
+      lowestX = x[i];
+    else if (x[i] > highestX)
+      highestX = x[i];
+  }
+  if (twiceArea == 0.0)
+    return false;
+  overlap.area = 0.5 * twiceArea;
+  overlap.smallestX = lowestX;
+  overlap.largestX = highestX;
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
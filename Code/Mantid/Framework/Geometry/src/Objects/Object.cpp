@@ -18,11 +18,49 @@
 #include "MantidKernel/Tolerance.h"
 #include <deque>
 #include <iostream>
+#include <limits>
 #include <stack>
 
 namespace Mantid {
 namespace Geometry {
 
+namespace {
+/**
+* Could the forward part of a track pass through or touch a box? The box is
+* padded by the tolerance and its faces count as inside, so a track that
+* grazes a face or an edge is kept.
+* @param box :: A non-null, axis-aligned box
+* @param start :: The start of the track
+* @param dir :: The direction of the track
+* @return False only if the track certainly misses the box
+*/
+bool trackMayCrossBox(const BoundingBox &box, const Kernel::V3D &start,
+                      const Kernel::V3D &dir) {
+  const double pad = Kernel::Tolerance;
+  const double lower[3] = {box.xMin() - pad, box.yMin() - pad,
+                           box.zMin() - pad};
+  const double upper[3] = {box.xMax() + pad, box.yMax() + pad,
+                           box.zMax() + pad};
+  double tNear(0.0), tFar(std::numeric_limits<double>::max());
+  for (size_t i = 0; i < 3; ++i) {
+    if (dir[i] == 0.0) {
+      if (start[i] < lower[i] || start[i] > upper[i])
+        return false;
+      continue;
+    }
+    double t1 = (lower[i] - start[i]) / dir[i];
+    double t2 = (upper[i] - start[i]) / dir[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tNear = std::max(tNear, t1);
+    tFar = std::min(tFar, t2);
+    if (tNear > tFar)
+      return false;
+  }
+  return true;
+}
+}
+
 using Kernel::V3D;
 using Kernel::Quat;
 
@@ -30,7 +68,8 @@ using Kernel::Quat;
 *  Default constuctor
 */
 Object::Object()
-    : ObjName(0), TopRule(0), m_boundingBox(), AABBxMax(0), AABByMax(0),
+    : ObjName(0), TopRule(0), m_boundingBox(), m_boundingBoxValid(false),
+      m_boundingBoxComputed(false), AABBxMax(0), AABByMax(0),
       AABBzMax(0), AABBxMin(0), AABByMin(0), AABBzMin(0), boolBounded(false),
       handle(), bGeometryCaching(false),
       vtkCacheReader(boost::shared_ptr<vtkGeometryCacheReader>()),
@@ -45,7 +84,8 @@ Object::Object()
 *  @param shapeXML : string with original shape xml.
 */
 Object::Object(const std::string &shapeXML)
-    : ObjName(0), TopRule(0), m_boundingBox(), AABBxMax(0), AABByMax(0),
+    : ObjName(0), TopRule(0), m_boundingBox(), m_boundingBoxValid(false),
+      m_boundingBoxComputed(false), AABBxMax(0), AABByMax(0),
       AABBzMax(0), AABBxMin(0), AABByMin(0), AABBzMin(0), boolBounded(false),
       handle(), bGeometryCaching(false),
       vtkCacheReader(boost::shared_ptr<vtkGeometryCacheReader>()),
@@ -61,7 +101,9 @@ Object::Object(const std::string &shapeXML)
 */
 Object::Object(const Object &A)
     : ObjName(A.ObjName), TopRule((A.TopRule) ? A.TopRule->clone() : NULL),
-      m_boundingBox(A.m_boundingBox), AABBxMax(A.AABBxMax),
+      m_boundingBox(A.m_boundingBox),
+      m_boundingBoxValid(A.m_boundingBoxValid),
+      m_boundingBoxComputed(A.m_boundingBoxComputed), AABBxMax(A.AABBxMax),
       AABByMax(A.AABByMax), AABBzMax(A.AABBzMax), AABBxMin(A.AABBxMin),
       AABByMin(A.AABByMin), AABBzMin(A.AABBzMin), boolBounded(A.boolBounded),
       handle(A.handle->clone()), bGeometryCaching(A.bGeometryCaching),
@@ -81,6 +123,9 @@ Object &Object::operator=(const Object &A) {
     ObjName = A.ObjName;
     delete TopRule;
     TopRule = (A.TopRule) ? A.TopRule->clone() : 0;
+    m_boundingBox = A.m_boundingBox;
+    m_boundingBoxValid = A.m_boundingBoxValid;
+    m_boundingBoxComputed = A.m_boundingBoxComputed;
     AABBxMax = A.AABBxMax;
     AABByMax = A.AABByMax;
     AABBzMax = A.AABBzMax;
@@ -300,6 +345,11 @@ int Object::populate(const std::map<int, Surface *> &Smap) {
     }
   }
   createSurfaceList();
+  // Work out the bounding box now, while the object is being set up, so that
+  // later users such as the absorption algorithms, which trace tracks through
+  // the object from many threads at once, only ever read it
+  if (!m_boundingBoxValid)
+    calcBoundingBox();
   return 0;
 }
 
@@ -602,6 +652,8 @@ void Object::print() const {
 void Object::makeComplement() {
   Rule *NCG = procComp(TopRule);
   TopRule = NCG;
+  m_boundingBoxValid = false;
+  m_boundingBoxComputed = false;
   return;
 }
 
@@ -662,6 +714,8 @@ void Object::write(std::ostream &OX) const {
 int Object::procString(const std::string &Line) {
   delete TopRule;
   TopRule = 0;
+  m_boundingBoxValid = false;
+  m_boundingBoxComputed = false;
   std::map<int, Rule *> RuleList; // List for the rules
   int Ridx = 0; // Current index (not necessary size of RuleList
   // SURFACE REPLACEMENT
@@ -746,6 +800,15 @@ int Object::procString(const std::string &Line) {
 */
 int Object::interceptSurface(Geometry::Track &UT) const {
   int cnt = UT.count(); // Number of intersections original track
+  // A track that misses the bounding box cannot cross any surface of the
+  // object so avoid visiting each of them. Only a box worked out from the
+  // surfaces is trusted to enclose the object; one given in the instrument
+  // definition may not.
+  const BoundingBox &boundingBox = getBoundingBox();
+  if (m_boundingBoxComputed && boundingBox.isNonNull() &&
+      !trackMayCrossBox(boundingBox, UT.startPoint(), UT.direction())) {
+    return 0;
+  }
   // Loop over all the surfaces.
   LineIntersectVisit LI(UT.startPoint(), UT.direction());
   std::vector<const Surface *>::const_iterator vc;
@@ -1465,41 +1528,58 @@ const BoundingBox &Object::getBoundingBox() const {
   // to call it on a const object. We need to call a non-const function in
   // places to update the cache,
   // which is where the const_cast comes in to play.
+  // The box is normally calculated when the object is populated. Should it be
+  // asked for before then the calculation is serialised, as this may be
+  // called from inside a parallel loop.
+  if (!m_boundingBoxValid) {
+    PARALLEL_CRITICAL(Object_getBoundingBox) {
+      if (!m_boundingBoxValid)
+        const_cast<Object *>(this)->calcBoundingBox();
+    }
+  }
+  return m_boundingBox;
+}
 
+/**
+* Calculate the axis-aligned bounding box of the shape from its rule tree.
+* If the rule tree does not give a finite extent the box is left null.
+*/
+void Object::calcBoundingBox() {
+  m_boundingBoxComputed = false;
   if (!TopRule) {
     // If we don't know the extent of the object, the bounding box doesn't mean
     // anything
-    const_cast<Object *>(this)->setNullBoundingBox();
-  } else if (m_boundingBox.isNull()) {
-    // First up, construct the trial set of elements from the object's bounding
-    // box
-    const double big(1e10);
-    double minX(-big), maxX(big), minY(-big), maxY(big), minZ(-big), maxZ(big);
-    TopRule->getBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
-    // If the object is not axis aligned then the bounding box will be poor, in
-    // particular the minima are left at the trial start so return
-    // a null object here
-    if (minX < -100 || maxX > 100 || minY < -100 || maxY > 100 || minZ < -100 ||
-        maxZ > 100) {
-      // std::cerr << this->getName() << '(' << minX << ',' << maxX << ") (" <<
-      // minY << ',' << maxY << ") (" << minZ << ',' << maxZ << ")\n";
-      minX = -100;
-      maxX = 100;
-      minY = -100;
-      maxY = 100;
-      minZ = -100;
-      maxZ = 100;
-    }
-    if (minX == -big || minY == -big || minZ == -big) {
-      const_cast<Object *>(this)->setNullBoundingBox();
-    } else {
-      const_cast<Object *>(this)
-          ->defineBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
-    }
+    m_boundingBox = BoundingBox();
+    return;
+  }
+  // First up, construct the trial set of elements from the object's bounding
+  // box
+  const double big(1e10);
+  double minX(-big), maxX(big), minY(-big), maxY(big), minZ(-big), maxZ(big);
+  TopRule->getBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
+  // If the object is not axis aligned then the bounding box will be poor, in
+  // particular the minima are left at the trial start so return
+  // a null object here
+  // A clipped box may not enclose the object, so it is not used to reject
+  // tracks
+  bool clipped(false);
+  if (minX < -100 || maxX > 100 || minY < -100 || maxY > 100 || minZ < -100 ||
+      maxZ > 100) {
+    minX = -100;
+    maxX = 100;
+    minY = -100;
+    maxY = 100;
+    minZ = -100;
+    maxZ = 100;
+    clipped = true;
+  }
+  if (minX == -big || minY == -big || minZ == -big) {
+    m_boundingBox = BoundingBox();
   } else {
+    defineBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
   }
-
-  return m_boundingBox;
+  m_boundingBoxValid = true;
+  m_boundingBoxComputed = !clipped;
 }
 
 /**
@@ -1572,13 +1652,21 @@ void Object::defineBoundingBox(const double &xMax, const double &yMax,
 
   PARALLEL_CRITICAL(defineBoundingBox) {
     m_boundingBox = BoundingBox(xMax, yMax, zMax, xMin, yMin, zMin);
+    m_boundingBoxValid = true;
+    // Not known to enclose the object unless calcBoundingBox() says so
+    m_boundingBoxComputed = false;
   }
 }
 
 /**
-* Set the bounding box to a null box
+* Set the bounding box to a null box. It stays null, rather than being
+* calculated again, until the shape is changed.
 */
-void Object::setNullBoundingBox() { m_boundingBox = BoundingBox(); }
+void Object::setNullBoundingBox() {
+  m_boundingBox = BoundingBox();
+  m_boundingBoxValid = true;
+  m_boundingBoxComputed = false;
+}
 
 /**
 Try to find a point that lies within (or on) the object
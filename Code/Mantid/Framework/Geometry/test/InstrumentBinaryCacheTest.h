@@ -0,0 +1,337 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_
+#define MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Objects/Object.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Timestamp.h>
+#include <boost/make_shared.hpp>
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::ConfigService;
+using Mantid::Kernel::V3D;
+
+class InstrumentBinaryCacheTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static InstrumentBinaryCacheTest *createSuite() { return new InstrumentBinaryCacheTest(); }
+  static void destroySuite( InstrumentBinaryCacheTest *suite ) { delete suite; }
+
+  InstrumentBinaryCacheTest()
+      : m_filename(Poco::Path(ConfigService::Instance().getTempDir(),
+                              "InstrumentBinaryCacheTest.instcache").toString())
+  {
+    ConfigService::Instance().getValue(ENABLED, m_enabled);
+    m_directory = ConfigService::Instance().getString(DIRECTORY);
+  }
+
+  void setUp()
+  {
+    // Parse without touching the default cache directory
+    ConfigService::Instance().setString(ENABLED, "0");
+  }
+
+  void tearDown()
+  {
+    ConfigService::Instance().setString(ENABLED, m_enabled);
+    ConfigService::Instance().setString(DIRECTORY, m_directory);
+    removeFile(m_filename);
+  }
+
+  void test_round_trip()
+  {
+    InstrumentDefinitionParser parser;
+    Instrument_sptr original = parse(parser);
+    InstrumentBinaryCache::ShapeMap shapes;
+    shapes["pixel"] = boost::const_pointer_cast<Object>(
+        original->getDetector(1)->shape());
+
+    InstrumentBinaryCache cache(m_filename);
+    TS_ASSERT_THROWS_NOTHING(cache.write(*original, shapes, "key"));
+
+    InstrumentBinaryCache::ShapeMap readShapes;
+    Instrument_sptr copy;
+    TS_ASSERT_THROWS_NOTHING(copy = cache.read("key", readShapes));
+    TS_ASSERT(copy);
+    if (!copy) return;
+
+    TS_ASSERT_EQUALS(copy->getName(), original->getName());
+    TS_ASSERT_EQUALS(copy->getReferenceFrame()->pointingUp(), X);
+    TS_ASSERT_EQUALS(copy->getReferenceFrame()->pointingAlongBeam(), Z);
+    TS_ASSERT_EQUALS(copy->getDefaultView(), original->getDefaultView());
+    TS_ASSERT_EQUALS(copy->getValidFromDate(), original->getValidFromDate());
+    TS_ASSERT_EQUALS(copy->getValidToDate(), original->getValidToDate());
+    TS_ASSERT_EQUALS(readShapes.size(), 1);
+    TS_ASSERT_EQUALS(readShapes["pixel"]->getShapeXML(),
+                     shapes["pixel"]->getShapeXML());
+
+    TS_ASSERT_EQUALS(copy->getSource()->getName(), "moderator");
+    TS_ASSERT_EQUALS(copy->getSample()->getName(), "sample");
+    TS_ASSERT_EQUALS(copy->getSample()->getPos(), V3D(0, 0, 0));
+    TS_ASSERT_EQUALS(copy->getSource()->getPos(), V3D(0, 0, -10));
+    TS_ASSERT_EQUALS(copy->getNumberOfChopperPoints(), 1);
+
+    // Detectors, monitors and the pixels of the rectangular detector
+    TS_ASSERT_EQUALS(copy->getDetectorIDs().size(),
+                     original->getDetectorIDs().size());
+    const std::vector<Mantid::detid_t> ids = original->getDetectorIDs();
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      TS_ASSERT_DELTA(copy->getDetector(ids[i])->getPos().distance(
+                          original->getDetector(ids[i])->getPos()), 0.0, 1e-12);
+      TS_ASSERT_EQUALS(copy->isMonitor(ids[i]), original->isMonitor(ids[i]));
+    }
+    TS_ASSERT(copy->isMonitor(11));
+    boost::shared_ptr<const RectangularDetector> bank =
+        boost::dynamic_pointer_cast<const RectangularDetector>(
+            copy->getComponentByName("panel"));
+    TS_ASSERT(bank);
+    if (bank)
+    {
+      TS_ASSERT_EQUALS(bank->xpixels(), 3);
+      TS_ASSERT_EQUALS(bank->getAtXY(2, 1)->getID(), 105);
+    }
+
+    // Parameters defined in the IDF
+    TS_ASSERT_EQUALS(copy->getLogfileCache().size(),
+                     original->getLogfileCache().size());
+    TS_ASSERT_EQUALS(copy->getLogfileCache().size(), 1);
+  }
+
+  void test_read_returns_nothing_without_a_file()
+  {
+    InstrumentBinaryCache cache(m_filename);
+    InstrumentBinaryCache::ShapeMap shapes;
+    TS_ASSERT(!cache.read("key", shapes));
+  }
+
+  void test_read_returns_nothing_for_another_key()
+  {
+    InstrumentDefinitionParser parser;
+    Instrument_sptr original = parse(parser);
+    InstrumentBinaryCache cache(m_filename);
+    cache.write(*original, InstrumentBinaryCache::ShapeMap(), "key");
+    InstrumentBinaryCache::ShapeMap shapes;
+    TS_ASSERT(!cache.read("other", shapes));
+  }
+
+  void test_read_throws_for_a_truncated_file()
+  {
+    InstrumentDefinitionParser parser;
+    Instrument_sptr original = parse(parser);
+    InstrumentBinaryCache cache(m_filename);
+    cache.write(*original, InstrumentBinaryCache::ShapeMap(), "key");
+    std::string contents;
+    {
+      std::ifstream in(m_filename.c_str(), std::ios_base::binary);
+      contents.assign(std::istreambuf_iterator<char>(in),
+                      std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream out(m_filename.c_str(), std::ios_base::binary);
+      out.write(contents.data(), contents.size() / 2);
+    }
+    InstrumentBinaryCache::ShapeMap shapes;
+    TS_ASSERT_THROWS(cache.read("key", shapes), std::runtime_error);
+  }
+
+  void test_parametrized_instrument_cannot_be_written()
+  {
+    InstrumentDefinitionParser parser;
+    Instrument_sptr original = parse(parser);
+    Instrument parametrized(original, boost::make_shared<ParameterMap>());
+    InstrumentBinaryCache cache(m_filename);
+    TS_ASSERT_THROWS(cache.write(parametrized, InstrumentBinaryCache::ShapeMap(),
+                                 "key"),
+                     std::invalid_argument);
+  }
+
+  void test_read_ignores_a_file_that_others_can_change()
+  {
+#ifndef _WIN32
+    InstrumentDefinitionParser parser;
+    Instrument_sptr original = parse(parser);
+    InstrumentBinaryCache cache(m_filename);
+    cache.write(*original, InstrumentBinaryCache::ShapeMap(), "key");
+    InstrumentBinaryCache::ShapeMap shapes;
+    TS_ASSERT(cache.read("key", shapes));
+    ::chmod(m_filename.c_str(), 0666);
+    shapes.clear();
+    TS_ASSERT(!cache.read("key", shapes));
+#endif
+  }
+
+  void test_default_directory_is_in_the_user_properties_directory()
+  {
+    ConfigService::Instance().setString(DIRECTORY, "");
+    const std::string directory = InstrumentBinaryCache::defaultDirectory();
+    TS_ASSERT_EQUALS(
+        directory.find(ConfigService::Instance().getUserPropertiesDir()), 0);
+    TS_ASSERT_DIFFERS(directory.find("instrument-cache"), std::string::npos);
+    TS_ASSERT_EQUALS(Poco::Path(InstrumentBinaryCache::defaultFilename("INST", "key"))
+                         .parent().toString(),
+                     directory);
+  }
+
+  void test_trim_removes_old_files_then_the_oldest_over_the_size_limit()
+  {
+    Poco::Path directory(ConfigService::Instance().getTempDir());
+    directory.makeDirectory();
+    directory.pushDirectory("InstrumentBinaryCacheTest_trim");
+    Poco::File(directory).createDirectories();
+    const std::string dir = directory.toString();
+    const Poco::Timestamp::TimeDiff day =
+        86400 * Poco::Timestamp::resolution();
+    Poco::Timestamp now;
+    createFile(dir + "ancient.instcache", 10, now - 100 * day);
+    createFile(dir + "old.instcache", 10, now - 3 * day);
+    createFile(dir + "recent.instcache", 10, now - 2 * day);
+    createFile(dir + "new.instcache", 10, now);
+    createFile(dir + "other.txt", 10, now - 100 * day);
+
+    InstrumentBinaryCache::trim(dir, 1000, 30.);
+    TS_ASSERT(!Poco::File(dir + "ancient.instcache").exists());
+    TS_ASSERT(Poco::File(dir + "old.instcache").exists());
+
+    InstrumentBinaryCache::trim(dir, 20, 30.);
+    TS_ASSERT(!Poco::File(dir + "old.instcache").exists());
+    TS_ASSERT(Poco::File(dir + "recent.instcache").exists());
+    TS_ASSERT(Poco::File(dir + "new.instcache").exists());
+    // Other files are left alone
+    TS_ASSERT(Poco::File(dir + "other.txt").exists());
+
+    Poco::File(dir).remove(true);
+  }
+
+  void test_parser_uses_the_cache_for_an_unchanged_definition()
+  {
+    ConfigService::Instance().setString(ENABLED, "1");
+    ConfigService::Instance().setString(DIRECTORY,
+                                        ConfigService::Instance().getTempDir());
+    const std::string filename = InstrumentBinaryCache::defaultFilename(
+        "BinaryCacheTest", InstrumentBinaryCache::key("BinaryCacheTest", IDF));
+    removeFile(filename);
+
+    InstrumentDefinitionParser first;
+    Instrument_sptr parsed = parse(first);
+    TS_ASSERT(Poco::File(filename).exists());
+
+    InstrumentDefinitionParser second;
+    Instrument_sptr cached = parse(second);
+    TS_ASSERT_DIFFERS(cached, parsed);
+    TS_ASSERT_EQUALS(cached->getXmlText(), IDF);
+    TS_ASSERT_EQUALS(cached->getDetectorIDs(), parsed->getDetectorIDs());
+    TS_ASSERT_EQUALS(cached->getComponentByName("panel")->getPos(),
+                     parsed->getComponentByName("panel")->getPos());
+    removeFile(filename);
+  }
+
+private:
+  Instrument_sptr parse(InstrumentDefinitionParser &parser)
+  {
+    parser.initialize("BinaryCacheTest_Definition.xml", "BinaryCacheTest", IDF);
+    return parser.parseXML(NULL);
+  }
+
+  void createFile(const std::string &filename, const size_t size,
+                  const Poco::Timestamp &modified)
+  {
+    {
+      std::ofstream out(filename.c_str(), std::ios_base::binary);
+      out << std::string(size, 'x');
+    }
+    Poco::File(filename).setLastModified(modified);
+  }
+
+  void removeFile(const std::string &filename)
+  {
+    Poco::File file(filename);
+    if (file.exists())
+      file.remove();
+  }
+
+  static const std::string IDF;
+  static const std::string ENABLED;
+  static const std::string DIRECTORY;
+  const std::string m_filename;
+  std::string m_enabled;
+  std::string m_directory;
+};
+
+const std::string InstrumentBinaryCacheTest::ENABLED =
+    "instrumentDefinition.binaryCache.enabled";
+const std::string InstrumentBinaryCacheTest::DIRECTORY =
+    "instrumentDefinition.binaryCache.directory";
+const std::string InstrumentBinaryCacheTest::IDF =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+    "<instrument name=\"BinaryCacheTest\" valid-from=\"1900-01-31 23:59:59\" "
+    "valid-to=\"2100-01-31 23:59:59\" last-modified=\"2014-10-01 00:00:00\">"
+    "<defaults>"
+    "  <length unit=\"meter\"/>"
+    "  <angle unit=\"degree\"/>"
+    "  <reference-frame>"
+    "    <along-beam axis=\"z\"/>"
+    "    <pointing-up axis=\"x\"/>"
+    "    <handedness val=\"right\"/>"
+    "  </reference-frame>"
+    "</defaults>"
+    "<component type=\"moderator\"><location z=\"-10.0\"/></component>"
+    "<type name=\"moderator\" is=\"Source\"/>"
+    "<component type=\"chopper\"><location z=\"-5.0\"/></component>"
+    "<type name=\"chopper\" is=\"ChopperPos\"/>"
+    "<component type=\"sample\"><location/></component>"
+    "<type name=\"sample\" is=\"SamplePos\"/>"
+    "<component type=\"monitors\" idlist=\"monitors\"><location/></component>"
+    "<type name=\"monitors\">"
+    "  <component type=\"monitor\">"
+    "    <location z=\"-2.0\" name=\"monitor1\"/>"
+    "    <location z=\"2.0\" name=\"monitor2\"/>"
+    "  </component>"
+    "</type>"
+    "<type name=\"monitor\" is=\"monitor\"/>"
+    "<idlist idname=\"monitors\"><id start=\"11\" end=\"12\"/></idlist>"
+    "<component type=\"tubes\" idlist=\"tubes\"><location z=\"1.0\"/></component>"
+    "<type name=\"tubes\">"
+    "  <component type=\"pixel\">"
+    "    <location x=\"0.1\" name=\"pixel1\"/>"
+    "    <location x=\"0.2\" rot=\"30\" axis-x=\"0\" axis-y=\"1\" axis-z=\"0\" name=\"pixel2\"/>"
+    "  </component>"
+    "</type>"
+    "<idlist idname=\"tubes\"><id start=\"1\" end=\"2\"/></idlist>"
+    "<component type=\"panel\" idstart=\"100\" idfillbyfirst=\"y\" idstepbyrow=\"2\">"
+    "  <location z=\"3.0\" rot=\"45\" axis-x=\"0\" axis-y=\"1\" axis-z=\"0\" name=\"panel\"/>"
+    "  <parameter name=\"tilt\" type=\"string\"><value val=\"level\"/></parameter>"
+    "</component>"
+    "<type name=\"panel\" is=\"rectangular_detector\" type=\"pixel\" "
+    "  xpixels=\"3\" xstart=\"-0.01\" xstep=\"0.01\" "
+    "  ypixels=\"2\" ystart=\"-0.01\" ystep=\"0.02\">"
+    "</type>"
+    "<type name=\"pixel\" is=\"detector\">"
+    "  <cuboid id=\"pixel-shape\">"
+    "    <left-front-bottom-point y=\"-0.001\" x=\"-0.001\" z=\"0.0\"/>"
+    "    <left-front-top-point y=\"0.001\" x=\"-0.001\" z=\"0.0\"/>"
+    "    <left-back-bottom-point y=\"-0.001\" x=\"-0.001\" z=\"-0.0001\"/>"
+    "    <right-front-bottom-point y=\"-0.001\" x=\"0.001\" z=\"0.0\"/>"
+    "  </cuboid>"
+    "  <algebra val=\"pixel-shape\"/>"
+    "</type>"
+    "</instrument>";
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_ */
@@ -370,6 +370,47 @@ public:
     checkTrackIntercept(geom_obj,track,expectedResults);
   }
 
+  void testInterceptSurfaceGrazingEdgeOfBoundingBox()
+  {
+    // The bounding box of the cube is the cube itself so this track only
+    // touches the box along an edge on the way in and out
+    Object_sptr geom_obj = createUnitCube();
+    Track track(V3D(-1,0,1),V3D(1,0,-1)/std::sqrt(2.0));
+
+    TS_ASSERT(geom_obj->interceptSurface(track) > 0);
+    double inside(0.0);
+    for (Track::LType::const_iterator it = track.begin(); it!=track.end();++it)
+    {
+      inside += it->distInsideObject;
+    }
+    TS_ASSERT_DELTA(inside,std::sqrt(2.0),1e-6);
+  }
+
+  void testInterceptSurfaceUserDefinedBoundingBoxDoesNotRejectTracks()
+  {
+    // A box given in the instrument definition is not checked against the
+    // surfaces so a track that misses it may still cross the object
+    Object_sptr geom_obj = createUnitCube();
+    geom_obj->defineBoundingBox(11.0,11.0,11.0,10.0,10.0,10.0);
+    std::vector<Link> expectedResults;
+    expectedResults.push_back(Link(V3D(-0.5,0,0),V3D(0.5,0,0),1.5,*geom_obj));
+
+    Track track(V3D(-1,0,0),V3D(1,0,0));
+    checkTrackIntercept(geom_obj,track,expectedResults);
+  }
+
+  void testInterceptSurfaceNullBoundingBoxDoesNotRejectTracks()
+  {
+    Object_sptr geom_obj = createUnitCube();
+    geom_obj->setNullBoundingBox();
+    TS_ASSERT(geom_obj->getBoundingBox().isNull());
+    std::vector<Link> expectedResults;
+    expectedResults.push_back(Link(V3D(-0.5,0,0),V3D(0.5,0,0),1.5,*geom_obj));
+
+    Track track(V3D(-1,0,0),V3D(1,0,0));
+    checkTrackIntercept(geom_obj,track,expectedResults);
+  }
+
   void checkTrackIntercept(Track& track, const std::vector<Link>& expectedResults)
   {
     int index = 0;
@@ -0,0 +1,84 @@
+#ifndef MANTID_GEOMETRY_RECTANGLEINTERSECTIONTEST_H_
+#define MANTID_GEOMETRY_RECTANGLEINTERSECTIONTEST_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidGeometry/Math/RectangleIntersection.h"
+#include "MantidGeometry/Math/LaszloIntersection.h"
+#include <cxxtest/TestSuite.h>
+
+using Mantid::Kernel::V2D;
+using Mantid::Geometry::ConvexPolygon;
+using Mantid::Geometry::OverlapRegion;
+using Mantid::Geometry::Quadrilateral;
+using Mantid::Geometry::intersectionWithRectangle;
+
+class RectangleIntersectionTest : public CxxTest::TestSuite
+{
+public:
+
+  void test_Partially_Overlapping_Squares()
+  {
+    Quadrilateral square(0.0, 2.0, 0.0, 2.0);
+    OverlapRegion overlap;
+    TS_ASSERT(intersectionWithRectangle(square, 1.0, 3.0, 1.0, 3.0, overlap));
+    TS_ASSERT_DELTA(overlap.area, 1.0, 1e-12);
+    TS_ASSERT_DELTA(overlap.smallestX, 1.0, 1e-12);
+    TS_ASSERT_DELTA(overlap.largestX, 2.0, 1e-12);
+  }
+
+  void test_Quadrilateral_Inside_Rectangle_Gives_Its_Own_Area()
+  {
+    Quadrilateral quad(V2D(1.0, 1.0), V2D(2.0, 1.5), V2D(2.5, 3.0), V2D(0.5, 2.0));
+    OverlapRegion overlap;
+    TS_ASSERT(intersectionWithRectangle(quad, 0.0, 10.0, 0.0, 10.0, overlap));
+    TS_ASSERT_DELTA(overlap.area, quad.area(), 1e-12);
+    TS_ASSERT_DELTA(overlap.smallestX, 0.5, 1e-12);
+    TS_ASSERT_DELTA(overlap.largestX, 2.5, 1e-12);
+  }
+
+  void test_Rectangle_Inside_Quadrilateral_Gives_Rectangle_Area()
+  {
+    Quadrilateral quad(V2D(-5.0, -4.0), V2D(6.0, -5.0), V2D(5.0, 7.0), V2D(-4.0, 6.0));
+    OverlapRegion overlap;
+    TS_ASSERT(intersectionWithRectangle(quad, -1.0, 1.0, -0.5, 0.5, overlap));
+    TS_ASSERT_DELTA(overlap.area, 2.0, 1e-12);
+    TS_ASSERT_DELTA(overlap.smallestX, -1.0, 1e-12);
+    TS_ASSERT_DELTA(overlap.largestX, 1.0, 1e-12);
+  }
+
+  void test_Separate_Or_Touching_Shapes_Do_Not_Overlap()
+  {
+    Quadrilateral square(0.0, 1.0, 0.0, 1.0);
+    OverlapRegion overlap;
+    TS_ASSERT(!intersectionWithRectangle(square, 2.0, 3.0, 0.0, 1.0, overlap));
+    TS_ASSERT(!intersectionWithRectangle(square, 1.0, 2.0, 0.0, 1.0, overlap));
+    TS_ASSERT(!intersectionWithRectangle(square, 0.0, 1.0, -2.0, -1.0, overlap));
+  }
+
+  void test_Skewed_Quadrilateral_Matches_Laszlo_Intersection()
+  {
+    Quadrilateral quad(V2D(0.1, 0.3), V2D(1.9, 0.1), V2D(2.3, 1.7), V2D(0.2, 2.2));
+    const double xmin(1.0), xmax(2.0), ymin(1.5), ymax(3.0);
+    OverlapRegion overlap;
+    TS_ASSERT(intersectionWithRectangle(quad, xmin, xmax, ymin, ymax, overlap));
+
+    ConvexPolygon expected =
+        intersectionByLaszlo(Quadrilateral(xmin, xmax, ymin, ymax), quad);
+    TS_ASSERT_DELTA(overlap.area, expected.area(), 1e-12);
+    TS_ASSERT_DELTA(overlap.smallestX, expected.smallestX(), 1e-12);
+    TS_ASSERT_DELTA(overlap.largestX, expected.largestX(), 1e-12);
+  }
+
+  void test_Twisted_Quadrilateral_Does_Not_Overrun_The_Clip_Buffers()
+  {
+    // The sides cross, so each clip can add more than one vertex
+    Quadrilateral twisted(V2D(0.0, 0.0), V2D(2.0, 2.0), V2D(2.0, 0.0), V2D(0.0, 2.0));
+    OverlapRegion overlap;
+    TS_ASSERT_THROWS_NOTHING(intersectionWithRectangle(twisted, 0.5, 1.5, 0.25, 1.75, overlap));
+  }
+
+};
+
+#endif /* MANTID_GEOMETRY_RECTANGLEINTERSECTIONTEST_H_ */
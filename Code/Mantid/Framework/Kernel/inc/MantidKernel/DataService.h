@@ -10,6 +10,12 @@
 #endif
 #include <Poco/NotificationCenter.h>
 #include <Poco/Notification.h>
+#include <Poco/NotificationQueue.h>
+#include <Poco/Mutex.h>
+#include <Poco/RWLock.h>
+#include <Poco/Runnable.h>
+#include <Poco/Thread.h>
+#include <Poco/Timestamp.h>
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/ConfigService.h"
@@ -27,6 +33,12 @@ namespace Kernel {
    through writing scripts or directly
     through the API. It is implemented as a singleton class.
 
+    Lookups take a shared read lock so that threads retrieving objects do not
+    wait for each other. Notifications are normally delivered to the observers
+    by the thread that changed the service. In the Asynchronous notification
+    mode they are queued and delivered in order by a thread of the service, so
+    that producer threads never wait for slow observers such as a GUI.
+
     Copyright &copy; 2008-2013 ISIS Rutherford Appleton Laboratory, NScD Oak
    Ridge National Laboratory & European Spallation Source
 
@@ -192,7 +204,7 @@ public:
     checkForNullPointer(Tobject);
 
     // Make DataService access thread-safe
-    m_mutex.lock();
+    m_mutex.writeLock();
 
     // At the moment, you can't overwrite an object (i.e. pass in a name
     // that's already in the map with a pointer to a different object).
@@ -208,7 +220,7 @@ public:
       g_log.debug() << "Add Data Object " << name << " successful" << std::endl;
       m_mutex.unlock();
 
-      notificationCenter.postNotification(new AddNotification(name, Tobject));
+      postNotification(new AddNotification(name, Tobject));
     }
     return;
   }
@@ -226,7 +238,7 @@ public:
     checkForNullPointer(Tobject);
 
     // Make DataService access thread-safe
-    m_mutex.lock();
+    m_mutex.writeLock();
 
     // find if the Tobject already exists
     std::string foundName;
@@ -234,17 +246,18 @@ public:
     if (it != datamap.end()) {
       g_log.debug("Data Object '" + foundName +
                   "' replaced in data service.\n");
+      // The iterator must not be used once the lock is released
+      boost::shared_ptr<T> oldObject = it->second;
       m_mutex.unlock();
 
-      notificationCenter.postNotification(
-          new BeforeReplaceNotification(name, it->second, Tobject));
+      postNotification(
+          new BeforeReplaceNotification(name, oldObject, Tobject));
 
-      m_mutex.lock();
+      m_mutex.writeLock();
       datamap[foundName] = Tobject;
       m_mutex.unlock();
 
-      notificationCenter.postNotification(
-          new AfterReplaceNotification(name, Tobject));
+      postNotification(new AfterReplaceNotification(name, Tobject));
     } else {
       // Avoid double-locking
       m_mutex.unlock();
@@ -258,7 +271,7 @@ public:
    * @param name :: name of the object */
   void remove(const std::string &name) {
     // Make DataService access thread-safe
-    m_mutex.lock();
+    m_mutex.writeLock();
 
     std::string foundName;
     svc_it it = findNameWithCaseSearch(name, foundName);
@@ -277,16 +290,15 @@ public:
     // Do NOT use "it" iterator after this point. Other threads may modify the
     // map
     m_mutex.unlock();
-    notificationCenter.postNotification(
-        new PreDeleteNotification(foundName, data));
-    m_mutex.lock();
+    postNotification(new PreDeleteNotification(foundName, data));
+    m_mutex.writeLock();
 
     data.reset(); // DataService now has no references to the object
     g_log.information("Data Object '" + foundName +
                       "' deleted from data service.");
 
     m_mutex.unlock();
-    notificationCenter.postNotification(new PostDeleteNotification(foundName));
+    postNotification(new PostDeleteNotification(foundName));
     return;
   }
 
@@ -299,7 +311,7 @@ public:
     checkForEmptyName(newName);
 
     // Make DataService access thread-safe
-    m_mutex.lock();
+    m_mutex.writeLock();
 
     std::string foundName;
     svc_it it = findNameWithCaseSearch(oldName, foundName);
@@ -315,9 +327,8 @@ public:
 
     // if there is another object which has newName delete it
     it = datamap.find(newName);
-    if (it != datamap.end()) {
-      notificationCenter.postNotification(
-          new AfterReplaceNotification(newName, object));
+    const bool replaced = (it != datamap.end());
+    if (replaced) {
       datamap.erase(it);
     }
 
@@ -333,8 +344,11 @@ public:
                       "'");
 
     m_mutex.unlock();
-    notificationCenter.postNotification(
-        new RenameNotification(oldName, newName));
+    // Observers are not called with the lock held as they may use the service
+    if (replaced) {
+      postNotification(new AfterReplaceNotification(newName, object));
+    }
+    postNotification(new RenameNotification(oldName, newName));
 
     return;
   }
@@ -343,11 +357,11 @@ public:
   /// Empty the service
   void clear() {
     // Make DataService access thread-safe
-    m_mutex.lock();
+    m_mutex.writeLock();
 
     datamap.clear();
     m_mutex.unlock();
-    notificationCenter.postNotification(new ClearNotification());
+    postNotification(new ClearNotification());
     g_log.debug() << typeid(this).name() << " cleared.\n";
   }
 
@@ -356,7 +370,7 @@ public:
    * @param name :: name of the object */
   boost::shared_ptr<T> retrieve(const std::string &name) const {
     // Make DataService access thread-safe
-    Poco::Mutex::ScopedLock _lock(m_mutex);
+    Poco::ScopedReadRWLock _lock(m_mutex);
 
     std::string foundName;
     svc_it it = findNameWithCaseSearch(name, foundName);
@@ -370,7 +384,7 @@ public:
   /// Check to see if a data object exists in the store
   bool doesExist(const std::string &name) const {
     // Make DataService access thread-safe
-    Poco::Mutex::ScopedLock _lock(m_mutex);
+    Poco::ScopedReadRWLock _lock(m_mutex);
 
     std::string foundName;
     svc_it it = findNameWithCaseSearch(name, foundName);
@@ -381,7 +395,7 @@ public:
 
   /// Return the number of objects stored by the data service
   size_t size() const {
-    Poco::Mutex::ScopedLock _lock(m_mutex);
+    Poco::ScopedReadRWLock _lock(m_mutex);
 
     if (showingHiddenObjects()) {
       return datamap.size();
@@ -400,7 +414,7 @@ public:
     if (showingHiddenObjects())
       return getObjectNamesInclHidden();
 
-    Poco::Mutex::ScopedLock _lock(m_mutex);
+    Poco::ScopedReadRWLock _lock(m_mutex);
 
     std::set<std::string> names;
     for (svc_constit it = datamap.begin(); it != datamap.end(); ++it) {
@@ -413,7 +427,7 @@ public:
 
   /// Get the names of the data objects stored by the service
   std::set<std::string> getObjectNamesInclHidden() const {
-    Poco::Mutex::ScopedLock _lock(m_mutex);
+    Poco::ScopedReadRWLock _lock(m_mutex);
 
     std::set<std::string> names;
     for (svc_constit it = datamap.begin(); it != datamap.end(); ++it) {
@@ -424,7 +438,7 @@ public:
 
   /// Get a vector of the pointers to the data objects stored by the service
   std::vector<boost::shared_ptr<T>> getObjects() const {
-    Poco::Mutex::ScopedLock _lock(m_mutex);
+    Poco::ScopedReadRWLock _lock(m_mutex);
 
     const bool showingHidden = showingHiddenObjects();
     std::vector<boost::shared_ptr<T>> objects;
@@ -454,6 +468,81 @@ public:
     }
   }
 
+  /// How notifications are delivered to the observers of notificationCenter
+  enum NotificationMode {
+    /// By the thread that changed the service, before the change returns
+    Synchronous,
+    /// In order by a thread of the service, the change does not wait for them
+    Asynchronous
+  };
+
+  /// Counters of the time taken to deliver notifications to the observers
+  struct NotificationStatistics {
+    NotificationStatistics() : count(0), totalSeconds(0.0), maxSeconds(0.0) {}
+    /// The number of notifications delivered
+    size_t count;
+    /// The total time from posting each notification to its observers
+    /// returning, in seconds
+    double totalSeconds;
+    /// The longest time from posting a notification to its observers
+    /// returning, in seconds
+    double maxSeconds;
+  };
+
+  /** Set how notifications are delivered. Changing to Synchronous waits for
+   * the queued notifications to be delivered.
+   * @param mode :: The new mode
+   */
+  void setNotificationMode(const NotificationMode mode) {
+    NotificationDispatcher *finished = NULL;
+    {
+      Poco::FastMutex::ScopedLock lock(m_dispatchMutex);
+      if (mode == Asynchronous && !m_dispatcher) {
+        m_dispatcher = new NotificationDispatcher(*this);
+      } else if (mode == Synchronous) {
+        std::swap(finished, m_dispatcher);
+      }
+    }
+    // The observers may change the service while the queue is emptied so the
+    // lock must not be held
+    delete finished;
+  }
+
+  /// @returns How notifications are delivered
+  NotificationMode notificationMode() const {
+    Poco::FastMutex::ScopedLock lock(m_dispatchMutex);
+    return m_dispatcher ? Asynchronous : Synchronous;
+  }
+
+  /// @returns The notification counters since the last reset
+  NotificationStatistics notificationStatistics() const {
+    Poco::FastMutex::ScopedLock lock(m_statisticsMutex);
+    return m_statistics;
+  }
+
+  /// Set the notification counters to zero
+  void resetNotificationStatistics() {
+    Poco::FastMutex::ScopedLock lock(m_statisticsMutex);
+    m_statistics = NotificationStatistics();
+  }
+
+  /** Send a notification to the observers of notificationCenter in the
+   * current notification mode.
+   * @param notification :: The notification, which is owned by this method
+   */
+  void postNotification(Poco::Notification *notification) {
+    Poco::Notification::Ptr owner(notification);
+    const Poco::Timestamp posted;
+    {
+      Poco::FastMutex::ScopedLock lock(m_dispatchMutex);
+      if (m_dispatcher) {
+        m_dispatcher->enqueue(owner, posted);
+        return;
+      }
+    }
+    deliver(owner, posted);
+  }
+
   /// Sends notifications to observers. Observers can subscribe to
   /// notificationCenter
   /// using Poco::NotificationCenter::addObserver(...)
@@ -462,8 +551,10 @@ public:
 
 protected:
   /// Protected constructor (singleton)
-  DataService(const std::string &name) : svcName(name), g_log(svcName) {}
-  virtual ~DataService() {}
+  DataService(const std::string &name)
+      : svcName(name), g_log(svcName), m_dispatcher(NULL) {}
+  /// Delivers any queued notifications before the service is destroyed
+  virtual ~DataService() { setNotificationMode(Synchronous); }
 
 private:
   /// Private, unimplemented copy constructor
@@ -471,6 +562,70 @@ private:
   /// Private, unimplemented copy assignment operator
   DataService &operator=(const DataService &);
 
+  /// A notification waiting in the queue of the NotificationDispatcher
+  class QueuedNotification : public Poco::Notification {
+  public:
+    QueuedNotification(const Poco::Notification::Ptr &notification,
+                       const Poco::Timestamp &posted)
+        : m_notification(notification), m_posted(posted) {}
+    /// The notification for the observers
+    Poco::Notification::Ptr m_notification;
+    /// When the notification was posted
+    Poco::Timestamp m_posted;
+  };
+
+  /// Delivers queued notifications in order from its own thread
+  class NotificationDispatcher : public Poco::Runnable {
+  public:
+    explicit NotificationDispatcher(DataService &service)
+        : m_service(service), m_queue(), m_thread() {
+      m_thread.start(*this);
+    }
+    /// Delivers the notifications already queued and stops the thread
+    ~NotificationDispatcher() {
+      m_queue.enqueueNotification(new Poco::Notification);
+      m_thread.join();
+    }
+    /// Queue a notification for delivery
+    void enqueue(const Poco::Notification::Ptr &notification,
+                 const Poco::Timestamp &posted) {
+      m_queue.enqueueNotification(new QueuedNotification(notification, posted));
+    }
+    /// Deliver notifications until one not queued by enqueue() is met
+    void run() {
+      for (;;) {
+        Poco::AutoPtr<Poco::Notification> next(
+            m_queue.waitDequeueNotification());
+        QueuedNotification *queued =
+            dynamic_cast<QueuedNotification *>(next.get());
+        if (!queued)
+          break;
+        m_service.deliver(queued->m_notification, queued->m_posted);
+      }
+    }
+
+  private:
+    DataService &m_service;
+    Poco::NotificationQueue m_queue;
+    Poco::Thread m_thread;
+  };
+
+  /** Post a notification to the observers and count the time since it was
+   * posted.
+   * @param notification :: The notification
+   * @param posted :: When the notification was posted
+   */
+  void deliver(const Poco::Notification::Ptr &notification,
+               const Poco::Timestamp &posted) {
+    notificationCenter.postNotification(notification);
+    const double seconds = static_cast<double>(posted.elapsed()) * 1e-6;
+    Poco::FastMutex::ScopedLock lock(m_statisticsMutex);
+    ++m_statistics.count;
+    m_statistics.totalSeconds += seconds;
+    if (seconds > m_statistics.maxSeconds)
+      m_statistics.maxSeconds = seconds;
+  }
+
   void checkForEmptyName(const std::string &name) {
     if (name.empty()) {
       const std::string error = "Add Data Object with empty name";
@@ -540,10 +695,18 @@ private:
   const std::string svcName;
   /// Map of objects in the data service
   svcmap datamap;
-  /// Recursive mutex to avoid simultaneous access or notifications
-  mutable Poco::Mutex m_mutex;
+  /// Lock allowing many readers of the map or a single writer
+  mutable Poco::RWLock m_mutex;
   /// Logger for this DataService
   Logger g_log;
+  /// Delivers notifications in the Asynchronous mode, NULL otherwise
+  NotificationDispatcher *m_dispatcher;
+  /// Guards m_dispatcher
+  mutable Poco::FastMutex m_dispatchMutex;
+  /// The notification counters
+  NotificationStatistics m_statistics;
+  /// Guards m_statistics
+  mutable Poco::FastMutex m_statisticsMutex;
 }; // End Class Data service
 
 } // Namespace Kernel
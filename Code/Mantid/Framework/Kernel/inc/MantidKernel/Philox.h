@@ -0,0 +1,114 @@
+#ifndef MANTID_KERNEL_PHILOX_H_
+#define MANTID_KERNEL_PHILOX_H_
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "MantidKernel/PseudoRandomNumberGenerator.h"
+#include "MantidKernel/ClassMacros.h"
+#include <stdint.h>
+
+namespace Mantid {
+namespace Kernel {
+/**
+  This implements the Philox4x32-10 counter-based pseudo-random number
+  generator as a specialization of the PseudoRandomNumberGenerator
+  interface.
+
+  A counter-based generator has no internal state beyond a key and a counter:
+  the n-th number of a sequence is a pure function of the seed and n. The
+  counter is split into a stream index and a position within that stream, so
+  that each independent piece of work, e.g. one point of a Monte Carlo
+  simulation, can draw from its own stream. The numbers a piece of work
+  receives then do not depend on which thread carries it out or in which
+  order the work is done.
+
+  Further documentation can be found in: J. K. Salmon et al., "Parallel random
+  numbers: as easy as 1, 2, 3", Proceedings of the International Conference
+  for High Performance Computing, Networking, Storage and Analysis (2011).
+
+  Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>.
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL Philox : public PseudoRandomNumberGenerator {
+public:
+  /// Construct the generator with an initial seed. It can be reseeded using
+  /// setSeed.
+  explicit Philox(const size_t seedValue);
+  /// Construct the generator with an initial seed and range.
+  Philox(const size_t seedValue, const double start, const double end);
+  /// Set the random number seed
+  virtual void setSeed(const size_t seedValue);
+  /// Sets the range of the subsequent calls to next
+  virtual void setRange(const double start, const double end);
+  /// Generate the next random number in the sequence within the given range,
+  /// (default=[0.0,1.0)).
+  virtual double nextValue();
+  /// Resets the generator to the start of the current stream
+  virtual void restart();
+  /// Saves the current state of the generator
+  virtual void save();
+  /// Restores the generator to the last saved point, or the beginning if
+  /// nothing has been saved
+  virtual void restore();
+
+  /// Move the generator to the start of the given independent stream
+  void setStream(const uint64_t stream);
+  /// Return the index of the current stream
+  uint64_t stream() const { return m_stream; }
+  /// Fill an array with the next values of the sequence
+  void generate(double *values, const size_t nvalues);
+
+  /// Apply the ten rounds of the Philox4x32 bijection to a counter
+  static void encrypt(const uint32_t key[2], uint32_t counter[4]);
+
+private:
+  DISABLE_DEFAULT_CONSTRUCT(Philox);
+  DISABLE_COPY_AND_ASSIGN(Philox);
+
+  /// Generate the block of output for the current position
+  void generateBlock();
+
+  /// The key, derived from the seed
+  uint32_t m_key[2];
+  /// The index of the current stream
+  uint64_t m_stream;
+  /// The index of the next block within the stream
+  uint64_t m_blockIndex;
+  /// The most recently generated block of output
+  uint32_t m_block[4];
+  /// The number of words of m_block that have been used
+  unsigned int m_wordsUsed;
+  /// The lower end of the output range
+  double m_start;
+  /// The width of the output range
+  double m_width;
+  /// The block index saved by save()
+  uint64_t m_savedBlockIndex;
+  /// The number of words used saved by save()
+  unsigned int m_savedWordsUsed;
+  /// Whether a position has been saved in the current stream
+  bool m_haveSaved;
+};
+}
+}
+
+#endif /* MANTID_KERNEL_PHILOX_H_ */
@@ -0,0 +1,227 @@
+#ifndef MANTID_KERNEL_PROFILER_H_
+#define MANTID_KERNEL_PROFILER_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#include <Poco/NObserver.h>
+#include <Poco/Thread.h>
+#include <Poco/Timestamp.h>
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+/**
+Records timed spans of execution (algorithms, child algorithms, thread pool
+tasks, file I/O and any code marked with a ProfilerScope) and exports them
+either as a per-name summary or as a Chrome trace-event JSON file, which can
+be opened in chrome://tracing.
+
+Recording is switched on by setting "profiler.enabled = 1" in the
+ConfigService. When it is off a ProfilerScope costs a single flag check. If
+"profiler.tracefile" is set the trace is written to that file when recording
+is switched off or the framework shuts down. At most "profiler.maxevents"
+spans are kept; once there are more the oldest are overwritten.
+
+Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>.
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ProfilerImpl {
+public:
+  /// A completed span
+  struct Event {
+    std::string name;     ///< What was timed, e.g. the algorithm name
+    std::string category; ///< The kind of span, e.g. "algorithm"
+    Poco::Timestamp::TimeVal start; ///< Start in microseconds since epoch
+    Poco::Timestamp::TimeDiff duration; ///< Duration in microseconds
+    int thread;            ///< Small integer identifying the thread
+    /// Resident memory of the process when the span ended in kiB, 0 if unset
+    std::size_t residentMemory;
+  };
+
+  /// Aggregated spans with the same name
+  struct Summary {
+    std::size_t count;     ///< The number of spans
+    double totalSeconds;   ///< The total time spent in them
+    double maxSeconds;     ///< The longest of them
+    /// Largest resident memory sampled at the end of them in kiB
+    std::size_t maxResidentMemory;
+  };
+
+  /// Returns true if spans are being recorded
+  inline bool isEnabled() const { return m_enabled; }
+  /// Switch recording on or off
+  void setEnabled(const bool enabled);
+
+  /// Record a span that started at the given time and ends now
+  void record(const std::string &name, const char *category,
+              const Poco::Timestamp::TimeVal start, const bool sampleMemory);
+
+  /// Returns a copy of the recorded spans, oldest first
+  std::vector<Event> events() const;
+  /// The number of spans that have been overwritten since the last clear
+  std::size_t droppedEvents() const;
+  /// The most spans that are kept
+  std::size_t maxEvents() const;
+  /// Set the most spans that are kept
+  void setMaxEvents(const std::size_t maxEvents);
+  /// Returns the recorded spans aggregated by name
+  std::map<std::string, Summary> summary() const;
+  /// Returns a table of the summary sorted by total time
+  std::string summaryStr() const;
+  /// Largest resident memory sampled at the end of a span since the last
+  /// clear, in kiB
+  std::size_t maxResidentMemory() const;
+  /// Write the spans in Chrome's trace-event JSON format
+  void writeChromeTrace(std::ostream &os) const;
+  /// Write the spans in Chrome's trace-event JSON format to a file
+  void writeChromeTrace(const std::string &filename) const;
+  /// Discard the recorded spans
+  void clear();
+
+private:
+  friend struct Mantid::Kernel::CreateUsingNew<ProfilerImpl>;
+
+  /// Private Constructor
+  ProfilerImpl();
+  /// Private copy constructor - NO COPY ALLOWED
+  ProfilerImpl(const ProfilerImpl &);
+  /// Private assignment operator - NO ASSIGNMENT ALLOWED
+  ProfilerImpl &operator=(const ProfilerImpl &);
+  /// Private Destructor
+  ~ProfilerImpl();
+
+  /// Follow changes to the profiler keys of the ConfigService
+  void handleConfigChange(
+      Mantid::Kernel::ConfigValChangeNotification_ptr notification);
+  /// Write the trace to the configured file, if any
+  void writeConfiguredTrace() const;
+
+  /// Checked on every span so is deliberately not behind the mutex
+  volatile bool m_enabled;
+  /// The file the trace is written to when recording stops
+  std::string m_traceFile;
+  /// The recorded spans. Once full this is a ring buffer and m_nextEvent is
+  /// the oldest span, which is overwritten next.
+  std::vector<Event> m_events;
+  /// The most spans kept in m_events
+  std::size_t m_maxEvents;
+  /// The slot of m_events that the next span is written to once it is full
+  std::size_t m_nextEvent;
+  /// The number of spans overwritten
+  std::size_t m_droppedEvents;
+  /// Maps thread ids to the small numbers used in the trace
+  std::map<Poco::Thread::TID, int> m_threads;
+  /// Largest resident memory sampled
+  std::size_t m_maxResidentMemory;
+  /// Guards the recorded data
+  mutable Mutex m_mutex;
+  /// Observer of the ConfigService
+  Poco::NObserver<ProfilerImpl, ConfigValChangeNotification> m_configObserver;
+};
+
+/// Forward declaration of a specialisation of SingletonHolder for
+/// ProfilerImpl (needed for dllexport/dllimport) and a typedef for it.
+#if defined(__APPLE__) && defined(__INTEL_COMPILER)
+inline
+#endif
+    template class MANTID_KERNEL_DLL
+        Mantid::Kernel::SingletonHolder<ProfilerImpl>;
+typedef MANTID_KERNEL_DLL Mantid::Kernel::SingletonHolder<ProfilerImpl>
+    Profiler;
+
+/**
+Records a span covering the lifetime of the object with the Profiler. Nothing
+is recorded, and no clock is read, if the Profiler is not enabled when the
+object is created.
+
+A span around a PARALLEL_FOR loop is made by placing a scope around the whole
+loop, not inside its body, e.g.
+@code
+{
+  PROFILER_SCOPE("MyAlgorithm::exec loop");
+  PARALLEL_FOR1(ws)
+  for (...) {...}
+}
+@endcode
+*/
+class MANTID_KERNEL_DLL ProfilerScope {
+public:
+  /// Start a span with a name known at compile time
+  explicit ProfilerScope(const char *name, const char *category = "function")
+      : m_name(), m_category(category), m_start(0), m_sampleMemory(false),
+        m_active(Profiler::Instance().isEnabled()) {
+    if (m_active)
+      start(name);
+  }
+  /// Start a span with a name built at run time
+  ProfilerScope(const std::string &name, const char *category)
+      : m_name(), m_category(category), m_start(0), m_sampleMemory(false),
+        m_active(Profiler::Instance().isEnabled()) {
+    if (m_active)
+      start(name);
+  }
+  /// Ends the span
+  ~ProfilerScope() {
+    if (m_active)
+      stop();
+  }
+  /// Returns true if the span will be recorded
+  bool isActive() const { return m_active; }
+  /// Change the recorded name
+  void setName(const std::string &name) { m_name = name; }
+  /// Sample the resident memory of the process when the span ends. This is
+  /// the memory in use at that moment, not the peak during the span.
+  void sampleMemory() { m_sampleMemory = true; }
+
+private:
+  /// Disable copying
+  ProfilerScope(const ProfilerScope &);
+  /// Disable assignment
+  ProfilerScope &operator=(const ProfilerScope &);
+
+  void start(const std::string &name);
+  void stop();
+
+  std::string m_name;
+  const char *m_category;
+  Poco::Timestamp::TimeVal m_start;
+  bool m_sampleMemory;
+  const bool m_active;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+/// Record a span from here to the end of the enclosing scope
+#define PROFILER_SCOPE(name)                                                   \
+  Mantid::Kernel::ProfilerScope profilerScope_(name)
+
+#endif // MANTID_KERNEL_PROFILER_H_
@@ -0,0 +1,202 @@
+#ifndef MANTID_KERNEL_SIMD_H_
+#define MANTID_KERNEL_SIMD_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidKernel/MultiThreaded.h"
+#include <cstddef>
+#include <vector>
+
+/** PRAGMA_SIMD marks the following loop as free of loop-carried dependencies
+ * so that the compiler vectorizes it. OpenMP 4 "omp simd" is used where it is
+ * available, otherwise the equivalent compiler-specific hint.
+ */
+#if defined(_OPENMP) && _OPENMP >= 201307
+#define PRAGMA_SIMD PRAGMA(omp simd)
+#elif defined(__INTEL_COMPILER)
+#define PRAGMA_SIMD PRAGMA(simd)
+#elif defined(__GNUC__) && !defined(__clang__) &&                             \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define PRAGMA_SIMD PRAGMA(GCC ivdep)
+#elif defined(__clang__)
+#define PRAGMA_SIMD PRAGMA(clang loop vectorize(enable))
+#elif defined(_MSC_VER) && _MSC_VER >= 1700
+#define PRAGMA_SIMD PRAGMA(loop(ivdep))
+#else
+#define PRAGMA_SIMD
+#endif
+
+namespace Mantid {
+namespace Kernel {
+/**
+Runs element-wise kernels over the Y and E (and X) arrays of a spectrum in a
+form that the compiler vectorizes.
+
+A kernel is a small function object whose operator() does the arithmetic for
+one bin. It is inlined into a loop marked with PRAGMA_SIMD, so each operation
+states its per-bin math once and gets vector instructions on every platform
+with a supporting compiler. The kernels for the arithmetic algorithms are
+defined next to the algorithms.
+
+The loops read all of an element's inputs before writing its outputs, so the
+output arrays may be the same as the input arrays, but must not otherwise
+overlap them.
+
+Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>.
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+namespace SIMD {
+
+/**
+ * out[i] = op(in[i])
+ * @param op :: Kernel with double operator()(double)
+ * @param in :: The input array
+ * @param out :: The output array, which may be the input
+ */
+template <typename Op>
+inline void transform(const std::vector<double> &in, std::vector<double> &out,
+                      const Op &op) {
+  const ptrdiff_t n = static_cast<ptrdiff_t>(in.size());
+  const double *x = in.empty() ? NULL : &in[0];
+  double *y = out.empty() ? NULL : &out[0];
+  PRAGMA_SIMD
+  for (ptrdiff_t i = 0; i < n; ++i) {
+    y[i] = op(x[i]);
+  }
+}
+
+/**
+ * Combines two spectra bin by bin.
+ * @param op :: Kernel with
+ * void operator()(double lhsY, double lhsE, double rhsY, double rhsE,
+ *                 double &YOut, double &EOut)
+ * @param lhsY :: The left-hand data
+ * @param lhsE :: The left-hand errors
+ * @param rhsY :: The right-hand data
+ * @param rhsE :: The right-hand errors
+ * @param YOut :: The output data, which may be either input data
+ * @param EOut :: The output errors, which may be either input errors
+ */
+template <typename Op>
+inline void binary(const Op &op, const std::vector<double> &lhsY,
+                   const std::vector<double> &lhsE,
+                   const std::vector<double> &rhsY,
+                   const std::vector<double> &rhsE, std::vector<double> &YOut,
+                   std::vector<double> &EOut) {
+  const ptrdiff_t n = static_cast<ptrdiff_t>(lhsY.size());
+  if (n == 0)
+    return;
+  const double *ly = &lhsY[0];
+  const double *le = &lhsE[0];
+  const double *ry = &rhsY[0];
+  const double *re = &rhsE[0];
+  double *y = &YOut[0];
+  double *e = &EOut[0];
+  PRAGMA_SIMD
+  for (ptrdiff_t i = 0; i < n; ++i) {
+    double yOut, eOut;
+    op(ly[i], le[i], ry[i], re[i], yOut, eOut);
+    y[i] = yOut;
+    e[i] = eOut;
+  }
+}
+
+/**
+ * Combines a spectrum with a single value.
+ * @param op :: Kernel as for the spectrum-spectrum form
+ * @param lhsY :: The left-hand data
+ * @param lhsE :: The left-hand errors
+ * @param rhsY :: The right-hand value
+ * @param rhsE :: The right-hand error
+ * @param YOut :: The output data, which may be the input data
+ * @param EOut :: The output errors, which may be the input errors
+ */
+template <typename Op>
+inline void binary(const Op &op, const std::vector<double> &lhsY,
+                   const std::vector<double> &lhsE, const double rhsY,
+                   const double rhsE, std::vector<double> &YOut,
+                   std::vector<double> &EOut) {
+  const ptrdiff_t n = static_cast<ptrdiff_t>(lhsY.size());
+  if (n == 0)
+    return;
+  const double *ly = &lhsY[0];
+  const double *le = &lhsE[0];
+  double *y = &YOut[0];
+  double *e = &EOut[0];
+  PRAGMA_SIMD
+  for (ptrdiff_t i = 0; i < n; ++i) {
+    double yOut, eOut;
+    op(ly[i], le[i], rhsY, rhsE, yOut, eOut);
+    y[i] = yOut;
+    e[i] = eOut;
+  }
+}
+
+/**
+ * Applies a kernel that may depend on X to each bin of a spectrum. For
+ * histograms the kernel is given the bin centre.
+ * @param op :: Kernel with
+ * void operator()(double X, double YIn, double EIn, double &YOut,
+ *                 double &EOut)
+ * @param X :: The X values, one longer than Y for a histogram
+ * @param YIn :: The input data
+ * @param EIn :: The input errors
+ * @param YOut :: The output data, which may be the input data
+ * @param EOut :: The output errors, which may be the input errors
+ */
+template <typename Op>
+inline void unary(const Op &op, const std::vector<double> &X,
+                  const std::vector<double> &YIn,
+                  const std::vector<double> &EIn, std::vector<double> &YOut,
+                  std::vector<double> &EOut) {
+  const ptrdiff_t n = static_cast<ptrdiff_t>(YIn.size());
+  if (n == 0)
+    return;
+  const double *x = &X[0];
+  const double *yIn = &YIn[0];
+  const double *eIn = &EIn[0];
+  double *y = &YOut[0];
+  double *e = &EOut[0];
+  if (X.size() == YIn.size() + 1) {
+    PRAGMA_SIMD
+    for (ptrdiff_t i = 0; i < n; ++i) {
+      double yOut, eOut;
+      op(0.5 * (x[i] + x[i + 1]), yIn[i], eIn[i], yOut, eOut);
+      y[i] = yOut;
+      e[i] = eOut;
+    }
+  } else {
+    PRAGMA_SIMD
+    for (ptrdiff_t i = 0; i < n; ++i) {
+      double yOut, eOut;
+      op(x[i], yIn[i], eIn[i], yOut, eOut);
+      y[i] = yOut;
+      e[i] = eOut;
+    }
+  }
+}
+
+} // namespace SIMD
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_SIMD_H_ */
@@ -188,6 +188,21 @@ public:
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
+  /** Whether, as initialized, singleToTOF(x) is factor * x^power. A conversion
+   * between two such units can then be done with a single power law.
+   * @param factor :: Set to the factor of the power law
+   * @param power :: Set to the power
+   * @return true if the conversion is a power law
+   */
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+
+  /** Whether, as initialized, singleFromTOF(tof) is factor * tof^power.
+   * @param factor :: Set to the factor of the power law
+   * @param power :: Set to the power
+   * @return true if the conversion is a power law
+   */
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
+
   /// some units can be converted from TOF only in the range of TOF ;
   /// This function returns minimal TOF value still reversibly convertible into
   /// the unit.
@@ -308,6 +323,8 @@ public:
   virtual void init();
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual Unit *clone() const;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   virtual double conversionTOFMin() const;
@@ -325,6 +342,8 @@ public:
 
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual void init();
   virtual Unit *clone() const;
 
@@ -354,6 +373,8 @@ public:
 
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual void init();
   virtual Unit *clone() const;
 
@@ -405,6 +426,8 @@ public:
 
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual void init();
   virtual Unit *clone() const;
   virtual double conversionTOFMin() const;
@@ -430,6 +453,8 @@ public:
 
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual void init();
   virtual Unit *clone() const;
   virtual double conversionTOFMin() const;
@@ -454,6 +479,8 @@ public:
 
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual void init();
   virtual Unit *clone() const;
   virtual double conversionTOFMin() const;
@@ -554,6 +581,8 @@ public:
 
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual void init();
   virtual Unit *clone() const;
   virtual double conversionTOFMin() const;
@@ -575,6 +604,8 @@ public:
 
   virtual double singleToTOF(const double x) const;
   virtual double singleFromTOF(const double tof) const;
+  virtual bool powerLawToTOF(double &factor, double &power) const;
+  virtual bool powerLawFromTOF(double &factor, double &power) const;
   virtual void init();
   virtual Unit *clone() const;
   virtual double conversionTOFMin() const;
@@ -4,6 +4,7 @@
 #include "MultiThreaded.h"
 
 #ifndef Q_MOC_RUN
+#include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #endif
 
@@ -84,7 +85,7 @@ public:
 */
 template <typename DataType>
 cow_ptr<DataType>::cow_ptr()
-    : Data(new DataType()) {}
+    : Data(boost::make_shared<DataType>()) {}
 
 /**
   Copy constructor : double references the data object
@@ -144,7 +145,7 @@ template <typename DataType> DataType &cow_ptr<DataType>::access() {
       if (!Data.unique()) {
         ptr_type oldData = Data;
         Data.reset();
-        Data = ptr_type(new DataType(*oldData));
+        Data = boost::make_shared<DataType>(*oldData);
       }
     }
   }
@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "MantidKernel/Philox.h"
+
+namespace {
+/// Multipliers of the two rounds functions
+const uint32_t PHILOX_M0 = 0xD2511F53;
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+/// Weyl sequence constants used to bump the key between rounds
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+/// Number of rounds applied to each counter
+const int PHILOX_ROUNDS = 10;
+/// Number of 32-bit words in a block of output
+const unsigned int WORDS_PER_BLOCK = 4;
+/// 2^-53, converts the upper 53 bits of a 64-bit integer into [0,1)
+const double TWO_POW_MINUS_53 = 1.0 / 9007199254740992.0;
+
+/// A single round of the bijection
+inline void philoxRound(const uint32_t key[2], uint32_t ctr[4]) {
+  const uint64_t prod0 = static_cast<uint64_t>(PHILOX_M0) * ctr[0];
+  const uint64_t prod1 = static_cast<uint64_t>(PHILOX_M1) * ctr[2];
+  const uint32_t hi0 = static_cast<uint32_t>(prod0 >> 32);
+  const uint32_t lo0 = static_cast<uint32_t>(prod0);
+  const uint32_t hi1 = static_cast<uint32_t>(prod1 >> 32);
+  const uint32_t lo1 = static_cast<uint32_t>(prod1);
+  ctr[0] = hi1 ^ ctr[1] ^ key[0];
+  ctr[1] = lo1;
+  ctr[2] = hi0 ^ ctr[3] ^ key[1];
+  ctr[3] = lo0;
+}
+}
+
+namespace Mantid {
+namespace Kernel {
+
+//------------------------------------------------------------------------------
+// Public member functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor taking a seed value. Sets the range to [0.0,1.0)
+ * @param seedValue :: The initial seed
+ */
+Philox::Philox(const size_t seedValue)
+    : m_stream(0), m_blockIndex(0), m_wordsUsed(WORDS_PER_BLOCK),
+      m_start(0.0), m_width(1.0), m_savedBlockIndex(0), m_savedWordsUsed(0),
+      m_haveSaved(false) {
+  setSeed(seedValue);
+}
+
+/**
+ * Constructor taking a seed value and a range
+ * @param seedValue :: The initial seed
+ * @param start :: The minimum value a generated number should take
+ * @param end :: The maximum value a generated number should take
+ */
+Philox::Philox(const size_t seedValue, const double start, const double end)
+    : m_stream(0), m_blockIndex(0), m_wordsUsed(WORDS_PER_BLOCK),
+      m_start(0.0), m_width(1.0), m_savedBlockIndex(0), m_savedWordsUsed(0),
+      m_haveSaved(false) {
+  setSeed(seedValue);
+  setRange(start, end);
+}
+
+/**
+ * (Re-)seed the generator. This moves the generator to the start of stream 0
+ * and clears the current saved state
+ * @param seedValue :: A seed for the generator
+ */
+void Philox::setSeed(const size_t seedValue) {
+  const uint64_t seed = static_cast<uint64_t>(seedValue);
+  m_key[0] = static_cast<uint32_t>(seed);
+  m_key[1] = static_cast<uint32_t>(seed >> 32);
+  setStream(0);
+}
+
+/**
+ * Sets the range of the subsequent calls to nextValue()
+ * @param start :: The lowest value a call to nextValue() will produce
+ * @param end :: The value that calls to nextValue() stay below
+ */
+void Philox::setRange(const double start, const double end) {
+  m_start = start;
+  m_width = end - start;
+}
+
+/**
+ * Returns the next number in the pseudo-random sequence. Each number uses 53
+ * bits taken from two words of output.
+ * @returns The next number in the pseudo-random sequence
+ */
+double Philox::nextValue() {
+  if (m_wordsUsed >= WORDS_PER_BLOCK)
+    generateBlock();
+  const uint64_t bits =
+      (static_cast<uint64_t>(m_block[m_wordsUsed]) << 32) |
+      m_block[m_wordsUsed + 1];
+  m_wordsUsed += 2;
+  return m_start + m_width * (static_cast<double>(bits >> 11) *
+                              TWO_POW_MINUS_53);
+}
+
+/**
+ * Resets the generator to the start of the current stream
+ */
+void Philox::restart() {
+  m_blockIndex = 0;
+  m_wordsUsed = WORDS_PER_BLOCK;
+}
+
+/// Saves the current position within the stream
+void Philox::save() {
+  m_savedBlockIndex = m_blockIndex;
+  m_savedWordsUsed = m_wordsUsed;
+  m_haveSaved = true;
+}
+
+/// Restores the generator to the last saved point, or the beginning of the
+/// stream if nothing has been saved
+void Philox::restore() {
+  if (!m_haveSaved) {
+    restart();
+    return;
+  }
+  m_blockIndex = m_savedBlockIndex;
+  m_wordsUsed = WORDS_PER_BLOCK;
+  if (m_savedWordsUsed < WORDS_PER_BLOCK) {
+    // Part way through a block, regenerate it
+    --m_blockIndex;
+    generateBlock();
+    m_wordsUsed = m_savedWordsUsed;
+  }
+}
+
+/**
+ * Streams with different indices produce independent sequences for the same
+ * seed. This clears the current saved state.
+ * @param stream :: The index of the stream
+ */
+void Philox::setStream(const uint64_t stream) {
+  m_stream = stream;
+  m_haveSaved = false;
+  restart();
+}
+
+/**
+ * Equivalent to calling nextValue() nvalues times
+ * @param values :: [Output] The start of the array to fill
+ * @param nvalues :: The number of values to generate
+ */
+void Philox::generate(double *values, const size_t nvalues) {
+  for (size_t i = 0; i < nvalues; ++i) {
+    values[i] = nextValue();
+  }
+}
+
+/**
+ * @param key :: The two words of the key
+ * @param counter :: [InOut] The four words of the counter, replaced by the
+ * output
+ */
+void Philox::encrypt(const uint32_t key[2], uint32_t counter[4]) {
+  uint32_t roundKey[2] = {key[0], key[1]};
+  for (int i = 0; i < PHILOX_ROUNDS; ++i) {
+    if (i > 0) {
+      roundKey[0] += PHILOX_W0;
+      roundKey[1] += PHILOX_W1;
+    }
+    philoxRound(roundKey, counter);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Private member functions
+//------------------------------------------------------------------------------
+
+/**
+ * The counter is made up of the block index in the low words and the stream
+ * index in the high words
+ */
+void Philox::generateBlock() {
+  m_block[0] = static_cast<uint32_t>(m_blockIndex);
+  m_block[1] = static_cast<uint32_t>(m_blockIndex >> 32);
+  m_block[2] = static_cast<uint32_t>(m_stream);
+  m_block[3] = static_cast<uint32_t>(m_stream >> 32);
+  encrypt(m_key, m_block);
+  ++m_blockIndex;
+  m_wordsUsed = 0;
+}
+}
+}
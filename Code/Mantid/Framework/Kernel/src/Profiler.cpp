@@ -0,0 +1,368 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidKernel/Profiler.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Memory.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+// Initialize the logger
+Logger g_log("Profiler");
+
+/// Write a string as a quoted JSON string
+void writeJSONString(std::ostream &os, const std::string &str) {
+  os << '"';
+  for (std::string::const_iterator it = str.begin(); it != str.end(); ++it) {
+    switch (*it) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    case '\t':
+      os << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(*it) < 0x20)
+        os << ' ';
+      else
+        os << *it;
+    }
+  }
+  os << '"';
+}
+
+/// The most spans that are kept if profiler.maxevents is not set
+const std::size_t DEFAULT_MAX_EVENTS = 200000;
+
+/// Orders summary entries by decreasing total time
+bool byTotalTime(const std::pair<std::string, ProfilerImpl::Summary> &lhs,
+                 const std::pair<std::string, ProfilerImpl::Summary> &rhs) {
+  return lhs.second.totalSeconds > rhs.second.totalSeconds;
+}
+}
+
+/// Private Constructor
+ProfilerImpl::ProfilerImpl()
+    : m_enabled(false), m_traceFile(), m_events(),
+      m_maxEvents(DEFAULT_MAX_EVENTS), m_nextEvent(0), m_droppedEvents(0),
+      m_threads(), m_maxResidentMemory(0), m_mutex(),
+      m_configObserver(*this, &ProfilerImpl::handleConfigChange) {
+  ConfigServiceImpl &config = ConfigService::Instance();
+  config.getValue("profiler.tracefile", m_traceFile);
+  int maxEvents(0);
+  if (config.getValue("profiler.maxevents", maxEvents) && maxEvents > 0) {
+    m_maxEvents = static_cast<std::size_t>(maxEvents);
+  }
+  int enabled(0);
+  if (config.getValue("profiler.enabled", enabled) && enabled != 0) {
+    setEnabled(true);
+  }
+  config.addObserver(m_configObserver);
+}
+
+/// Private Destructor. Writes the trace file if recording is still on.
+ProfilerImpl::~ProfilerImpl() {
+  ConfigService::Instance().removeObserver(m_configObserver);
+  if (m_enabled)
+    writeConfiguredTrace();
+}
+
+/**
+ * Switching recording off writes the trace to the file named by
+ * "profiler.tracefile", if one is set. The recorded spans are kept until
+ * clear() is called.
+ * @param enabled :: True to record spans
+ */
+void ProfilerImpl::setEnabled(const bool enabled) {
+  if (enabled == m_enabled)
+    return;
+  m_enabled = enabled;
+  if (enabled)
+    g_log.notice("Profiling is enabled\n");
+  else
+    writeConfiguredTrace();
+}
+
+/**
+ * @param name :: The name of the span
+ * @param category :: The kind of span
+ * @param start :: The start time in microseconds since the epoch
+ * @param sampleMemory :: If true, also record the resident memory
+ */
+void ProfilerImpl::record(const std::string &name, const char *category,
+                          const Poco::Timestamp::TimeVal start,
+                          const bool sampleMemory) {
+  Event event;
+  event.name = name;
+  event.category = category;
+  event.start = start;
+  event.duration = Poco::Timestamp().epochMicroseconds() - start;
+  event.residentMemory = 0;
+  if (sampleMemory) {
+    // Reading the process statistics is not free so is only done on request
+    MemoryStats mem(MEMORY_STATS_IGNORE_SYSTEM);
+    event.residentMemory = mem.residentMem();
+  }
+  const Poco::Thread::TID tid = Poco::Thread::currentTid();
+
+  Mutex::ScopedLock lock(m_mutex);
+  std::map<Poco::Thread::TID, int>::const_iterator thread = m_threads.find(tid);
+  if (thread == m_threads.end()) {
+    const int number = static_cast<int>(m_threads.size());
+    m_threads[tid] = number;
+    event.thread = number;
+  } else {
+    event.thread = thread->second;
+  }
+  m_maxResidentMemory = std::max(m_maxResidentMemory, event.residentMemory);
+  if (m_events.size() < m_maxEvents) {
+    m_events.push_back(event);
+    return;
+  }
+  // Full, so overwrite the oldest span
+  if (m_droppedEvents == 0) {
+    g_log.warning() << "More than " << m_maxEvents
+                    << " spans recorded, the oldest are being discarded. "
+                       "Increase profiler.maxevents to keep more.\n";
+  }
+  m_events[m_nextEvent] = event;
+  m_nextEvent = (m_nextEvent + 1) % m_maxEvents;
+  ++m_droppedEvents;
+}
+
+/// @returns A copy of the spans recorded since the last clear(), oldest first
+std::vector<ProfilerImpl::Event> ProfilerImpl::events() const {
+  Mutex::ScopedLock lock(m_mutex);
+  std::vector<Event> ordered(m_events.begin() + m_nextEvent, m_events.end());
+  ordered.insert(ordered.end(), m_events.begin(),
+                 m_events.begin() + m_nextEvent);
+  return ordered;
+}
+
+/// @returns The number of spans overwritten since the last clear()
+std::size_t ProfilerImpl::droppedEvents() const {
+  Mutex::ScopedLock lock(m_mutex);
+  return m_droppedEvents;
+}
+
+/// @returns The most spans that are kept
+std::size_t ProfilerImpl::maxEvents() const {
+  Mutex::ScopedLock lock(m_mutex);
+  return m_maxEvents;
+}
+
+/**
+ * If more spans are held than the new limit allows the oldest are discarded.
+ * @param maxEvents :: The most spans to keep, at least 1
+ */
+void ProfilerImpl::setMaxEvents(const std::size_t maxEvents) {
+  std::vector<Event> ordered = events();
+  Mutex::ScopedLock lock(m_mutex);
+  m_maxEvents = std::max(maxEvents, static_cast<std::size_t>(1));
+  if (ordered.size() > m_maxEvents) {
+    m_droppedEvents += ordered.size() - m_maxEvents;
+    ordered.erase(ordered.begin(), ordered.end() - m_maxEvents);
+  }
+  m_events.swap(ordered);
+  m_nextEvent = 0;
+}
+
+/// @returns The recorded spans aggregated by name
+std::map<std::string, ProfilerImpl::Summary> ProfilerImpl::summary() const {
+  std::map<std::string, Summary> result;
+  Mutex::ScopedLock lock(m_mutex);
+  for (std::vector<Event>::const_iterator it = m_events.begin();
+       it != m_events.end(); ++it) {
+    std::map<std::string, Summary>::iterator entry = result.find(it->name);
+    if (entry == result.end()) {
+      Summary empty = {0, 0.0, 0.0, 0};
+      entry = result.insert(std::make_pair(it->name, empty)).first;
+    }
+    Summary &summary = entry->second;
+    const double seconds = static_cast<double>(it->duration) * 1e-6;
+    ++summary.count;
+    summary.totalSeconds += seconds;
+    summary.maxSeconds = std::max(summary.maxSeconds, seconds);
+    summary.maxResidentMemory =
+        std::max(summary.maxResidentMemory, it->residentMemory);
+  }
+  return result;
+}
+
+/// @returns A table of the summary, the most expensive names first
+std::string ProfilerImpl::summaryStr() const {
+  const std::map<std::string, Summary> byName = summary();
+  std::vector<std::pair<std::string, Summary>> rows(byName.begin(),
+                                                    byName.end());
+  std::stable_sort(rows.begin(), rows.end(), byTotalTime);
+
+  std::ostringstream os;
+  os << std::left << std::setw(40) << "Name" << std::right << std::setw(8)
+     << "Count" << std::setw(12) << "Total (s)" << std::setw(12) << "Mean (s)"
+     << std::setw(12) << "Max (s)" << std::setw(18) << "End RSS (kiB)"
+     << "\n";
+  os << std::fixed << std::setprecision(3);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const Summary &row = rows[i].second;
+    os << std::left << std::setw(40) << rows[i].first << std::right
+       << std::setw(8) << row.count << std::setw(12) << row.totalSeconds
+       << std::setw(12) << row.totalSeconds / static_cast<double>(row.count)
+       << std::setw(12) << row.maxSeconds << std::setw(18)
+       << row.maxResidentMemory << "\n";
+  }
+  const std::size_t dropped = droppedEvents();
+  if (dropped > 0)
+    os << dropped << " older spans were discarded\n";
+  return os.str();
+}
+
+/**
+ * The memory is only sampled at the end of a span, for spans that ask for it,
+ * so this is not the peak memory of the process.
+ * @returns The largest resident memory sampled since the last clear(), in kiB
+ */
+std::size_t ProfilerImpl::maxResidentMemory() const {
+  Mutex::ScopedLock lock(m_mutex);
+  return m_maxResidentMemory;
+}
+
+/**
+ * Spans are written as complete ("X") events and memory samples as counter
+ * ("C") events. Times are in microseconds from the earliest span.
+ * @param os :: The stream to write to
+ */
+void ProfilerImpl::writeChromeTrace(std::ostream &os) const {
+  const std::vector<Event> spans = events();
+  Poco::Timestamp::TimeVal origin(0);
+  for (size_t i = 0; i < spans.size(); ++i) {
+    if (i == 0 || spans[i].start < origin)
+      origin = spans[i].start;
+  }
+
+  os << "{\"traceEvents\":[";
+  for (size_t i = 0; i < spans.size(); ++i) {
+    const Event &event = spans[i];
+    const Poco::Timestamp::TimeVal start = event.start - origin;
+    if (i > 0)
+      os << ",";
+    os << "\n{\"name\":";
+    writeJSONString(os, event.name);
+    os << ",\"cat\":";
+    writeJSONString(os, event.category);
+    os << ",\"ph\":\"X\",\"ts\":" << start << ",\"dur\":" << event.duration
+       << ",\"pid\":1,\"tid\":" << event.thread << "}";
+    if (event.residentMemory > 0) {
+      os << ",\n{\"name\":\"Resident memory\",\"ph\":\"C\",\"ts\":"
+         << start + event.duration << ",\"pid\":1,\"args\":{\"kiB\":"
+         << event.residentMemory << "}}";
+    }
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+/**
+ * @param filename :: The file to write. It is overwritten if it exists.
+ * @throws std::runtime_error if the file cannot be opened
+ */
+void ProfilerImpl::writeChromeTrace(const std::string &filename) const {
+  std::ofstream file(filename.c_str());
+  if (!file) {
+    throw std::runtime_error("Unable to open profiler trace file " +
+                             filename);
+  }
+  writeChromeTrace(file);
+}
+
+/// Discard all recorded spans and samples
+void ProfilerImpl::clear() {
+  Mutex::ScopedLock lock(m_mutex);
+  m_events.clear();
+  m_nextEvent = 0;
+  m_droppedEvents = 0;
+  m_threads.clear();
+  m_maxResidentMemory = 0;
+}
+
+/**
+ * @param notification :: A notification that a ConfigService key has changed
+ */
+void ProfilerImpl::handleConfigChange(
+    Mantid::Kernel::ConfigValChangeNotification_ptr notification) {
+  const std::string &key = notification->key();
+  if (key == "profiler.tracefile") {
+    m_traceFile = notification->curValue();
+  } else if (key == "profiler.enabled") {
+    int enabled(0);
+    try {
+      enabled = boost::lexical_cast<int>(notification->curValue());
+    } catch (boost::bad_lexical_cast &) {
+      g_log.warning() << "Ignoring profiler.enabled = "
+                      << notification->curValue() << ", expected 0 or 1\n";
+      return;
+    }
+    setEnabled(enabled != 0);
+  } else if (key == "profiler.maxevents") {
+    int maxEvents(0);
+    try {
+      maxEvents = boost::lexical_cast<int>(notification->curValue());
+    } catch (boost::bad_lexical_cast &) {
+    }
+    if (maxEvents <= 0) {
+      g_log.warning() << "Ignoring profiler.maxevents = "
+                      << notification->curValue()
+                      << ", expected a positive number\n";
+      return;
+    }
+    setMaxEvents(static_cast<std::size_t>(maxEvents));
+  }
+}
+
+/// Write the trace and log the summary if a trace file has been set
+void ProfilerImpl::writeConfiguredTrace() const {
+  if (m_traceFile.empty())
+    return;
+  try {
+    writeChromeTrace(m_traceFile);
+    g_log.notice() << "Profiler trace written to " << m_traceFile << "\n";
+    g_log.information() << summaryStr();
+  } catch (std::exception &e) {
+    g_log.error() << e.what() << "\n";
+  }
+}
+
+//----------------------------------------------------------------------
+// ProfilerScope
+//----------------------------------------------------------------------
+
+/// @param name :: The name of the span
+void ProfilerScope::start(const std::string &name) {
+  m_name = name;
+  m_start = Poco::Timestamp().epochMicroseconds();
+}
+
+/// Hand the span to the Profiler
+void ProfilerScope::stop() {
+  try {
+    Profiler::Instance().record(m_name, m_category, m_start, m_sampleMemory);
+  } catch (...) {
+    // Never throw from a destructor
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -1,4 +1,5 @@
 #include "MantidKernel/ThreadPoolRunnable.h"
+#include "MantidKernel/Profiler.h"
 #include "MantidKernel/System.h"
 
 namespace Mantid {
@@ -59,6 +60,7 @@ void ThreadPoolRunnable::run() {
         mutex->lock();
 
       try {
+        ProfilerScope profile("ThreadPool task", "thread pool");
         // Run the task (synchronously within this thread)
         task->run();
       } catch (std::exception &e) {
@@ -208,6 +208,28 @@ double Unit::convertSingleFromTOF(const double xvalue, const double &l1,
   return this->singleFromTOF(xvalue);
 }
 
+/** By default a conversion is not a power law
+ * @param factor :: Unused
+ * @param power :: Unused
+ * @return false
+ */
+bool Unit::powerLawToTOF(double &factor, double &power) const {
+  UNUSED_ARG(factor);
+  UNUSED_ARG(power);
+  return false;
+}
+
+/** By default a conversion is not a power law
+ * @param factor :: Unused
+ * @param power :: Unused
+ * @return false
+ */
+bool Unit::powerLawFromTOF(double &factor, double &power) const {
+  UNUSED_ARG(factor);
+  UNUSED_ARG(power);
+  return false;
+}
+
 std::pair<double, double> Unit::conversionRange() const {
   double u1 = this->singleFromTOF(this->conversionTOFMin());
   double u2 = this->singleFromTOF(this->conversionTOFMax());
@@ -304,6 +326,18 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+bool TOF::powerLawToTOF(double &factor, double &power) const {
+  factor = 1.0;
+  power = 1.0;
+  return true;
+}
+
+bool TOF::powerLawFromTOF(double &factor, double &power) const {
+  factor = 1.0;
+  power = 1.0;
+  return true;
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -430,6 +464,22 @@ double Wavelength::conversionTOFMax() const {
   return max_tof;
 }
 
+bool Wavelength::powerLawToTOF(double &factor, double &power) const {
+  if (!initialized || emode == 1 || emode == 2)
+    return false;
+  factor = factorTo;
+  power = 1.0;
+  return true;
+}
+
+bool Wavelength::powerLawFromTOF(double &factor, double &power) const {
+  if (!initialized || do_sfpFrom)
+    return false;
+  factor = factorFrom;
+  power = 1.0;
+  return true;
+}
+
 Unit *Wavelength::clone() const { return new Wavelength(*this); }
 
 // ============================================================================================
@@ -486,6 +536,22 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+bool Energy::powerLawToTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = factorTo;
+  power = -0.5;
+  return true;
+}
+
+bool Energy::powerLawFromTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = factorFrom;
+  power = -2.0;
+  return true;
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -594,6 +660,22 @@ double dSpacing::singleFromTOF(const double tof) const {
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
+bool dSpacing::powerLawToTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = factorTo;
+  power = 1.0;
+  return true;
+}
+
+bool dSpacing::powerLawFromTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = 1.0 / factorFrom;
+  power = 1.0;
+  return true;
+}
+
 Unit *dSpacing::clone() const { return new dSpacing(*this); }
 
 // ================================================================================
@@ -651,6 +733,22 @@ double MomentumTransfer::conversionTOFMin() const {
 }
 double MomentumTransfer::conversionTOFMax() const { return DBL_MAX; }
 
+bool MomentumTransfer::powerLawToTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = factorTo;
+  power = -1.0;
+  return true;
+}
+
+bool MomentumTransfer::powerLawFromTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = factorFrom;
+  power = -1.0;
+  return true;
+}
+
 Unit *MomentumTransfer::clone() const { return new MomentumTransfer(*this); }
 
 /* ===================================================================================================
@@ -712,6 +810,22 @@ double QSquared::conversionTOFMax() const {
     return factorTo / sqrt(DBL_MAX);
 }
 
+bool QSquared::powerLawToTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = factorTo;
+  power = -0.5;
+  return true;
+}
+
+bool QSquared::powerLawFromTOF(double &factor, double &power) const {
+  if (!initialized)
+    return false;
+  factor = factorFrom;
+  power = -2.0;
+  return true;
+}
+
 Unit *QSquared::clone() const { return new QSquared(*this); }
 
 /* ==============================================================================
@@ -1033,6 +1147,16 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// Not a power law, unlike Wavelength
+bool SpinEchoLength::powerLawToTOF(double &factor, double &power) const {
+  return Unit::powerLawToTOF(factor, power);
+}
+
+/// Not a power law, unlike Wavelength
+bool SpinEchoLength::powerLawFromTOF(double &factor, double &power) const {
+  return Unit::powerLawFromTOF(factor, power);
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1078,6 +1202,16 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// Not a power law, unlike Wavelength
+bool SpinEchoTime::powerLawToTOF(double &factor, double &power) const {
+  return Unit::powerLawToTOF(factor, power);
+}
+
+/// Not a power law, unlike Wavelength
+bool SpinEchoTime::powerLawFromTOF(double &factor, double &power) const {
+  return Unit::powerLawFromTOF(factor, power);
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
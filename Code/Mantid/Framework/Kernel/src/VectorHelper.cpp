@@ -2,6 +2,7 @@
 #include <cmath>
 
 #include "MantidKernel/VectorHelper.h"
+#include "MantidKernel/SIMD.h"
 #include <algorithm>
 #include <vector>
 #include <numeric>
@@ -16,6 +17,13 @@ namespace Mantid {
 namespace Kernel {
 namespace VectorHelper {
 
+namespace {
+/// Kernel used to turn summed squared errors into errors
+struct SquareRoot {
+  inline double operator()(const double x) const { return std::sqrt(x); }
+};
+}
+
 /** Creates a new output X array given a 'standard' set of rebinning parameters.
  *  @param[in]  params Rebin parameters input [x_1, delta_1,x_2, ...
  *,x_n-1,delta_n-1,x_n]
@@ -214,9 +222,7 @@ void rebin(const std::vector<double> &xold, const std::vector<double> &yold,
       }
     } else {
       // non-distribution, just square root final error value
-      typedef double (*pf)(double);
-      pf uf = std::sqrt;
-      std::transform(enew.begin(), enew.end(), enew.begin(), uf);
+      SIMD::transform(enew, enew, SquareRoot());
     }
   }
 
@@ -329,9 +335,7 @@ void rebinHistogram(const std::vector<double> &xold,
                  // (should be done externally)
   {
     // Now take the root-square of the errors
-    typedef double (*pf)(double);
-    pf uf = std::sqrt;
-    std::transform(enew.begin(), enew.end(), enew.begin(), uf);
+    SIMD::transform(enew, enew, SquareRoot());
   }
 
   return;
@@ -298,6 +298,62 @@ public:
     TS_ASSERT_EQUALS( *svc.retrieve("item2345"), 2345);
   }
 
+  void test_asynchronous_notifications_are_all_delivered()
+  {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> observer(*this, &DataServiceTest::handleAddNotification);
+    svc.notificationCenter.addObserver(observer);
+    vector.clear();
+    svc.resetNotificationStatistics();
+
+    svc.setNotificationMode(FakeDataService::Asynchronous);
+    TS_ASSERT_EQUALS( svc.notificationMode(), FakeDataService::Asynchronous );
+    int num = 1000;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i=0; i<num; i++)
+    {
+      std::ostringstream mess;  mess << "item" << i;
+      svc.add( mess.str(), boost::make_shared<int>(i));
+    }
+    // Going back to synchronous delivery waits for the queue to be emptied
+    svc.setNotificationMode(FakeDataService::Synchronous);
+    TS_ASSERT_EQUALS( svc.notificationMode(), FakeDataService::Synchronous );
+
+    TS_ASSERT_EQUALS( vector.size(), size_t(num) );
+    FakeDataService::NotificationStatistics stats = svc.notificationStatistics();
+    TS_ASSERT_EQUALS( stats.count, size_t(num) );
+    TS_ASSERT_LESS_THAN_EQUALS( stats.maxSeconds, stats.totalSeconds );
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_notification_statistics_count_synchronous_notifications()
+  {
+    svc.resetNotificationStatistics();
+    TS_ASSERT_EQUALS( svc.notificationStatistics().count, 0 );
+    svc.add("one", boost::make_shared<int>(1));
+    svc.addOrReplace("one", boost::make_shared<int>(2));
+    // Add, BeforeReplace and AfterReplace
+    TS_ASSERT_EQUALS( svc.notificationStatistics().count, 3 );
+    TS_ASSERT_LESS_THAN_EQUALS( 0.0, svc.notificationStatistics().totalSeconds );
+  }
+
+  // Handler that uses the service while a notification is delivered
+  void handleAfterReplaceByRename(const Poco::AutoPtr<FakeDataService::AfterReplaceNotification>& notice)
+  {
+    if (svc.doesExist(notice->objectName()))
+      ++notificationFlag;
+  }
+
+  void test_observers_can_use_the_service_during_rename()
+  {
+    Poco::NObserver<DataServiceTest, FakeDataService::AfterReplaceNotification> observer(*this, &DataServiceTest::handleAfterReplaceByRename);
+    svc.notificationCenter.addObserver(observer);
+    svc.add("One", boost::make_shared<int>(1));
+    svc.add("Two", boost::make_shared<int>(2));
+    svc.rename("One", "Two");
+    TS_ASSERT_EQUALS( notificationFlag, 1 );
+    svc.notificationCenter.removeObserver(observer);
+  }
+
   void test_prefixToHide()
   {
     TS_ASSERT_EQUALS( FakeDataService::prefixToHide(), "__" );
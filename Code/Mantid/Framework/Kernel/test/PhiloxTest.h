@@ -0,0 +1,149 @@
+#ifndef MANTID_KERNEL_PHILOXTEST_H_
+#define MANTID_KERNEL_PHILOXTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidKernel/Philox.h"
+
+using Mantid::Kernel::Philox;
+
+class PhiloxTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PhiloxTest *createSuite() { return new PhiloxTest(); }
+  static void destroySuite( PhiloxTest *suite ) { delete suite; }
+
+  void test_That_Object_Construction_Does_Not_Throw()
+  {
+    TS_ASSERT_THROWS_NOTHING(Philox(1));
+  }
+
+  void test_Encrypt_Matches_Published_Known_Answers()
+  {
+    // Known answer tests distributed with the Random123 library
+    uint32_t zeroKey[2] = {0, 0};
+    uint32_t zeroCtr[4] = {0, 0, 0, 0};
+    Philox::encrypt(zeroKey, zeroCtr);
+    TS_ASSERT_EQUALS(zeroCtr[0], 0x6627e8d5);
+    TS_ASSERT_EQUALS(zeroCtr[1], 0xe169c58d);
+    TS_ASSERT_EQUALS(zeroCtr[2], 0xbc57ac4c);
+    TS_ASSERT_EQUALS(zeroCtr[3], 0x9b00dbd8);
+
+    uint32_t piKey[2] = {0xa4093822, 0x299f31d0};
+    uint32_t piCtr[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    Philox::encrypt(piKey, piCtr);
+    TS_ASSERT_EQUALS(piCtr[0], 0xd16cfe09);
+    TS_ASSERT_EQUALS(piCtr[1], 0x94fdcceb);
+    TS_ASSERT_EQUALS(piCtr[2], 0x5001e420);
+    TS_ASSERT_EQUALS(piCtr[3], 0x24126ea1);
+  }
+
+  void test_That_A_Given_Seed_Produces_Expected_Sequence()
+  {
+    Philox randGen(1);
+    randGen.setSeed(39857239);
+    assertSequenceCorrectForSeed_39857239(randGen);
+  }
+
+  void test_That_Next_For_Different_Seeds_Returns_Different_Values()
+  {
+    Philox gen_1(212437999), gen_2(247021340);
+    TS_ASSERT_DIFFERS(gen_1.nextValue(), gen_2.nextValue());
+  }
+
+  void test_That_A_Restart_Gives_Same_Sequence_Again_From_Start()
+  {
+    Philox randGen(39857239);
+    assertSequenceCorrectForSeed_39857239(randGen);
+    randGen.restart();
+    assertSequenceCorrectForSeed_39857239(randGen);
+  }
+
+  void test_That_A_Restore_Without_Save_Does_The_Same_As_Restart()
+  {
+    Philox randGen(39857239);
+    assertSequenceCorrectForSeed_39857239(randGen);
+    randGen.restore();
+    assertSequenceCorrectForSeed_39857239(randGen);
+  }
+
+  void test_That_Save_Then_Call_Next_Value_And_Restore_Gives_Sequence_From_Saved_Point()
+  {
+    Philox randGen(1);
+    doNextValueCalls(7, randGen); // Part way through a block
+
+    randGen.save();
+    std::vector<double> firstValues = doNextValueCalls(50, randGen);
+    randGen.restore();
+    std::vector<double> secondValues = doNextValueCalls(50, randGen);
+    TS_ASSERT_EQUALS(firstValues, secondValues);
+  }
+
+  void test_Streams_Are_Independent_Of_The_Order_They_Are_Used_In()
+  {
+    Philox forwards(12345), backwards(12345);
+    std::vector<std::vector<double>> forwardValues(10), backwardValues(10);
+    for(size_t i = 0; i < 10; ++i)
+    {
+      forwards.setStream(i);
+      forwardValues[i] = doNextValueCalls(5, forwards);
+      backwards.setStream(9 - i);
+      backwardValues[9 - i] = doNextValueCalls(5, backwards);
+    }
+    TS_ASSERT_EQUALS(forwardValues, backwardValues);
+    TS_ASSERT_DIFFERS(forwardValues[0][0], forwardValues[1][0]);
+  }
+
+  void test_Generate_Gives_Same_Values_As_Next_Value()
+  {
+    Philox gen_1(54321), gen_2(54321);
+    gen_1.setStream(42);
+    gen_2.setStream(42);
+    std::vector<double> filled(13, 0.0);
+    gen_1.generate(&filled[0], filled.size());
+    TS_ASSERT_EQUALS(filled, doNextValueCalls(13, gen_2));
+  }
+
+  void test_That_A_Given_Range_Produces_Numbers_Within_This_Range()
+  {
+    const double start(2.5), end(5.);
+    Philox randGen(15423894, start, end);
+    for( std::size_t i = 0; i < 20; ++i )
+    {
+      const double r = randGen.nextValue();
+      TS_ASSERT(r >= start && r < end);
+    }
+  }
+
+  void test_That_nextPoint_returns_1_Value()
+  {
+    Philox randGen(12345);
+    const std::vector<double> point = randGen.nextPoint();
+    TS_ASSERT_EQUALS(point.size(), 1);
+  }
+
+private:
+  void assertSequenceCorrectForSeed_39857239(Philox &randGen)
+  {
+    double expectedValues[10] =
+    {  0.953617777707,0.0521162737101,0.312157584436,0.362597809188,0.404875356723,
+       0.407172118372,0.3038590835,0.996446305251,0.00184375653652,0.510281520462 };
+    for( std::size_t i = 0; i < 10; ++i )
+    {
+      TS_ASSERT_DELTA(randGen.nextValue(), expectedValues[i], 1e-12);
+    }
+  }
+
+  std::vector<double> doNextValueCalls(const unsigned int ncalls, Philox &randGen)
+  {
+    std::vector<double> values(ncalls,0.0);
+    for(unsigned int i = 0; i < ncalls; ++i)
+    {
+      values[i] = randGen.nextValue();
+    }
+    return values;
+  }
+};
+
+#endif /* MANTID_KERNEL_PHILOXTEST_H_ */
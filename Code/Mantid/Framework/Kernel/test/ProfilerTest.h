@@ -0,0 +1,178 @@
+#ifndef MANTID_KERNEL_PROFILERTEST_H_
+#define MANTID_KERNEL_PROFILERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Profiler.h"
+
+#include <sstream>
+
+using namespace Mantid::Kernel;
+
+class ProfilerTest : public CxxTest::TestSuite
+{
+public:
+  void setUp()
+  {
+    Profiler::Instance().clear();
+  }
+
+  void tearDown()
+  {
+    Profiler::Instance().setEnabled(false);
+    Profiler::Instance().clear();
+  }
+
+  void test_nothing_is_recorded_when_disabled()
+  {
+    Profiler::Instance().setEnabled(false);
+    {
+      ProfilerScope scope("disabled");
+      TS_ASSERT(!scope.isActive());
+    }
+    TS_ASSERT(Profiler::Instance().events().empty());
+  }
+
+  void test_scopes_are_recorded_when_enabled()
+  {
+    Profiler::Instance().setEnabled(true);
+    {
+      PROFILER_SCOPE("outer");
+      ProfilerScope inner(std::string("inner"), "test");
+      TS_ASSERT(inner.isActive());
+    }
+    std::vector<ProfilerImpl::Event> events = Profiler::Instance().events();
+    TS_ASSERT_EQUALS(events.size(), 2);
+    // The inner scope is destroyed first
+    TS_ASSERT_EQUALS(events[0].name, "inner");
+    TS_ASSERT_EQUALS(events[0].category, "test");
+    TS_ASSERT_EQUALS(events[1].name, "outer");
+    TS_ASSERT_EQUALS(events[1].category, "function");
+    TS_ASSERT_LESS_THAN_EQUALS(events[1].start, events[0].start);
+    TS_ASSERT_EQUALS(events[0].thread, events[1].thread);
+  }
+
+  void test_summary_aggregates_by_name()
+  {
+    Profiler::Instance().setEnabled(true);
+    for (int i = 0; i < 3; ++i)
+    {
+      PROFILER_SCOPE("repeated");
+    }
+    {
+      ProfilerScope scope("sampled");
+      scope.sampleMemory();
+    }
+    std::map<std::string, ProfilerImpl::Summary> summary =
+        Profiler::Instance().summary();
+    TS_ASSERT_EQUALS(summary.size(), 2);
+    TS_ASSERT_EQUALS(summary["repeated"].count, 3);
+    TS_ASSERT_LESS_THAN_EQUALS(summary["repeated"].maxSeconds,
+                               summary["repeated"].totalSeconds);
+    TS_ASSERT_EQUALS(summary["sampled"].count, 1);
+    TS_ASSERT_LESS_THAN(0, summary["sampled"].maxResidentMemory);
+    TS_ASSERT_EQUALS(Profiler::Instance().maxResidentMemory(),
+                     summary["sampled"].maxResidentMemory);
+    TS_ASSERT_DIFFERS(Profiler::Instance().summaryStr().find("repeated"),
+                      std::string::npos);
+  }
+
+  void test_chrome_trace_contains_complete_and_counter_events()
+  {
+    Profiler::Instance().setEnabled(true);
+    {
+      ProfilerScope scope(std::string("quote\"d"), "test");
+      scope.sampleMemory();
+    }
+    std::ostringstream os;
+    Profiler::Instance().writeChromeTrace(os);
+    const std::string trace = os.str();
+    TS_ASSERT_EQUALS(trace.find("{\"traceEvents\":["), 0);
+    TS_ASSERT_DIFFERS(trace.find("\"name\":\"quote\\\"d\""), std::string::npos);
+    TS_ASSERT_DIFFERS(trace.find("\"ph\":\"X\",\"ts\":0,"), std::string::npos);
+    TS_ASSERT_DIFFERS(trace.find("\"ph\":\"C\""), std::string::npos);
+  }
+
+  void test_oldest_spans_are_overwritten_when_full()
+  {
+    const size_t oldMax = Profiler::Instance().maxEvents();
+    Profiler::Instance().setMaxEvents(3);
+    Profiler::Instance().setEnabled(true);
+    const char *names[] = {"one", "two", "three", "four", "five"};
+    for (int i = 0; i < 5; ++i)
+    {
+      ProfilerScope scope(names[i]);
+    }
+    std::vector<ProfilerImpl::Event> events = Profiler::Instance().events();
+    TS_ASSERT_EQUALS(events.size(), 3);
+    TS_ASSERT_EQUALS(Profiler::Instance().droppedEvents(), 2);
+    if (events.size() == 3)
+    {
+      TS_ASSERT_EQUALS(events[0].name, "three");
+      TS_ASSERT_EQUALS(events[1].name, "four");
+      TS_ASSERT_EQUALS(events[2].name, "five");
+    }
+
+    // Shrinking keeps the newest
+    Profiler::Instance().setMaxEvents(2);
+    events = Profiler::Instance().events();
+    TS_ASSERT_EQUALS(events.size(), 2);
+    TS_ASSERT_EQUALS(Profiler::Instance().droppedEvents(), 3);
+    if (events.size() == 2)
+    {
+      TS_ASSERT_EQUALS(events[0].name, "four");
+      TS_ASSERT_EQUALS(events[1].name, "five");
+    }
+
+    Profiler::Instance().clear();
+    TS_ASSERT_EQUALS(Profiler::Instance().droppedEvents(), 0);
+    Profiler::Instance().setMaxEvents(oldMax);
+  }
+
+  void test_config_service_sets_the_span_limit()
+  {
+    const size_t oldMax = Profiler::Instance().maxEvents();
+    ConfigServiceImpl &config = ConfigService::Instance();
+    config.setString("profiler.maxevents", "7");
+    TS_ASSERT_EQUALS(Profiler::Instance().maxEvents(), 7);
+    config.setString("profiler.maxevents", "-1");
+    TS_ASSERT_EQUALS(Profiler::Instance().maxEvents(), 7);
+    Profiler::Instance().setMaxEvents(oldMax);
+  }
+
+  void test_config_service_switches_recording()
+  {
+    ConfigServiceImpl &config = ConfigService::Instance();
+    config.setString("profiler.enabled", "1");
+    TS_ASSERT(Profiler::Instance().isEnabled());
+    config.setString("profiler.enabled", "0");
+    TS_ASSERT(!Profiler::Instance().isEnabled());
+  }
+};
+
+class ProfilerTestPerformance : public CxxTest::TestSuite
+{
+public:
+  void test_disabled_scopes()
+  {
+    Profiler::Instance().setEnabled(false);
+    for (int i = 0; i < 10000000; ++i)
+    {
+      PROFILER_SCOPE("disabled");
+    }
+  }
+
+  void test_enabled_scopes()
+  {
+    Profiler::Instance().setEnabled(true);
+    for (int i = 0; i < 100000; ++i)
+    {
+      PROFILER_SCOPE("enabled");
+    }
+    Profiler::Instance().setEnabled(false);
+    Profiler::Instance().clear();
+  }
+};
+
+#endif /* MANTID_KERNEL_PROFILERTEST_H_ */
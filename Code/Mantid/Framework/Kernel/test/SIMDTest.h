@@ -0,0 +1,136 @@
+#ifndef MANTID_KERNEL_SIMDTEST_H_
+#define MANTID_KERNEL_SIMDTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/SIMD.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Mantid::Kernel;
+
+namespace {
+struct Twice {
+  double operator()(const double x) const { return 2.0 * x; }
+};
+
+struct Add {
+  void operator()(const double lhsY, const double lhsE, const double rhsY,
+                  const double rhsE, double &YOut, double &EOut) const {
+    YOut = lhsY + rhsY;
+    EOut = std::sqrt(lhsE * lhsE + rhsE * rhsE);
+  }
+};
+
+struct ScaleByX {
+  void operator()(const double X, const double YIn, const double EIn,
+                  double &YOut, double &EOut) const {
+    YOut = X * YIn;
+    EOut = X * EIn;
+  }
+};
+}
+
+class SIMDTest : public CxxTest::TestSuite
+{
+public:
+  void test_transform()
+  {
+    std::vector<double> in(5), out(5);
+    for (size_t i = 0; i < in.size(); ++i)
+      in[i] = static_cast<double>(i);
+    SIMD::transform(in, out, Twice());
+    for (size_t i = 0; i < in.size(); ++i)
+      TS_ASSERT_EQUALS(out[i], 2.0 * static_cast<double>(i));
+  }
+
+  void test_transform_in_place()
+  {
+    std::vector<double> data(3, 1.5);
+    SIMD::transform(data, data, Twice());
+    TS_ASSERT_EQUALS(data[0], 3.0);
+    TS_ASSERT_EQUALS(data[2], 3.0);
+  }
+
+  void test_transform_empty()
+  {
+    std::vector<double> in, out;
+    TS_ASSERT_THROWS_NOTHING(SIMD::transform(in, out, Twice()));
+  }
+
+  void test_binary_with_spectrum()
+  {
+    std::vector<double> lhsY(4, 1.0), lhsE(4, 3.0), rhsY(4, 2.0), rhsE(4, 4.0);
+    std::vector<double> YOut(4), EOut(4);
+    SIMD::binary(Add(), lhsY, lhsE, rhsY, rhsE, YOut, EOut);
+    for (size_t i = 0; i < YOut.size(); ++i) {
+      TS_ASSERT_EQUALS(YOut[i], 3.0);
+      TS_ASSERT_DELTA(EOut[i], 5.0, 1e-12);
+    }
+  }
+
+  void test_binary_in_place()
+  {
+    std::vector<double> lhsY(4, 1.0), lhsE(4, 3.0), rhsY(4, 2.0), rhsE(4, 4.0);
+    SIMD::binary(Add(), lhsY, lhsE, rhsY, rhsE, lhsY, lhsE);
+    TS_ASSERT_EQUALS(lhsY[3], 3.0);
+    TS_ASSERT_DELTA(lhsE[3], 5.0, 1e-12);
+  }
+
+  void test_binary_with_value()
+  {
+    std::vector<double> lhsY(4, 1.0), lhsE(4, 3.0), YOut(4), EOut(4);
+    SIMD::binary(Add(), lhsY, lhsE, 2.0, 4.0, YOut, EOut);
+    TS_ASSERT_EQUALS(YOut[0], 3.0);
+    TS_ASSERT_DELTA(EOut[0], 5.0, 1e-12);
+  }
+
+  void test_unary_uses_bin_centres_for_histograms()
+  {
+    std::vector<double> X(3), Y(2, 1.0), E(2, 2.0);
+    X[0] = 0.0;
+    X[1] = 2.0;
+    X[2] = 6.0;
+    SIMD::unary(ScaleByX(), X, Y, E, Y, E);
+    TS_ASSERT_EQUALS(Y[0], 1.0);
+    TS_ASSERT_EQUALS(E[0], 2.0);
+    TS_ASSERT_EQUALS(Y[1], 4.0);
+    TS_ASSERT_EQUALS(E[1], 8.0);
+  }
+
+  void test_unary_uses_points_for_point_data()
+  {
+    std::vector<double> X(2), Y(2, 1.0), E(2, 2.0), YOut(2), EOut(2);
+    X[0] = 3.0;
+    X[1] = 5.0;
+    SIMD::unary(ScaleByX(), X, Y, E, YOut, EOut);
+    TS_ASSERT_EQUALS(YOut[0], 3.0);
+    TS_ASSERT_EQUALS(EOut[1], 10.0);
+  }
+};
+
+class SIMDTestPerformance : public CxxTest::TestSuite
+{
+public:
+  SIMDTestPerformance()
+      : m_lhsY(10000000, 1.0), m_lhsE(10000000, 1.0), m_rhsY(10000000, 2.0),
+        m_rhsE(10000000, 2.0), m_YOut(10000000), m_EOut(10000000) {}
+
+  void test_binary()
+  {
+    for (int i = 0; i < 10; ++i)
+      SIMD::binary(Add(), m_lhsY, m_lhsE, m_rhsY, m_rhsE, m_YOut, m_EOut);
+  }
+
+  void test_transform()
+  {
+    for (int i = 0; i < 10; ++i)
+      SIMD::transform(m_lhsY, m_YOut, Twice());
+  }
+
+private:
+  std::vector<double> m_lhsY, m_lhsE, m_rhsY, m_rhsE, m_YOut, m_EOut;
+};
+
+#endif /* MANTID_KERNEL_SIMDTEST_H_ */
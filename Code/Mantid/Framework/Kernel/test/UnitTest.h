@@ -1325,6 +1325,51 @@ public:
 
   }
 
+  //----------------------------------------------------------------------
+  // Power law tests
+  //----------------------------------------------------------------------
+
+  void testPowerLaws_matchSingleConversions()
+  {
+    std::vector<Unit*> units;
+    units.push_back(new Units::TOF);
+    units.push_back(new Units::Wavelength);
+    units.push_back(new Units::Energy);
+    units.push_back(new Units::dSpacing);
+    units.push_back(new Units::MomentumTransfer);
+    units.push_back(new Units::QSquared);
+    for (size_t i = 0; i < units.size(); i++)
+    {
+      Unit *u = units[i];
+      u->initialize(10.0, 1.5, 0.7, 0, 0.0, 0.0);
+      double factor, power;
+      TSM_ASSERT( u->unitID(), u->powerLawToTOF(factor, power) )
+      TSM_ASSERT_DELTA( u->unitID(), factor * std::pow(2.5, power), u->singleToTOF(2.5), 1e-9 * u->singleToTOF(2.5) )
+      TSM_ASSERT( u->unitID(), u->powerLawFromTOF(factor, power) )
+      TSM_ASSERT_DELTA( u->unitID(), factor * std::pow(1234.5, power), u->singleFromTOF(1234.5), 1e-9 * u->singleFromTOF(1234.5) )
+      delete u;
+    }
+  }
+
+  void testPowerLaws_notForInelasticOrDerivedUnits()
+  {
+    double factor, power;
+    Units::Wavelength wavelength;
+    wavelength.initialize(10.0, 1.5, 0.7, 1, 25.0, 0.0);
+    TS_ASSERT( !wavelength.powerLawToTOF(factor, power) )
+    TS_ASSERT( !wavelength.powerLawFromTOF(factor, power) )
+
+    Units::SpinEchoLength sel;
+    sel.initialize(10.0, 1.5, 0.7, 0, 2.0, 0.0);
+    TS_ASSERT( !sel.powerLawToTOF(factor, power) )
+    TS_ASSERT( !sel.powerLawFromTOF(factor, power) )
+
+    Units::DeltaE deltaE;
+    deltaE.initialize(10.0, 1.5, 0.7, 1, 25.0, 0.0);
+    TS_ASSERT( !deltaE.powerLawToTOF(factor, power) )
+    TS_ASSERT( !deltaE.powerLawFromTOF(factor, power) )
+  }
+
 
 private:
   Units::Label label;
@@ -0,0 +1,113 @@
+#ifndef MANTID_LIVEDATA_PULSEBATCHQUEUE_H_
+#define MANTID_LIVEDATA_PULSEBATCHQUEUE_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidDataObjects/Events.h"
+#include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/System.h"
+
+#include <boost/shared_ptr.hpp>
+#include <Poco/Mutex.h>
+
+#include <vector>
+
+namespace Mantid {
+namespace LiveData {
+
+/// The events received from the network for a single pulse
+struct DLLExport PulseBatch {
+  PulseBatch()
+      : protonCharge(0.0), droppedEvents(0), late(false), overflowPulses(0),
+        overflowEvents(0) {}
+  /// Empty the batch, keeping the memory of its vectors
+  void clear();
+
+  /// The time of the pulse
+  Kernel::DateAndTime pulseTime;
+  /// The proton charge of the pulse in picoCoulombs
+  double protonCharge;
+  /// The workspace index of each event
+  std::vector<size_t> indices;
+  /// The events, in the same order as indices
+  std::vector<DataObjects::TofEvent> events;
+  /// The number of events that were thrown away, e.g. for an unknown pixel
+  size_t droppedEvents;
+  /// True if the pulse arrived after a later one
+  bool late;
+  /// The pulses the producer threw away, since the last batch it queued,
+  /// because the queue was full
+  size_t overflowPulses;
+  /// The events in those pulses
+  size_t overflowEvents;
+  /// When the producer queued the batch
+  Kernel::DateAndTime queued;
+};
+
+/// Typedef for a shared pointer to a PulseBatch
+typedef boost::shared_ptr<PulseBatch> PulseBatch_sptr;
+
+/** A fixed size ring of PulseBatch objects passed from a producer thread to
+    a consumer thread. A mutex is held only while a slot and the counts are
+    updated, never while a batch is filled or emptied, so neither thread
+    waits for long. Taking the mutex also orders the memory accesses: the
+    consumer sees everything the producer wrote to a batch before pushing it,
+    on any platform.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+ */
+class DLLExport PulseBatchQueue {
+public:
+  explicit PulseBatchQueue(const size_t capacity);
+
+  /// Add a batch at the head
+  bool push(const PulseBatch_sptr &batch);
+  /// Remove the batch at the tail
+  PulseBatch_sptr pop();
+
+  /// The number of batches waiting
+  size_t size() const;
+  /// The number of events in the batches waiting
+  size_t events() const;
+  /// The maximum number of batches that can wait
+  size_t capacity() const { return m_slots.size(); }
+
+private:
+  /// The ring of batches
+  std::vector<PulseBatch_sptr> m_slots;
+  /// The next slot to fill
+  size_t m_head;
+  /// The next slot to empty
+  size_t m_tail;
+  /// The number of filled slots
+  size_t m_count;
+  /// The number of events in the filled slots
+  size_t m_events;
+  /// Guards all of the above
+  mutable Poco::FastMutex m_mutex;
+};
+
+} // namespace LiveData
+} // namespace Mantid
+
+#endif /* MANTID_LIVEDATA_PULSEBATCHQUEUE_H_ */
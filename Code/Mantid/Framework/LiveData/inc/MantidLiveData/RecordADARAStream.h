@@ -0,0 +1,82 @@
+#ifndef MANTID_LIVEDATA_RECORDADARASTREAM_H_
+#define MANTID_LIVEDATA_RECORDADARASTREAM_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/Algorithm.h"
+#include "MantidLiveData/ADARA/ADARAParser.h"
+
+#include <fstream>
+
+namespace Mantid {
+namespace LiveData {
+/**
+    Connects to an SMS daemon and writes the ADARA stream it sends to a file,
+    whole packets only, for ReplayADARAStream to serve later.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+ */
+class DLLExport RecordADARAStream : public API::Algorithm,
+                                    public ADARA::Parser {
+public:
+  RecordADARAStream();
+  virtual ~RecordADARAStream();
+
+  /// Algorithm's name for identification overriding a virtual method
+  virtual const std::string name() const { return "RecordADARAStream"; }
+  /// Algorithm's version for identification overriding a virtual method
+  virtual int version() const { return 1; }
+  /// Algorithm's category for identification overriding a virtual method
+  virtual const std::string category() const {
+    return "DataHandling\\DataAcquisition";
+  }
+
+  /// Algorithm's summary
+  virtual const std::string summary() const {
+    return "Writes the ADARA stream sent by an SMS daemon to a file.";
+  }
+
+protected:
+  using ADARA::Parser::rxPacket;
+  virtual bool rxPacket(const ADARA::Packet &pkt);
+  virtual bool rxPacket(const ADARA::BankedEventPkt &pkt);
+  virtual bool rxOversizePkt(const ADARA::PacketHeader *hdr,
+                             const uint8_t *chunk, unsigned int chunk_offset,
+                             unsigned int chunk_len);
+
+private:
+  void init();
+  void exec();
+
+  /// The file being written
+  std::ofstream m_file;
+  /// The number of packets written
+  int64_t m_packets;
+  /// The number of neutron events written
+  int64_t m_events;
+};
+
+} // namespace LiveData
+} // namespace Mantid
+
+#endif /* MANTID_LIVEDATA_RECORDADARASTREAM_H_ */
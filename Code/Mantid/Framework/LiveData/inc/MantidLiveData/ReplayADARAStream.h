@@ -0,0 +1,110 @@
+#ifndef MANTID_LIVEDATA_REPLAYADARASTREAM_H_
+#define MANTID_LIVEDATA_REPLAYADARASTREAM_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/Algorithm.h"
+#include "MantidLiveData/ADARA/ADARAParser.h"
+
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/Timestamp.h>
+
+namespace Poco {
+namespace Net {
+class ServerSocket;
+}
+}
+
+namespace Mantid {
+namespace LiveData {
+/**
+    Serves a recorded ADARA stream, e.g. one captured by RecordADARAStream,
+    to a single client on a local port so that SNSLiveEventDataListener,
+    LoadLiveData and any post-processing can be run against real data away
+    from the beamline.
+
+    The packets are sent at the rate given by their timestamps, scaled by the
+    Speed property, or as fast as the client reads them if Speed is 0. The
+    rate at which events were sent is reported at the end.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+ */
+class DLLExport ReplayADARAStream : public API::Algorithm,
+                                    public ADARA::Parser {
+public:
+  ReplayADARAStream();
+  virtual ~ReplayADARAStream();
+
+  /// Algorithm's name for identification overriding a virtual method
+  virtual const std::string name() const { return "ReplayADARAStream"; }
+  /// Algorithm's version for identification overriding a virtual method
+  virtual int version() const { return 1; }
+  /// Algorithm's category for identification overriding a virtual method
+  virtual const std::string category() const {
+    return "DataHandling\\DataAcquisition";
+  }
+
+  /// Algorithm's summary
+  virtual const std::string summary() const {
+    return "Serves a recorded ADARA stream to a live listener on a local "
+           "port.";
+  }
+
+protected:
+  using ADARA::Parser::rxPacket;
+  virtual bool rxPacket(const ADARA::Packet &pkt);
+  virtual bool rxPacket(const ADARA::BankedEventPkt &pkt);
+  virtual bool rxOversizePkt(const ADARA::PacketHeader *hdr,
+                             const uint8_t *chunk, unsigned int chunk_offset,
+                             unsigned int chunk_len);
+
+private:
+  void init();
+  void exec();
+
+  void waitForClient(Poco::Net::ServerSocket &server);
+  void waitUntilDue(const ADARA::PacketHeader &hdr);
+  void sendAll(const uint8_t *data, unsigned int length);
+
+  /// The connection to the client
+  Poco::Net::StreamSocket m_client;
+  /// The speed multiplier; zero means no pacing
+  double m_speed;
+  /// When the first timestamped packet was sent
+  Poco::Timestamp m_wallStart;
+  /// The timestamp of the first packet, in seconds since the EPICS epoch
+  double m_streamStart;
+  /// The latest timestamp seen so far, in seconds since the EPICS epoch
+  double m_streamLatest;
+  /// The number of packets sent
+  int64_t m_packets;
+  /// The number of neutron events sent
+  int64_t m_events;
+  /// The number of bytes sent
+  int64_t m_bytes;
+};
+
+} // namespace LiveData
+} // namespace Mantid
+
+#endif /* MANTID_LIVEDATA_REPLAYADARASTREAM_H_ */
@@ -5,6 +5,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidLiveData/ADARA/ADARAParser.h"
+#include "MantidLiveData/PulseBatchQueue.h"
 #include "MantidAPI/ILiveListener.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/MultiThreaded.h"
@@ -65,6 +66,38 @@ public:
 
   virtual void run(); // the background thread.  What gets executed when we call
                       // POCO::Thread::start()
+
+  /// Counts of what has happened to the events taken from the network
+  struct DLLExport IngestStatistics {
+    IngestStatistics()
+        : pulses(0), events(0), droppedEvents(0), latePulses(0),
+          overflowPulses(0), overflowEvents(0), maxBacklog(0),
+          maxBacklogEvents(0), firstQueued(), lastExtracted(), latencies(),
+          nextLatency(0) {}
+    /// Remember how long a pulse waited to be extracted
+    void addLatency(const double seconds);
+    /// The latency, in seconds, that a percentage of recent pulses beat
+    double latencyPercentile(const double percent) const;
+    /// The mean number of events per second from the first pulse queued to
+    /// the last extractData()
+    double eventRate() const;
+
+    uint64_t pulses;        ///< Pulses added to extracted workspaces
+    uint64_t events;        ///< Events added to extracted workspaces
+    uint64_t droppedEvents; ///< Events thrown away, e.g. for an unknown pixel
+    uint64_t latePulses;    ///< Pulses that arrived after a later pulse
+    uint64_t overflowPulses; ///< Pulses thrown away because the queue was full
+    uint64_t overflowEvents; ///< The events in those pulses
+    size_t maxBacklog;       ///< Most pulses waiting for a single extractData()
+    size_t maxBacklogEvents; ///< Most events waiting for a single extractData()
+    Kernel::DateAndTime firstQueued;   ///< When the first pulse was queued
+    Kernel::DateAndTime lastExtracted; ///< When extractData() last ran
+    /// Seconds from queueing to extraction of the most recent pulses
+    std::vector<double> latencies;
+    size_t nextLatency; ///< The index in latencies to overwrite next
+  };
+  /// The statistics for every extractData() call so far
+  const IngestStatistics &ingestStatistics() const { return m_statistics; }
 protected:
   using ADARA::Parser::rxPacket;
   // virtual bool rxPacket( const ADARA::Packet &pkt);
@@ -115,7 +148,7 @@ private:
   // Returns true if we've got a value for every log listed in m_requiredLogs
   bool haveRequiredLogs();
 
-  void appendEvent(uint32_t pixelId, double tof,
+  void appendEvent(PulseBatch &batch, uint32_t pixelId, double tof,
                    const Mantid::Kernel::DateAndTime pulseTime);
   // tof is "Time Of Flight" and is in units of microsecondss relative to the
   // start of the pulse
@@ -126,6 +159,26 @@ private:
   // Both values are designed to be passed straight into the TofEvent
   // constructor.
 
+protected:
+  // The events of each pulse are collected in a PulseBatch by the background
+  // thread and handed to extractData() through m_pulseBatches without taking
+  // m_mutex.  Emptied batches go back through m_freeBatches to be reused.
+  // (Protected rather than private so that the tests can drive them.)
+  PulseBatch_sptr nextBatch();
+  void queueBatch(const PulseBatch_sptr &batch);
+  void drainBatches(DataObjects::EventWorkspace &workspace);
+
+private:
+  PulseBatchQueue m_pulseBatches;
+  PulseBatchQueue m_freeBatches;
+  size_t m_maxQueuedEvents; // The most events m_pulseBatches may hold
+  // Pulses and events thrown away by queueBatch() since it last queued a
+  // batch.  Only touched by the background thread.
+  size_t m_overflowPulses;
+  size_t m_overflowEvents;
+  Kernel::DateAndTime m_lastPulseTime; // Used to spot late pulses
+  IngestStatistics m_statistics;       // Only touched by extractData()
+
   ILiveListener::RunStatus m_status;
   int m_runNumber;
   DataObjects::EventWorkspace_sptr
@@ -151,7 +204,8 @@ private:
   bool m_isConnected;
 
   Poco::Thread m_thread;
-  Poco::FastMutex m_mutex; // protects m_buffer & m_status
+  Poco::FastMutex m_mutex; // protects m_buffer & m_status (but not the
+                           // events, which go through m_pulseBatches)
   bool m_pauseNetRead;
   bool
       m_stopThread; // background thread checks this periodically.  If true, the
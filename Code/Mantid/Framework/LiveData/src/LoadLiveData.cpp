@@ -229,7 +229,7 @@ void LoadLiveData::runPostProcessing() {
 
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by adding (summing) to the output workspace.
- * Calls the Plus algorithm
+ * Merges events in place, otherwise calls the Plus algorithm
  * Sets m_accumWS.
  *
  * @param chunkWS :: processed live data chunk workspace
@@ -293,7 +293,10 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
       accumMon += chunkMon;
   }
 
-  // Now do the main workspace
+  // Now do the main workspace. Events are merged in place if possible
+  if (addEventChunk(accumWS, chunkWS))
+    return;
+
   IAlgorithm_sptr alg = this->createChildAlgorithm(algoName);
   alg->setProperty("LHSWorkspace", accumWS);
   alg->setProperty("RHSWorkspace", chunkWS);
@@ -319,6 +322,53 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/**
+ * Add the events of a chunk straight into the accumulation workspace,
+ * rather than having Plus append them and doSortEvents() sort every list
+ * again. Each event list of the accumulation workspace stays sorted by TOF,
+ * so only the events of the chunk are sorted before being merged in. The
+ * merge is still linear in the length of each accumulated list, so an update
+ * costs less than before but still grows with the length of the run.
+ *
+ * @param accumWS :: accumulation workspace
+ * @param chunkWS :: processed live data chunk workspace
+ * @return false if the workspaces are not both EventWorkspaces with the same
+ *spectra, in which case nothing is done
+ */
+bool LoadLiveData::addEventChunk(Workspace_sptr accumWS,
+                                 Workspace_sptr chunkWS) {
+  EventWorkspace_sptr accumEW =
+      boost::dynamic_pointer_cast<EventWorkspace>(accumWS);
+  EventWorkspace_const_sptr chunkEW =
+      boost::dynamic_pointer_cast<const EventWorkspace>(chunkWS);
+  if (!accumEW || !chunkEW)
+    return false;
+
+  const size_t numHists = accumEW->getNumberHistograms();
+  if (chunkEW->getNumberHistograms() != numHists)
+    return false;
+  for (size_t i = 0; i < numHists; ++i) {
+    if (accumEW->getSpectrum(i)->getSpectrumNo() !=
+        chunkEW->getSpectrum(i)->getSpectrumNo())
+      return false;
+  }
+
+  CPUTimer tim;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(numHists); ++i) {
+    const EventList &chunkList = chunkEW->getEventList(i);
+    if (chunkList.getNumberEvents() > 0)
+      accumEW->getEventList(i).mergeByTof(chunkList);
+  }
+  // Proton charge and logs, as Plus would do
+  accumEW->mutableRun() += chunkEW->run();
+  accumEW->clearMRU();
+  g_log.debug() << tim << " to merge the chunk events into "
+                << accumEW->name() << std::endl;
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by replacing the output workspace.
  * Sets m_accumWS.
@@ -0,0 +1,70 @@
+#include "MantidLiveData/PulseBatchQueue.h"
+
+#include <stdexcept>
+
+namespace Mantid {
+namespace LiveData {
+
+void PulseBatch::clear() {
+  pulseTime = Kernel::DateAndTime();
+  protonCharge = 0.0;
+  indices.clear();
+  events.clear();
+  droppedEvents = 0;
+  late = false;
+  overflowPulses = 0;
+  overflowEvents = 0;
+  queued = Kernel::DateAndTime();
+}
+
+/// Constructor
+/// @param capacity :: The maximum number of batches that can wait in the queue
+PulseBatchQueue::PulseBatchQueue(const size_t capacity)
+    : m_slots(capacity), m_head(0), m_tail(0), m_count(0), m_events(0),
+      m_mutex() {
+  if (capacity == 0) {
+    throw std::invalid_argument("PulseBatchQueue needs a non-zero capacity");
+  }
+}
+
+/// @param batch :: The batch to add
+/// @return False if the queue is full and the batch was not added
+bool PulseBatchQueue::push(const PulseBatch_sptr &batch) {
+  Poco::FastMutex::ScopedLock lock(m_mutex);
+  if (m_count == m_slots.size())
+    return false;
+  m_slots[m_head] = batch;
+  m_head = (m_head + 1) % m_slots.size();
+  ++m_count;
+  m_events += batch->events.size();
+  return true;
+}
+
+/// @return The oldest batch, or an empty pointer if the queue is empty
+PulseBatch_sptr PulseBatchQueue::pop() {
+  PulseBatch_sptr batch;
+  Poco::FastMutex::ScopedLock lock(m_mutex);
+  if (m_count == 0)
+    return batch;
+  batch.swap(m_slots[m_tail]);
+  m_tail = (m_tail + 1) % m_slots.size();
+  --m_count;
+  m_events -= batch->events.size();
+  return batch;
+}
+
+/// @return The number of batches waiting. The other thread may change it.
+size_t PulseBatchQueue::size() const {
+  Poco::FastMutex::ScopedLock lock(m_mutex);
+  return m_count;
+}
+
+/// @return The number of events in the batches waiting. The other thread
+/// may change it.
+size_t PulseBatchQueue::events() const {
+  Poco::FastMutex::ScopedLock lock(m_mutex);
+  return m_events;
+}
+
+} // namespace LiveData
+} // namespace Mantid
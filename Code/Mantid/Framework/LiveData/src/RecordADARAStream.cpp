@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidLiveData/RecordADARAStream.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/MandatoryValidator.h"
+
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/Timestamp.h>
+
+#include <boost/lexical_cast.hpp>
+
+namespace Mantid {
+namespace LiveData {
+// Register the algorithm into the algorithm factory
+DECLARE_ALGORITHM(RecordADARAStream)
+
+using namespace Kernel;
+using namespace API;
+
+/// Constructor
+RecordADARAStream::RecordADARAStream()
+    : API::Algorithm(), ADARA::Parser(), m_file(), m_packets(0), m_events(0) {
+}
+
+/// Destructor
+RecordADARAStream::~RecordADARAStream() {}
+
+/**
+ * Declare the algorithm properties
+ */
+void RecordADARAStream::init() {
+  declareProperty("Address", "",
+                  boost::make_shared<MandatoryValidator<std::string>>(),
+                  "The host:port of the SMS daemon, e.g. the live data "
+                  "address of the instrument in Facilities.xml.");
+  std::vector<std::string> exts;
+  exts.push_back(".adara");
+  declareProperty(new FileProperty("Filename", "", FileProperty::Save, exts),
+                  "The file to write the packets to.");
+  auto mustBePositive = boost::make_shared<BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("Duration", 60.0, mustBePositive,
+                  "How many seconds to record for. 0 records until the "
+                  "algorithm is cancelled or the SMS closes the connection.");
+
+  declareProperty(new PropertyWithValue<int64_t>("NumberOfEvents", 0,
+                                                 Direction::Output),
+                  "The number of neutron events recorded.");
+}
+
+/**
+ * Execute the algorithm.
+ */
+void RecordADARAStream::exec() {
+  const std::string address = getPropertyValue("Address");
+  const std::string filename = getPropertyValue("Filename");
+  const double duration = getProperty("Duration");
+
+  m_file.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+  if (!m_file) {
+    throw Exception::FileError("Unable to open", filename);
+  }
+
+  Poco::Net::StreamSocket socket;
+  socket.connect(Poco::Net::SocketAddress(address));
+  socket.setReceiveTimeout(Poco::Timespan(1, 0));
+
+  // Ask for live data only, as SNSLiveEventDataListener does with no start
+  // time
+  uint32_t helloPkt[5] = {4, ADARA::PacketType::CLIENT_HELLO_V0, 0, 0, 0};
+  Poco::Timestamp now;
+  helloPkt[2] = (uint32_t)(now.epochTime() - ADARA::EPICS_EPOCH_OFFSET);
+  helloPkt[3] = (uint32_t)((now.epochMicroseconds() % 1000000) * 1000);
+  if (socket.sendBytes(helloPkt, sizeof(helloPkt)) != sizeof(helloPkt)) {
+    throw std::runtime_error("Failed to send the client hello packet to " +
+                             address);
+  }
+
+  m_packets = m_events = 0;
+  Poco::Timestamp started;
+  const Poco::Timestamp::TimeDiff limit =
+      static_cast<Poco::Timestamp::TimeDiff>(duration * 1e6);
+  while (limit == 0 || started.elapsed() < limit) {
+    try {
+      interruption_point();
+    } catch (CancelException &) {
+      break; // Keep what has been recorded so far
+    }
+
+    int bytesRead = 0;
+    try {
+      bytesRead = socket.receiveBytes(bufferFillAddress(),
+                                      static_cast<int>(bufferFillLength()));
+    } catch (Poco::TimeoutException &) {
+      continue;
+    }
+    if (bytesRead <= 0) {
+      g_log.information() << "The SMS closed the connection" << std::endl;
+      break;
+    }
+    bufferBytesAppended(bytesRead);
+    bufferParse();
+    progress(0.0, boost::lexical_cast<std::string>(m_events) + " events");
+  }
+  socket.close();
+  m_file.close();
+
+  g_log.notice() << "Recorded " << m_events << " events in " << m_packets
+                 << " packets to " << filename << std::endl;
+  setProperty("NumberOfEvents", m_events);
+}
+
+/// Write a packet to the file, then let the parser count its events
+bool RecordADARAStream::rxPacket(const ADARA::Packet &pkt) {
+  m_file.write(reinterpret_cast<const char *>(pkt.packet()),
+               pkt.packet_length());
+  ++m_packets;
+  return ADARA::Parser::rxPacket(pkt);
+}
+
+/// Count the events of a pulse
+bool RecordADARAStream::rxPacket(const ADARA::BankedEventPkt &pkt) {
+  const ADARA::Event *event = pkt.firstEvent();
+  while (event != NULL) {
+    // Bank IDs -1 and -2 hold events that were not mapped to a pixel
+    if (pkt.curBankId() < 0xFFFFFFFE)
+      ++m_events;
+    event = pkt.nextEvent();
+  }
+  return false;
+}
+
+/// Packets too large for the parser are written as they arrive
+bool RecordADARAStream::rxOversizePkt(const ADARA::PacketHeader *hdr,
+                                      const uint8_t *chunk, unsigned int,
+                                      unsigned int chunk_len) {
+  if (hdr)
+    ++m_packets;
+  m_file.write(reinterpret_cast<const char *>(chunk), chunk_len);
+  return false;
+}
+
+} // namespace LiveData
+} // namespace Mantid
@@ -0,0 +1,214 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidLiveData/ReplayADARAStream.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Thread.h>
+
+#include <fstream>
+
+namespace Mantid {
+namespace LiveData {
+// Register the algorithm into the algorithm factory
+DECLARE_ALGORITHM(ReplayADARAStream)
+
+using namespace Kernel;
+using namespace API;
+
+namespace {
+/// The size of each read from the file
+const unsigned int READ_SIZE = 64 * 1024;
+}
+
+/// Constructor
+ReplayADARAStream::ReplayADARAStream()
+    : API::Algorithm(), ADARA::Parser(), m_client(), m_speed(1.0),
+      m_wallStart(), m_streamStart(0.0), m_streamLatest(0.0), m_packets(0),
+      m_events(0), m_bytes(0) {}
+
+/// Destructor
+ReplayADARAStream::~ReplayADARAStream() {}
+
+/**
+ * Declare the algorithm properties
+ */
+void ReplayADARAStream::init() {
+  std::vector<std::string> exts;
+  exts.push_back(".adara");
+  exts.push_back(".dat");
+  declareProperty(
+      new FileProperty("Filename", "", FileProperty::Load, exts),
+      "A file of ADARA packets, as written by RecordADARAStream or the SMS.");
+  declareProperty(new PropertyWithValue<int>("Port", 31415, Direction::Input),
+                  "The port to serve the stream on (default 31415, the port "
+                  "that SNSLiveEventDataListener uses for localhost).");
+  auto mustBePositive = boost::make_shared<BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("Speed", 1.0, mustBePositive,
+                  "How many times faster than it was recorded to send the "
+                  "stream. 0 sends it as fast as the client reads it.");
+
+  declareProperty(new PropertyWithValue<int64_t>("NumberOfEvents", 0,
+                                                 Direction::Output),
+                  "The number of neutron events sent.");
+  declareProperty(
+      new PropertyWithValue<double>("Duration", 0.0, Direction::Output),
+      "The number of seconds taken to send the stream.");
+  declareProperty(
+      new PropertyWithValue<double>("EventRate", 0.0, Direction::Output),
+      "The mean number of events sent per second.");
+}
+
+/**
+ * Execute the algorithm.
+ */
+void ReplayADARAStream::exec() {
+  const std::string filename = getPropertyValue("Filename");
+  const int port = getProperty("Port");
+  m_speed = getProperty("Speed");
+
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (!file) {
+    throw Exception::FileError("Unable to open", filename);
+  }
+
+  Poco::Net::ServerSocket server(static_cast<Poco::UInt16>(port));
+  waitForClient(server);
+
+  m_streamStart = m_streamLatest = 0.0;
+  m_packets = m_events = m_bytes = 0;
+  Poco::Timestamp started;
+  while (file) {
+    interruption_point();
+
+    // Read straight into the parser's buffer; rxPacket() sends each
+    // complete packet on to the client
+    const unsigned int length = std::min(bufferFillLength(), READ_SIZE);
+    file.read(reinterpret_cast<char *>(bufferFillAddress()), length);
+    bufferBytesAppended(static_cast<unsigned int>(file.gcount()));
+    bufferParse();
+  }
+  m_client.shutdownSend();
+
+  const double duration = static_cast<double>(started.elapsed()) * 1e-6;
+  const double rate =
+      duration > 0.0 ? static_cast<double>(m_events) / duration : 0.0;
+  g_log.notice() << "Sent " << m_events << " events in " << m_packets
+                 << " packets (" << m_bytes << " bytes) in " << duration
+                 << " seconds: " << static_cast<int64_t>(rate)
+                 << " events/s" << std::endl;
+  setProperty("NumberOfEvents", m_events);
+  setProperty("Duration", duration);
+  setProperty("EventRate", rate);
+
+  // Give the client a chance to read the end of the stream before closing
+  Poco::Thread::sleep(100);
+  m_client.close();
+  server.close();
+}
+
+/**
+ * Wait, until cancelled, for a client to connect and read its hello packet.
+ * @param server :: The listening socket
+ */
+void ReplayADARAStream::waitForClient(Poco::Net::ServerSocket &server) {
+  progress(0.0, "Waiting for a client");
+  while (!server.poll(Poco::Timespan(0, 50000),
+                      Poco::Net::Socket::SELECT_READ)) {
+    interruption_point();
+  }
+  m_client = server.acceptConnection();
+  g_log.information() << "Client connected from "
+                      << m_client.peerAddress().toString() << std::endl;
+
+  // The client starts with a hello packet asking for historical data. It has
+  // to be read so that closing the socket does not reset the connection, but
+  // is otherwise ignored: the whole recording is always sent.
+  uint32_t hello[5];
+  m_client.setReceiveTimeout(Poco::Timespan(1, 0));
+  try {
+    m_client.receiveBytes(hello, sizeof(hello));
+  } catch (Poco::TimeoutException &) {
+    g_log.warning("The client did not send a hello packet");
+  }
+  progress(0.0, "Sending");
+}
+
+/**
+ * Sleep until a packet is due to be sent. Packets are sent at the rate given
+ * by their timestamps; a packet whose timestamp is earlier than one already
+ * sent is sent at once.
+ * @param hdr :: The header of the packet
+ */
+void ReplayADARAStream::waitUntilDue(const ADARA::PacketHeader &hdr) {
+  const double timestamp =
+      static_cast<double>(hdr.pulseId() >> 32) +
+      static_cast<double>(hdr.pulseId() & 0xFFFFFFFF) * 1e-9;
+  if (timestamp <= m_streamLatest)
+    return;
+  m_streamLatest = timestamp;
+  if (m_streamStart == 0.0) {
+    m_streamStart = timestamp;
+    m_wallStart.update();
+    return;
+  }
+  if (m_speed <= 0.0)
+    return;
+
+  const double due = (m_streamLatest - m_streamStart) / m_speed;
+  const double wait =
+      due - static_cast<double>(m_wallStart.elapsed()) * 1e-6;
+  if (wait > 0.001) {
+    Poco::Thread::sleep(static_cast<long>(wait * 1000.0));
+  }
+}
+
+/**
+ * Send a buffer to the client.
+ * @param data :: The start of the buffer
+ * @param length :: The number of bytes to send
+ */
+void ReplayADARAStream::sendAll(const uint8_t *data, unsigned int length) {
+  unsigned int sent = 0;
+  while (sent < length) {
+    sent += m_client.sendBytes(data + sent, static_cast<int>(length - sent));
+  }
+  m_bytes += length;
+}
+
+/// Send a packet when it is due, then let the parser count its events
+bool ReplayADARAStream::rxPacket(const ADARA::Packet &pkt) {
+  waitUntilDue(pkt);
+  sendAll(pkt.packet(), pkt.packet_length());
+  ++m_packets;
+  return ADARA::Parser::rxPacket(pkt);
+}
+
+/// Count the events of a pulse
+bool ReplayADARAStream::rxPacket(const ADARA::BankedEventPkt &pkt) {
+  const ADARA::Event *event = pkt.firstEvent();
+  while (event != NULL) {
+    // Bank IDs -1 and -2 hold events that were not mapped to a pixel
+    if (pkt.curBankId() < 0xFFFFFFFE)
+      ++m_events;
+    event = pkt.nextEvent();
+  }
+  return false;
+}
+
+/// Packets too large for the parser are passed on as they are, unpaced
+bool ReplayADARAStream::rxOversizePkt(const ADARA::PacketHeader *hdr,
+                                      const uint8_t *chunk, unsigned int,
+                                      unsigned int chunk_len) {
+  if (hdr)
+    ++m_packets;
+  sendAll(chunk, chunk_len);
+  return false;
+}
+
+} // namespace LiveData
+} // namespace Mantid
@@ -10,6 +10,8 @@
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/WriteLock.h"
 
+#include <boost/make_shared.hpp>
+
 #include <Poco/Net/NetException.h>
 #include <Poco/Net/StreamSocket.h>
 #include <Poco/Net/SocketStream.h>
@@ -25,6 +27,7 @@
 #include <Poco/Thread.h>
 #include <Poco/Runnable.h>
 
+#include <algorithm>
 #include <time.h>
 #include <sstream> // for ostringstream
 #include <string>
@@ -42,6 +45,19 @@ using namespace Mantid::API;
 #define SCAN_PROPERTY "scan_index"
 #define PROTON_CHARGE_PROPERTY "proton_charge"
 
+// Default for the number of events that can wait for extractData().  Can be
+// overridden with the livelistener.maxqueuedevents property.  (About 240MB,
+// as each event takes 24 bytes in a PulseBatch.)
+#define DEFAULT_MAX_QUEUED_EVENTS 10000000
+// Number of pulses that can wait for extractData().  The events are the real
+// limit; this only sizes the ring of pointers.  (Ten minutes at 60Hz.)
+#define MAX_QUEUED_PULSES 36000
+// Number of emptied pulse batches kept for reuse by the background thread
+#define MAX_FREE_BATCHES 64
+// Number of recent pulses whose latency is kept for the statistics (about
+// three minutes at 60Hz)
+#define LATENCY_SAMPLES 10000
+
 // Helper function to get a DateAndTime value from an ADARA packet header
 Mantid::Kernel::DateAndTime timeFromPacket(const ADARA::PacketHeader &hdr) {
   uint32_t seconds = (uint32_t)(hdr.pulseId() >> 32);
@@ -63,14 +79,63 @@ DECLARE_LISTENER(SNSLiveEventDataListener);
 namespace {
 /// static logger
 Kernel::Logger g_log("SNSLiveEventDataListener");
+
+/// The number of events that can wait for extractData()
+size_t maxQueuedEvents() {
+  int maxEvents = 0;
+  if (!ConfigService::Instance().getValue("livelistener.maxqueuedevents",
+                                          maxEvents) ||
+      maxEvents <= 0) {
+    maxEvents = DEFAULT_MAX_QUEUED_EVENTS;
+  }
+  return static_cast<size_t>(maxEvents);
+}
+}
+
+/// @param seconds :: How long the pulse waited between being queued by the
+/// network thread and being added to a workspace by extractData()
+void SNSLiveEventDataListener::IngestStatistics::addLatency(
+    const double seconds) {
+  if (latencies.size() < LATENCY_SAMPLES) {
+    latencies.push_back(seconds);
+  } else {
+    latencies[nextLatency] = seconds;
+  }
+  nextLatency = (nextLatency + 1) % LATENCY_SAMPLES;
+}
+
+/// @param percent :: The percentage of pulses, e.g. 50 for the median
+/// @return The latency in seconds, or 0 if no pulses have been extracted
+double SNSLiveEventDataListener::IngestStatistics::latencyPercentile(
+    const double percent) const {
+  if (latencies.empty())
+    return 0.0;
+  std::vector<double> sorted(latencies);
+  const double rank =
+      percent / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5;
+  const size_t n = std::min(static_cast<size_t>(std::max(rank, 0.0)),
+                            sorted.size() - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + n, sorted.end());
+  return sorted[n];
+}
+
+/// @return The rate in events per second, or 0 before the first extraction
+double SNSLiveEventDataListener::IngestStatistics::eventRate() const {
+  if (pulses == 0)
+    return 0.0;
+  const double seconds =
+      DateAndTime::secondsFromDuration(lastExtracted - firstQueued);
+  return seconds > 0.0 ? static_cast<double>(events) / seconds : 0.0;
 }
 
 /// Constructor
 SNSLiveEventDataListener::SNSLiveEventDataListener()
-    : ILiveListener(), ADARA::Parser(), m_status(NoRun), m_runNumber(0),
-      m_workspaceInitialized(false), m_socket(), m_isConnected(false),
-      m_pauseNetRead(false), m_stopThread(false), m_runPaused(false),
-      m_ignorePackets(true), m_filterUntilRunStart(false)
+    : ILiveListener(), ADARA::Parser(), m_pulseBatches(MAX_QUEUED_PULSES),
+      m_freeBatches(MAX_FREE_BATCHES), m_maxQueuedEvents(maxQueuedEvents()),
+      m_overflowPulses(0), m_overflowEvents(0), m_status(NoRun),
+      m_runNumber(0), m_workspaceInitialized(false), m_socket(),
+      m_isConnected(false), m_pauseNetRead(false), m_stopThread(false),
+      m_runPaused(false), m_ignorePackets(true), m_filterUntilRunStart(false)
 // ADARA::Parser() will accept values for buffer size and max packet size, but
 // the
 // defaults will work fine
@@ -93,6 +158,24 @@ SNSLiveEventDataListener::SNSLiveEventDataListener()
 
 /// Destructor
 SNSLiveEventDataListener::~SNSLiveEventDataListener() {
+  if (m_statistics.pulses > 0) {
+    g_log.notice() << "Ingested " << m_statistics.events << " events from "
+                   << m_statistics.pulses << " pulses at "
+                   << static_cast<int64_t>(m_statistics.eventRate())
+                   << " events/s. Pulse latency (s): median "
+                   << m_statistics.latencyPercentile(50.0) << ", 90% "
+                   << m_statistics.latencyPercentile(90.0) << ", 99% "
+                   << m_statistics.latencyPercentile(99.0) << ", max "
+                   << m_statistics.latencyPercentile(100.0) << std::endl;
+  }
+  if (m_statistics.overflowPulses > 0) {
+    g_log.notice() << "Threw away " << m_statistics.overflowEvents
+                   << " events from " << m_statistics.overflowPulses
+                   << " pulses because extractData() fell behind. At most "
+                   << m_statistics.maxBacklogEvents << " events waited"
+                   << std::endl;
+  }
+
   // Stop the background thread
   if (m_thread.isRunning()) {
     // Ask the thread to exit (and hope that it does - Poco doesn't
@@ -401,16 +484,22 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
   g_log.debug() << "----- Pulse ID: " << pkt.pulseId() << " -----\n";
   // Scope braces
   {
-    Poco::ScopedLock<Poco::FastMutex> scopedLock(m_mutex);
+    // The events go into a batch of their own that extractData() picks up
+    // later, so there's no need to lock the mutex
+    PulseBatch_sptr batch = nextBatch();
 
     // Timestamp for the events
     Mantid::Kernel::DateAndTime eventTime = timeFromPacket(pkt);
+    batch->pulseTime = eventTime;
+    if (eventTime < m_lastPulseTime) {
+      batch->late = true;
+    } else {
+      m_lastPulseTime = eventTime;
+    }
 
-    // Save the pulse charge in the logs (*10 because we want the units to be
+    // Save the pulse charge for the logs (*10 because we want the units to be
     // picoCulombs, and ADARA sends them out in units of 10pC)
-    m_eventBuffer->mutableRun()
-        .getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
-        ->addValue(eventTime, pkt.pulseCharge() * 10);
+    batch->protonCharge = pkt.pulseCharge() * 10;
 
     // Iterate through each event
     const ADARA::Event *event = pkt.firstEvent();
@@ -426,9 +515,9 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
         // appendEvent needs tof to be in units of microseconds, but it comes
         // from the ADARA stream in units of 100ns.
         if (pkt.getSourceCORFlag()) {
-          appendEvent(event->pixel, event->tof / 10.0, eventTime);
+          appendEvent(*batch, event->pixel, event->tof / 10.0, eventTime);
         } else {
-          appendEvent(event->pixel,
+          appendEvent(*batch, event->pixel,
                       (event->tof + pkt.getSourceTOFOffset()) / 10.0,
                       eventTime);
         }
@@ -443,7 +532,9 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
         eventsPerBank = 0;
       }
     }
-  } // mutex automatically unlocks here
+
+    queueBatch(batch);
+  }
 
   g_log.debug() << "Total Events: " << totalEvents << "\n";
   g_log.debug("-------------------------------");
@@ -1333,23 +1424,147 @@ bool SNSLiveEventDataListener::haveRequiredLogs() {
   return allFound;
 }
 
-/// Adds an event to the workspace
+/// Adds an event to the batch for the current pulse
 void SNSLiveEventDataListener::appendEvent(
-    uint32_t pixelId, double tof, const Mantid::Kernel::DateAndTime pulseTime)
-// NOTE: This function does NOT lock the mutex!  Make sure you do that
-// before calling this function!
-{
+    PulseBatch &batch, uint32_t pixelId, double tof,
+    const Mantid::Kernel::DateAndTime pulseTime) {
   // It'd be nice to use operator[], but we might end up inserting a value....
   // Have to use find() instead.
   detid2index_map::iterator it = m_indexMap.find(pixelId);
   if (it != m_indexMap.end()) {
-    std::size_t workspaceIndex = it->second;
-    Mantid::DataObjects::TofEvent event(tof, pulseTime);
-    m_eventBuffer->getEventList(workspaceIndex).addEventQuickly(event);
+    batch.indices.push_back(it->second);
+    batch.events.push_back(Mantid::DataObjects::TofEvent(tof, pulseTime));
   } else {
-    g_log.warning() << "Invalid pixel ID: " << pixelId << " (TofF: " << tof
-                    << " microseconds)" << std::endl;
+    // Reported by extractData().  A message per event would flood the log.
+    batch.droppedEvents++;
+  }
+}
+
+/// Returns an empty batch for the background thread to fill, reusing one
+/// that extractData() has finished with if there is one
+PulseBatch_sptr SNSLiveEventDataListener::nextBatch() {
+  PulseBatch_sptr batch = m_freeBatches.pop();
+  if (!batch) {
+    batch = boost::make_shared<PulseBatch>();
   }
+  return batch;
+}
+
+/// Hands a filled batch over to extractData()
+
+/// If queueing the batch would take the queue over m_maxQueuedEvents (or
+/// the ring is full) the batch is thrown away, proton charge and all, so the
+/// background thread never stops reading packets.  The pulses and events
+/// thrown away are counted in the next batch that is queued, so that
+/// extractData() can report them.
+/// @param batch The batch to queue
+void SNSLiveEventDataListener::queueBatch(const PulseBatch_sptr &batch) {
+  batch->queued = DateAndTime::getCurrentTime();
+  // A single pulse is always let into an empty queue, however big it is
+  const size_t queuedEvents = m_pulseBatches.events();
+  if (queuedEvents == 0 ||
+      queuedEvents + batch->events.size() <= m_maxQueuedEvents) {
+    batch->overflowPulses = m_overflowPulses;
+    batch->overflowEvents = m_overflowEvents;
+    if (m_pulseBatches.push(batch)) {
+      if (m_overflowPulses > 0) {
+        g_log.notice() << "Queueing pulses again after throwing away "
+                       << m_overflowEvents << " events from "
+                       << m_overflowPulses << " pulses" << std::endl;
+      }
+      m_overflowPulses = 0;
+      m_overflowEvents = 0;
+      return;
+    }
+  }
+
+  if (m_overflowPulses == 0) {
+    g_log.warning() << "extractData() has fallen behind with "
+                    << m_pulseBatches.events() << " events waiting. Pulses "
+                    << "will be thrown away until there is room "
+                    << "(see livelistener.maxqueuedevents)" << std::endl;
+  }
+  m_overflowPulses++;
+  m_overflowEvents += batch->events.size();
+}
+
+/// Moves the events of every queued batch into a workspace
+
+/// Called by extractData() only.  The proton charge of each pulse goes into
+/// the workspace's logs along with its events.
+/// @param workspace The workspace to fill
+void SNSLiveEventDataListener::drainBatches(
+    DataObjects::EventWorkspace &workspace) {
+  const size_t backlog = m_pulseBatches.size();
+  if (backlog > m_statistics.maxBacklog) {
+    m_statistics.maxBacklog = backlog;
+  }
+  const size_t backlogEvents = m_pulseBatches.events();
+  if (backlogEvents > m_statistics.maxBacklogEvents) {
+    m_statistics.maxBacklogEvents = backlogEvents;
+  }
+
+  TimeSeriesProperty<double> *protonCharge =
+      workspace.mutableRun().getTimeSeriesProperty<double>(
+          PROTON_CHARGE_PROPERTY);
+  const size_t numHistograms = workspace.getNumberHistograms();
+
+  IngestStatistics drained;
+  const DateAndTime now = DateAndTime::getCurrentTime();
+  PulseBatch_sptr batch;
+  while ((batch = m_pulseBatches.pop())) {
+    if (m_statistics.pulses == 0 && drained.pulses == 0) {
+      m_statistics.firstQueued = batch->queued;
+    }
+    m_statistics.addLatency(
+        DateAndTime::secondsFromDuration(now - batch->queued));
+    protonCharge->addValue(batch->pulseTime, batch->protonCharge);
+    for (size_t i = 0; i < batch->events.size(); ++i) {
+      const size_t index = batch->indices[i];
+      if (index < numHistograms) {
+        workspace.getEventList(index).addEventQuickly(batch->events[i]);
+        drained.events++;
+      } else {
+        drained.droppedEvents++;
+      }
+    }
+    drained.pulses++;
+    drained.droppedEvents += batch->droppedEvents;
+    if (batch->late) {
+      drained.latePulses++;
+    }
+    drained.overflowPulses += batch->overflowPulses;
+    drained.overflowEvents += batch->overflowEvents;
+
+    batch->clear();
+    m_freeBatches.push(batch); // If there's no room it's simply deleted
+  }
+
+  g_log.debug() << "Extracted " << drained.events << " events from "
+                << drained.pulses << " pulses\n";
+  if (drained.droppedEvents > 0) {
+    g_log.warning() << "Dropped " << drained.droppedEvents
+                    << " events with an invalid pixel ID" << std::endl;
+  }
+  if (drained.latePulses > 0) {
+    g_log.warning() << drained.latePulses
+                    << " pulses arrived out of time order" << std::endl;
+  }
+  if (drained.overflowPulses > 0) {
+    g_log.warning() << "Threw away " << drained.overflowEvents
+                    << " events and the proton charge of "
+                    << drained.overflowPulses << " pulses because more than "
+                    << m_maxQueuedEvents << " events were waiting"
+                    << std::endl;
+  }
+
+  m_statistics.pulses += drained.pulses;
+  m_statistics.events += drained.events;
+  m_statistics.droppedEvents += drained.droppedEvents;
+  m_statistics.latePulses += drained.latePulses;
+  m_statistics.overflowPulses += drained.overflowPulses;
+  m_statistics.overflowEvents += drained.overflowEvents;
+  m_statistics.lastExtracted = now;
 }
 
 /// Retrieve buffered data
@@ -1422,6 +1637,10 @@ boost::shared_ptr<Workspace> SNSLiveEventDataListener::extractData() {
     std::swap(m_eventBuffer, temp);
   } // mutex automatically unlocks here
 
+  // The background thread no longer touches the old buffer, so the events
+  // can be added to it without holding the mutex
+  drainBatches(*temp);
+
   return temp;
 }
 
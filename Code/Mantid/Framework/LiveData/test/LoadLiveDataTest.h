@@ -13,6 +13,9 @@
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidAPI/LiveListenerFactory.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidTestHelpers/FacilityHelper.h"
 #include "TestGroupDataListener.h"
 
@@ -22,6 +25,26 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
 
+//------------------------------------------------------------------------------------------------
+/** A listener that hands out a fixed list of workspaces, one per extractData() */
+class ChunkListener : public ILiveListener
+{
+public:
+  ChunkListener(const std::vector<Workspace_sptr> & chunks) : m_chunks(chunks), m_next(0) {}
+  std::string name() const { return "ChunkListener"; }
+  bool supportsHistory() const { return false; }
+  bool buffersEvents() const { return true; }
+  bool connect(const Poco::Net::SocketAddress&) { return true; }
+  void start(DateAndTime = DateAndTime()) {}
+  Workspace_sptr extractData() { return m_chunks.at(m_next++); }
+  bool isConnected() { return true; }
+  ILiveListener::RunStatus runStatus() { return Running; }
+  int runNumber() const { return 999; }
+private:
+  std::vector<Workspace_sptr> m_chunks;
+  size_t m_next;
+};
+
 class LoadLiveDataTest : public CxxTest::TestSuite
 {
 public:
@@ -154,6 +177,50 @@ public:
     TS_ASSERT( ws2->monitorWorkspace() );
   }
 
+  //--------------------------------------------------------------------------------------------
+  /** Adding event chunks in place must give what Plus followed by sorting gave */
+  void test_add_events_in_place_matches_Plus()
+  {
+    std::vector<Workspace_sptr> chunks;
+    chunks.push_back(makeEventChunk(0));
+    chunks.push_back(makeEventChunk(1));
+    ILiveListener_sptr listener(new ChunkListener(chunks));
+    doExec<EventWorkspace>("Add", "","","","",true, listener);
+    EventWorkspace_sptr ws = doExec<EventWorkspace>("Add", "","","","",true, listener);
+
+    IAlgorithm_sptr plus = AlgorithmManager::Instance().createUnmanaged("Plus");
+    plus->initialize();
+    plus->setChild(true);
+    plus->setProperty("LHSWorkspace", makeEventChunk(0));
+    plus->setProperty("RHSWorkspace", makeEventChunk(1));
+    plus->setPropertyValue("OutputWorkspace", "LoadLiveDataTest_plus");
+    plus->execute();
+    TS_ASSERT( plus->isExecuted() );
+    MatrixWorkspace_sptr plusOut = plus->getProperty("OutputWorkspace");
+    EventWorkspace_sptr expected = boost::dynamic_pointer_cast<EventWorkspace>(plusOut);
+    TS_ASSERT( expected );
+    if (!ws || !expected) return;
+    expected->sortAll(TOF_SORT, NULL);
+
+    TS_ASSERT_EQUALS( ws->getNumberEvents(), 200 );
+    TS_ASSERT_EQUALS( ws->getNumberEvents(), expected->getNumberEvents() );
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+    {
+      TS_ASSERT( ws->getEventList(i).isSortedByTof() );
+      TS_ASSERT( ws->getEventList(i).getEvents() == expected->getEventList(i).getEvents() );
+    }
+
+    const Run & run = ws->run();
+    const Run & expectedRun = expected->run();
+    TS_ASSERT_DELTA( run.getProtonCharge(), expectedRun.getProtonCharge(), 1e-12 );
+    TS_ASSERT_DELTA( run.getProtonCharge(), 4.0, 1e-12 );
+    TS_ASSERT_EQUALS( run.getTimeSeriesProperty<double>("proton_charge")->value(),
+                      expectedRun.getTimeSeriesProperty<double>("proton_charge")->value() );
+    TS_ASSERT_EQUALS( run.getTimeSeriesProperty<double>("SampleTemp")->value(),
+                      expectedRun.getTimeSeriesProperty<double>("SampleTemp")->value() );
+    TS_ASSERT_EQUALS( run.getTimeSeriesProperty<double>("SampleTemp")->size(), 4 );
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Make the test listener send out a "reset" signal. */
   void test_dataReset()
@@ -464,6 +531,39 @@ public:
       TS_ASSERT_EQUALS( std::accumulate( mws->readY(1).begin(), mws->readY(1).end(), 0.0, std::plus<double>() ), 16.0 );
       AnalysisDataService::Instance().clear();
   }
+
+private:
+  /// A chunk of 2 spectra of 50 events, distinct in TOF, with proton charge and
+  /// temperature logs. The same index always gives the same chunk.
+  EventWorkspace_sptr makeEventChunk(const int index)
+  {
+    EventWorkspace_sptr ws = boost::dynamic_pointer_cast<EventWorkspace>(
+        WorkspaceFactory::Instance().create("EventWorkspace", 2, 2, 1));
+    ws->getAxis(0)->setUnit("TOF");
+    ws->mutableRun().addProperty("run_number", std::string("999"));
+    const DateAndTime start = DateAndTime("2014-06-01T10:00:00") + 10.0 * index;
+    for (size_t i = 0; i < 2; ++i)
+    {
+      ws->getSpectrum(i)->setDetectorID(detid_t(i));
+      EventList & el = ws->getEventList(i);
+      for (int j = 0; j < 50; ++j)
+      {
+        const double tof = 1000. + ((j * 7919 + index * 31 + static_cast<int>(i) * 13) % 5000) + 0.25 * index;
+        el.addEventQuickly(TofEvent(tof, start + 0.01 * j));
+      }
+    }
+    TimeSeriesProperty<double> * charge = new TimeSeriesProperty<double>("proton_charge");
+    TimeSeriesProperty<double> * temp = new TimeSeriesProperty<double>("SampleTemp");
+    for (int j = 0; j < 2; ++j)
+    {
+      charge->addValue(start + 5.0 * j, 1.0);
+      temp->addValue(start + 5.0 * j, 290.0 + index + 0.5 * j);
+    }
+    ws->mutableRun().addProperty(charge);
+    ws->mutableRun().addProperty(temp);
+    ws->mutableRun().integrateProtonCharge();
+    return ws;
+  }
 };
 
 
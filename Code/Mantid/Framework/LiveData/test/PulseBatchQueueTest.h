@@ -0,0 +1,243 @@
+#ifndef MANTID_LIVEDATA_PULSEBATCHQUEUETEST_H_
+#define MANTID_LIVEDATA_PULSEBATCHQUEUETEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidLiveData/PulseBatchQueue.h"
+#include "MantidLiveData/SNSLiveEventDataListener.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+
+#include <boost/make_shared.hpp>
+#include <Poco/Runnable.h>
+#include <Poco/Thread.h>
+
+using namespace Mantid::LiveData;
+using Mantid::DataObjects::EventWorkspace;
+using Mantid::DataObjects::EventWorkspace_sptr;
+using Mantid::Kernel::DateAndTime;
+using Mantid::Kernel::TimeSeriesProperty;
+
+namespace {
+/// Gives the tests the listener's batch handling without a network
+class BatchingListener : public SNSLiveEventDataListener {
+public:
+  /// Queues a pulse with one event for each of the given indices
+  void queuePulse(const DateAndTime &time, const double charge,
+                  const std::vector<size_t> &indices) {
+    PulseBatch_sptr batch = nextBatch();
+    batch->pulseTime = time;
+    batch->protonCharge = charge;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      batch->indices.push_back(indices[i]);
+      batch->events.push_back(
+          Mantid::DataObjects::TofEvent(static_cast<double>(i), time));
+    }
+    queueBatch(batch);
+  }
+  void drain(EventWorkspace &workspace) { drainBatches(workspace); }
+};
+
+/// Pushes numbered batches onto a queue from another thread
+class BatchProducer : public Poco::Runnable {
+public:
+  BatchProducer(PulseBatchQueue &queue, const size_t count)
+      : m_queue(queue), m_count(count) {}
+  void run() {
+    for (size_t i = 0; i < m_count; ++i) {
+      PulseBatch_sptr batch = boost::make_shared<PulseBatch>();
+      batch->indices.push_back(i);
+      while (!m_queue.push(batch))
+        Poco::Thread::yield();
+    }
+  }
+
+private:
+  PulseBatchQueue &m_queue;
+  const size_t m_count;
+};
+}
+
+class PulseBatchQueueTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PulseBatchQueueTest *createSuite() { return new PulseBatchQueueTest(); }
+  static void destroySuite(PulseBatchQueueTest *suite) { delete suite; }
+
+  PulseBatchQueueTest() { Mantid::API::FrameworkManager::Instance(); }
+
+  void test_zero_capacity_throws() {
+    TS_ASSERT_THROWS(PulseBatchQueue(0), std::invalid_argument);
+  }
+
+  void test_batches_come_out_in_order_until_empty() {
+    PulseBatchQueue queue(2);
+    PulseBatch_sptr first = boost::make_shared<PulseBatch>();
+    PulseBatch_sptr second = boost::make_shared<PulseBatch>();
+    TS_ASSERT(!queue.pop());
+    TS_ASSERT(queue.push(first));
+    TS_ASSERT(queue.push(second));
+    TS_ASSERT_EQUALS(queue.size(), 2);
+    TS_ASSERT_EQUALS(queue.pop(), first);
+    TS_ASSERT_EQUALS(queue.pop(), second);
+    TS_ASSERT(!queue.pop());
+    TS_ASSERT_EQUALS(queue.size(), 0);
+  }
+
+  void test_push_fails_when_full_and_the_queue_wraps_around() {
+    PulseBatchQueue queue(2);
+    PulseBatch_sptr batch = boost::make_shared<PulseBatch>();
+    TS_ASSERT(queue.push(batch));
+    TS_ASSERT(queue.push(batch));
+    TS_ASSERT(!queue.push(batch));
+    TS_ASSERT(queue.pop());
+    TS_ASSERT(queue.push(batch));
+    TS_ASSERT_EQUALS(queue.size(), 2);
+  }
+
+  void test_events_are_counted_until_popped() {
+    PulseBatchQueue queue(4);
+    PulseBatch_sptr batch = boost::make_shared<PulseBatch>();
+    batch->events.resize(3);
+    TS_ASSERT(queue.push(batch));
+    TS_ASSERT(queue.push(boost::make_shared<PulseBatch>()));
+    TS_ASSERT(queue.push(batch));
+    TS_ASSERT_EQUALS(queue.events(), 6);
+    TS_ASSERT(queue.pop());
+    TS_ASSERT_EQUALS(queue.events(), 3);
+    TS_ASSERT(queue.pop());
+    TS_ASSERT(queue.pop());
+    TS_ASSERT_EQUALS(queue.events(), 0);
+  }
+
+  void test_clear_keeps_nothing_from_the_last_pulse() {
+    PulseBatch batch;
+    batch.protonCharge = 1.0;
+    batch.indices.push_back(3);
+    batch.events.push_back(Mantid::DataObjects::TofEvent(1.0));
+    batch.droppedEvents = 2;
+    batch.late = true;
+    batch.overflowPulses = 4;
+    batch.overflowEvents = 5;
+    batch.clear();
+    TS_ASSERT_EQUALS(batch.protonCharge, 0.0);
+    TS_ASSERT(batch.indices.empty());
+    TS_ASSERT(batch.events.empty());
+    TS_ASSERT_EQUALS(batch.droppedEvents, 0);
+    TS_ASSERT(!batch.late);
+    TS_ASSERT_EQUALS(batch.overflowPulses, 0);
+    TS_ASSERT_EQUALS(batch.overflowEvents, 0);
+  }
+
+  void test_batches_pass_between_threads_in_order() {
+    const size_t count = 10000;
+    PulseBatchQueue queue(16);
+    BatchProducer producer(queue, count);
+    Poco::Thread thread;
+    thread.start(producer);
+
+    size_t received = 0;
+    bool inOrder = true;
+    while (received < count) {
+      PulseBatch_sptr batch = queue.pop();
+      if (!batch) {
+        Poco::Thread::yield();
+        continue;
+      }
+      inOrder = inOrder && (batch->indices.front() == received);
+      ++received;
+    }
+    thread.join();
+    TS_ASSERT(inOrder);
+    TS_ASSERT(!queue.pop());
+  }
+
+  void test_listener_drains_events_and_proton_charge_into_the_workspace() {
+    BatchingListener listener;
+    const DateAndTime start("2014-06-01T10:00:00");
+    std::vector<size_t> indices;
+    indices.push_back(0);
+    indices.push_back(2);
+    indices.push_back(2);
+    listener.queuePulse(start, 10.0, indices);
+    indices.assign(1, 7); // Not a spectrum of the workspace
+    listener.queuePulse(start + 1.0, 20.0, indices);
+    listener.queuePulse(start + 0.5, 30.0, std::vector<size_t>());
+
+    EventWorkspace_sptr workspace = createBuffer();
+    listener.drain(*workspace);
+
+    TS_ASSERT_EQUALS(workspace->getEventList(0).getNumberEvents(), 1);
+    TS_ASSERT_EQUALS(workspace->getEventList(1).getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(workspace->getEventList(2).getNumberEvents(), 2);
+    TS_ASSERT_EQUALS(workspace->getEventList(2).getEvents()[1].pulseTime(),
+                     start);
+    auto *charge = workspace->run().getTimeSeriesProperty<double>(
+        "proton_charge");
+    TS_ASSERT_EQUALS(charge->size(), 3);
+    TS_ASSERT_DELTA(charge->nthValue(2), 20.0, 1e-12);
+
+    const SNSLiveEventDataListener::IngestStatistics &stats =
+        listener.ingestStatistics();
+    TS_ASSERT_EQUALS(stats.pulses, 3);
+    TS_ASSERT_EQUALS(stats.events, 3);
+    TS_ASSERT_EQUALS(stats.droppedEvents, 1);
+    TS_ASSERT_EQUALS(stats.overflowPulses, 0);
+    TS_ASSERT_EQUALS(stats.maxBacklog, 3);
+    TS_ASSERT_EQUALS(stats.maxBacklogEvents, 4);
+  }
+
+  void test_listener_reports_pulses_thrown_away_over_the_event_limit() {
+    Mantid::Kernel::ConfigService::Instance().setString(
+        "livelistener.maxqueuedevents", "4");
+    BatchingListener listener;
+    Mantid::Kernel::ConfigService::Instance().setString(
+        "livelistener.maxqueuedevents", "");
+    const DateAndTime start("2014-06-01T10:00:00");
+    const std::vector<size_t> three(3, 0);
+    const std::vector<size_t> two(2, 1);
+    // Fits, then two pulses that would take it over 4 are thrown away
+    listener.queuePulse(start, 1.0, three);
+    listener.queuePulse(start + 1.0, 2.0, two);
+    listener.queuePulse(start + 2.0, 3.0, three);
+    listener.queuePulse(start + 3.0, 4.0, std::vector<size_t>(1, 2));
+
+    EventWorkspace_sptr workspace = createBuffer();
+    listener.drain(*workspace);
+    TS_ASSERT_EQUALS(workspace->getNumberEvents(), 4);
+    TS_ASSERT_EQUALS(workspace->getEventList(1).getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(workspace->run()
+                         .getTimeSeriesProperty<double>("proton_charge")
+                         ->size(),
+                     2);
+    const SNSLiveEventDataListener::IngestStatistics &stats =
+        listener.ingestStatistics();
+    TS_ASSERT_EQUALS(stats.pulses, 2);
+    TS_ASSERT_EQUALS(stats.overflowPulses, 2);
+    TS_ASSERT_EQUALS(stats.overflowEvents, 5);
+
+    // Once drained, a pulse bigger than the limit still gets through
+    listener.queuePulse(start + 4.0, 5.0, std::vector<size_t>(6, 0));
+    workspace = createBuffer();
+    listener.drain(*workspace);
+    TS_ASSERT_EQUALS(workspace->getNumberEvents(), 6);
+    TS_ASSERT_EQUALS(listener.ingestStatistics().overflowPulses, 2);
+  }
+
+private:
+  /// An event workspace with 3 spectra and a proton charge log, as
+  /// extractData() hands to drainBatches()
+  EventWorkspace_sptr createBuffer() {
+    EventWorkspace_sptr workspace =
+        boost::dynamic_pointer_cast<EventWorkspace>(
+            Mantid::API::WorkspaceFactory::Instance().create("EventWorkspace",
+                                                             3, 2, 1));
+    workspace->mutableRun().addLogData(
+        new TimeSeriesProperty<double>("proton_charge"));
+    return workspace;
+  }
+};
+
+#endif /* MANTID_LIVEDATA_PULSEBATCHQUEUETEST_H_ */
@@ -0,0 +1,93 @@
+#ifndef MANTID_LIVEDATA_REPLAYADARASTREAMTEST_H_
+#define MANTID_LIVEDATA_REPLAYADARASTREAMTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidLiveData/ReplayADARAStream.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <Poco/ActiveResult.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Thread.h>
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include <fstream>
+
+using namespace Mantid::LiveData;
+using Mantid::Kernel::ConfigService;
+
+class ReplayADARAStreamTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ReplayADARAStreamTest *createSuite() { return new ReplayADARAStreamTest(); }
+  static void destroySuite( ReplayADARAStreamTest *suite ) { delete suite; }
+
+  ReplayADARAStreamTest()
+      : m_filename(Poco::Path(ConfigService::Instance().getTempDir(),
+                              "ReplayADARAStreamTest.adara").toString())
+  {
+  }
+
+  void test_Init()
+  {
+    ReplayADARAStream alg;
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    TS_ASSERT( alg.isInitialized() )
+  }
+
+  void test_packets_are_sent_unchanged_and_paced()
+  {
+    // Two heartbeats a second apart, so replaying at 10x takes 0.1s
+    const uint32_t packets[8] = {0, ADARA::PacketType::HEARTBEAT_V0, 1000, 0,
+                                 0, ADARA::PacketType::HEARTBEAT_V0, 1001, 0};
+    {
+      std::ofstream file(m_filename.c_str(), std::ios::binary);
+      file.write(reinterpret_cast<const char *>(packets), sizeof(packets));
+    }
+
+    ReplayADARAStream alg;
+    alg.initialize();
+    alg.setPropertyValue("Filename", m_filename);
+    alg.setProperty("Port", 31416);
+    alg.setProperty("Speed", 10.0);
+    Poco::ActiveResult<bool> result = alg.executeAsync();
+
+    Poco::Net::StreamSocket client;
+    Poco::Thread::sleep(100);
+    TS_ASSERT_THROWS_NOTHING(
+        client.connect(Poco::Net::SocketAddress("localhost:31416")) );
+    const uint32_t hello[5] = {4, ADARA::PacketType::CLIENT_HELLO_V0, 0, 0, 0};
+    client.sendBytes(hello, sizeof(hello));
+
+    uint32_t received[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    int length = 0;
+    while (length < static_cast<int>(sizeof(received)))
+    {
+      const int n = client.receiveBytes(reinterpret_cast<char *>(received) + length,
+                                        static_cast<int>(sizeof(received)) - length);
+      if (n <= 0) break;
+      length += n;
+    }
+    result.wait();
+    client.close();
+
+    TS_ASSERT( alg.isExecuted() )
+    TS_ASSERT_EQUALS( length, static_cast<int>(sizeof(packets)) );
+    TS_ASSERT_SAME_DATA( received, packets, sizeof(packets) );
+    const int64_t events = alg.getProperty("NumberOfEvents");
+    TS_ASSERT_EQUALS( events, 0 );
+    const double duration = alg.getProperty("Duration");
+    TS_ASSERT_LESS_THAN( 0.09, duration );
+
+    Poco::File(m_filename).remove();
+  }
+
+private:
+  std::string m_filename;
+};
+
+#endif /* MANTID_LIVEDATA_REPLAYADARASTREAMTEST_H_ */
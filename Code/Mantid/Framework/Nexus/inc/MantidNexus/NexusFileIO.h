@@ -83,6 +83,8 @@ public:
       const API::MatrixWorkspace_const_sptr &localworkspace,
       const bool &uniformSpectra, const std::vector<int> &spec,
       const char *group_name, bool write2Ddata) const;
+  /// The number of spectra stored together in one chunk of a 2D data set
+  static size_t spectraPerChunk(const size_t numberOfBins);
 
   /// write table workspace
   int writeNexusTableWorkspace(
@@ -133,6 +135,12 @@ private:
   int m_nexuscompression;
   /// Allow an externally supplied progress object to be used
   API::Progress *m_progress;
+  /// Write the given spectra of a workspace to the open 2D data set
+  template <class WorkspaceType>
+  void writeSpectraInChunks(
+      const WorkspaceType &workspace,
+      const MantidVec &(WorkspaceType::*readData)(const std::size_t) const,
+      const std::vector<int> &spec, const size_t chunkSpectra) const;
   /// Write a simple value plus possible attributes
   template <class TYPE>
   bool writeNxValue(const std::string &name, const TYPE &value,
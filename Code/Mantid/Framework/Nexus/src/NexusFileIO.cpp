@@ -21,6 +21,8 @@
 #include "MantidAPI/NumericAxis.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Profiler.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/TableColumn.h"
@@ -42,6 +44,28 @@ using namespace DataObjects;
 namespace {
 /// static logger
 Logger g_log("NexusFileIO");
+/// The size in bytes aimed for when choosing the chunking of a data set. A
+/// chunk this size fits comfortably in the default HDF5 chunk cache of 1MB.
+const size_t TARGET_CHUNK_BYTES = 512 * 1024;
+
+/// Returns the size in bytes of one element of the given NeXus type
+size_t nxTypeSize(const int datatype) {
+  switch (datatype) {
+  case NX_INT8:
+  case NX_UINT8:
+  case NX_CHAR:
+    return 1;
+  case NX_INT16:
+  case NX_UINT16:
+    return 2;
+  case NX_INT32:
+  case NX_UINT32:
+  case NX_FLOAT32:
+    return 4;
+  default:
+    return 8;
+  }
+}
 }
 
 /// Empty default constructor
@@ -84,6 +108,7 @@ void NexusFileIO::openNexusWrite(const std::string &fileName,
   // open named file and entry - file may exist
   // @throw Exception::FileError if cannot open Nexus file for writing
   //
+  ProfilerScope profile("NexusFileIO::openNexusWrite", "file I/O");
   NXaccess mode(NXACC_CREATE5);
   std::string mantidEntryName;
   m_filename = fileName;
@@ -290,6 +315,7 @@ int NexusFileIO::writeNexusProcessedData2D(
     const API::MatrixWorkspace_const_sptr &localworkspace,
     const bool &uniformSpectra, const std::vector<int> &spec,
     const char *group_name, bool write2Ddata) const {
+  ProfilerScope profile("NexusFileIO::writeNexusProcessedData2D", "file I/O");
   NXstatus status;
 
   // write data entry
@@ -339,17 +365,18 @@ int NexusFileIO::writeNexusProcessedData2D(
 
   // -------------- Actually write the 2D data ----------------------------
   if (write2Ddata) {
+    // Several spectra are stored in each chunk so that the compression works
+    // on large blocks and a reader fetching consecutive spectra decompresses
+    // each chunk only once
+    const size_t chunkSpectra =
+        std::min(spectraPerChunk(nSpectBins), std::max(nSpect, size_t(1)));
+    int chunk[2] = {static_cast<int>(chunkSpectra), dims_array[1]};
     std::string name = "values";
     NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
-                   m_nexuscompression, asize);
+                   m_nexuscompression, chunk);
     NXopendata(fileID, name.c_str());
-    for (size_t i = 0; i < nSpect; i++) {
-      int s = spec[i];
-      NXputslab(fileID, reinterpret_cast<void *>(const_cast<double *>(
-                            &(localworkspace->readY(s)[0]))),
-                start, asize);
-      start[0]++;
-    }
+    writeSpectraInChunks(*localworkspace, &MatrixWorkspace::readY, spec,
+                         chunkSpectra);
     if (m_progress != 0)
       m_progress->reportIncrement(1, "Writing data");
     int signal = 1;
@@ -372,16 +399,10 @@ int NexusFileIO::writeNexusProcessedData2D(
     // error
     name = "errors";
     NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
-                   m_nexuscompression, asize);
+                   m_nexuscompression, chunk);
     NXopendata(fileID, name.c_str());
-    start[0] = 0;
-    for (size_t i = 0; i < nSpect; i++) {
-      int s = spec[i];
-      NXputslab(fileID, reinterpret_cast<void *>(const_cast<double *>(
-                            &(localworkspace->readE(s)[0]))),
-                start, asize);
-      start[0]++;
-    }
+    writeSpectraInChunks(*localworkspace, &MatrixWorkspace::readE, spec,
+                         chunkSpectra);
     if (m_progress != 0)
       m_progress->reportIncrement(1, "Writing data");
 
@@ -391,16 +412,10 @@ int NexusFileIO::writeNexusProcessedData2D(
           boost::dynamic_pointer_cast<const RebinnedOutput>(localworkspace);
       name = "frac_area";
       NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
-                     m_nexuscompression, asize);
+                     m_nexuscompression, chunk);
       NXopendata(fileID, name.c_str());
-      start[0] = 0;
-      for (size_t i = 0; i < nSpect; i++) {
-        int s = spec[i];
-        NXputslab(fileID, reinterpret_cast<void *>(const_cast<double *>(
-                              &(rebin_workspace->readF(s)[0]))),
-                  start, asize);
-        start[0]++;
-      }
+      writeSpectraInChunks(*rebin_workspace, &RebinnedOutput::readF, spec,
+                           chunkSpectra);
       if (m_progress != 0)
         m_progress->reportIncrement(1, "Writing data");
     }
@@ -510,6 +525,55 @@ int NexusFileIO::writeNexusProcessedData2D(
   return ((status == NX_ERROR) ? 3 : 0);
 }
 
+/**
+ * The chunks hold whole spectra and are sized to be close to
+ * TARGET_CHUNK_BYTES.
+ * @param numberOfBins :: The number of values in each spectrum
+ * @returns The number of spectra to put in each chunk
+ */
+size_t NexusFileIO::spectraPerChunk(const size_t numberOfBins) {
+  const size_t spectrumBytes =
+      std::max(numberOfBins, size_t(1)) * sizeof(double);
+  return std::max(TARGET_CHUNK_BYTES / spectrumBytes, size_t(1));
+}
+
+/**
+ * Write a set of spectra to the currently open 2D data set. The spectra are
+ * gathered, in parallel when the workspace allows it, into a buffer holding
+ * one chunk at a time so that each call to NXputslab writes whole chunks.
+ * @param workspace :: The workspace holding the data
+ * @param readData :: The method returning one spectrum of the data to write
+ * @param spec :: The workspace indices of the spectra to write
+ * @param chunkSpectra :: The number of spectra in each chunk of the data set
+ */
+template <class WorkspaceType>
+void NexusFileIO::writeSpectraInChunks(
+    const WorkspaceType &workspace,
+    const MantidVec &(WorkspaceType::*readData)(const std::size_t) const,
+    const std::vector<int> &spec, const size_t chunkSpectra) const {
+  const size_t nSpect = spec.size();
+  if (nSpect == 0)
+    return;
+  const size_t nbins = (workspace.*readData)(spec[0]).size();
+  std::vector<double> buffer(std::min(chunkSpectra, nSpect) * nbins);
+  int start[2] = {0, 0};
+  int size[2] = {0, static_cast<int>(nbins)};
+  const bool threadSafe = workspace.threadSafe();
+
+  for (size_t first = 0; first < nSpect; first += chunkSpectra) {
+    const int64_t nblock =
+        static_cast<int64_t>(std::min(chunkSpectra, nSpect - first));
+    PARALLEL_FOR_IF(threadSafe)
+    for (int64_t i = 0; i < nblock; ++i) {
+      const MantidVec &values = (workspace.*readData)(spec[first + i]);
+      std::copy(values.begin(), values.end(), buffer.begin() + i * nbins);
+    }
+    start[0] = static_cast<int>(first);
+    size[0] = static_cast<int>(nblock);
+    NXputslab(fileID, &buffer[0], start, size);
+  }
+}
+
 //-------------------------------------------------------------------------------------
 /**
   * Save a numeric columns of a TableWorkspace to currently open nexus file.
@@ -634,6 +698,7 @@ void NexusFileIO::writeNexusVectorColumn(
 int NexusFileIO::writeNexusTableWorkspace(
     const API::ITableWorkspace_const_sptr &itableworkspace,
     const char *group_name) const {
+  ProfilerScope profile("NexusFileIO::writeNexusTableWorkspace", "file I/O");
   NXstatus status = 0;
 
   boost::shared_ptr<const TableWorkspace> tableworkspace =
@@ -743,6 +808,8 @@ int NexusFileIO::writeNexusProcessedDataEventCombined(
     const DataObjects::EventWorkspace_const_sptr &ws,
     std::vector<int64_t> &indices, double *tofs, float *weights,
     float *errorSquareds, int64_t *pulsetimes, bool compress) const {
+  ProfilerScope profile("NexusFileIO::writeNexusProcessedDataEventCombined",
+                        "file I/O");
   NXopengroup(fileID, "event_workspace", "NXdata");
 
   // The array of indices for each event list #
@@ -814,9 +881,17 @@ void NexusFileIO::NXwritedata(const char *name, int datatype, int rank,
                               int *dims_array, void *data,
                               bool compress) const {
   if (compress) {
-    // We'll use the same slab/buffer size as the size of the array
+    // Chunk along the first dimension only, limiting the size of a chunk so
+    // that large arrays are not compressed as a single block
+    std::vector<int> chunk(dims_array, dims_array + rank);
+    size_t rowBytes = nxTypeSize(datatype);
+    for (int i = 1; i < rank; ++i)
+      rowBytes *= static_cast<size_t>(dims_array[i]);
+    const size_t maxRows = std::max(TARGET_CHUNK_BYTES / rowBytes, size_t(1));
+    if (chunk[0] > 0 && static_cast<size_t>(chunk[0]) > maxRows)
+      chunk[0] = static_cast<int>(maxRows);
     NXcompmakedata(fileID, name, datatype, rank, dims_array, m_nexuscompression,
-                   dims_array);
+                   &chunk[0]);
   } else {
     // Write uncompressed.
     NXmakedata(fileID, name, datatype, rank, dims_array);
@@ -0,0 +1,53 @@
+#ifndef MANTID_PYTHONINTERFACE_WRAPMATRIXWORKSPACE_H_
+#define MANTID_PYTHONINTERFACE_WRAPMATRIXWORKSPACE_H_
+/*
+  Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>.
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+#include <boost/python/object.hpp> //Safer way to include Python.h
+
+namespace Mantid {
+namespace PythonInterface {
+//** @name Numpy views of data*/
+///{
+/// Wrap the X values of a spectrum in a read-only numpy array
+PyObject *wrapReadX(const boost::python::object &self, const size_t index);
+/// Wrap the Y values of a spectrum in a read-only numpy array
+PyObject *wrapReadY(const boost::python::object &self, const size_t index);
+/// Wrap the E values of a spectrum in a read-only numpy array
+PyObject *wrapReadE(const boost::python::object &self, const size_t index);
+/// Wrap the Dx values of a spectrum in a read-only numpy array
+PyObject *wrapReadDx(const boost::python::object &self, const size_t index);
+/// Wrap the X values of a spectrum in a writable numpy array
+PyObject *wrapDataX(const boost::python::object &self, const size_t index);
+/// Wrap the Y values of a spectrum in a writable numpy array
+PyObject *wrapDataY(const boost::python::object &self, const size_t index);
+/// Wrap the E values of a spectrum in a writable numpy array
+PyObject *wrapDataE(const boost::python::object &self, const size_t index);
+/// Wrap the Dx values of a spectrum in a writable numpy array
+PyObject *wrapDataDx(const boost::python::object &self, const size_t index);
+/// Copy the TOFs of an event list into a read-only numpy array
+PyObject *wrapReadTofs(const boost::python::object &self, const size_t index);
+///@}
+}
+}
+
+#endif /* MANTID_PYTHONINTERFACE_WRAPMATRIXWORKSPACE_H_ */
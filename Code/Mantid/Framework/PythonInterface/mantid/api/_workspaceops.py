@@ -20,6 +20,9 @@ def attach_binary_operators_to_workspace():
     def add_operator_func(attr, algorithm, inplace, reverse):
         # Wrapper for the function call
         def op_wrapper(self, other):
+            # Let a WorkspaceExpression on the other side build the deferred expression
+            if isinstance(other, _api.WorkspaceExpression):
+                return NotImplemented
             # Get the result variable to know what to call the output
             result_info = lhs_info()
             # Pass off to helper
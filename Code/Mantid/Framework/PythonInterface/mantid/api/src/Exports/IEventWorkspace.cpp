@@ -1,14 +1,50 @@
 #include "MantidAPI/IEventWorkspace.h"
 #include "MantidAPI/IEventList.h"
+#include "MantidPythonInterface/api/WrapMatrixWorkspace.h"
+#include "MantidPythonInterface/kernel/Converters/NDArrayToVector.h"
+#include "MantidPythonInterface/kernel/Converters/PySequenceToVector.h"
 #include "MantidPythonInterface/kernel/Registry/DataItemInterface.h"
 
+#include <boost/lexical_cast.hpp>
 #include <boost/python/class.hpp>
 #include <boost/python/object.hpp>
 
+// See http://docs.scipy.org/doc/numpy/reference/c-api.array.html#PY_ARRAY_UNIQUE_SYMBOL
+#define PY_ARRAY_UNIQUE_SYMBOL API_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+
 using namespace Mantid::API;
 using Mantid::PythonInterface::Registry::DataItemInterface;
 using namespace boost::python;
 
+namespace Converters = Mantid::PythonInterface::Converters;
+
+namespace
+{
+  /**
+   * Replace the TOFs of the events at the given index. The list is marked as
+   * unsorted and the histograms cached from the old TOFs are cleared.
+   * @param self :: A reference to the calling object
+   * @param wsIndex :: The workspace index of the event list
+   * @param values :: A numpy array or sequence with one TOF per event
+   */
+  void setTofsFromPyObject(IEventWorkspace & self, const size_t wsIndex, const object & values)
+  {
+    const std::vector<double> tofs = PyArray_Check(values.ptr()) ?
+      Converters::NDArrayToVector<double>(values)() : Converters::PySequenceToVector<double>(values)();
+    IEventList *eventList = self.getEventListPtr(wsIndex);
+    const size_t nevents = eventList->getNumberEvents();
+    if(tofs.size() != nevents)
+    {
+      throw std::invalid_argument("Length mismatch between event list & python array. events="
+            + boost::lexical_cast<std::string>(nevents) + ", python=" + boost::lexical_cast<std::string>(tofs.size()));
+    }
+    eventList->setTofs(tofs);
+    self.clearMRU();
+  }
+}
+
 /**
  * Python exports of the Mantid::API::IEventWorkspace class.
  */
@@ -23,6 +59,11 @@ void export_IEventWorkspace()
          "Returns the maximum TOF value (in microseconds) held by the workspace")
     .def("getEventList", (IEventList*(IEventWorkspace::*)(const int) ) &IEventWorkspace::getEventListPtr,
          return_internal_reference<>(), args("self", "workspace_index"), "Return the event list managing the events at the given workspace index")
+    .def("readTofs", &Mantid::PythonInterface::wrapReadTofs, args("self", "workspace_index"),
+         "Returns a read-only numpy array holding a copy of the TOF values of the events at the given index.")
+    .def("setTofs", &setTofsFromPyObject, args("self", "workspace_index", "tofs"),
+         "Replaces the TOF values of the events at the given index. There must be one value per event. "
+         "The list is marked as unsorted.")
     .def("clearMRU", &IEventWorkspace::clearMRU, args("self"), "Clear the most-recently-used lists")
     ;
 
@@ -2,9 +2,9 @@
 #include "MantidAPI/WorkspaceOpOverloads.h"
 
 #include "MantidPythonInterface/api/CloneMatrixWorkspace.h"
-#include "MantidPythonInterface/kernel/Converters/WrapWithNumpy.h"
+#include "MantidPythonInterface/api/WrapMatrixWorkspace.h"
+#include "MantidPythonInterface/kernel/Converters/NDArrayToVector.h"
 #include "MantidPythonInterface/kernel/Policies/RemoveConst.h"
-#include "MantidPythonInterface/kernel/Policies/VectorToNumpy.h"
 #include "MantidPythonInterface/kernel/Registry/DataItemInterface.h"
 
 #include <boost/python/class.hpp>
@@ -13,6 +13,11 @@
 #include <boost/python/implicit.hpp>
 #include <boost/python/numeric.hpp>
 
+// See http://docs.scipy.org/doc/numpy/reference/c-api.array.html#PY_ARRAY_UNIQUE_SYMBOL
+#define PY_ARRAY_UNIQUE_SYMBOL API_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -27,11 +32,6 @@ namespace
   /// Typedef for data access, i.e. dataX,Y,E members
   typedef Mantid::MantidVec&(MatrixWorkspace::*data_modifier)(const std::size_t);
 
-  /// return_value_policy for read-only numpy array
-  typedef return_value_policy<Policies::VectorRefToNumpy<Converters::WrapReadOnly> > return_readonly_numpy;
-  /// return_value_policy for read-write numpy array
-  typedef return_value_policy<Policies::VectorRefToNumpy<Converters::WrapReadWrite> > return_readwrite_numpy;
-
   //------------------------------- Overload macros ---------------------------
   // Overloads for binIndexOf function which has 1 optional argument
   BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(MatrixWorkspace_binIndexOfOverloads,
@@ -62,9 +62,18 @@ namespace
       throw std::invalid_argument("Length mismatch between workspace array & python array. ws="
             + boost::lexical_cast<std::string>(wsArrayLength) + ", python=" + boost::lexical_cast<std::string>(pyArrayLength));
     }
-    for(size_t i = 0; i < wsArrayLength; ++i)
+    if( PyArray_Check(values.ptr()) )
+    {
+      // Copy straight from the array memory rather than extracting each element
+      const std::vector<double> converted = Converters::NDArrayToVector<double>(values)();
+      std::copy(converted.begin(), converted.end(), wsArrayRef.begin());
+    }
+    else
     {
-      wsArrayRef[i] = extract<double>(values[i]);
+      for(size_t i = 0; i < wsArrayLength; ++i)
+      {
+        wsArrayRef[i] = extract<double>(values[i]);
+      }
     }
   }
 
@@ -183,30 +192,32 @@ void export_MatrixWorkspace()
     .def("replaceAxis", &MatrixWorkspace::replaceAxis, args("self", "axisIndex", "newAxis"))
 
     //--------------------------------------- Read spectrum data -------------------------
-    .def("readX", &MatrixWorkspace::readX, return_readonly_numpy(),
+    .def("readX", &Mantid::PythonInterface::wrapReadX,
           args("self", "workspaceIndex"), 
          "Creates a read-only numpy wrapper around the original X data at the given index")
-    .def("readY", &MatrixWorkspace::readY, return_readonly_numpy(),
+    .def("readY", &Mantid::PythonInterface::wrapReadY,
          args("self", "workspaceIndex"),  
-         "Creates a read-only numpy wrapper around the original Y data at the given index")
-    .def("readE", &MatrixWorkspace::readE, return_readonly_numpy(),
+         "Creates a read-only numpy wrapper around the original Y data at the given index. "
+         "For an event workspace the values are copied")
+    .def("readE", &Mantid::PythonInterface::wrapReadE,
           args("self", "workspaceIndex"), 
-         "Creates a read-only numpy wrapper around the original E data at the given index")
-    .def("readDx", &MatrixWorkspace::readDx, return_readonly_numpy(),
+         "Creates a read-only numpy wrapper around the original E data at the given index. "
+         "For an event workspace the values are copied")
+    .def("readDx", &Mantid::PythonInterface::wrapReadDx,
          args("self", "workspaceIndex"), 
          "Creates a read-only numpy wrapper around the original Dx data at the given index")
 
     //--------------------------------------- Write spectrum data ------------------------
-    .def("dataX", (data_modifier)&MatrixWorkspace::dataX, return_readwrite_numpy(),
+    .def("dataX", &Mantid::PythonInterface::wrapDataX,
          args("self", "workspaceIndex"), 
          "Creates a writable numpy wrapper around the original X data at the given index")
-    .def("dataY", (data_modifier)&MatrixWorkspace::dataY, return_readwrite_numpy(),
+    .def("dataY", &Mantid::PythonInterface::wrapDataY,
          args("self", "workspaceIndex"), 
          "Creates a writable numpy wrapper around the original Y data at the given index")
-    .def("dataE", (data_modifier)&MatrixWorkspace::dataE, return_readwrite_numpy(),
+    .def("dataE", &Mantid::PythonInterface::wrapDataE,
          args("self", "workspaceIndex"), 
          "Creates a writable numpy wrapper around the original E data at the given index")
-    .def("dataDx", (data_modifier)&MatrixWorkspace::dataDx, return_readwrite_numpy(),
+    .def("dataDx", &Mantid::PythonInterface::wrapDataDx,
         args("self", "workspaceIndex"), 
          "Creates a writable numpy wrapper around the original Dx data at the given index")
     .def("setX", &setXFromPyObject, args("self", "workspaceIndex", "x"), 
@@ -223,10 +234,12 @@ void export_MatrixWorkspace()
          "of memory free that will fit all of the data.")
     .def("extractY", Mantid::PythonInterface::cloneY, args("self"),
          "Extracts (copies) the Y data from the workspace into a 2D numpy array. "
+         "There is no 2D view as each spectrum is stored separately. "
          "Note: This can fail for large workspaces as numpy will require a block "
          "of memory free that will fit all of the data.")
     .def("extractE", Mantid::PythonInterface::cloneE, args("self"),
          "Extracts (copies) the E data from the workspace into a 2D numpy array. "
+         "There is no 2D view as each spectrum is stored separately. "
          "Note: This can fail for large workspaces as numpy will require a block "
          "of memory free that will fit all of the data.")
     .def("extractDx", Mantid::PythonInterface::cloneDx, args("self"),
@@ -0,0 +1,76 @@
+#include "MantidAPI/WorkspaceExpression.h"
+#include "MantidPythonInterface/kernel/Policies/DowncastingPolicies.h"
+
+#include <boost/python/class.hpp>
+#include <boost/python/make_constructor.hpp>
+#include <boost/python/operators.hpp>
+#include <boost/python/return_value_policy.hpp>
+
+using Mantid::API::MatrixWorkspace_sptr;
+using Mantid::API::WorkspaceExpression;
+using namespace boost::python;
+namespace Policies = Mantid::PythonInterface::Policies;
+
+namespace
+{
+  /**
+   * Creates an expression from a workspace. The C++ class also accepts a pointer to a const
+   * workspace, which Python cannot distinguish, so only the non-const form is exposed.
+   * @param workspace :: The workspace
+   * @return A new expression
+   */
+  WorkspaceExpression * createFromWorkspace(const MatrixWorkspace_sptr & workspace)
+  {
+    return new WorkspaceExpression(workspace);
+  }
+
+  /// Creates an expression from a value and an optional error
+  WorkspaceExpression * createFromValue(const double value, const double error)
+  {
+    return new WorkspaceExpression(value, error);
+  }
+
+  /// The overload of evaluate that has no calling algorithm
+  typedef MatrixWorkspace_sptr (WorkspaceExpression::*EvaluateFunction)() const;
+}
+
+void export_WorkspaceExpression()
+{
+  class_<WorkspaceExpression>("WorkspaceExpression", 
+                              "A deferred chain of workspace arithmetic that is computed in a single pass by evaluate()",
+                              no_init)
+    .def("__init__", make_constructor(&createFromWorkspace, default_call_policies(), (arg("workspace"))))
+    .def("__init__", make_constructor(&createFromValue, default_call_policies(), (arg("value"), arg("error")=0.0)))
+    .def("evaluate", (EvaluateFunction)&WorkspaceExpression::evaluate, return_value_policy<Policies::ToSharedPtrWithDowncast>(),
+         "Computes the expression into a new workspace. Nothing is added to the AnalysisDataService")
+    .def("numberOfOperations", &WorkspaceExpression::numberOfOperations,
+         "Returns the number of operations that will be fused into a single pass")
+    .def("isFused", &WorkspaceExpression::isFused,
+         "Returns True if evaluate() computes the expression in a single pass, False if it runs the algorithms")
+    .def("power", &Mantid::API::power, (arg("self"), arg("exponent")),
+         "Returns an expression that raises each value to the given power")
+    .def("exponential", &Mantid::API::exponential, (arg("self")),
+         "Returns an expression that takes the exponential of each value")
+    .def("__str__", &WorkspaceExpression::toString)
+    .def(self + self)
+    .def(self + double())
+    .def(double() + self)
+    .def(self + other<MatrixWorkspace_sptr>())
+    .def(other<MatrixWorkspace_sptr>() + self)
+    .def(self - self)
+    .def(self - double())
+    .def(double() - self)
+    .def(self - other<MatrixWorkspace_sptr>())
+    .def(other<MatrixWorkspace_sptr>() - self)
+    .def(self * self)
+    .def(self * double())
+    .def(double() * self)
+    .def(self * other<MatrixWorkspace_sptr>())
+    .def(other<MatrixWorkspace_sptr>() * self)
+    .def(self / self)
+    .def(self / double())
+    .def(double() / self)
+    .def(self / other<MatrixWorkspace_sptr>())
+    .def(other<MatrixWorkspace_sptr>() / self)
+    ;
+}
@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidPythonInterface/api/WrapMatrixWorkspace.h"
+#include "MantidPythonInterface/kernel/WeakPtr.h"
+#include "MantidAPI/IEventList.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+
+#include <boost/python/extract.hpp>
+
+#include <cstring>
+
+// See http://docs.scipy.org/doc/numpy/reference/c-api.array.html#PY_ARRAY_UNIQUE_SYMBOL
+#define PY_ARRAY_UNIQUE_SYMBOL API_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+
+namespace Mantid
+{
+  namespace PythonInterface
+  {
+    using Mantid::API::IEventList;
+    using Mantid::API::IEventWorkspace;
+    using Mantid::API::MatrixWorkspace;
+    using Mantid::API::Workspace;
+    using Mantid::API::Workspace_sptr;
+    namespace bpl = boost::python;
+
+    // ----------------------------------------------------------------------------------------------------------
+    namespace
+    {
+      /// Typedef for the read-only data accessors, i.e. readX,Y,E
+      typedef const MantidVec & (MatrixWorkspace::*data_accessor)(const size_t) const;
+      /// Typedef for the writable data accessors, i.e. dataX,Y,E
+      typedef MantidVec & (MatrixWorkspace::*data_modifier)(const size_t);
+
+      /**
+       * Get a shared reference to the workspace from the smart pointer held by
+       * a Python object, if it holds one to a T
+       * @param self :: The Python object wrapping the workspace
+       * @param owner :: Set to the workspace if the held type is T
+       * @returns True if self holds a pointer to a T
+       */
+      template<typename T>
+      bool heldWorkspace(const bpl::object &self, Workspace_sptr &owner)
+      {
+        bpl::extract<boost::weak_ptr<T>&> weak(self);
+        if(weak.check())
+        {
+          owner = weak().lock();
+          return true;
+        }
+        bpl::extract<boost::shared_ptr<T>&> shared(self);
+        if(shared.check())
+        {
+          owner = shared();
+          return true;
+        }
+        return false;
+      }
+
+      /**
+       * Find a Python object that keeps the workspace alive.
+       * Workspaces handed out by the ADS are only weakly referenced from Python
+       * so that they can be deleted from it. An array that outlives such a
+       * reference would point at freed memory, so take a shared reference from
+       * the pointer that self holds instead.
+       * @param self :: The Python object wrapping the workspace
+       * @returns An object owning a reference to the workspace
+       */
+      bpl::object findOwner(const bpl::object &self)
+      {
+        Workspace_sptr owner;
+        if(heldWorkspace<IEventWorkspace>(self, owner) || heldWorkspace<MatrixWorkspace>(self, owner) ||
+           heldWorkspace<Workspace>(self, owner))
+        {
+          if(owner) return bpl::object(owner);
+        }
+        return self;
+      }
+
+      /**
+       * Create a 1D numpy array over memory owned by a workspace. The array
+       * holds a reference to the owner so the memory stays valid for as long
+       * as the array exists.
+       * @param data :: The first value
+       * @param length :: The number of values
+       * @param stride :: The number of bytes between values
+       * @param writable :: If false the array is marked read-only
+       * @param owner :: An object keeping the memory alive
+       * @returns A new reference to the array
+       */
+      PyObject *wrapMemory(const double *data, const size_t length, const size_t stride,
+                           const bool writable, const bpl::object &owner)
+      {
+        npy_intp dims[1] = { static_cast<npy_intp>(length) };
+        npy_intp strides[1] = { static_cast<npy_intp>(stride) };
+        int flags = NPY_ALIGNED;
+        if(writable) flags |= NPY_WRITEABLE;
+        PyObject *nparray = PyArray_New(&PyArray_Type, 1, dims, NPY_DOUBLE, strides,
+                                        const_cast<double*>(data), 0, flags, NULL);
+        if(!nparray) bpl::throw_error_already_set();
+        // The array steals the reference
+        PyObject *base = bpl::incref(owner.ptr());
+        #if NPY_API_VERSION >= 0x00000007 //(1.7)
+          PyArray_SetBaseObject((PyArrayObject*)nparray, base);
+        #else
+          PyArray_BASE(nparray) = base;
+        #endif
+        return nparray;
+      }
+
+      /**
+       * Copy values, stride bytes apart, into a new read-only numpy array
+       * @param data :: The first value
+       * @param length :: The number of values
+       * @param stride :: The number of bytes between values
+       * @returns A new reference to the array
+       */
+      PyObject *copyToReadOnly(const double *data, const size_t length, const size_t stride)
+      {
+        npy_intp dims[1] = { static_cast<npy_intp>(length) };
+        PyObject *nparray = PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+        if(!nparray) bpl::throw_error_already_set();
+        double *dest = static_cast<double*>(PyArray_DATA((PyArrayObject*)nparray));
+        if(stride == sizeof(double))
+        {
+          if(length > 0) std::memcpy(dest, data, length * sizeof(double));
+        }
+        else
+        {
+          const char *src = reinterpret_cast<const char*>(data);
+          for(size_t i = 0; i < length; ++i, src += stride)
+          {
+            dest[i] = *reinterpret_cast<const double*>(src);
+          }
+        }
+        #if NPY_API_VERSION >= 0x00000007 //(1.7)
+          PyArray_CLEARFLAGS((PyArrayObject*)nparray, NPY_ARRAY_WRITEABLE);
+        #else
+          PyArray_FLAGS(nparray) &= ~NPY_WRITEABLE;
+        #endif
+        return nparray;
+      }
+
+      /// Wrap a spectrum array returned by a read-only accessor
+      PyObject *wrapSpectrum(const bpl::object &self, data_accessor accessor, const size_t index)
+      {
+        const MatrixWorkspace &workspace = bpl::extract<MatrixWorkspace &>(self)();
+        const MantidVec &values = (workspace.*accessor)(index);
+        // The Y and E of an event workspace live in its MRU cache and are
+        // freed when they drop out of it, so they are copied
+        if(accessor != &MatrixWorkspace::readX && accessor != &MatrixWorkspace::readDx &&
+           dynamic_cast<const IEventWorkspace*>(&workspace))
+        {
+          return copyToReadOnly(values.empty() ? NULL : &values.front(), values.size(), sizeof(double));
+        }
+        const double *data = values.empty() ? NULL : &values.front();
+        return wrapMemory(data, values.size(), sizeof(double), false, findOwner(self));
+      }
+
+      /// Wrap a spectrum array returned by a writable accessor
+      PyObject *wrapSpectrum(const bpl::object &self, data_modifier accessor, const size_t index)
+      {
+        MatrixWorkspace &workspace = bpl::extract<MatrixWorkspace &>(self)();
+        MantidVec &values = (workspace.*accessor)(index);
+        const double *data = values.empty() ? NULL : &values.front();
+        return wrapMemory(data, values.size(), sizeof(double), true, findOwner(self));
+      }
+    }
+
+    /**
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A read-only numpy array over the X values of the spectrum
+     */
+    PyObject *wrapReadX(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, &MatrixWorkspace::readX, index);
+    }
+
+    /**
+     * The Y values of an event workspace are histogrammed on demand into a
+     * cache that can drop them at any time, so they are copied
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A read-only numpy array over the Y values of the spectrum
+     */
+    PyObject *wrapReadY(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, &MatrixWorkspace::readY, index);
+    }
+
+    /**
+     * The E values of an event workspace are copied, as for wrapReadY
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A read-only numpy array over the E values of the spectrum
+     */
+    PyObject *wrapReadE(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, &MatrixWorkspace::readE, index);
+    }
+
+    /**
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A read-only numpy array over the Dx values of the spectrum
+     */
+    PyObject *wrapReadDx(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, &MatrixWorkspace::readDx, index);
+    }
+
+    /**
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A writable numpy array over the X values of the spectrum
+     */
+    PyObject *wrapDataX(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, (data_modifier)&MatrixWorkspace::dataX, index);
+    }
+
+    /**
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A writable numpy array over the Y values of the spectrum
+     */
+    PyObject *wrapDataY(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, (data_modifier)&MatrixWorkspace::dataY, index);
+    }
+
+    /**
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A writable numpy array over the E values of the spectrum
+     */
+    PyObject *wrapDataE(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, (data_modifier)&MatrixWorkspace::dataE, index);
+    }
+
+    /**
+     * @param self :: A Python object wrapping a MatrixWorkspace
+     * @param index :: A workspace index
+     * @returns A writable numpy array over the Dx values of the spectrum
+     */
+    PyObject *wrapDataDx(const bpl::object &self, const size_t index)
+    {
+      return wrapSpectrum(self, (data_modifier)&MatrixWorkspace::dataDx, index);
+    }
+
+    /**
+     * The TOFs are gathered straight out of the event structures into the new
+     * array. They are copied because the events can be reallocated and any
+     * change to them must also unsort the list and clear the MRU, so changes
+     * go back through IEventWorkspace.setTofs.
+     * @param self :: A Python object wrapping an IEventWorkspace
+     * @param index :: A workspace index
+     * @returns A read-only numpy array holding a copy of the TOFs of the event list
+     */
+    PyObject *wrapReadTofs(const bpl::object &self, const size_t index)
+    {
+      IEventWorkspace &workspace = bpl::extract<IEventWorkspace &>(self)();
+      const IEventList *eventList = workspace.getEventListPtr(index);
+      size_t stride(sizeof(double));
+      const double *data = eventList->readTofs(stride);
+      return copyToReadOnly(data, eventList->getNumberEvents(), stride);
+    }
+
+  }
+}
@@ -5,6 +5,8 @@
 #include "MantidPythonInterface/kernel/Converters/NDArrayTypeIndex.h"
 #include <boost/python/extract.hpp>
 
+#include <algorithm>
+
 // See http://docs.scipy.org/doc/numpy/reference/c-api.array.html#PY_ARRAY_UNIQUE_SYMBOL
 #define PY_ARRAY_UNIQUE_SYMBOL KERNEL_ARRAY_API
 #define NO_IMPORT_ARRAY
@@ -28,7 +30,14 @@ namespace Mantid
       {
         void operator()(PyArrayObject *arr, std::vector<DestElementType> & cvector)
         {
-          // Use the iterator API to iterate through the array
+          // The type has already been coerced so a contiguous array is a straight copy
+          if(PyArray_ISCARRAY_RO(arr))
+          {
+            const DestElementType *data = (const DestElementType*)PyArray_DATA(arr);
+            std::copy(data, data + cvector.size(), cvector.begin());
+            return;
+          }
+          // Otherwise use the iterator API to iterate through the array
           // and assign each value to the corresponding vector
           PyObject *iter = PyArray_IterNew((PyObject*)arr);
           npy_intp index(0);
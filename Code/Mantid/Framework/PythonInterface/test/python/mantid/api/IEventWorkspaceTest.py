@@ -60,6 +60,45 @@ class IEventWorkspaceTest(unittest.TestCase):
         self.assertAlmostEquals(weightErrorList[0], 1.0) #first value
         self.assertAlmostEquals(weightErrorList[len(weightErrorList)-1], 1.0) #last value
 
+    def test_readTofs_gives_a_readonly_copy_of_the_events(self):
+        tofs = self._test_ws.readTofs(0)
+        self.assertFalse(tofs.flags.writeable)
+        self.assertEquals(len(tofs), 200)
+        expected = self._test_ws.getEventList(0).getTofs()
+        for i in range(len(tofs)):
+            self.assertEquals(tofs[i], expected[i])
+        self.assertTrue(tofs.flags.owndata)
+
+    def test_setTofs_writes_through_to_the_events_and_unsorts_them(self):
+        test_ws = WorkspaceCreationHelper.CreateEventWorkspace2(self._npixels, self._nbins)
+        self.assertTrue(test_ws.readY(1).sum() > 0.0)
+        tofs = test_ws.readTofs(1) + 1000.0
+        test_ws.setTofs(1, tofs)
+        self.assertAlmostEquals(test_ws.getEventList(1).getTofs()[0], 1000.5)
+        self.assertFalse(test_ws.getEventList(1).isSortedByTof())
+        # The histogram is rebuilt from the new TOFs, which are now out of range
+        self.assertEquals(test_ws.readY(1).sum(), 0.0)
+        # Other spectra are untouched
+        self.assertAlmostEquals(test_ws.getEventList(0).getTofs()[0], 0.5)
+
+    def test_setTofs_rejects_the_wrong_number_of_values(self):
+        test_ws = WorkspaceCreationHelper.CreateEventWorkspace2(self._npixels, self._nbins)
+        self.assertRaises(ValueError, test_ws.setTofs, 1, [1.0, 2.0])
+
+    def test_readY_and_readE_copy_the_histogrammed_values(self):
+        test_ws = WorkspaceCreationHelper.CreateEventWorkspace2(self._npixels, self._nbins)
+        y = test_ws.readY(0)
+        e = test_ws.readE(0)
+        self.assertFalse(y.flags.writeable)
+        self.assertFalse(e.flags.writeable)
+        expected_y, expected_e = list(y), list(e)
+        # Histograms are rebuilt into new memory after the cache is cleared
+        test_ws.clearMRU()
+        for i in range(1, self._npixels):
+            test_ws.readY(i)
+        self.assertEquals(list(y), expected_y)
+        self.assertEquals(list(e), expected_e)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -243,6 +243,31 @@ class MatrixWorkspaceTest(unittest.TestCase):
         self.assertEquals(self._test_ws.readY(0)[0], ynow)
 
 
+    def test_numpy_views_keep_a_workspace_from_the_ADS_alive(self):
+        run_algorithm('CreateWorkspace', OutputWorkspace='view_test', DataX=[1.,2.,3.], DataY=[2.,3.], DataE=[4.,5.],UnitX='TOF')
+        ads = AnalysisDataService
+        y = ads['view_test'].readY(0)
+        e = ads['view_test'].dataE(0)
+        self.assertFalse(y.flags.writeable)
+        e[1] = 6.0
+        self.assertEquals(ads['view_test'].readE(0)[1], 6.0)
+
+        ads.remove('view_test')
+        # The arrays still own a reference to the data
+        self.assertEquals(y[0], 2.0)
+        self.assertEquals(y[1], 3.0)
+        self.assertEquals(e[1], 6.0)
+
+    def test_numpy_views_keep_their_own_workspace_alive_when_the_name_is_reused(self):
+        run_algorithm('CreateWorkspace', OutputWorkspace='view_test', DataX=[1.,2.,3.], DataY=[2.,3.], DataE=[4.,5.],UnitX='TOF')
+        ads = AnalysisDataService
+        y = ads['view_test'].readY(0)
+        run_algorithm('CreateWorkspace', OutputWorkspace='view_test', DataX=[1.,2.,3.], DataY=[7.,8.], DataE=[4.,5.],UnitX='TOF')
+        self.assertEquals(ads['view_test'].readY(0)[0], 7.0)
+        self.assertEquals(y[0], 2.0)
+        self.assertEquals(y[1], 3.0)
+        ads.remove('view_test')
+
     def test_operators_with_workspaces_in_ADS(self):
         run_algorithm('CreateWorkspace', OutputWorkspace='a',DataX=[1.,2.,3.], DataY=[2.,3.], DataE=[2.,3.],UnitX='TOF')
         ads = AnalysisDataService
@@ -0,0 +1,135 @@
+import unittest
+import math
+from testhelpers import run_algorithm
+from mantid.api import AnalysisDataService, MatrixWorkspace, WorkspaceExpression
+
+class WorkspaceExpressionTest(unittest.TestCase):
+
+    def setUp(self):
+        for name, value in (('s', 10.), ('c', 5.), ('v', 2.)):
+            run_algorithm('CreateWorkspace', OutputWorkspace=name, DataX=[1.,2.,3.],
+                          DataY=[value, value], DataE=[1., 1.], UnitX='TOF')
+
+    def tearDown(self):
+        AnalysisDataService.clear()
+
+    def test_chained_expression_gives_same_values_as_operators(self):
+        ads = AnalysisDataService
+        s, c, v = ads['s'], ads['c'], ads['v']
+        expr = (WorkspaceExpression(s) - WorkspaceExpression(c) * 0.9) / v
+        self.assertEquals(expr.numberOfOperations(), 3)
+
+        fused = expr.evaluate()
+        self.assertTrue(isinstance(fused, MatrixWorkspace))
+        eager = (s - c * 0.9) / v
+        for i in range(2):
+            self.assertAlmostEqual(fused.readY(0)[i], eager.readY(0)[i])
+            self.assertAlmostEqual(fused.readE(0)[i], eager.readE(0)[i])
+
+    def test_evaluate_does_not_add_workspaces_to_the_ADS(self):
+        before = len(AnalysisDataService)
+        WorkspaceExpression(AnalysisDataService['s']).power(2.).evaluate()
+        self.assertEquals(len(AnalysisDataService), before)
+
+    def test_values_on_the_left(self):
+        result = (1.0 - WorkspaceExpression(AnalysisDataService['v'])).evaluate()
+        self.assertAlmostEqual(result.readY(0)[0], -1.0)
+
+    def test_expression_without_a_workspace_raises(self):
+        self.assertRaises(ValueError, WorkspaceExpression(1.0).evaluate)
+
+    def test_workspace_on_the_left_of_an_expression(self):
+        ads = AnalysisDataService
+        s, c, v = ads['s'], ads['c'], ads['v']
+        expr = s - WorkspaceExpression(c) * 0.9
+        self.assertTrue(isinstance(expr, WorkspaceExpression))
+        expr = v * (s / expr)
+        self.assertTrue(isinstance(expr, WorkspaceExpression))
+        self.assertEquals(expr.numberOfOperations(), 4)
+        fused = expr.evaluate()
+        eager = v * (s / (s - c * 0.9))
+        for i in range(2):
+            self.assertAlmostEqual(fused.readY(0)[i], eager.readY(0)[i])
+            self.assertAlmostEqual(fused.readE(0)[i], eager.readE(0)[i])
+
+    def test_event_workspaces_are_computed_with_the_algorithms(self):
+        run_algorithm('CreateSampleWorkspace', WorkspaceType='Event', NumBanks=1,
+                      BankPixelWidth=2, NumEvents=50, OutputWorkspace='events')
+        events = AnalysisDataService['events']
+        expr = WorkspaceExpression(events) * 2.0 + events
+        self.assertFalse(expr.isFused())
+        self.assertEquals(expr.evaluate().id(), 'EventWorkspace')
+        self._assert_same_data(expr.evaluate(), events * 2.0 + events)
+
+    def test_masked_bins_are_computed_with_the_algorithms(self):
+        self._create_histograms()
+        run_algorithm('MaskBins', InputWorkspace='hist', OutputWorkspace='hist', XMin=100., XMax=2000.)
+        ads = AnalysisDataService
+        hist, other = ads['hist'], ads['other']
+        expr = WorkspaceExpression(other) + hist
+        self.assertFalse(expr.isFused())
+        self._assert_same_data(expr.evaluate(), other + hist)
+
+    def test_values_on_the_left_of_event_workspaces(self):
+        run_algorithm('CreateSampleWorkspace', WorkspaceType='Event', NumBanks=1,
+                      BankPixelWidth=2, NumEvents=50, OutputWorkspace='events')
+        self._check_values_on_the_left('events')
+
+    def test_values_on_the_left_of_masked_workspaces(self):
+        self._create_histograms()
+        run_algorithm('MaskBins', InputWorkspace='hist', OutputWorkspace='hist', XMin=100., XMax=2000.)
+        self._check_values_on_the_left('hist')
+
+    def test_masked_detectors_are_computed_with_the_algorithms(self):
+        self._create_histograms()
+        run_algorithm('MaskDetectors', Workspace='hist', WorkspaceIndexList=[1])
+        ads = AnalysisDataService
+        hist, other = ads['hist'], ads['other']
+        expr = WorkspaceExpression(other) * hist
+        self.assertFalse(expr.isFused())
+        fused = expr.evaluate()
+        self._assert_same_data(fused, other * hist)
+        self.assertEquals(fused.readY(1)[0], 0.0)
+        self.assertTrue(fused.getDetector(1).isMasked())
+
+    def test_y_units_match_the_algorithms(self):
+        self._create_histograms()
+        ads = AnalysisDataService
+        hist, other = ads['hist'], ads['other']
+        expr = WorkspaceExpression(hist) / other
+        self.assertTrue(expr.isFused())
+        fused, eager = expr.evaluate(), hist / other
+        self.assertEquals(fused.YUnit(), eager.YUnit())
+        self.assertEquals(fused.isDistribution(), eager.isDistribution())
+        self._assert_same_data(fused, eager)
+
+    def _check_values_on_the_left(self, name):
+        """
+            Minus and Divide reject a single value on the left so the algorithms
+            compute x - ws as ws * -1 + x and x / ws as Power(ws, -1) * x
+        """
+        ws = AnalysisDataService[name]
+        expr = 2.0 - WorkspaceExpression(ws)
+        self.assertFalse(expr.isFused())
+        self._assert_same_data(expr.evaluate(), ws * -1.0 + 2.0)
+
+        # Empty and masked bins are shifted away from zero
+        expr = 2.0 / (WorkspaceExpression(ws) + 1.0)
+        self.assertFalse(expr.isFused())
+        shifted = ws + 1.0
+        run_algorithm('Power', InputWorkspace=shifted, Exponent=-1., OutputWorkspace='inverse')
+        self._assert_same_data(expr.evaluate(), AnalysisDataService['inverse'] * 2.0)
+
+    def _create_histograms(self):
+        run_algorithm('CreateSampleWorkspace', NumBanks=1, BankPixelWidth=2, OutputWorkspace='hist')
+        run_algorithm('CreateSampleWorkspace', NumBanks=1, BankPixelWidth=2, OutputWorkspace='other')
+
+    def _assert_same_data(self, lhs, rhs):
+        self.assertEquals(lhs.getNumberHistograms(), rhs.getNumberHistograms())
+        for i in range(lhs.getNumberHistograms()):
+            for j in range(lhs.blocksize()):
+                self.assertAlmostEqual(lhs.readY(i)[j], rhs.readY(i)[j])
+                self.assertAlmostEqual(lhs.readE(i)[j], rhs.readE(i)[j])
+
+if __name__ == '__main__':
+    unittest.main()
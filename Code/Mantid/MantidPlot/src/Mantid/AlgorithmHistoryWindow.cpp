@@ -296,7 +296,7 @@ AlgEnvHistoryGrpBox* AlgorithmHistoryWindow::createEnvHistGrpBox(const Environme
 AlgHistoryProperties* AlgorithmHistoryWindow::createAlgHistoryPropWindow()
 {	
   std::vector<PropertyHistory_sptr> histProp;
-  const Mantid::API::AlgorithmHistories & entries = m_algHist.getAlgorithmHistories();
+  const Mantid::API::AlgorithmHistories entries = m_algHist.getAlgorithmHistories();
   auto rIter = entries.rbegin();
   histProp=(*rIter)->getProperties();
 
@@ -597,7 +597,7 @@ void AlgHistoryTreeWidget::selectionChanged ( const QItemSelection & selected, c
 void AlgHistoryTreeWidget::populateAlgHistoryTreeWidget(const WorkspaceHistory& wsHist)
 {
   this->blockSignals(true);
-  const Mantid::API::AlgorithmHistories & entries = wsHist.getAlgorithmHistories();
+  const Mantid::API::AlgorithmHistories entries = wsHist.getAlgorithmHistories();
   auto algHistIter = entries.begin();
 
   QString algName = "";
@@ -616,7 +616,7 @@ void AlgHistoryTreeWidget::populateAlgHistoryTreeWidget(const WorkspaceHistory&
 void AlgHistoryTreeWidget::populateNestedHistory(AlgHistoryItem* parentWidget, Mantid::API::AlgorithmHistory_sptr history)
 {
   QString algName = "";
-  const Mantid::API::AlgorithmHistories & entries = history->getChildHistories();
+  const Mantid::API::AlgorithmHistories entries = history->getChildHistories();
   if(history->childHistorySize() > 0)
   {
     parentWidget->setFlags(Qt::ItemIsUserCheckable | Qt::ItemIsSelectable | Qt::ItemIsEnabled );